@@ -5,21 +5,78 @@
  *
  *  Communication Protocol (UART):
  *  ------------------------------
+ *  Every command and response is one frame (see services/frame.h):
+ *    SOF(0x7E) | LEN | CMD | PAYLOAD[LEN] | CRC16
+ *  Frames with a bad length or CRC are dropped by the receiver.
+ *  The first payload byte is a sequence number (see services/request.h);
+ *  each response echoes the sequence number of its command. The formats
+ *  below describe the payload after that byte.
+ *
  *  Commands from HMI_ECU to Control_ECU:
  *    'S' - Setup Password: Receive 2 passwords (5 digits each), store if match
  *    'O' - Open Door: Receive password (5 digits), verify and open door
  *    'C' - Change Password: Receive old password, then 2 new passwords
  *    'T' - Set Timeout: Receive timeout value (1 byte integer, 5-30), then password
+ *    'H' - Link Health: Diagnostic, answered even during lockout
+ *    'R' - Ready Query: (unsolicited) HMI is waiting for the ready signal
  *
  *  Responses from Control_ECU to HMI_ECU:
- *    'R' - Ready: System initialized and ready
+ *    'R' - Ready: System initialized and ready (payload: timeout byte);
+ *          sent unsolicited each time the HMI link comes up, and in
+ *          answer to a Ready Query
  *    'Y' - Success: Operation completed successfully
  *    'N' - Failure: Operation failed (wrong password, etc.)
  *    'L' - Lockout: System locked out (3 wrong attempts)
+ *    'B' - Busy: Door is still moving/open, request not accepted
+ *    'H' - Health: Link counters of the Control ECU (see below)
+ *
+ *  Events from Control_ECU to HMI_ECU (unsolicited, sequence number 0):
+ *    'D' - Door state: [state][timestamp ms, 4 bytes big-endian][duration s]
+ *          state: 0 secured, 1 unlocking, 2 open, 3 locking
+ *          duration: how long the state lasts (0 for secured)
+ *
+ *  Link control (commands below 0x20, no sequence number) is handled
+ *  inside HAL_COMM and never reaches the handlers below: the baud-rate
+ *  negotiation run once at startup, and the reliable-delivery layer
+ *  (services/link.h) that carries every frame below with its own SEQ,
+ *  ACKs and retransmission, and the heartbeat both ECUs send when their
+ *  side of the link has been quiet for a second. The HMI counts as lost
+ *  after HAL_COMM_LIVENESS_MS without a valid frame; when it is heard
+ *  again the baud rate is renegotiated and Ready is repeated.
+ *
+ *  Built with HAL_COMM_BUS_MODE = HAL_COMM_BUS_MASTER, one Control serves
+ *  HAL_COMM_BUS_NODES HMI panels on an RS-485 bus (see hal_comm.h). Each
+ *  response goes to the panel that sent the command, Ready to each panel
+ *  as it comes up, and door events to all panels. Password, lockout and
+ *  timeout are shared by all panels.
+ *
+ *  Payload Format:
+ *    - Passwords: [len][len ASCII digits], len 5-16
+ *    - 'S': [pwd1][pwd2], or a single 0 byte to query whether one is set
+ *    - 'O': [pwd]
+ *    - 'C': [old pwd][new pwd][new pwd]
+ *    - 'T': [timeout (5-30)][pwd]
+ *    - 'H': (none), or [1] to clear the UART counters after reading them
+ *    - 'H' response, big-endian, 58 bytes, exactly these fields in order:
+ *         rxBytes, txBytes, rxRingOverruns, rxFifoOverruns, framingErrors,
+ *         parityErrors, breaks, rxThrottles, crcErrors, lengthErrors,
+ *         truncatedFrames, retransmits (4 bytes each),
+ *         rxHighWater, txHighWater, rxBurstMax (2 bytes each),
+ *         isrMaxCycles (4 bytes)
+ *      HAL_COMM_StatsType.linkDropped is not sent (it would take the reply
+ *      past a reliable-link request's 61 bytes); the console "stats"
+ *      command shows it.
+ *    A payload shorter than its length bytes claim is answered with 'N'.
  *
- *  Data Format:
- *    - Passwords: 5 bytes (ASCII digits, sent as individual bytes)
- *    - Timeout: 1 byte (integer value, 5-30)
+ *  Diagnostic Console (UART0, the ICDI virtual COM port, 115200 8N1):
+ *  ------------------------------------------------------------------
+ *  Built only with DIAG_CONSOLE_ENABLE=1: it has no password.
+ *  A line shell pumped from the main loop; type "help" for the commands
+ *  (EEPROM layout, link counters, motor, ADC, idle time, CPU load, and
+ *  the "prof" table in PROF_ENABLE builds). It only reads what has already
+ *  arrived and never waits on UART1. In TRACE_ENABLE builds "trace on" also
+ *  streams the event trace (services/trace.h) as binary packets between
+ *  console lines, for Common/host/trace_export.c.
  *===========================================================================*/
 
 #include <stdint.h>
@@ -32,11 +89,19 @@
 #include "mcal/mcal_gpio.h"
 #include "mcal/mcal_systick.h"
 #include "mcal/mcal_eeprom.h"
+#include "mcal/mcal_adc.h"
 
 #include "hal/hal_eeprom.h"
 #include "hal/hal_motor.h"
 #include "hal/hal_buzzer.h"
 #include "hal/hal_comm.h"
+#include "services/request.h"
+#include "services/console.h"
+#include "services/swtimer.h"
+#include "services/prof.h"
+#include "services/timebase.h"
+#include "services/trace.h"
+#include "services/cpuload.h"
 #include "Types.h"
 
 /*======================================================================
@@ -56,12 +121,18 @@
 #define CMD_SET_TIMEOUT         'T'  /* Set auto-lock timeout */
 #define CMD_VERIFY_PASSWORD     'V'  /* Verify password (for timeout) */
 #define CMD_READY               'R'  /* System ready */
+#define CMD_HEALTH              'H'  /* Link health counters (diagnostic) */
 
 /* Communication Protocol Responses */
 #define RESP_SUCCESS            'Y'  /* Success/Yes */
 #define RESP_FAILURE            'N'  /* Failure/No */
 #define RESP_LOCKOUT            'L'  /* System locked out */
 #define RESP_READY              'R'  /* Ready for command */
+#define RESP_BUSY               'B'  /* Door sequence in progress */
+#define RESP_HEALTH             'H'  /* Link health counters */
+
+/* Communication Protocol Events (unsolicited) */
+#define EVT_DOOR_STATE          'D'  /* Door state transition */
 
 /* Password Configuration */
 #define PASSWORD_MAX_LENGTH     (16U)  /* Maximum password length (matches HAL_EEPROM) */
@@ -74,8 +145,45 @@
 #define TIMEOUT_MAX_SECONDS     (30U)  /* Maximum timeout: 30 seconds */
 #define TIMEOUT_DEFAULT_SECONDS (15U)  /* Default timeout: 15 seconds */
 
+/* Door motor timing */
+#define DOOR_UNLOCK_TIME_MS     (2000U)  /* Bolt retract time */
+#define DOOR_LOCK_TIME_MS       (2000U)  /* Bolt extend time */
+
 /* EEPROM Addresses */
 #define EEPROM_TIMEOUT_ADDR     (28U)  /* Timeout value storage (after password flag at 24) */
+/* HAL_COMM_BAUD_CACHE_ADDR (32) holds the negotiated link rate */
+
+/* Diagnostic console. It can drive the bolt motor without a password, so
+ * it is off unless a bench build sets DIAG_CONSOLE_ENABLE to 1. */
+#ifndef DIAG_CONSOLE_ENABLE
+#define DIAG_CONSOLE_ENABLE     (0)
+#endif
+#define CONSOLE_BAUD_RATE       (115200U)
+#define CONSOLE_CHARS_PER_LOOP  (16U)    /* Input handled per main-loop pass */
+#define CONSOLE_MOTOR_MAX_MS    (DOOR_UNLOCK_TIME_MS)  /* A manual move stops by itself */
+
+/* Longest idle sleep. UART interrupts end it early; polled work (link
+ * supervision, heartbeats, retransmits) is at most this late. The bus
+ * master runs its poll turns from the loop, so it only sleeps tick by tick. */
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+#define IDLE_MAX_SLEEP_MS       (1U)
+#else
+#define IDLE_MAX_SLEEP_MS       (20U)
+#endif
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Door opening sequence, advanced by doorTimer.
+ * Values are sent as-is in EVT_DOOR_STATE events. */
+typedef enum
+{
+    DOOR_IDLE = 0,      /* Locked (reported as "secured") */
+    DOOR_UNLOCKING,     /* Motor forward */
+    DOOR_OPEN,          /* Motor stopped, waiting for auto-lock timeout */
+    DOOR_LOCKING        /* Motor backward */
+} DoorStateType;
 
 /*======================================================================
  *  Local Variables
@@ -84,24 +192,88 @@
 static uint8_t wrongAttempts = 0U;
 static boolean isLockedOut = FALSE;
 static uint32_t currentTimeout = TIMEOUT_DEFAULT_SECONDS;
+static uint8_t requestSeq = REQ_SEQ_UNSOLICITED;  /* Echoed in responses */
+static uint8_t requestNode = HAL_COMM_NODE_PEER;  /* Panel that sent the command */
+static boolean linkUp[HAL_COMM_BUS_NODES];       /* Panel heard from recently */
+
+static DoorStateType doorState = DOOR_IDLE;
+static uint32_t doorStateStartMs = 0U;
+static uint32_t doorOpenMs = 0U;
+static SWTIMER_Type doorTimer;                    /* Ends the current door step */
+static SWTIMER_Type lockoutTimer;                 /* Ends the lockout */
+
+static HAL_COMM_HandleType consolePort = NULL;   /* NULL: console disabled */
+#if (DIAG_CONSOLE_ENABLE != 0)
+static boolean consoleAdcReady = FALSE;
+static SWTIMER_Type consoleMotorTimer;           /* Ends a manual motor move */
+#endif
 
 /*======================================================================
  *  Local Function Prototypes
  *====================================================================*/
 
 static void System_Init(void);
+static void System_OnTick(void);
 static void LED_Init(void);
 static void LED_SetGreen(void);
 static void LED_SetRed(void);
 static void LED_Clear(void);
+static void Motor_Move(Motor_DirType direction);
 static uint32_t EEPROM_ReadTimeout(void);
 static uint8_t EEPROM_StoreTimeout(uint32_t timeout);
-static void HandlePasswordSetup(void);
-static void HandleOpenDoor(void);
-static void HandleChangePassword(void);
-static void HandleSetTimeout(void);
+static void SendResponse(uint8_t response);
+static void SendReady(uint8_t node);
+static void Link_Supervise(void);
+static void Link_WaitHook(void);
+static boolean Frame_ReadPassword(const FRAME_Type *frame, uint8_t *pos,
+                                  char *password, uint8_t *pwdLen);
+static void HandlePasswordSetup(const FRAME_Type *frame);
+static void HandleOpenDoor(const FRAME_Type *frame);
+static void HandleChangePassword(const FRAME_Type *frame);
+static void HandleSetTimeout(const FRAME_Type *frame);
+static void HandleHealth(const FRAME_Type *frame);
+static void Frame_PutU32(uint8_t *buf, uint8_t *pos, uint32_t value);
 static void ActivateLockout(void);
 static void OpenDoorSequence(uint32_t timeoutSeconds);
+static void Lockout_End(void *context);
+static void DoorSequence_Step(void *context);
+static void DoorSequence_Enter(DoorStateType state, uint32_t durationMs);
+static void Idle_Sleep(void);
+static void Console_Init(void);
+static void Console_Service(void);
+#if (DIAG_CONSOLE_ENABLE != 0)
+static void Console_Puts(const char *str);
+static void Console_PrintValue(const char *label, uint32_t value);
+static void Console_PrintEepromWord(uint32_t addr, const char *label);
+static void Console_CmdEeprom(uint8_t argc, char *argv[]);
+static void Console_CmdStats(uint8_t argc, char *argv[]);
+static void Console_CmdMotor(uint8_t argc, char *argv[]);
+static void Console_MotorStop(void *context);
+static void Console_CmdAdc(uint8_t argc, char *argv[]);
+static void Console_CmdIdle(uint8_t argc, char *argv[]);
+#endif
+#if (TRACE_ENABLE != 0)
+static void Console_SendTrace(void);
+#endif
+
+#if (DIAG_CONSOLE_ENABLE != 0)
+/* Console command table ("help" is built in) */
+static const CONSOLE_CommandType consoleCommands[] =
+{
+    { "eeprom", "EEPROM layout and stored words",             Console_CmdEeprom },
+    { "stats",  "[reset] link counters (reset clears UART)",  Console_CmdStats  },
+    { "motor",  "fwd|back|stop - drive the bolt motor (2 s)", Console_CmdMotor  },
+    { "adc",    "read AIN0 (PE3)",                            Console_CmdAdc    },
+    { "idle",   "uptime and time spent asleep",               Console_CmdIdle   },
+    { "load",   "[reset] CPU load per second, peak, busy max", LOAD_ConsoleCmd  },
+#if (PROF_ENABLE != 0)
+    { "prof",   "[reset] cycles per profiled site",          PROF_ConsoleCmd   },
+#endif
+#if (TRACE_ENABLE != 0)
+    { "trace",  "[on|off] stream the event trace",            TRACE_ConsoleCmd  },
+#endif
+};
+#endif
 
 /*======================================================================
  *  Main Function
@@ -109,8 +281,10 @@ static void OpenDoorSequence(uint32_t timeoutSeconds);
 
 int main(void)
 {
-    uint8_t command;
+    FRAME_Type frame;
+    FRAME_Type request;
     uint8_t eepromResult;
+    boolean gotFrame;
     
     /* System Clock Setup */
     //SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN);
@@ -147,78 +321,104 @@ int main(void)
     //     EEPROM_StoreTimeout(currentTimeout);
     // }
     
-    /* Send ready signal to HMI */
-    HAL_COMM_SendByte(CMD_READY);
-    /* HMI waits for this byte after seeing CMD_READY */
-    HAL_COMM_SendByte((uint8_t)currentTimeout);
+    /* Baud negotiation and the ready signal follow as soon as the HMI is
+     * heard (Link_Supervise), and again after every link loss */
+    REQ_Init(HAL_COMM_SendFrame, HAL_COMM_MAX_PAYLOAD);
     
     /* Main application loop */
     while(1)
     {
-        /* Check if data is available from HMI */
-        if (HAL_COMM_IsDataAvailable())
+        /* Check if a complete command frame has arrived from HMI */
+        gotFrame = HAL_COMM_PollFrame(&frame);
+        if (gotFrame && REQ_Unwrap(&frame, &requestSeq, &request))
         {
-            /* Read command byte */
-            command = HAL_COMM_ReceiveByte();
+            TRACE(TRACE_EVT_REQ_RECV, request.cmd, requestSeq);
+
+            /* Responses go back to the panel that asked */
+            requestNode = HAL_COMM_GetSourceNode();
+            HAL_COMM_SelectNode(requestNode);
             
             /* Process command based on current state */
-            switch(command)
+            switch(request.cmd)
             {
                 case CMD_SETUP_PASSWORD:
                     if (!isLockedOut)
                     {
-                        HandlePasswordSetup();
+                        HandlePasswordSetup(&request);
                     }
                     else
                     {
-                        HAL_COMM_SendByte(RESP_LOCKOUT);
+                        SendResponse(RESP_LOCKOUT);
                     }
                     break;
                     
                 case CMD_OPEN_DOOR:
                     if (!isLockedOut)
                     {
-                        HandleOpenDoor();
+                        HandleOpenDoor(&request);
                     }
                     else
                     {
-                        HAL_COMM_SendByte(RESP_LOCKOUT);
+                        SendResponse(RESP_LOCKOUT);
                     }
                     break;
                     
                 case CMD_CHANGE_PASSWORD:
                     if (!isLockedOut)
                     {
-                        HandleChangePassword();
+                        HandleChangePassword(&request);
                     }
                     else
                     {
-                        HAL_COMM_SendByte(RESP_LOCKOUT);
+                        SendResponse(RESP_LOCKOUT);
                     }
                     break;
                     
                 case CMD_SET_TIMEOUT:
                     if (!isLockedOut)
                     {
-                        HandleSetTimeout();
+                        HandleSetTimeout(&request);
                     }
                     else
                     {
-                        HAL_COMM_SendByte(RESP_LOCKOUT);
+                        SendResponse(RESP_LOCKOUT);
                     }
                     break;
                     
+                case CMD_HEALTH:
+                    /* Diagnostic only: allowed during lockout */
+                    HandleHealth(&request);
+                    break;
+                    
+                case CMD_READY:
+                    /* HMI restarted or lost us while we still heard it */
+                    SendReady(requestNode);
+                    break;
+                    
                 default:
                     /* Unknown command - ignore */
                     break;
             }
         }
         
-        /* Keep this delay small:
-         * UART1 runs at 115200 and has a limited RX FIFO. Large idle delays can
-         * let an entire command frame arrive without being drained, causing RX
-         * FIFO overflow and the receiver to block forever waiting for missing bytes. */
-        MCAL_SysTick_DelayMs(1U);
+        /* Timed work (door sequence, lockout) runs between commands */
+        SWTIMER_Process(MCAL_SysTick_GetTickMs());
+        
+        /* Repeat the ready handshake whenever the HMI comes (back) up */
+        Link_Supervise();
+        
+        /* Diagnostic shell on UART0 */
+        Console_Service();
+        
+        /* Sleep until the next deadline or interrupt; more frames may be
+         * waiting in the RX ring after one was handled, so go round first.
+         * UART1 RX is drained into a RAM ring by the UART1 ISR, so sleeping
+         * only adds command latency; it does not risk overflowing the
+         * 16-byte hardware FIFO. */
+        if (!gotFrame)
+        {
+            Idle_Sleep();
+        }
     }
     
     //return 0;
@@ -236,8 +436,27 @@ static void System_Init(void)
     /* Initialize SysTick for delays */
     MCAL_SysTick_Init();
     
-    /* Initialize UART communication */
+    /* Cycle counter for PROF_BEGIN/PROF_END (nothing unless PROF_ENABLE) */
+    PROF_Init();
+    
+    /* Microsecond timebase and the event trace it stamps records with
+     * (the trace is nothing unless TRACE_ENABLE) */
+    TIME_Init();
+    TRACE_Init(TRACE_ECU_CONTROL);
+    
+    /* Initialize UART communication; heartbeats and the load meter run
+     * off the SysTick */
     HAL_COMM_Init();
+    LOAD_Init();
+    MCAL_SysTick_SetCallback(System_OnTick);
+    
+    /* Software timers for the door sequence and lockout */
+    SWTIMER_Init(MCAL_SysTick_GetTickMs());
+    SWTIMER_Setup(&doorTimer, DoorSequence_Step, NULL);
+    SWTIMER_Setup(&lockoutTimer, Lockout_End, NULL);
+    
+    /* Baud negotiation blocks; the door and lockout timers run through it */
+    HAL_COMM_SetWaitHook(Link_WaitHook);
     
     /* Initialize Motor */
     HAL_Motor_Init();
@@ -249,7 +468,19 @@ static void System_Init(void)
     LED_Init();
     
     /* Ensure motor is stopped initially */
-    HAL_Motor_Move(MOTOR_STOP);
+    Motor_Move(MOTOR_STOP);
+    
+    /* Diagnostic console on UART0 */
+    Console_Init();
+}
+
+/**
+ * @brief SysTick callback work (interrupt context)
+ */
+static void System_OnTick(void)
+{
+    HAL_COMM_OnTick();
+    LOAD_OnTick();
 }
 
 /**
@@ -290,6 +521,16 @@ static void LED_Clear(void)
     MCAL_GPIO_WritePin(LED_PORT_BASE, RED_LED_PIN, LOGIC_LOW);
 }
 
+/**
+ * @brief Drive the bolt motor; the change goes into the event trace here,
+ *        as the motor HAL stays free of services
+ */
+static void Motor_Move(Motor_DirType direction)
+{
+    TRACE(TRACE_EVT_MOTOR, direction, 0U);
+    HAL_Motor_Move(direction);
+}
+
 /*======================================================================
  *  EEPROM Timeout Functions
  *====================================================================*/
@@ -350,74 +591,152 @@ static uint8_t EEPROM_StoreTimeout(uint32_t timeout)
  *  Command Handlers
  *====================================================================*/
 
+/**
+ * @brief Send a response frame (no payload) to HMI
+ * Echoes the sequence number of the command being handled.
+ * @param response RESP_* code
+ */
+static void SendResponse(uint8_t response)
+{
+    REQ_Reply(requestSeq, response, NULL, 0U);
+}
+
+/**
+ * @brief Send the unsolicited ready signal, carrying the stored timeout
+ * @param node Panel to send it to (HAL_COMM_NODE_PEER point-to-point)
+ */
+static void SendReady(uint8_t node)
+{
+    uint8_t timeoutByte = (uint8_t)currentTimeout;
+    
+    HAL_COMM_SelectNode(node);
+    REQ_Reply(REQ_SEQ_UNSOLICITED, CMD_READY, &timeoutByte, 1U);
+    HAL_COMM_SelectNode(requestNode);
+}
+
+/**
+ * @brief Follow each HMI's liveness and redo the handshake on each (re)connect
+ * HAL_COMM drops to the base baud rate when the HMI goes quiet, so the
+ * rate is negotiated again (cached in EEPROM after the first agreement)
+ * before Ready is sent; the HMI answers the probe while it waits.
+ */
+static void Link_Supervise(void)
+{
+    boolean alive;
+    uint8_t node;
+    
+    for (node = 1U; node <= HAL_COMM_BUS_NODES; node++)
+    {
+        alive = HAL_COMM_IsNodeAlive(node);
+        if (alive && !linkUp[node - 1U])
+        {
+            /* No-op on the bus, where every panel runs the base rate */
+            (void)HAL_COMM_NegotiateBaud();
+            SendReady(node);
+        }
+        linkUp[node - 1U] = alive;
+    }
+}
+
+/**
+ * @brief Keep the software timers running while HAL_COMM_NegotiateBaud()
+ *        waits; their callbacks only drive the motor and buzzer, never
+ *        the link
+ */
+static void Link_WaitHook(void)
+{
+    SWTIMER_Process(MCAL_SysTick_GetTickMs());
+}
+
+/**
+ * @brief Read one length-prefixed password from a frame payload
+ * @param frame    Received command frame
+ * @param pos      Read offset; advanced past the password on success
+ * @param password Destination (PASSWORD_MAX_LENGTH + 1 bytes), null-terminated
+ * @param pwdLen   Receives the password length
+ * @return TRUE if the length byte and all password bytes are present
+ */
+static boolean Frame_ReadPassword(const FRAME_Type *frame, uint8_t *pos,
+                                  char *password, uint8_t *pwdLen)
+{
+    uint8_t len;
+    uint8_t i;
+
+    if (*pos >= frame->len)
+    {
+        return FALSE;
+    }
+
+    len = frame->payload[*pos];
+    if ((len > PASSWORD_MAX_LENGTH) ||
+        ((uint16_t)*pos + 1U + len > (uint16_t)frame->len))
+    {
+        return FALSE;
+    }
+
+    for (i = 0U; i < len; i++)
+    {
+        password[i] = (char)frame->payload[*pos + 1U + i];
+    }
+    password[len] = '\0';
+
+    *pwdLen = len;
+    *pos    = (uint8_t)(*pos + 1U + len);
+
+    return TRUE;
+}
+
 /**
  * @brief Handle initial password setup
- * Protocol:
- * 1. Receive first password (5 digits)
- * 2. Receive second password (5 digits) for confirmation
+ * Payload:
+ * 1. First password (length-prefixed)
+ * 2. Second password (length-prefixed) for confirmation
  * 3. Compare and store if match, otherwise send failure
+ * A payload of a single 0 byte queries whether a password is already set.
  */
-static void HandlePasswordSetup(void)
+static void HandlePasswordSetup(const FRAME_Type *frame)
 {
     char password1[PASSWORD_MAX_LENGTH + 1U];
     char password2[PASSWORD_MAX_LENGTH + 1U];
     boolean passwordsMatch;
     uint8_t result;
     uint8_t len1, len2;
+    uint8_t pos = 0U;
     uint8_t i;
     
-    /* Receive first password length */
-    len1 = HAL_COMM_ReceiveByte();
-    
-    /* If length is 0, this is a query - check if password is already set */
-    if (len1 == 0U)
+    /* If first length is 0, this is a query - check if password is already set */
+    if ((frame->len >= 1U) && (frame->payload[0] == 0U))
     {
         if (HAL_EEPROM_IsPasswordSet())
         {
-            HAL_COMM_SendByte(RESP_FAILURE);  /* Password already set */
+            SendResponse(RESP_FAILURE);  /* Password already set */
         }
         else
         {
-            HAL_COMM_SendByte(RESP_SUCCESS);  /* No password, need setup */
+            SendResponse(RESP_SUCCESS);  /* No password, need setup */
         }
         return;
     }
     
-    /* Validate first password length */
-    if (len1 < PASSWORD_MIN_LENGTH || len1 > PASSWORD_MAX_LENGTH)
+    /* Extract both passwords; a truncated payload is rejected */
+    if (!Frame_ReadPassword(frame, &pos, password1, &len1) ||
+        !Frame_ReadPassword(frame, &pos, password2, &len2))
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
-    /* Receive first password (variable length) */
-    for (i = 0U; i < len1; i++)
+    /* Validate password lengths */
+    if (len1 < PASSWORD_MIN_LENGTH || len2 < PASSWORD_MIN_LENGTH)
     {
-        password1[i] = (char)HAL_COMM_ReceiveByte();
-    }
-    password1[len1] = '\0';
-    
-    /* Receive second password length */
-    len2 = HAL_COMM_ReceiveByte();
-    
-    /* Validate second password length */
-    if (len2 < PASSWORD_MIN_LENGTH || len2 > PASSWORD_MAX_LENGTH)
-    {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
-    /* Receive second password (confirmation, variable length) */
-    for (i = 0U; i < len2; i++)
-    {
-        password2[i] = (char)HAL_COMM_ReceiveByte();
-    }
-    password2[len2] = '\0';
-    
     /* Check if lengths match first */
     if (len1 != len2)
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
@@ -438,54 +757,51 @@ static void HandlePasswordSetup(void)
         result = HAL_EEPROM_StorePassword(password1, len1);
         if (result == HAL_EEPROM_SUCCESS)
         {
-            HAL_COMM_SendByte(RESP_SUCCESS);
+            SendResponse(RESP_SUCCESS);
             LED_SetGreen();
             wrongAttempts = 0U;  /* Reset wrong attempts */
             isLockedOut = FALSE;  /* Clear lockout on success */
         }
         else
         {
-            HAL_COMM_SendByte(RESP_FAILURE);
+            SendResponse(RESP_FAILURE);
         }
     }
     else
     {
         /* Passwords don't match */
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
     }
 }
 
 /**
  * @brief Handle open door request
- * Protocol:
- * 1. Receive password from HMI
+ * Payload:
+ * 1. Password (length-prefixed)
  * 2. Verify password
  * 3. If correct: open door, wait timeout, close door
  * 4. If wrong: increment attempts, activate lockout if 3 failures
  */
-static void HandleOpenDoor(void)
+static void HandleOpenDoor(const FRAME_Type *frame)
 {
     char receivedPassword[PASSWORD_MAX_LENGTH + 1U];
     boolean isCorrect;
     uint8_t pwdLen;
-    uint8_t i;
-    
-    /* Receive password length */
-    pwdLen = HAL_COMM_ReceiveByte();
+    uint8_t pos = 0U;
     
-    /* Validate length */
-    if (pwdLen > PASSWORD_MAX_LENGTH)
+    /* Door still moving or open - refuse without counting an attempt */
+    if (doorState != DOOR_IDLE)
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_BUSY);
         return;
     }
     
-    /* Receive password from HMI (variable length) */
-    for (i = 0U; i < pwdLen; i++)
+    /* Extract password; a truncated payload is rejected */
+    if (!Frame_ReadPassword(frame, &pos, receivedPassword, &pwdLen))
     {
-        receivedPassword[i] = (char)HAL_COMM_ReceiveByte();
+        SendResponse(RESP_FAILURE);
+        return;
     }
-    receivedPassword[pwdLen] = '\0';
     
     /* Verify password */
     isCorrect = HAL_EEPROM_VerifyPassword(receivedPassword, pwdLen);
@@ -493,7 +809,7 @@ static void HandleOpenDoor(void)
     if (isCorrect)
     {
         /* Correct password - open door */
-        HAL_COMM_SendByte(RESP_SUCCESS);
+        SendResponse(RESP_SUCCESS);
         LED_SetGreen();
         wrongAttempts = 0U;  /* Reset wrong attempts */
         isLockedOut = FALSE;  /* Clear lockout on success */
@@ -508,24 +824,24 @@ static void HandleOpenDoor(void)
         
         if (wrongAttempts >= MAX_PASSWORD_ATTEMPTS)
         {
-          HAL_COMM_SendByte(RESP_LOCKOUT);
+          SendResponse(RESP_LOCKOUT);
             ActivateLockout();
         }
         else{
-          HAL_COMM_SendByte(RESP_FAILURE);
+          SendResponse(RESP_FAILURE);
         }
     }
 }
 
 /**
  * @brief Handle change password request
- * Protocol:
- * 1. Receive old password
+ * Payload:
+ * 1. Old password, then new password twice (all length-prefixed)
  * 2. Verify old password
- * 3. If correct: receive new password twice (confirmation)
+ * 3. If correct: check the new password against its confirmation
  * 4. Store new password if confirmation matches
  */
-static void HandleChangePassword(void)
+static void HandleChangePassword(const FRAME_Type *frame)
 {
     char oldPassword[PASSWORD_MAX_LENGTH + 1U];
     char newPassword1[PASSWORD_MAX_LENGTH + 1U];
@@ -533,25 +849,18 @@ static void HandleChangePassword(void)
     boolean passwordsMatch;
     uint8_t result;
     uint8_t oldLen, newLen1, newLen2;
+    uint8_t pos = 0U;
     uint8_t i;
     
-    /* Receive old password length */
-    oldLen = HAL_COMM_ReceiveByte();
-    
-    /* Validate length */
-    if (oldLen > PASSWORD_MAX_LENGTH)
+    /* Extract all three passwords; a truncated payload is rejected */
+    if (!Frame_ReadPassword(frame, &pos, oldPassword, &oldLen) ||
+        !Frame_ReadPassword(frame, &pos, newPassword1, &newLen1) ||
+        !Frame_ReadPassword(frame, &pos, newPassword2, &newLen2))
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
-    /* Receive old password (variable length) */
-    for (i = 0U; i < oldLen; i++)
-    {
-        oldPassword[i] = (char)HAL_COMM_ReceiveByte();
-    }
-    oldPassword[oldLen] = '\0';
-    
     /* Verify old password */
     if (!HAL_EEPROM_VerifyPassword(oldPassword, oldLen))
     {
@@ -560,55 +869,28 @@ static void HandleChangePassword(void)
 
         if (wrongAttempts >= MAX_PASSWORD_ATTEMPTS)
         {
-            HAL_COMM_SendByte(RESP_LOCKOUT);
+            SendResponse(RESP_LOCKOUT);
             ActivateLockout();
         }
         else
         {
-            HAL_COMM_SendByte(RESP_FAILURE);
+            SendResponse(RESP_FAILURE);
         }
 
         return;
     }
     
-    /* Old password correct - receive new password length */
-    newLen1 = HAL_COMM_ReceiveByte();
-    
-    /* Validate new password length */
-    if (newLen1 < PASSWORD_MIN_LENGTH || newLen1 > PASSWORD_MAX_LENGTH)
-    {
-        HAL_COMM_SendByte(RESP_FAILURE);
-        return;
-    }
-    
-    /* Receive new password (variable length) */
-    for (i = 0U; i < newLen1; i++)
-    {
-        newPassword1[i] = (char)HAL_COMM_ReceiveByte();
-    }
-    newPassword1[newLen1] = '\0';
-    
-    /* Receive confirmation length */
-    newLen2 = HAL_COMM_ReceiveByte();
-    
-    /* Validate confirmation length */
-    if (newLen2 < PASSWORD_MIN_LENGTH || newLen2 > PASSWORD_MAX_LENGTH)
+    /* Old password correct - validate new password lengths */
+    if (newLen1 < PASSWORD_MIN_LENGTH || newLen2 < PASSWORD_MIN_LENGTH)
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
-    /* Receive confirmation (variable length) */
-    for (i = 0U; i < newLen2; i++)
-    {
-        newPassword2[i] = (char)HAL_COMM_ReceiveByte();
-    }
-    newPassword2[newLen2] = '\0';
-    
     /* Check if lengths match first */
     if (newLen1 != newLen2)
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
@@ -630,63 +912,59 @@ static void HandleChangePassword(void)
                                            newPassword1, newLen1);
         if (result == HAL_EEPROM_SUCCESS)
         {
-            HAL_COMM_SendByte(RESP_SUCCESS);
+            SendResponse(RESP_SUCCESS);
             LED_SetGreen();
             wrongAttempts = 0U;  /* Reset wrong attempts */
             isLockedOut = FALSE;  /* Clear lockout on success */
         }
         else
         {
-            HAL_COMM_SendByte(RESP_FAILURE);
+            SendResponse(RESP_FAILURE);
         }
     }
     else
     {
         /* New passwords don't match */
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
     }
 }
 
 /**
  * @brief Handle set timeout request
- * Protocol:
- * 1. Receive timeout value (as single byte integer, 5-30)
- * 2. Receive password for verification (exactly 5 bytes)
+ * Payload:
+ * 1. Timeout value (single byte integer, 5-30)
+ * 2. Password for verification (length-prefixed)
  * 3. If password correct: store timeout value
  */
-static void HandleSetTimeout(void)
+static void HandleSetTimeout(const FRAME_Type *frame)
 {
     char password[PASSWORD_MAX_LENGTH + 1U];
     uint8_t timeoutValue;
     uint8_t result;
-    uint8_t i;
-    
-    /* Receive timeout value as single byte (integer) */
-    timeoutValue = HAL_COMM_ReceiveByte();
+    uint8_t pwdLen;
+    uint8_t pos = 1U;
     
-    /* Validate timeout range (5-30 seconds) */
-    if (timeoutValue < TIMEOUT_MIN_SECONDS || timeoutValue > TIMEOUT_MAX_SECONDS)
+    /* Timeout value is the first payload byte */
+    if (frame->len < 1U)
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
+    timeoutValue = frame->payload[0];
     
-    /* Receive password length */
-    uint8_t pwdLen = HAL_COMM_ReceiveByte();
-    
-    /* Validate length */
-    if (pwdLen > PASSWORD_MAX_LENGTH)
+    /* Validate timeout range (5-30 seconds) */
+    if (timeoutValue < TIMEOUT_MIN_SECONDS || timeoutValue > TIMEOUT_MAX_SECONDS)
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
         return;
     }
     
-    /* Receive password for verification (variable length) */
-    for (i = 0U; i < pwdLen; i++)
+    /* Extract password for verification; a truncated payload is rejected */
+    if (!Frame_ReadPassword(frame, &pos, password, &pwdLen))
     {
-        password[i] = (char)HAL_COMM_ReceiveByte();
+        SendResponse(RESP_FAILURE);
+        return;
     }
-    password[pwdLen] = '\0';
     
     /* Verify password */
     if (!HAL_EEPROM_VerifyPassword(password, pwdLen))
@@ -696,12 +974,12 @@ static void HandleSetTimeout(void)
 
         if (wrongAttempts >= MAX_PASSWORD_ATTEMPTS)
         {
-            HAL_COMM_SendByte(RESP_LOCKOUT);
+            SendResponse(RESP_LOCKOUT);
             ActivateLockout();
         }
         else
         {
-            HAL_COMM_SendByte(RESP_FAILURE);
+            SendResponse(RESP_FAILURE);
         }
         return;
     }
@@ -711,14 +989,60 @@ static void HandleSetTimeout(void)
     if (result == HAL_EEPROM_SUCCESS)
     {
         currentTimeout = (uint32_t)timeoutValue;
-        HAL_COMM_SendByte(RESP_SUCCESS);
+        SendResponse(RESP_SUCCESS);
         LED_SetGreen();
         wrongAttempts = 0U;  /* Reset wrong attempts */
         isLockedOut = FALSE;  /* Clear lockout on success */
     }
     else
     {
-        HAL_COMM_SendByte(RESP_FAILURE);
+        SendResponse(RESP_FAILURE);
+    }
+}
+
+/**
+ * @brief Handle link health request
+ * Replies with the HAL_COMM counters so a degraded link (line errors,
+ * overruns, CRC failures, retransmissions) shows up before commands
+ * start to fail.
+ * @param frame Received command frame
+ */
+static void HandleHealth(const FRAME_Type *frame)
+{
+    HAL_COMM_StatsType stats;
+    uint8_t payload[58];
+    uint8_t pos = 0U;
+    
+    HAL_COMM_GetStats(&stats);
+    
+    Frame_PutU32(payload, &pos, stats.rxBytes);
+    Frame_PutU32(payload, &pos, stats.txBytes);
+    Frame_PutU32(payload, &pos, stats.rxRingOverruns);
+    Frame_PutU32(payload, &pos, stats.rxFifoOverruns);
+    Frame_PutU32(payload, &pos, stats.framingErrors);
+    Frame_PutU32(payload, &pos, stats.parityErrors);
+    Frame_PutU32(payload, &pos, stats.breaks);
+    Frame_PutU32(payload, &pos, stats.rxThrottles);
+    Frame_PutU32(payload, &pos, stats.crcErrors);
+    Frame_PutU32(payload, &pos, stats.lengthErrors);
+    Frame_PutU32(payload, &pos, stats.truncatedFrames);
+    Frame_PutU32(payload, &pos, stats.retransmits);
+    
+    payload[pos++] = (uint8_t)(stats.rxHighWater >> 8);
+    payload[pos++] = (uint8_t)(stats.rxHighWater);
+    payload[pos++] = (uint8_t)(stats.txHighWater >> 8);
+    payload[pos++] = (uint8_t)(stats.txHighWater);
+    payload[pos++] = (uint8_t)(stats.rxBurstMax >> 8);
+    payload[pos++] = (uint8_t)(stats.rxBurstMax);
+    
+    Frame_PutU32(payload, &pos, stats.isrMaxCycles);
+    
+    REQ_Reply(requestSeq, RESP_HEALTH, payload, pos);
+    
+    /* Clear after the snapshot so nothing is lost between the two */
+    if ((frame->len >= 1U) && (frame->payload[0] == 1U))
+    {
+        HAL_COMM_ResetStats();
     }
 }
 
@@ -726,13 +1050,28 @@ static void HandleSetTimeout(void)
  *  Helper Functions
  *====================================================================*/
 
+/**
+ * @brief Append a big-endian 32-bit value to a frame payload
+ * @param buf   Payload buffer
+ * @param pos   Write offset; advanced by 4
+ * @param value Value to append
+ */
+static void Frame_PutU32(uint8_t *buf, uint8_t *pos, uint32_t value)
+{
+    buf[(*pos)++] = (uint8_t)(value >> 24);
+    buf[(*pos)++] = (uint8_t)(value >> 16);
+    buf[(*pos)++] = (uint8_t)(value >> 8);
+    buf[(*pos)++] = (uint8_t)(value);
+}
+
 
 /**
  * @brief Activate lockout mode (3 wrong attempts)
  * - Sound buzzer for specified duration
  * - Set lockout flag during buzzer period
  * - Reset wrong attempts counter
- * - Clear lockout after buzzer period (system returns to main menu)
+ * lockoutTimer runs Lockout_End() once the period is over, so commands
+ * keep being answered (with 'L') meanwhile.
  */
 static void ActivateLockout(void)
 {
@@ -740,39 +1079,392 @@ static void ActivateLockout(void)
     wrongAttempts = 0U;
     LED_SetRed();
 
-    //HAL_COMM_SendByte(RESP_LOCKOUT);
+    //SendResponse(RESP_LOCKOUT);
     
     /* Sound buzzer for lockout duration */
-    BUZZER_beep(LOCKOUT_BUZZER_DURATION);
+    BUZZER_setState(BUZZER_ON);
+    SWTIMER_Start(&lockoutTimer, LOCKOUT_BUZZER_DURATION, 0U);
+}
+
+/**
+ * @brief End of the lockout period (lockoutTimer expiry)
+ * Silences the buzzer and clears the lockout flag (system returns to main menu)
+ */
+static void Lockout_End(void *context)
+{
+    (void)context;
     
-    /* After lockout period, clear lockout flag (system returns to main menu) */
+    BUZZER_setState(BUZZER_OFF);
     isLockedOut = FALSE;
 }
 
 /**
- * @brief Execute door opening sequence
+ * @brief Start the door opening sequence
+ * Each motor step is ended by doorTimer (DoorSequence_Step),
+ * so the ECU keeps answering commands while the door is open.
  * @param timeoutSeconds Timeout in seconds before auto-lock
  */
 static void OpenDoorSequence(uint32_t timeoutSeconds)
 {
+    doorOpenMs = timeoutSeconds * 1000U;
+    doorStateStartMs = MCAL_SysTick_GetTickMs();
+    
     /* 1. Unlock door (motor forward) */
-    HAL_Motor_Move(MOTOR_FORWARD);
+    Motor_Move(MOTOR_FORWARD);
+    DoorSequence_Enter(DOOR_UNLOCKING, DOOR_UNLOCK_TIME_MS);
+}
+
+/**
+ * @brief Switch door state, tell HMI about it and time the step
+ * Event payload: [state][timestamp ms (BE32)][duration s, rounded up]
+ * The step ends at doorStateStartMs + durationMs, so dispatch latency
+ * does not accumulate over the sequence.
+ * @param state      New door state
+ * @param durationMs How long the state will last (0 when secured)
+ */
+static void DoorSequence_Enter(DoorStateType state, uint32_t durationMs)
+{
+    uint8_t event[6];
+    int32_t remainingMs;
+    
+    doorState = state;
+    
+    event[0] = (uint8_t)state;
+    event[1] = (uint8_t)(doorStateStartMs >> 24);
+    event[2] = (uint8_t)(doorStateStartMs >> 16);
+    event[3] = (uint8_t)(doorStateStartMs >> 8);
+    event[4] = (uint8_t)(doorStateStartMs);
+    event[5] = (uint8_t)((durationMs + 999U) / 1000U);
+    
+    /* Every panel shows the door */
+    HAL_COMM_SelectNode(HAL_COMM_ADDR_BROADCAST);
+    REQ_Reply(REQ_SEQ_UNSOLICITED, EVT_DOOR_STATE, event, (uint8_t)sizeof(event));
+    HAL_COMM_SelectNode(requestNode);
+    
+    if (state == DOOR_IDLE)
+    {
+        return;
+    }
+    
+    remainingMs = (int32_t)((doorStateStartMs + durationMs) - MCAL_SysTick_GetTickMs());
+    SWTIMER_Start(&doorTimer, (remainingMs > 0) ? (uint32_t)remainingMs : 0U, 0U);
+}
+
+/**
+ * @brief End the current door step and start the next (doorTimer expiry)
+ */
+static void DoorSequence_Step(void *context)
+{
+    (void)context;
+    
+    switch (doorState)
+    {
+        case DOOR_UNLOCKING:
+            /* 2. Bolt retracted: hold position */
+            Motor_Move(MOTOR_STOP);
+            doorStateStartMs += DOOR_UNLOCK_TIME_MS;
+            DoorSequence_Enter(DOOR_OPEN, doorOpenMs);
+            break;
+            
+        case DOOR_OPEN:
+            /* 3. Timeout period over (user could enter): lock */
+            Motor_Move(MOTOR_BACKWARD);
+            doorStateStartMs += doorOpenMs;
+            DoorSequence_Enter(DOOR_LOCKING, DOOR_LOCK_TIME_MS);
+            break;
+            
+        case DOOR_LOCKING:
+            /* 4. Bolt extended: stop */
+            Motor_Move(MOTOR_STOP);
+            doorStateStartMs += DOOR_LOCK_TIME_MS;
+            DoorSequence_Enter(DOOR_IDLE, 0U);
+            break;
+            
+        case DOOR_IDLE:
+        default:
+            break;
+    }
+}
+
+/*======================================================================
+ *  Idle
+ *====================================================================*/
+
+/**
+ * @brief Sleep until the next timer deadline, or an interrupt
+ * Tickless when nothing is due for a while, so the core is not woken
+ * every millisecond just to find nothing to do.
+ */
+static void Idle_Sleep(void)
+{
+    uint32_t sleepMs;
+    
+    sleepMs = SWTIMER_GetIdleMs(MCAL_SysTick_GetTickMs(), IDLE_MAX_SLEEP_MS);
+    
+    if (sleepMs != 0U)
+    {
+        MCAL_SysTick_Sleep(sleepMs);
+    }
+}
+
+/*======================================================================
+ *  Diagnostic Console
+ *====================================================================*/
+
+/**
+ * @brief Open UART0 and start the shell (no-op with DIAG_CONSOLE_ENABLE 0)
+ */
+static void Console_Init(void)
+{
+#if (DIAG_CONSOLE_ENABLE != 0)
+    SWTIMER_Setup(&consoleMotorTimer, Console_MotorStop, NULL);
+    consolePort = HAL_COMM_Open(HAL_COMM_PORT_UART0, CONSOLE_BAUD_RATE);
+    if (consolePort != NULL)
+    {
+        CONSOLE_Init(consoleCommands,
+                     (uint8_t)(sizeof(consoleCommands) / sizeof(consoleCommands[0])),
+                     Console_Puts);
+    }
+#endif
+}
+
+/**
+ * @brief Feed the shell what UART0 has received, a bounded amount per pass
+ * Commands run here, between command frames, and print into the UART0
+ * TX ring, so the UART1 protocol is never held up by console I/O.
+ */
+static void Console_Service(void)
+{
+    uint8_t data;
+    uint8_t count = 0U;
+    
+    while ((count < CONSOLE_CHARS_PER_LOOP) &&
+           HAL_COMM_PortReceiveByte(consolePort, &data))
+    {
+        CONSOLE_Feed((char)data);
+        count++;
+    }
+    
+#if (TRACE_ENABLE != 0)
+    Console_SendTrace();
+#endif
+}
+
+#if (TRACE_ENABLE != 0)
+/**
+ * @brief Drain the event trace into the UART0 TX ring
+ * A packet is only built when it fits whole, so it never blocks and is
+ * never cut by console output.
+ */
+static void Console_SendTrace(void)
+{
+    uint8_t  packet[TRACE_PACKET_MAX_SIZE];
+    uint16_t len;
+    uint16_t i;
+    
+    while (HAL_COMM_PortGetTxRoom(consolePort) >= TRACE_PACKET_MAX_SIZE)
+    {
+        len = TRACE_BuildPacket(packet, (uint16_t)sizeof(packet));
+        if (len == 0U)
+        {
+            break;
+        }
+        for (i = 0U; i < len; i++)
+        {
+            HAL_COMM_PortSendByte(consolePort, packet[i]);
+        }
+    }
+}
+#endif
+
+#if (DIAG_CONSOLE_ENABLE != 0)
+/**
+ * @brief Console output hook
+ */
+static void Console_Puts(const char *str)
+{
+    HAL_COMM_PortSendString(consolePort, str);
+}
+
+/**
+ * @brief Print one "label value" line
+ */
+static void Console_PrintValue(const char *label, uint32_t value)
+{
+    CONSOLE_Print(label);
+    CONSOLE_PrintDec(value);
+    CONSOLE_Print("\r\n");
+}
+
+/**
+ * @brief Print one EEPROM word with its address and meaning
+ */
+static void Console_PrintEepromWord(uint32_t addr, const char *label)
+{
+    uint32_t word;
+    
+    CONSOLE_PrintHex(addr, 2U);
+    CONSOLE_Print("  ");
+    CONSOLE_Print(label);
+    if (MCAL_EEPROM_ReadWord(addr, &word) == EEPROM_SUCCESS)
+    {
+        CONSOLE_PrintHex(word, 8U);
+        CONSOLE_Print(" (");
+        CONSOLE_PrintDec(word);
+        CONSOLE_Print(")\r\n");
+    }
+    else
+    {
+        CONSOLE_Print("read error\r\n");
+    }
+}
+
+/**
+ * @brief eeprom - show the EEPROM layout and its stored words
+ * The password itself is never printed.
+ */
+static void Console_CmdEeprom(uint8_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    
+    CONSOLE_Print("addr  field     value\r\n");
+    CONSOLE_PrintHex(HAL_EEPROM_PASSWORD_START_ADDR, 2U);
+    CONSOLE_Print("  password  ");
+    CONSOLE_Print(HAL_EEPROM_IsPasswordSet() ? "set (hidden)\r\n" : "not set\r\n");
+    Console_PrintEepromWord(HAL_EEPROM_PASSWORD_LENGTH_ADDR, "length    ");
+    Console_PrintEepromWord(HAL_EEPROM_PASSWORD_SET_FLAG_ADDR, "set flag  ");
+    Console_PrintEepromWord(EEPROM_TIMEOUT_ADDR, "timeout s ");
+    Console_PrintEepromWord(HAL_COMM_BAUD_CACHE_ADDR, "link baud ");
+}
+
+/**
+ * @brief stats [reset] - link health counters, as in the 'H' command
+ */
+static void Console_CmdStats(uint8_t argc, char *argv[])
+{
+    HAL_COMM_StatsType stats;
+    
+    HAL_COMM_GetStats(&stats);
+    
+    Console_PrintValue("rx bytes          ", stats.rxBytes);
+    Console_PrintValue("tx bytes          ", stats.txBytes);
+    Console_PrintValue("rx ring overruns  ", stats.rxRingOverruns);
+    Console_PrintValue("rx fifo overruns  ", stats.rxFifoOverruns);
+    Console_PrintValue("framing errors    ", stats.framingErrors);
+    Console_PrintValue("parity errors     ", stats.parityErrors);
+    Console_PrintValue("breaks            ", stats.breaks);
+    Console_PrintValue("rx throttles      ", stats.rxThrottles);
+    Console_PrintValue("crc errors        ", stats.crcErrors);
+    Console_PrintValue("length errors     ", stats.lengthErrors);
+    Console_PrintValue("truncated frames  ", stats.truncatedFrames);
+    Console_PrintValue("retransmits       ", stats.retransmits);
+    Console_PrintValue("link dropped      ", stats.linkDropped);
+    Console_PrintValue("rx high water     ", stats.rxHighWater);
+    Console_PrintValue("tx high water     ", stats.txHighWater);
+    Console_PrintValue("rx burst max      ", stats.rxBurstMax);
+    Console_PrintValue("isr max cycles    ", stats.isrMaxCycles);
+    Console_PrintValue("peer alive        ", HAL_COMM_IsPeerAlive() ? 1U : 0U);
+    
+    if ((argc > 1U) && (strcmp(argv[1], "reset") == 0))
+    {
+        HAL_COMM_ResetStats();
+        CONSOLE_Print("UART counters cleared\r\n");
+    }
+}
+
+/**
+ * @brief motor fwd|back|stop - drive the bolt motor by hand
+ * Refused while the door sequence owns the motor. A move stops by itself
+ * after CONSOLE_MOTOR_MAX_MS, so a lost "stop" cannot stall it at the end
+ * of its travel.
+ */
+static void Console_CmdMotor(uint8_t argc, char *argv[])
+{
+    if (doorState != DOOR_IDLE)
+    {
+        CONSOLE_Print("door sequence running\r\n");
+        return;
+    }
     
-    /* 2. Wait for bolt to retract (2 seconds) */
-    MCAL_SysTick_DelayMs(2000U);
+    if ((argc > 1U) && (strcmp(argv[1], "fwd") == 0))
+    {
+        Motor_Move(MOTOR_FORWARD);
+        SWTIMER_Start(&consoleMotorTimer, CONSOLE_MOTOR_MAX_MS, 0U);
+    }
+    else if ((argc > 1U) && (strcmp(argv[1], "back") == 0))
+    {
+        Motor_Move(MOTOR_BACKWARD);
+        SWTIMER_Start(&consoleMotorTimer, CONSOLE_MOTOR_MAX_MS, 0U);
+    }
+    else if ((argc > 1U) && (strcmp(argv[1], "stop") == 0))
+    {
+        SWTIMER_Stop(&consoleMotorTimer);
+        Motor_Move(MOTOR_STOP);
+    }
+    else
+    {
+        CONSOLE_Print("usage: motor fwd|back|stop\r\n");
+        return;
+    }
     
-    /* 3. Stop motor (hold position) */
-    HAL_Motor_Move(MOTOR_STOP);
+    CONSOLE_Print("ok\r\n");
+}
+
+/**
+ * @brief consoleMotorTimer expired: end the manual move
+ * Leaves the motor alone if a door sequence has taken it over since.
+ */
+static void Console_MotorStop(void *context)
+{
+    (void)context;
+    
+    if (doorState == DOOR_IDLE)
+    {
+        Motor_Move(MOTOR_STOP);
+        CONSOLE_Print("motor stopped\r\n");
+    }
+}
+
+/**
+ * @brief adc - one conversion of AIN0 (PE3)
+ */
+static void Console_CmdAdc(uint8_t argc, char *argv[])
+{
+    uint16_t raw;
     
-    /* 4. Wait for timeout period (user can enter) */
-    MCAL_SysTick_DelayMs(timeoutSeconds * 1000U);
+    (void)argc;
+    (void)argv;
     
-    /* 5. Lock door (motor backward) */
-    HAL_Motor_Move(MOTOR_BACKWARD);
+    if (!consoleAdcReady)
+    {
+        ADC_Init(ADC_CHANNEL_0);
+        consoleAdcReady = TRUE;
+    }
     
-    /* 6. Wait for bolt to extend (2 seconds) */
-    MCAL_SysTick_DelayMs(2000U);
+    PROF_BEGIN(PROF_SITE_ADC_READ);
+    raw = ADC_Read();
+    PROF_END(PROF_SITE_ADC_READ);
+    CONSOLE_Print("AIN0 raw ");
+    CONSOLE_PrintDec(raw);
+    CONSOLE_Print(", ");
+    CONSOLE_PrintDec(ADC_ToMillivolts(raw));
+    CONSOLE_Print(" mV\r\n");
+}
+
+/**
+ * @brief idle - uptime, time asleep and the idle share
+ */
+static void Console_CmdIdle(uint8_t argc, char *argv[])
+{
+    uint32_t upMs = MCAL_SysTick_GetTickMs();
+    uint32_t idleMs = MCAL_SysTick_GetIdleMs();
     
-    /* 7. Stop motor */
-    HAL_Motor_Move(MOTOR_STOP);
-}
\ No newline at end of file
+    (void)argc;
+    (void)argv;
+    
+    Console_PrintValue("uptime ms  ", upMs);
+    Console_PrintValue("idle ms    ", idleMs);
+    Console_PrintValue("idle %     ", (upMs != 0U) ? (uint32_t)(((uint64_t)idleMs * 100U) / upMs) : 0U);
+}
+#endif /* DIAG_CONSOLE_ENABLE */
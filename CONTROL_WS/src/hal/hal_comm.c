@@ -7,17 +7,784 @@
 #include "hal/hal_comm.h"
 #include "mcal/mcal_uart.h"
 #include "mcal/mcal_gpio.h"
+#include "mcal/mcal_systick.h"
+#include "mcal/mcal_eeprom.h"
 
 #include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
+
+#if (HAL_COMM_FLOW_CONTROL == UART_FLOW_RTS_CTS) && (HAL_COMM_PORT != HAL_COMM_PORT_UART1)
+#error "UART_FLOW_RTS_CTS needs the link on UART1"
+#endif
+
+/*======================================================================
+ *  Port Table
+ *====================================================================*/
+
+/* Pins and peripherals of one UART port */
+typedef struct
+{
+    uint32_t uartPeriph;
+    uint32_t intNumber;
+    uint32_t gpioPeriph;
+    uint32_t gpioPort;
+    uint32_t rxPinConfig;       /* GPIO_Pxn_UnRX for GPIOPinConfigure() */
+    uint32_t txPinConfig;       /* GPIO_Pxn_UnTX */
+    uint8_t  pins;              /* RX | TX */
+    uint8_t  lockedPins;        /* Locked at reset, unlocked before muxing */
+} HalComm_PortMapType;
+
+/* Indexed by HAL_COMM_PORT_UARTn */
+static const HalComm_PortMapType portMap[HAL_COMM_NUM_PORTS] =
+{
+    { SYSCTL_PERIPH_UART0, INT_UART0, SYSCTL_PERIPH_GPIOA, GPIO_PORTA_BASE,
+      GPIO_PA0_U0RX, GPIO_PA1_U0TX, GPIO_PIN_0 | GPIO_PIN_1, 0U },
+    { SYSCTL_PERIPH_UART1, INT_UART1, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE,
+      GPIO_PB0_U1RX, GPIO_PB1_U1TX, GPIO_PIN_0 | GPIO_PIN_1, 0U },
+    { SYSCTL_PERIPH_UART2, INT_UART2, SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE,
+      GPIO_PD6_U2RX, GPIO_PD7_U2TX, GPIO_PIN_6 | GPIO_PIN_7, GPIO_PIN_7 },
+    { SYSCTL_PERIPH_UART3, INT_UART3, SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE,
+      GPIO_PC6_U3RX, GPIO_PC7_U3TX, GPIO_PIN_6 | GPIO_PIN_7, 0U },
+    { SYSCTL_PERIPH_UART4, INT_UART4, SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE,
+      GPIO_PC4_U4RX, GPIO_PC5_U4TX, GPIO_PIN_4 | GPIO_PIN_5, 0U },
+    { SYSCTL_PERIPH_UART5, INT_UART5, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE,
+      GPIO_PE4_U5RX, GPIO_PE5_U5TX, GPIO_PIN_4 | GPIO_PIN_5, 0U },
+    { SYSCTL_PERIPH_UART6, INT_UART6, SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE,
+      GPIO_PD4_U6RX, GPIO_PD5_U6TX, GPIO_PIN_4 | GPIO_PIN_5, 0U },
+    { SYSCTL_PERIPH_UART7, INT_UART7, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE,
+      GPIO_PE0_U7RX, GPIO_PE1_U7TX, GPIO_PIN_0 | GPIO_PIN_1, 0U }
+};
 
 /*======================================================================
  *  Local Variables
  *====================================================================*/
 
-static boolean isInitialized = FALSE;
+static boolean isInitialized = FALSE;
+
+/* RX ring filled and TX ring drained by the link UART's ISR (power-of-two sizes) */
+static uint8_t rxRing[HAL_COMM_RX_BUFFER_SIZE];
+static uint8_t txRing[HAL_COMM_TX_BUFFER_SIZE];
+
+/* Incremental parser for incoming protocol frames */
+static FRAME_ParserType frameParser;
+static uint32_t         frameLastRxMs;   /* Tick of the last byte fed to the parser */
+
+#if (HAL_COMM_FRAMING_COBS != 0)
+/* COBS packets are decoded here first, then run through frameParser */
+static COBS_DecoderType cobsDecoder;
+static uint8_t          cobsPacket[FRAME_MAX_SIZE];
+#endif
+
+/* Baud-rate negotiation */
+static uint32_t       uartClockHz;
+static uint32_t       currentBaud = HAL_COMM_BAUD_RATE;
+static const uint32_t baudCandidates[] = HAL_COMM_BAUD_CANDIDATES;
+static HAL_COMM_WaitHookType waitHook = NULL;      /* HAL_COMM_SetWaitHook() */
+static boolean        probeFailed = FALSE;         /* Last full probe found no faster rate ... */
+static uint32_t       probeFailedMs;               /* ... at this tick */
+
+/* Liveness supervision. txLock is held by the main loop while it queues a
+ * frame or changes rate, so HAL_COMM_OnTick() never splits either. */
+static volatile uint8_t  txLock = 0U;
+static volatile uint32_t lastTxMs;        /* Tick the main loop last finished queueing */
+static uint32_t          lastHeardMs;     /* Tick of the last valid frame from the peer */
+static boolean           peerAlive = FALSE;
+static uint8_t           heartbeatWire[COBS_MAX_ENCODED(FRAME_OVERHEAD)];
+static uint16_t          heartbeatLen;    /* Encoded once at init */
+
+/* Ports opened with HAL_COMM_Open(); slot i owns ring pair i of the pools */
+static HAL_COMM_InstanceType openPorts[HAL_COMM_MAX_OPEN_PORTS];
+static uint8_t               openPortCount = 0U;
+static uint8_t               portRxPool[HAL_COMM_MAX_OPEN_PORTS][HAL_COMM_PORT_RX_BUFFER_SIZE];
+static uint8_t               portTxPool[HAL_COMM_MAX_OPEN_PORTS][HAL_COMM_PORT_TX_BUFFER_SIZE];
+
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+/* A frame waiting for its turn on the bus */
+typedef struct
+{
+    uint8_t addr;                               /* Destination (master) or own address (slave) */
+    uint8_t cmd;
+    uint8_t len;
+    uint8_t payload[HAL_COMM_MAX_PAYLOAD];      /* After the address byte */
+} HalComm_BusFrameType;
+
+static HalComm_BusFrameType busQueue[HAL_COMM_BUS_QUEUE_DEPTH];
+static uint8_t              busQueueHead;
+static uint8_t              busQueueCount;
+#endif
+
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+static uint8_t  busDest = HAL_COMM_ADDR_BROADCAST;   /* HAL_COMM_SelectNode() */
+static uint8_t  busSource = HAL_COMM_NODE_PEER;      /* Sender of the last frame returned */
+static uint8_t  busWaitNode = 0U;                     /* Slave whose answer is due, 0 = none */
+static uint32_t busWaitMs;
+static uint8_t  busNextPoll = 1U;
+static uint32_t nodeHeardMs[HAL_COMM_BUS_NODES];
+static boolean  nodeAlive[HAL_COMM_BUS_NODES];
+static uint32_t nodeProbeMs[HAL_COMM_BUS_NODES];     /* Last poll of a silent slave */
+#endif
+
+/* Outcome of one negotiation attempt */
+#define HAL_COMM_TRY_OK             (0U)
+#define HAL_COMM_TRY_FAILED         (1U)   /* Refused or errors at the trial rate */
+#define HAL_COMM_TRY_NO_PEER        (2U)   /* Proposal never answered */
+
+#if (HAL_COMM_RECORD_ENABLE != 0)
+static COMMREC_RecordType recordRing[HAL_COMM_RECORD_DEPTH];
+#define HAL_COMM_RECORD(dir, data)  COMMREC_Record((dir), (data), MCAL_SysTick_GetTickMs())
+#else
+#define HAL_COMM_RECORD(dir, data)  ((void)0)
+#endif
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+/* Wrap-around safe deadline check; HAL_COMM_WAIT_FOREVER never expires */
+static boolean prv_isExpired(uint32_t startMs, uint32_t timeoutMs)
+{
+    if (timeoutMs == HAL_COMM_WAIT_FOREVER)
+    {
+        return FALSE;
+    }
+
+    return ((MCAL_SysTick_GetTickMs() - startMs) >= timeoutMs) ? TRUE : FALSE;
+}
+
+/* Clock a port and hand its pins to the UART */
+static void prv_muxPort(uint8_t port)
+{
+    const HalComm_PortMapType *map = &portMap[port];
+
+    /* MCAL handles enable + ready wait */
+    MCAL_GPIO_EnablePort(map->uartPeriph);
+    MCAL_GPIO_EnablePort(map->gpioPeriph);
+
+    if (map->lockedPins != 0U)
+    {
+        MCAL_GPIO_UnlockPin(map->gpioPort, map->lockedPins);
+    }
+
+    GPIOPinConfigure(map->rxPinConfig);
+    GPIOPinConfigure(map->txPinConfig);
+    GPIOPinTypeUART(map->gpioPort, map->pins);
+}
+
+/* All byte-wise TX/RX goes through these so the recorder sees it */
+static void prv_txByte(uint8_t data)
+{
+    HAL_COMM_RECORD(COMMREC_DIR_TX, data);
+    sendByte(HAL_COMM_UART_MODULE, data);
+}
+
+static void prv_txLock(void)
+{
+    txLock++;
+}
+
+static void prv_txUnlock(void)
+{
+    lastTxMs = MCAL_SysTick_GetTickMs();
+    txLock--;
+}
+
+static uint8_t prv_rxByte(void)
+{
+    uint8_t data = receiveByte(HAL_COMM_UART_MODULE);
+
+    HAL_COMM_RECORD(COMMREC_DIR_RX, data);
+    return data;
+}
+
+/* Run one received byte through the wire framing; TRUE once
+ * frameParser.frame holds a complete frame */
+static boolean prv_feedByte(uint8_t data)
+{
+#if (HAL_COMM_FRAMING_COBS != 0)
+    boolean  done = FALSE;
+    uint16_t i;
+
+    if (COBS_DecoderFeed(&cobsDecoder, data) != COBS_STATUS_COMPLETE)
+    {
+        return FALSE;
+    }
+
+    /* A packet carries exactly one plain frame, SOF included */
+    FRAME_ParserAbort(&frameParser);
+    for (i = 0U; (i < cobsDecoder.length) && !done; i++)
+    {
+        done = (FRAME_ParserFeed(&frameParser, cobsPacket[i]) == FRAME_STATUS_COMPLETE) ? TRUE : FALSE;
+    }
+    return done;
+#else
+    return (FRAME_ParserFeed(&frameParser, data) == FRAME_STATUS_COMPLETE) ? TRUE : FALSE;
+#endif
+}
+
+static boolean prv_rxIsBusy(void)
+{
+#if (HAL_COMM_FRAMING_COBS != 0)
+    return COBS_DecoderIsBusy(&cobsDecoder);
+#else
+    return FRAME_ParserIsBusy(&frameParser);
+#endif
+}
+
+static void prv_rxAbort(void)
+{
+#if (HAL_COMM_FRAMING_COBS != 0)
+    COBS_DecoderReset(&cobsDecoder);
+#endif
+    FRAME_ParserAbort(&frameParser);
+}
+
+/* Encode one frame in its wire form; returns 0 if it does not fit */
+static uint16_t prv_encodeWire(uint8_t cmd, const uint8_t *payload, uint8_t len,
+                               uint8_t *buf, uint16_t bufSize)
+{
+#if (HAL_COMM_FRAMING_COBS != 0)
+    uint8_t  plainBuf[FRAME_MAX_SIZE];
+    uint16_t plainLen;
+
+    plainLen = FRAME_Encode(cmd, payload, len, plainBuf, (uint16_t)sizeof(plainBuf));
+    if (plainLen == 0U)
+    {
+        return 0U;
+    }
+    return COBS_Encode(plainBuf, plainLen, buf, bufSize);
+#else
+    return FRAME_Encode(cmd, payload, len, buf, bufSize);
+#endif
+}
+
+/* Encode and queue one frame as is (no link layer) */
+static uint8_t prv_sendRaw(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    uint8_t  frameBuf[COBS_MAX_ENCODED(FRAME_MAX_SIZE)];
+    uint16_t frameLen;
+    uint16_t i;
+
+    frameLen = prv_encodeWire(cmd, payload, len, frameBuf, (uint16_t)sizeof(frameBuf));
+    if (frameLen == 0U)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    prv_txLock();
+    for (i = 0U; i < frameLen; i++)
+    {
+        prv_txByte(frameBuf[i]);
+    }
+    prv_txUnlock();
+
+    return HAL_COMM_SUCCESS;
+}
+
+/* Feed buffered bytes to the parser; returns every complete frame */
+static boolean prv_pollRaw(FRAME_Type *frame)
+{
+    uint8_t i;
+
+    /* Sender went quiet mid-frame: drop the fragment so the next SOF resyncs */
+    if (!isDataAvailable(HAL_COMM_UART_MODULE) && prv_rxIsBusy() &&
+        prv_isExpired(frameLastRxMs, HAL_COMM_FRAME_GAP_MS))
+    {
+        prv_rxAbort();
+    }
+
+    while (isDataAvailable(HAL_COMM_UART_MODULE))
+    {
+        frameLastRxMs = MCAL_SysTick_GetTickMs();
+
+        if (prv_feedByte(prv_rxByte()))
+        {
+            lastHeardMs = frameLastRxMs;
+            peerAlive   = TRUE;
+
+            frame->cmd = frameParser.frame.cmd;
+            frame->len = frameParser.frame.len;
+            for (i = 0U; i < frame->len; i++)
+            {
+                frame->payload[i] = frameParser.frame.payload[i];
+            }
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* Wait for a frame with the given command, discarding anything else */
+static boolean prv_waitFrame(uint8_t cmd, FRAME_Type *frame, uint32_t timeoutMs)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+
+    while (!prv_isExpired(start, timeoutMs))
+    {
+        if (prv_pollRaw(frame) && (frame->cmd == cmd))
+        {
+            return TRUE;
+        }
+        if (waitHook != NULL)
+        {
+            waitHook();
+        }
+    }
+
+    return FALSE;
+}
+
+/* Negotiation pause that keeps the wait hook running */
+static void prv_waitMs(uint32_t ms)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+
+    while (!prv_isExpired(start, ms))
+    {
+        if (waitHook != NULL)
+        {
+            waitHook();
+        }
+    }
+}
+
+static boolean prv_isValidBaud(uint32_t baud)
+{
+    return ((baud != 0U) && (baud <= (uartClockHz / 8U))) ? TRUE : FALSE;
+}
+
+static void prv_putBe32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)(value >> 24);
+    buf[1] = (uint8_t)(value >> 16);
+    buf[2] = (uint8_t)(value >> 8);
+    buf[3] = (uint8_t)value;
+}
+
+static uint32_t prv_getBe32(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+           ((uint32_t)buf[2] << 8)  |  (uint32_t)buf[3];
+}
+
+/* Switch rates once the last byte at the old rate has left */
+static void prv_setBaud(uint32_t baud)
+{
+    prv_txLock();
+    (void)HAL_COMM_Flush(HAL_COMM_BAUD_REPLY_MS);
+
+    (void)UART_SetBaudRate(HAL_COMM_UART_MODULE, uartClockHz, baud);
+    currentBaud = baud;
+    prv_txUnlock();
+
+    /* Anything half-received belongs to the old rate */
+    while (isDataAvailable(HAL_COMM_UART_MODULE))
+    {
+        (void)prv_rxByte();
+    }
+    prv_rxAbort();
+}
+
+/* Test pattern: alternating bits, all-zero/all-one runs and the SOF,
+ * then a round-dependent sequence so stale echoes do not match */
+static void prv_fillTestPattern(uint8_t *buf, uint8_t round)
+{
+    static const uint8_t head[] = { 0x55U, 0xAAU, 0x00U, 0xFFU, FRAME_SOF, 0x80U, 0x01U, 0xF0U };
+    uint8_t i;
+
+    for (i = 0U; i < HAL_COMM_BAUD_TEST_LEN; i++)
+    {
+        buf[i] = (i < sizeof(head)) ? head[i] : (uint8_t)((i * 37U) + round);
+    }
+}
+
+/* Proposer side of one candidate (see HAL_COMM_NegotiateBaud) */
+static uint8_t prv_tryBaud(uint32_t baud)
+{
+    uint8_t    proposal[4];
+    uint8_t    pattern[HAL_COMM_BAUD_TEST_LEN];
+    FRAME_Type reply;
+    boolean    ok = FALSE;
+    uint8_t    round;
+    uint8_t    i;
+
+    prv_putBe32(proposal, baud);
+
+    for (i = 0U; (i < HAL_COMM_BAUD_RETRIES) && !ok; i++)
+    {
+        (void)prv_sendRaw(HAL_COMM_CMD_BAUD_PROPOSE, proposal, 4U);
+        ok = prv_waitFrame(HAL_COMM_CMD_BAUD_PROPOSE, &reply, HAL_COMM_BAUD_REPLY_MS);
+    }
+
+    if (!ok)
+    {
+        return HAL_COMM_TRY_NO_PEER;
+    }
+
+    if ((reply.len < 4U) || (prv_getBe32(reply.payload) != baud))
+    {
+        return HAL_COMM_TRY_FAILED;
+    }
+
+    prv_setBaud(baud);
+    prv_waitMs(HAL_COMM_BAUD_SETTLE_MS);
+
+    for (round = 0U; (round < HAL_COMM_BAUD_TEST_ROUNDS) && ok; round++)
+    {
+        prv_fillTestPattern(pattern, round);
+        (void)prv_sendRaw(HAL_COMM_CMD_BAUD_TEST, pattern, HAL_COMM_BAUD_TEST_LEN);
+
+        ok = prv_waitFrame(HAL_COMM_CMD_BAUD_TEST, &reply, HAL_COMM_BAUD_REPLY_MS) &&
+             (reply.len == HAL_COMM_BAUD_TEST_LEN);
+        for (i = 0U; ok && (i < HAL_COMM_BAUD_TEST_LEN); i++)
+        {
+            ok = (reply.payload[i] == pattern[i]) ? TRUE : FALSE;
+        }
+    }
+
+    if (ok)
+    {
+        ok = FALSE;
+        for (i = 0U; (i < HAL_COMM_BAUD_RETRIES) && !ok; i++)
+        {
+            (void)prv_sendRaw(HAL_COMM_CMD_BAUD_COMMIT, NULL, 0U);
+            ok = prv_waitFrame(HAL_COMM_CMD_BAUD_COMMIT, &reply, HAL_COMM_BAUD_REPLY_MS);
+        }
+    }
+
+    if (ok)
+    {
+        return HAL_COMM_TRY_OK;
+    }
+
+    /* Back to the base rate, and give the peer time to drop the trial too */
+    prv_setBaud(HAL_COMM_BAUD_RATE);
+    prv_waitMs(HAL_COMM_BAUD_TRIAL_MS + HAL_COMM_BAUD_REPLY_MS);
+
+    return HAL_COMM_TRY_FAILED;
+}
+
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_NONE)
+/* Responder side: run a proposed rate until it is committed or goes quiet */
+static void prv_runBaudTrial(uint32_t baud)
+{
+    FRAME_Type frame;
+    uint32_t   lastMs;
+
+    prv_setBaud(baud);
+    lastMs = MCAL_SysTick_GetTickMs();
+
+    while (!prv_isExpired(lastMs, HAL_COMM_BAUD_TRIAL_MS))
+    {
+        if (!prv_pollRaw(&frame))
+        {
+            if (waitHook != NULL)
+            {
+                waitHook();
+            }
+            continue;
+        }
+
+        if (frame.cmd == HAL_COMM_CMD_BAUD_TEST)
+        {
+            (void)prv_sendRaw(HAL_COMM_CMD_BAUD_TEST, frame.payload, frame.len);
+            lastMs = MCAL_SysTick_GetTickMs();
+        }
+        else if (frame.cmd == HAL_COMM_CMD_BAUD_COMMIT)
+        {
+            (void)prv_sendRaw(HAL_COMM_CMD_BAUD_COMMIT, NULL, 0U);
+            return;
+        }
+        else
+        {
+            /* Nothing else is expected mid-trial */
+        }
+    }
+
+    prv_setBaud(HAL_COMM_BAUD_RATE);
+}
+
+/* Answer a baud-negotiation frame; FALSE if the frame is for someone else */
+static boolean prv_handleBaudFrame(const FRAME_Type *frame)
+{
+    uint8_t refusal[4] = { 0U, 0U, 0U, 0U };
+    uint32_t baud;
+
+    if ((frame->cmd < HAL_COMM_CMD_BAUD_PROPOSE) || (frame->cmd > HAL_COMM_CMD_BAUD_COMMIT))
+    {
+        return FALSE;
+    }
+
+    switch (frame->cmd)
+    {
+        case HAL_COMM_CMD_BAUD_PROPOSE:
+            if (frame->len < 4U)
+            {
+                break;
+            }
+            baud = prv_getBe32(frame->payload);
+            if (!prv_isValidBaud(baud))
+            {
+                (void)prv_sendRaw(HAL_COMM_CMD_BAUD_PROPOSE, refusal, 4U);
+                break;
+            }
+            /* Echo at the current rate, then follow the proposer */
+            (void)prv_sendRaw(HAL_COMM_CMD_BAUD_PROPOSE, frame->payload, 4U);
+            prv_runBaudTrial(baud);
+            break;
+
+        case HAL_COMM_CMD_BAUD_COMMIT:
+            /* Our first echo was lost; the rate is already kept */
+            (void)prv_sendRaw(HAL_COMM_CMD_BAUD_COMMIT, NULL, 0U);
+            break;
+
+        default:
+            /* Stray test frame: drop */
+            break;
+    }
+
+    return TRUE;
+}
+#endif
+
+/* Peer silent for too long: report it lost and go back to the rate a
+ * rebooted peer starts at. Called once the RX ring has been drained. */
+static void prv_checkLiveness(void)
+{
+    if (peerAlive && prv_isExpired(lastHeardMs, HAL_COMM_LIVENESS_MS))
+    {
+        peerAlive = FALSE;
+
+        if (currentBaud != HAL_COMM_BAUD_RATE)
+        {
+            prv_setBaud(HAL_COMM_BAUD_RATE);
+        }
+    }
+}
+
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+/* Put one addressed frame on the bus: drive it only while sending */
+static void prv_busTransmit(uint8_t addr, uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    uint8_t buf[FRAME_MAX_PAYLOAD];
+    uint8_t i;
+
+    buf[0] = addr;
+    for (i = 0U; i < len; i++)
+    {
+        buf[1U + i] = payload[i];
+    }
+
+    MCAL_GPIO_WritePin(HAL_COMM_DE_PORT, HAL_COMM_DE_PIN, 1U);
+    (void)prv_sendRaw(cmd, buf, (uint8_t)(len + 1U));
+
+    /* Release the line once the last stop bit is out, before anyone answers */
+    (void)HAL_COMM_Flush(HAL_COMM_WAIT_FOREVER);
+    MCAL_GPIO_WritePin(HAL_COMM_DE_PORT, HAL_COMM_DE_PIN, 0U);
+}
+
+/* Send the oldest queued frame; FALSE if the queue is empty */
+static boolean prv_busSendQueued(uint8_t *addr)
+{
+    const HalComm_BusFrameType *entry;
+
+    if (busQueueCount == 0U)
+    {
+        return FALSE;
+    }
+
+    entry = &busQueue[busQueueHead];
+    *addr = entry->addr;
+    prv_busTransmit(entry->addr, entry->cmd, entry->payload, entry->len);
+
+    busQueueHead = (uint8_t)((busQueueHead + 1U) % HAL_COMM_BUS_QUEUE_DEPTH);
+    busQueueCount--;
+
+    return TRUE;
+}
+
+/* Wait for our turn; addressed to the selected slave (master) or
+ * from us (slave) */
+static uint8_t prv_busQueue(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    HalComm_BusFrameType *entry;
+    uint8_t i;
+
+    if ((len > HAL_COMM_MAX_PAYLOAD) || ((payload == NULL) && (len != 0U)))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    if (busQueueCount >= HAL_COMM_BUS_QUEUE_DEPTH)
+    {
+        return HAL_COMM_ERROR_BUSY;
+    }
+
+    entry = &busQueue[(busQueueHead + busQueueCount) % HAL_COMM_BUS_QUEUE_DEPTH];
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+    entry->addr = busDest;
+#else
+    entry->addr = HAL_COMM_NODE_ADDRESS;
+#endif
+    entry->cmd = cmd;
+    entry->len = len;
+    for (i = 0U; i < len; i++)
+    {
+        entry->payload[i] = payload[i];
+    }
+    busQueueCount++;
+
+    return HAL_COMM_SUCCESS;
+}
+
+/* Move the payload down over the address byte */
+static void prv_busStrip(FRAME_Type *frame)
+{
+    uint8_t i;
+
+    frame->len = (uint8_t)(frame->len - 1U);
+    for (i = 0U; i < frame->len; i++)
+    {
+        frame->payload[i] = frame->payload[1U + i];
+    }
+}
+#endif
+
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+/* Take a slave's frame; TRUE if it is for the application */
+static boolean prv_busOnFrame(FRAME_Type *frame)
+{
+    uint8_t node;
+
+    if (frame->len < 1U)
+    {
+        return FALSE;
+    }
+
+    node = frame->payload[0];
+    if ((node < 1U) || (node > HAL_COMM_BUS_NODES))
+    {
+        return FALSE;
+    }
+
+    nodeHeardMs[node - 1U] = MCAL_SysTick_GetTickMs();
+    nodeAlive[node - 1U]   = TRUE;
+
+    /* Its answer ends its turn */
+    if (node == busWaitNode)
+    {
+        busWaitNode = 0U;
+    }
+
+    if (frame->cmd == HAL_COMM_CMD_HEARTBEAT)
+    {
+        return FALSE;
+    }
+
+    busSource = node;
+    prv_busStrip(frame);
+
+    return TRUE;
+}
+
+/* Hand out the next turn once the current one is over */
+static void prv_busService(void)
+{
+    uint32_t now = MCAL_SysTick_GetTickMs();
+    uint8_t  addr;
+    uint8_t  i;
+
+    for (i = 0U; i < HAL_COMM_BUS_NODES; i++)
+    {
+        if (nodeAlive[i] && ((now - nodeHeardMs[i]) >= HAL_COMM_LIVENESS_MS))
+        {
+            nodeAlive[i] = FALSE;
+        }
+    }
+
+    if ((busWaitNode != 0U) && ((now - busWaitMs) < HAL_COMM_BUS_REPLY_MS))
+    {
+        return;
+    }
+    busWaitNode = 0U;   /* Answered, or silent for too long */
+
+    /* A queued frame is its slave's turn; broadcasts are not answered */
+    if (!prv_busSendQueued(&addr))
+    {
+        /* Silent slaves are only probed once per heartbeat period, so an
+         * absent panel does not cost the others a reply window per round */
+        for (i = 0U; i < HAL_COMM_BUS_NODES; i++)
+        {
+            addr = busNextPoll;
+            busNextPoll = (uint8_t)((busNextPoll % HAL_COMM_BUS_NODES) + 1U);
+            if (nodeAlive[addr - 1U] ||
+                ((now - nodeProbeMs[addr - 1U]) >= HAL_COMM_HEARTBEAT_MS))
+            {
+                break;
+            }
+        }
+        if (i == HAL_COMM_BUS_NODES)
+        {
+            return;     /* Nobody due */
+        }
+        nodeProbeMs[addr - 1U] = now;
+        prv_busTransmit(addr, HAL_COMM_CMD_POLL, NULL, 0U);
+    }
+
+    if (addr != HAL_COMM_ADDR_BROADCAST)
+    {
+        busWaitNode = addr;
+        busWaitMs   = MCAL_SysTick_GetTickMs();
+    }
+}
+#endif
+
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_SLAVE)
+/* Take a master's frame, answering it if it is addressed to us;
+ * TRUE if it is for the application */
+static boolean prv_busOnFrame(FRAME_Type *frame)
+{
+    uint8_t addr;
+
+    if (frame->len < 1U)
+    {
+        return FALSE;
+    }
+
+    addr = frame->payload[0];
+    if ((addr != HAL_COMM_NODE_ADDRESS) && (addr != HAL_COMM_ADDR_BROADCAST))
+    {
+        return FALSE;   /* Another slave's turn, or another slave's answer */
+    }
+
+    /* Our turn: exactly one frame back, unless the poll sat in the ring
+     * so long that the master has moved on and an answer would collide.
+     * Anything behind the poll means the bus has already moved on; with
+     * the ring empty, its last byte is the newest the UART ISR took. */
+    if ((addr == HAL_COMM_NODE_ADDRESS) && !isDataAvailable(HAL_COMM_UART_MODULE) &&
+        ((MCAL_SysTick_GetTickMs() - UART_GetLastRxTickMs(HAL_COMM_UART_MODULE)) <
+         (HAL_COMM_BUS_REPLY_MS / 2U)))
+    {
+        if (!prv_busSendQueued(&addr))
+        {
+            prv_busTransmit(HAL_COMM_NODE_ADDRESS, HAL_COMM_CMD_HEARTBEAT, NULL, 0U);
+        }
+    }
+
+    if ((frame->cmd == HAL_COMM_CMD_POLL) || (frame->cmd == HAL_COMM_CMD_HEARTBEAT))
+    {
+        return FALSE;
+    }
+
+    prv_busStrip(frame);
+
+    return TRUE;
+}
+#endif
 
 /*======================================================================
  *  API Implementations
@@ -27,26 +794,32 @@ uint8_t HAL_COMM_Init(void)
 {
     UART_ConfigType uartConfig;
     
-    /* 1. Enable peripheral clocks (MCAL handles enable + ready wait) */
-    MCAL_GPIO_EnablePort(HAL_COMM_UART_PERIPH);
-    MCAL_GPIO_EnablePort(HAL_COMM_GPIO_PERIPH);
-    
-    /* 2. Configure GPIO pins for UART functionality */
-    /* PB0: U1RX (UART1 Receive) */
-    /* PB1: U1TX (UART1 Transmit) */
-    GPIOPinConfigure(GPIO_PB0_U1RX);
-    GPIOPinConfigure(GPIO_PB1_U1TX);
+    /* 1-2. Enable clocks and mux the link's RX/TX pins (PB0/PB1 on UART1) */
+    prv_muxPort(HAL_COMM_PORT);
     
-    /* Set pin type to UART */
-    GPIOPinTypeUART(HAL_COMM_GPIO_PORT, HAL_COMM_RX_PIN | HAL_COMM_TX_PIN);
+#if (HAL_COMM_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    /* PC4: U1RTS, PC5: U1CTS */
+    MCAL_GPIO_EnablePort(SYSCTL_PERIPH_GPIOC);
+    GPIOPinConfigure(GPIO_PC4_U1RTS);
+    GPIOPinConfigure(GPIO_PC5_U1CTS);
+    GPIOPinTypeUART(GPIO_PORTC_BASE, HAL_COMM_RTS_PIN | HAL_COMM_CTS_PIN);
+#endif
     
     /* 3. Configure UART parameters using MCAL layer */
-    uartConfig.clockFreq = SysCtlClockGet();
+    uartClockHz = SysCtlClockGet();
+    currentBaud = HAL_COMM_BAUD_RATE;
+
+    uartConfig.clockFreq = uartClockHz;
     uartConfig.uartBase  = HAL_COMM_UART_MODULE;
     uartConfig.baudRate  = HAL_COMM_BAUD_RATE;
     uartConfig.dataBits  = 8U;
     uartConfig.parity    = 0U;  /* None */
     uartConfig.stopBits  = 1U;
+    uartConfig.rxBuffer     = rxRing;
+    uartConfig.rxBufferSize = HAL_COMM_RX_BUFFER_SIZE;
+    uartConfig.txBuffer     = txRing;
+    uartConfig.txBufferSize = HAL_COMM_TX_BUFFER_SIZE;
+    uartConfig.flowControl  = HAL_COMM_FLOW_CONTROL;
     
     /* Initialize UART through MCAL */
     UART_init(&uartConfig);
@@ -54,6 +827,34 @@ uint8_t HAL_COMM_Init(void)
     /* Small delay to ensure UART is fully initialized */
     SysCtlDelay(SysCtlClockGet() / (3U * 1000U));  /* ~1ms delay */
     
+    FRAME_ParserInit(&frameParser);
+#if (HAL_COMM_FRAMING_COBS != 0)
+    COBS_DecoderInit(&cobsDecoder, cobsPacket, (uint16_t)sizeof(cobsPacket));
+#endif
+
+#if (HAL_COMM_RECORD_ENABLE != 0)
+    COMMREC_Init(recordRing, HAL_COMM_RECORD_DEPTH);
+#endif
+
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+    /* Transceiver listens until we have something to say */
+    MCAL_GPIO_EnablePort(HAL_COMM_DE_PERIPH);
+    MCAL_GPIO_InitPin(HAL_COMM_DE_PORT, HAL_COMM_DE_PIN, GPIO_DIR_OUTPUT, GPIO_ATTACH_DEFAULT);
+    MCAL_GPIO_WritePin(HAL_COMM_DE_PORT, HAL_COMM_DE_PIN, 0U);
+    busQueueHead  = 0U;
+    busQueueCount = 0U;
+#endif
+
+    heartbeatLen = prv_encodeWire(HAL_COMM_CMD_HEARTBEAT, NULL, 0U,
+                                  heartbeatWire, (uint16_t)sizeof(heartbeatWire));
+    lastTxMs     = MCAL_SysTick_GetTickMs();
+    peerAlive    = FALSE;
+
+#if (HAL_COMM_RELIABLE != 0)
+    /* Sends the first SYNC; the peer may not be up yet, LINK_Tick retries */
+    LINK_Init(prv_sendRaw, MCAL_SysTick_GetTickMs());
+#endif
+
     isInitialized = TRUE;
     
     return HAL_COMM_SUCCESS;
@@ -63,36 +864,497 @@ void HAL_COMM_SendByte(uint8_t data)
 {
     if (isInitialized)
     {
-        sendByte(HAL_COMM_UART_MODULE, data);
+        prv_txLock();
+        prv_txByte(data);
+        prv_txUnlock();
+    }
+}
+
+uint8_t HAL_COMM_Flush(uint32_t timeoutMs)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    while (!UART_IsTxIdle(HAL_COMM_UART_MODULE))
+    {
+        if (prv_isExpired(start, timeoutMs))
+        {
+            return HAL_COMM_ERROR_TIMEOUT;
+        }
     }
+
+    return HAL_COMM_SUCCESS;
 }
 
 uint8_t HAL_COMM_ReceiveByte(void)
 {
     if (isInitialized)
     {
-        return receiveByte(HAL_COMM_UART_MODULE);
+        return prv_rxByte();
     }
     
     return 0U;
 }
 
+uint8_t HAL_COMM_ReceiveByteTimeout(uint8_t *data, uint32_t timeoutMs)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if (data == NULL)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while (!isDataAvailable(HAL_COMM_UART_MODULE))
+    {
+        if (prv_isExpired(start, timeoutMs))
+        {
+            return HAL_COMM_ERROR_TIMEOUT;
+        }
+    }
+
+    *data = prv_rxByte();
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint8_t HAL_COMM_ReceiveBytesTimeout(uint8_t *buffer, uint32_t len,
+                                     uint32_t timeoutMs, uint32_t *received)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+    uint32_t count = 0U;
+    uint8_t  result = HAL_COMM_SUCCESS;
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((buffer == NULL) && (len != 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while (count < len)
+    {
+        if (isDataAvailable(HAL_COMM_UART_MODULE))
+        {
+            buffer[count++] = prv_rxByte();
+        }
+        else if (prv_isExpired(start, timeoutMs))
+        {
+            result = HAL_COMM_ERROR_TIMEOUT;
+            break;
+        }
+    }
+
+    if (received != NULL)
+    {
+        *received = count;
+    }
+
+    return result;
+}
+
+uint8_t HAL_COMM_SendBuffer(const uint8_t *data, uint32_t len)
+{
+    uint8_t result;
+#if (HAL_COMM_RECORD_ENABLE != 0)
+    uint32_t i;
+#endif
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((data == NULL) || (len == 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    if (UART_IsDmaTxBusy(HAL_COMM_UART_MODULE))
+    {
+        return HAL_COMM_ERROR_BUSY;
+    }
+
+#if (HAL_COMM_RECORD_ENABLE != 0)
+    /* Stamped when queued; the uDMA puts them on the wire afterwards */
+    for (i = 0U; i < len; i++)
+    {
+        HAL_COMM_RECORD(COMMREC_DIR_TX, data[i]);
+    }
+#endif
+
+    /* Queued single bytes go out first (at most HAL_COMM_TX_BUFFER_SIZE) */
+    prv_txLock();
+    while (UART_GetTxPending(HAL_COMM_UART_MODULE) != 0U) { }
+
+    result = UART_StartDmaTx(HAL_COMM_UART_MODULE, data, len);
+    prv_txUnlock();
+
+    return (result == UART_SUCCESS) ? HAL_COMM_SUCCESS : HAL_COMM_ERROR_BUSY;
+}
+
+uint8_t HAL_COMM_ReceiveBuffer(uint8_t *buffer, uint32_t len)
+{
+    uint8_t result;
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((buffer == NULL) || (len == 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    result = UART_StartDmaRx(HAL_COMM_UART_MODULE, buffer, len);
+
+    return (result == UART_SUCCESS) ? HAL_COMM_SUCCESS : HAL_COMM_ERROR_BUSY;
+}
+
+boolean HAL_COMM_IsSendComplete(void)
+{
+    return UART_IsDmaTxBusy(HAL_COMM_UART_MODULE) ? FALSE : TRUE;
+}
+
+boolean HAL_COMM_IsReceiveComplete(void)
+{
+    return UART_IsDmaRxBusy(HAL_COMM_UART_MODULE) ? FALSE : TRUE;
+}
+
+uint8_t HAL_COMM_SendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+    return prv_busQueue(cmd, payload, len);
+#elif (HAL_COMM_RELIABLE != 0)
+    switch (LINK_Send(cmd, payload, len, MCAL_SysTick_GetTickMs()))
+    {
+        case LINK_SUCCESS:    return HAL_COMM_SUCCESS;
+        case LINK_ERROR_BUSY: return HAL_COMM_ERROR_BUSY;
+        default:              return HAL_COMM_ERROR_INVALID;
+    }
+#else
+    return prv_sendRaw(cmd, payload, len);
+#endif
+}
+
+boolean HAL_COMM_PollFrame(FRAME_Type *frame)
+{
+    if ((!isInitialized) || (frame == NULL))
+    {
+        return FALSE;
+    }
+
+    while (prv_pollRaw(frame))
+    {
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+        /* Bus answers are heartbeats too, so they go through first */
+        if (prv_busOnFrame(frame))
+        {
+            return TRUE;
+        }
+#else
+        if ((frame->cmd == HAL_COMM_CMD_HEARTBEAT) || prv_handleBaudFrame(frame))
+        {
+            continue;
+        }
+#if (HAL_COMM_RELIABLE != 0)
+        if (LINK_OnFrame(frame, frame, MCAL_SysTick_GetTickMs()))
+        {
+            return TRUE;
+        }
+#else
+        return TRUE;
+#endif
+#endif
+    }
+
+    prv_checkLiveness();
+
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+    prv_busService();
+#endif
+
+#if (HAL_COMM_RELIABLE != 0)
+    /* Retransmits and SYNC retries run off the same poll */
+    LINK_Tick(MCAL_SysTick_GetTickMs());
+#endif
+
+    return FALSE;
+}
+
+uint8_t HAL_COMM_ReceiveFrameTimeout(FRAME_Type *frame, uint32_t timeoutMs)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if (frame == NULL)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while (!HAL_COMM_PollFrame(frame))
+    {
+        if (prv_isExpired(start, timeoutMs))
+        {
+            return HAL_COMM_ERROR_TIMEOUT;
+        }
+    }
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint32_t HAL_COMM_NegotiateBaud(void)
+{
+    uint32_t cached;
+    uint8_t  result = HAL_COMM_TRY_FAILED;
+    uint8_t  i;
+
+    if ((!isInitialized) || (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE))
+    {
+        return currentBaud;
+    }
+
+    if (MCAL_EEPROM_ReadWord(HAL_COMM_BAUD_CACHE_ADDR, &cached) != EEPROM_SUCCESS)
+    {
+        cached = 0U;    /* Unreadable: treat as never negotiated */
+    }
+
+    /* A rate agreed on an earlier boot is tried alone first; anything
+     * else in the word (erased, or the base rate older builds stored)
+     * is not a candidate */
+    for (i = 0U; i < (sizeof(baudCandidates) / sizeof(baudCandidates[0])); i++)
+    {
+        if ((baudCandidates[i] == cached) && prv_isValidBaud(cached))
+        {
+            result = prv_tryBaud(cached);
+        }
+    }
+
+    /* The full probe found nothing recently: stay at the base rate */
+    if ((result == HAL_COMM_TRY_FAILED) && probeFailed &&
+        !prv_isExpired(probeFailedMs, HAL_COMM_BAUD_REPROBE_MS))
+    {
+        return currentBaud;
+    }
+
+    for (i = 0U; (result == HAL_COMM_TRY_FAILED) &&
+                 (i < (sizeof(baudCandidates) / sizeof(baudCandidates[0]))); i++)
+    {
+        if ((baudCandidates[i] != cached) && prv_isValidBaud(baudCandidates[i]))
+        {
+            result = prv_tryBaud(baudCandidates[i]);
+        }
+    }
+
+    if (result == HAL_COMM_TRY_OK)
+    {
+        probeFailed = FALSE;
+        if (currentBaud != cached)
+        {
+            (void)MCAL_EEPROM_WriteWord(HAL_COMM_BAUD_CACHE_ADDR, currentBaud);
+        }
+    }
+    else if (result == HAL_COMM_TRY_FAILED)
+    {
+        /* Every candidate failed with the peer answering: the next boot
+         * probes afresh, this one waits HAL_COMM_BAUD_REPROBE_MS */
+        probeFailed   = TRUE;
+        probeFailedMs = MCAL_SysTick_GetTickMs();
+        if (cached != 0U)
+        {
+            (void)MCAL_EEPROM_WriteWord(HAL_COMM_BAUD_CACHE_ADDR, 0U);
+        }
+    }
+    else
+    {
+        /* The peer never answered: nothing learnt, cache left as is */
+    }
+
+    return currentBaud;
+}
+
+void HAL_COMM_SetWaitHook(HAL_COMM_WaitHookType hook)
+{
+    waitHook = hook;
+}
+
+uint32_t HAL_COMM_GetBaudRate(void)
+{
+    return currentBaud;
+}
+
+void HAL_COMM_OnTick(void)
+{
+    uint32_t now = MCAL_SysTick_GetTickMs();
+    uint16_t i;
+
+    if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+    {
+        return;     /* Only the master's turns may start a transmission */
+    }
+
+    /* Only into an idle gap: not mid-frame, not behind a uDMA transfer,
+     * not while the main loop has the UART interrupt masked, and only if
+     * the whole frame fits without waiting */
+    if ((!isInitialized) || (txLock != 0U) ||
+        ((now - lastTxMs) < HAL_COMM_HEARTBEAT_MS) ||
+        UART_IsDmaTxBusy(HAL_COMM_UART_MODULE) ||
+        !IntIsEnabled(portMap[HAL_COMM_PORT].intNumber) ||
+        ((HAL_COMM_TX_BUFFER_SIZE - UART_GetTxPending(HAL_COMM_UART_MODULE)) < heartbeatLen))
+    {
+        return;
+    }
+
+    /* Straight to the ring: the recorder is not interrupt safe */
+    for (i = 0U; i < heartbeatLen; i++)
+    {
+        sendByte(HAL_COMM_UART_MODULE, heartbeatWire[i]);
+    }
+    lastTxMs = now;
+}
+
+boolean HAL_COMM_IsPeerAlive(void)
+{
+    return peerAlive;
+}
+
+void HAL_COMM_SelectNode(uint8_t node)
+{
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+    busDest = node;
+#else
+    (void)node;
+#endif
+}
+
+uint8_t HAL_COMM_GetSourceNode(void)
+{
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+    return busSource;
+#else
+    return HAL_COMM_NODE_PEER;
+#endif
+}
+
+boolean HAL_COMM_IsNodeAlive(uint8_t node)
+{
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_MASTER)
+    if ((node < 1U) || (node > HAL_COMM_BUS_NODES))
+    {
+        return FALSE;
+    }
+    return nodeAlive[node - 1U];
+#else
+    return (node == HAL_COMM_NODE_PEER) ? peerAlive : FALSE;
+#endif
+}
+
+void HAL_COMM_GetStats(HAL_COMM_StatsType *stats)
+{
+    UART_StatsType uart;
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_StatsType link;
+#endif
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    UART_GetStats(HAL_COMM_UART_MODULE, &uart);
+
+    stats->rxBytes         = uart.rxBytes;
+    stats->txBytes         = uart.txBytes;
+    stats->rxRingOverruns  = uart.rxRingOverruns;
+    stats->rxFifoOverruns  = uart.rxFifoOverruns;
+    stats->framingErrors   = uart.rxFramingErrors;
+    stats->parityErrors    = uart.rxParityErrors;
+    stats->breaks          = uart.rxBreaks;
+    stats->rxThrottles     = uart.rxThrottles;
+    stats->crcErrors       = frameParser.crcErrors;
+    stats->lengthErrors    = frameParser.lengthErrors;
+    stats->truncatedFrames = frameParser.truncatedFrames;
+    stats->rxHighWater     = uart.rxHighWater;
+    stats->txHighWater     = uart.txHighWater;
+    stats->rxBurstMax      = uart.rxBurstMax;
+    stats->isrMaxCycles    = uart.isrMaxCycles;
+
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_GetStats(&link);
+    stats->retransmits     = link.retransmits;
+    stats->linkDropped     = link.dropped;
+#else
+    stats->retransmits     = 0U;
+    stats->linkDropped     = 0U;
+#endif
+}
+
+void HAL_COMM_ResetStats(void)
+{
+    if (isInitialized)
+    {
+        UART_ResetStats(HAL_COMM_UART_MODULE);
+    }
+}
+
 void HAL_COMM_SendString(const char *str)
 {
     if ((isInitialized) && (str != NULL))
     {
-        sendString(HAL_COMM_UART_MODULE, str);
+        prv_txLock();
+        while (*str != '\0')
+        {
+            prv_txByte((uint8_t)*str++);
+        }
+        prv_txUnlock();
     }
 }
 
 uint32_t HAL_COMM_ReceiveString(char *buffer, uint32_t maxLen)
 {
-    if ((isInitialized) && (buffer != NULL))
+    uint32_t count = 0U;
+    char c;
+
+    if ((!isInitialized) || (buffer == NULL) || (maxLen == 0U))
     {
-        return receiveString(HAL_COMM_UART_MODULE, buffer, maxLen);
+        return 0U;
     }
-    
-    return 0U;
+
+    /* Same rules as receiveString(): CR, LF or buffer full */
+    while (count < (maxLen - 1U))
+    {
+        c = (char)prv_rxByte();
+        if ((c == '\r') || (c == '\n'))
+        {
+            break;
+        }
+        buffer[count++] = c;
+    }
+    buffer[count] = '\0';
+
+    return count;
 }
 
 boolean HAL_COMM_IsDataAvailable(void)
@@ -106,6 +1368,121 @@ boolean HAL_COMM_IsDataAvailable(void)
     return FALSE;
 }
 
+uint16_t HAL_COMM_ReadRecording(COMMREC_RecordType *out, uint16_t max)
+{
+#if (HAL_COMM_RECORD_ENABLE != 0)
+    return COMMREC_Read(out, max);
+#else
+    (void)out;
+    (void)max;
+    return 0U;
+#endif
+}
+
+HAL_COMM_HandleType HAL_COMM_Open(uint8_t port, uint32_t baudRate)
+{
+    UART_ConfigType uartConfig;
+    HAL_COMM_InstanceType *instance;
+    uint8_t slot;
+
+    if ((port >= HAL_COMM_NUM_PORTS) || (port == HAL_COMM_PORT) ||
+        (openPortCount >= HAL_COMM_MAX_OPEN_PORTS))
+    {
+        return NULL;
+    }
+
+    for (slot = 0U; slot < openPortCount; slot++)
+    {
+        if (openPorts[slot].port == port)
+        {
+            return NULL;
+        }
+    }
+
+    prv_muxPort(port);
+
+    slot = openPortCount;
+    uartConfig.clockFreq    = SysCtlClockGet();
+    uartConfig.uartBase     = HAL_COMM_PORT_BASE(port);
+    uartConfig.baudRate     = baudRate;
+    uartConfig.dataBits     = 8U;
+    uartConfig.parity       = 0U;  /* None */
+    uartConfig.stopBits     = 1U;
+    uartConfig.rxBuffer     = portRxPool[slot];
+    uartConfig.rxBufferSize = HAL_COMM_PORT_RX_BUFFER_SIZE;
+    uartConfig.txBuffer     = portTxPool[slot];
+    uartConfig.txBufferSize = HAL_COMM_PORT_TX_BUFFER_SIZE;
+    uartConfig.flowControl  = UART_FLOW_NONE;
+    UART_init(&uartConfig);
+
+    instance = &openPorts[slot];
+    instance->uartBase = uartConfig.uartBase;
+    instance->port     = port;
+    openPortCount++;
+
+    return instance;
+}
+
+void HAL_COMM_PortSendByte(HAL_COMM_HandleType handle, uint8_t data)
+{
+    if (handle != NULL)
+    {
+        sendByte(handle->uartBase, data);
+    }
+}
+
+void HAL_COMM_PortSendString(HAL_COMM_HandleType handle, const char *str)
+{
+    if ((handle != NULL) && (str != NULL))
+    {
+        while (*str != '\0')
+        {
+            sendByte(handle->uartBase, (uint8_t)*str++);
+        }
+    }
+}
+
+uint16_t HAL_COMM_PortGetTxRoom(HAL_COMM_HandleType handle)
+{
+    if (handle == NULL)
+    {
+        return 0U;
+    }
+
+    return (uint16_t)(HAL_COMM_PORT_TX_BUFFER_SIZE - UART_GetTxPending(handle->uartBase));
+}
+
+boolean HAL_COMM_PortReceiveByte(HAL_COMM_HandleType handle, uint8_t *data)
+{
+    if ((handle == NULL) || (data == NULL) || !isDataAvailable(handle->uartBase))
+    {
+        return FALSE;
+    }
+
+    *data = receiveByte(handle->uartBase);
+    return TRUE;
+}
+
+uint8_t HAL_COMM_PortFlush(HAL_COMM_HandleType handle, uint32_t timeoutMs)
+{
+    uint32_t start = MCAL_SysTick_GetTickMs();
+
+    if (handle == NULL)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while (!UART_IsTxIdle(handle->uartBase))
+    {
+        if (prv_isExpired(start, timeoutMs))
+        {
+            return HAL_COMM_ERROR_TIMEOUT;
+        }
+    }
+
+    return HAL_COMM_SUCCESS;
+}
+
 void HAL_COMM_SendMessage(const char *message)
 {
     if ((isInitialized) && (message != NULL))
@@ -0,0 +1,733 @@
+/*============================================================================
+ *  Module      : HAL COMM
+ *  File Name   : hal_comm_pty.c
+ *  Description : Host (Linux) backend for the HAL_COMM API over a POSIX
+ *                pseudo-terminal
+ *
+ *  Drop-in replacement for hal_comm.c when building an ECU as a host
+ *  process; not part of the IAR projects. Link exactly one of the two.
+ *
+ *  Pairing two processes:
+ *    - The first process (no HAL_COMM_PTY environment variable) opens a
+ *      pty master and prints the slave path on stderr:
+ *          HAL_COMM: pty slave /dev/pts/N
+ *    - The second process is started with HAL_COMM_PTY=/dev/pts/N and
+ *      opens that slave in raw mode.
+ *  Bytes written by one side are read by the other exactly as over UART1.
+ *
+ *  Timeouts use CLOCK_MONOTONIC, so no SysTick driver is needed.
+ *
+ *  With HAL_COMM_PTY_RECORD=file every byte read from and written to the
+ *  pty is appended to file as services/commrec.h records, stamped with
+ *  milliseconds since HAL_COMM_Init(). The RX side of such a capture can
+ *  be fed back with hal_comm_replay.c.
+ *
+ *  HAL_COMM_Open() gives one further port, on the process's stdin and
+ *  stdout, so a console opened on any UART can be used from the terminal.
+ *===========================================================================*/
+
+#define _DEFAULT_SOURCE         /* cfmakeraw() */
+#define _XOPEN_SOURCE 600       /* posix_openpt(), ptsname() */
+
+#include "hal/hal_comm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Environment variable naming the peer's pty slave */
+#define HAL_COMM_PTY_ENV            "HAL_COMM_PTY"
+
+/* Environment variable naming a capture file to record the traffic in */
+#define HAL_COMM_PTY_RECORD_ENV     "HAL_COMM_PTY_RECORD"
+
+/* One peer at the other end; the RS-485 bus needs the target backend */
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+#error "host backend supports point-to-point only (HAL_COMM_BUS_NONE)"
+#endif
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static boolean isInitialized = FALSE;
+static int     ptyFd = -1;
+
+/* One byte of read-ahead so IsDataAvailable() does not consume data */
+static boolean peekValid = FALSE;
+static uint8_t peekByte;
+
+/* Liveness supervision (no interrupt context here: heartbeats go out
+ * from HAL_COMM_PollFrame() instead of HAL_COMM_OnTick()) */
+static uint32_t lastTxMs;                /* Tick of the last write */
+static uint32_t lastHeardMs;             /* Tick of the last valid frame from the peer */
+static boolean  peerAlive = FALSE;
+
+/* Link health counters (HAL_COMM_GetStats) */
+static uint32_t rxBytes = 0U;
+static uint32_t txBytes = 0U;
+
+/* The one further port (HAL_COMM_Open), on stdin/stdout */
+static HAL_COMM_InstanceType stdioPort;
+static boolean               stdioPortOpen = FALSE;
+
+/* Incremental parser for incoming protocol frames */
+static FRAME_ParserType frameParser;
+static uint32_t         frameLastRxMs;   /* Tick of the last byte fed to the parser */
+
+/* Capture (HAL_COMM_PTY_RECORD); unbuffered, so a killed process keeps it */
+static int      recordFd = -1;
+static uint32_t recordStartMs;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+/* Monotonic milliseconds; wraps like MCAL_SysTick_GetTickMs() */
+static uint32_t prv_nowMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U);
+}
+
+/* Wrap-around safe deadline check; HAL_COMM_WAIT_FOREVER never expires */
+static boolean prv_isExpired(uint32_t startMs, uint32_t timeoutMs)
+{
+    if (timeoutMs == HAL_COMM_WAIT_FOREVER)
+    {
+        return FALSE;
+    }
+
+    return ((prv_nowMs() - startMs) >= timeoutMs) ? TRUE : FALSE;
+}
+
+/* Put the terminal in raw 8N1 mode so no byte is translated or swallowed */
+static void prv_makeRaw(int fd)
+{
+    struct termios tio;
+
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tio.c_cc[VMIN]  = 0;
+        tio.c_cc[VTIME] = 0;
+        (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+}
+
+/* Fill the read-ahead byte if one is waiting; never blocks */
+static boolean prv_peek(void)
+{
+    ssize_t n;
+
+    if (!peekValid)
+    {
+        n = read(ptyFd, &peekByte, 1U);
+        if (n == 1)
+        {
+            peekValid = TRUE;
+        }
+    }
+
+    return peekValid;
+}
+
+/* Wait up to waitMs for input (-1 = forever) */
+static void prv_waitReadable(int waitMs)
+{
+    struct pollfd pfd;
+
+    pfd.fd      = ptyFd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    (void)poll(&pfd, 1U, waitMs);
+}
+
+static void prv_record(uint8_t dir, const uint8_t *data, uint32_t len)
+{
+    COMMREC_RecordType rec;
+    uint8_t            encoded[COMMREC_RECORD_SIZE];
+    uint32_t           i;
+
+    if (recordFd < 0)
+    {
+        return;
+    }
+
+    rec.tickMs = prv_nowMs() - recordStartMs;
+    rec.dir    = dir;
+    for (i = 0U; i < len; i++)
+    {
+        rec.data = data[i];
+        COMMREC_Encode(&rec, encoded);
+        (void)write(recordFd, encoded, sizeof(encoded));
+    }
+}
+
+static uint8_t prv_takeByte(void)
+{
+    rxBytes++;
+    peekValid = FALSE;
+    prv_record(COMMREC_DIR_RX, &peekByte, 1U);
+    return peekByte;
+}
+
+static void prv_write(const uint8_t *data, uint32_t len)
+{
+    ssize_t n;
+
+    while (len > 0U)
+    {
+        n = write(ptyFd, data, len);
+        if (n > 0)
+        {
+            prv_record(COMMREC_DIR_TX, data, (uint32_t)n);
+            txBytes += (uint32_t)n;
+            data += n;
+            len  -= (uint32_t)n;
+        }
+        else if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            break;      /* Peer gone; drop like a disconnected line */
+        }
+    }
+
+    lastTxMs = prv_nowMs();
+}
+
+/* Encode and write one frame as is (no link layer) */
+static uint8_t prv_sendRaw(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    uint8_t  frameBuf[FRAME_MAX_SIZE];
+    uint16_t frameLen;
+
+    frameLen = FRAME_Encode(cmd, payload, len, frameBuf, (uint16_t)sizeof(frameBuf));
+    if (frameLen == 0U)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    /* One write per frame, as the UART backend queues it in one go */
+    prv_write(frameBuf, frameLen);
+
+    return HAL_COMM_SUCCESS;
+}
+
+/* Heartbeat after HAL_COMM_HEARTBEAT_MS of silence, and the liveness
+ * timeout; the pty keeps one rate, so there is nothing to fall back to */
+static void prv_superviseLink(void)
+{
+    if ((prv_nowMs() - lastTxMs) >= HAL_COMM_HEARTBEAT_MS)
+    {
+        (void)prv_sendRaw(HAL_COMM_CMD_HEARTBEAT, NULL, 0U);
+    }
+
+    if (peerAlive && prv_isExpired(lastHeardMs, HAL_COMM_LIVENESS_MS))
+    {
+        peerAlive = FALSE;
+    }
+}
+
+/*======================================================================
+ *  API Implementations
+ *====================================================================*/
+
+uint8_t HAL_COMM_Init(void)
+{
+    const char *peer   = getenv(HAL_COMM_PTY_ENV);
+    const char *record = getenv(HAL_COMM_PTY_RECORD_ENV);
+
+    if (peer != NULL)
+    {
+        ptyFd = open(peer, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    }
+    else
+    {
+        ptyFd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if ((ptyFd >= 0) && ((grantpt(ptyFd) != 0) || (unlockpt(ptyFd) != 0)))
+        {
+            (void)close(ptyFd);
+            ptyFd = -1;
+        }
+    }
+
+    if (ptyFd < 0)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    prv_makeRaw(ptyFd);
+
+    if (peer == NULL)
+    {
+        fprintf(stderr, "HAL_COMM: pty slave %s\n", ptsname(ptyFd));
+    }
+
+    if (record != NULL)
+    {
+        recordFd = open(record, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (recordFd < 0)
+        {
+            fprintf(stderr, "HAL_COMM: cannot record to %s\n", record);
+        }
+        recordStartMs = prv_nowMs();
+    }
+
+    FRAME_ParserInit(&frameParser);
+    peekValid = FALSE;
+    peerAlive = FALSE;
+
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_Init(prv_sendRaw, prv_nowMs());
+#endif
+
+    isInitialized = TRUE;
+
+    return HAL_COMM_SUCCESS;
+}
+
+void HAL_COMM_SendByte(uint8_t data)
+{
+    if (isInitialized)
+    {
+        prv_write(&data, 1U);
+    }
+}
+
+uint8_t HAL_COMM_Flush(uint32_t timeoutMs)
+{
+    (void)timeoutMs;
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    /* Writes go straight to the kernel; there is no local queue to drain */
+    return HAL_COMM_SUCCESS;
+}
+
+uint8_t HAL_COMM_ReceiveByte(void)
+{
+    if (!isInitialized)
+    {
+        return 0U;
+    }
+
+    while (!prv_peek())
+    {
+        prv_waitReadable(-1);
+    }
+
+    return prv_takeByte();
+}
+
+uint8_t HAL_COMM_ReceiveByteTimeout(uint8_t *data, uint32_t timeoutMs)
+{
+    uint32_t received;
+
+    return HAL_COMM_ReceiveBytesTimeout(data, 1U, timeoutMs, &received);
+}
+
+uint8_t HAL_COMM_ReceiveBytesTimeout(uint8_t *buffer, uint32_t len,
+                                     uint32_t timeoutMs, uint32_t *received)
+{
+    uint32_t start = prv_nowMs();
+    uint32_t count = 0U;
+    uint8_t  result = HAL_COMM_SUCCESS;
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((buffer == NULL) && (len != 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while (count < len)
+    {
+        if (prv_peek())
+        {
+            buffer[count++] = prv_takeByte();
+        }
+        else if (prv_isExpired(start, timeoutMs))
+        {
+            result = HAL_COMM_ERROR_TIMEOUT;
+            break;
+        }
+        else
+        {
+            prv_waitReadable(1);
+        }
+    }
+
+    if (received != NULL)
+    {
+        *received = count;
+    }
+
+    return result;
+}
+
+uint8_t HAL_COMM_SendBuffer(const uint8_t *data, uint32_t len)
+{
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((data == NULL) || (len == 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    /* No uDMA on the host: the write completes before returning */
+    prv_write(data, len);
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint8_t HAL_COMM_ReceiveBuffer(uint8_t *buffer, uint32_t len)
+{
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((buffer == NULL) || (len == 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    /* Completes synchronously, so IsReceiveComplete() is always TRUE */
+    return HAL_COMM_ReceiveBytesTimeout(buffer, len, HAL_COMM_WAIT_FOREVER, NULL);
+}
+
+boolean HAL_COMM_IsSendComplete(void)
+{
+    return TRUE;
+}
+
+boolean HAL_COMM_IsReceiveComplete(void)
+{
+    return TRUE;
+}
+
+uint8_t HAL_COMM_SendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+#if (HAL_COMM_RELIABLE != 0)
+    switch (LINK_Send(cmd, payload, len, prv_nowMs()))
+    {
+        case LINK_SUCCESS:    return HAL_COMM_SUCCESS;
+        case LINK_ERROR_BUSY: return HAL_COMM_ERROR_BUSY;
+        default:              return HAL_COMM_ERROR_INVALID;
+    }
+#else
+    return prv_sendRaw(cmd, payload, len);
+#endif
+}
+
+boolean HAL_COMM_PollFrame(FRAME_Type *frame)
+{
+#if (HAL_COMM_RELIABLE == 0)
+    uint8_t i;
+#endif
+
+    if ((!isInitialized) || (frame == NULL))
+    {
+        return FALSE;
+    }
+
+    /* Sender went quiet mid-frame: drop the fragment so the next SOF resyncs */
+    if (!prv_peek() && FRAME_ParserIsBusy(&frameParser) &&
+        prv_isExpired(frameLastRxMs, HAL_COMM_FRAME_GAP_MS))
+    {
+        FRAME_ParserAbort(&frameParser);
+    }
+
+    while (prv_peek())
+    {
+        frameLastRxMs = prv_nowMs();
+
+        if (FRAME_ParserFeed(&frameParser, prv_takeByte()) == FRAME_STATUS_COMPLETE)
+        {
+            lastHeardMs = frameLastRxMs;
+            peerAlive   = TRUE;
+
+            if (frameParser.frame.cmd == HAL_COMM_CMD_HEARTBEAT)
+            {
+                continue;
+            }
+#if (HAL_COMM_RELIABLE != 0)
+            if (LINK_OnFrame(&frameParser.frame, frame, prv_nowMs()))
+            {
+                return TRUE;
+            }
+#else
+            frame->cmd = frameParser.frame.cmd;
+            frame->len = frameParser.frame.len;
+            for (i = 0U; i < frame->len; i++)
+            {
+                frame->payload[i] = frameParser.frame.payload[i];
+            }
+            return TRUE;
+#endif
+        }
+    }
+
+    prv_superviseLink();
+
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_Tick(prv_nowMs());
+#endif
+
+    return FALSE;
+}
+
+uint8_t HAL_COMM_ReceiveFrameTimeout(FRAME_Type *frame, uint32_t timeoutMs)
+{
+    uint32_t start = prv_nowMs();
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if (frame == NULL)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while (!HAL_COMM_PollFrame(frame))
+    {
+        if (prv_isExpired(start, timeoutMs))
+        {
+            return HAL_COMM_ERROR_TIMEOUT;
+        }
+        prv_waitReadable(1);
+    }
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint32_t HAL_COMM_NegotiateBaud(void)
+{
+    /* A pty has no line rate to raise; report the nominal one */
+    return HAL_COMM_BAUD_RATE;
+}
+
+void HAL_COMM_SetWaitHook(HAL_COMM_WaitHookType hook)
+{
+    /* Negotiation never waits here */
+    (void)hook;
+}
+
+uint32_t HAL_COMM_GetBaudRate(void)
+{
+    return HAL_COMM_BAUD_RATE;
+}
+
+void HAL_COMM_OnTick(void)
+{
+    /* Heartbeats are sent from HAL_COMM_PollFrame() on the host */
+}
+
+boolean HAL_COMM_IsPeerAlive(void)
+{
+    return peerAlive;
+}
+
+void HAL_COMM_SelectNode(uint8_t node)
+{
+    (void)node;
+}
+
+uint8_t HAL_COMM_GetSourceNode(void)
+{
+    return HAL_COMM_NODE_PEER;
+}
+
+boolean HAL_COMM_IsNodeAlive(uint8_t node)
+{
+    return (node == HAL_COMM_NODE_PEER) ? peerAlive : FALSE;
+}
+
+void HAL_COMM_GetStats(HAL_COMM_StatsType *stats)
+{
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_StatsType link;
+#endif
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    /* The pty has no line errors, FIFO or ISR: those read 0 */
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->rxBytes         = rxBytes;
+    stats->txBytes         = txBytes;
+    stats->crcErrors       = frameParser.crcErrors;
+    stats->lengthErrors    = frameParser.lengthErrors;
+    stats->truncatedFrames = frameParser.truncatedFrames;
+
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_GetStats(&link);
+    stats->retransmits     = link.retransmits;
+    stats->linkDropped     = link.dropped;
+#endif
+}
+
+void HAL_COMM_ResetStats(void)
+{
+    rxBytes = 0U;
+    txBytes = 0U;
+}
+
+void HAL_COMM_SendString(const char *str)
+{
+    if ((isInitialized) && (str != NULL))
+    {
+        while (*str != '\0')
+        {
+            HAL_COMM_SendByte((uint8_t)*str++);
+        }
+    }
+}
+
+uint32_t HAL_COMM_ReceiveString(char *buffer, uint32_t maxLen)
+{
+    uint32_t count = 0U;
+    char c;
+
+    if ((!isInitialized) || (buffer == NULL) || (maxLen == 0U))
+    {
+        return 0U;
+    }
+
+    /* Same termination rules as the UART backend: CR, LF or buffer full */
+    while (count < (maxLen - 1U))
+    {
+        c = (char)HAL_COMM_ReceiveByte();
+        if ((c == '\r') || (c == '\n'))
+        {
+            break;
+        }
+        buffer[count++] = c;
+    }
+    buffer[count] = '\0';
+
+    return count;
+}
+
+boolean HAL_COMM_IsDataAvailable(void)
+{
+    if (isInitialized)
+    {
+        return prv_peek();
+    }
+
+    return FALSE;
+}
+
+uint16_t HAL_COMM_ReadRecording(COMMREC_RecordType *out, uint16_t max)
+{
+    /* Recorded to HAL_COMM_PTY_RECORD instead, not into a ring */
+    (void)out;
+    (void)max;
+    return 0U;
+}
+
+HAL_COMM_HandleType HAL_COMM_Open(uint8_t port, uint32_t baudRate)
+{
+    (void)baudRate;
+
+    if ((port >= HAL_COMM_NUM_PORTS) || (port == HAL_COMM_PORT) || stdioPortOpen)
+    {
+        return NULL;
+    }
+
+    stdioPort.uartBase = 0U;    /* No UART behind it on the host */
+    stdioPort.port     = port;
+    stdioPortOpen      = TRUE;
+
+    return &stdioPort;
+}
+
+void HAL_COMM_PortSendByte(HAL_COMM_HandleType handle, uint8_t data)
+{
+    if (handle != NULL)
+    {
+        (void)write(STDOUT_FILENO, &data, 1U);
+    }
+}
+
+void HAL_COMM_PortSendString(HAL_COMM_HandleType handle, const char *str)
+{
+    if ((handle != NULL) && (str != NULL))
+    {
+        (void)write(STDOUT_FILENO, str, strlen(str));
+    }
+}
+
+uint16_t HAL_COMM_PortGetTxRoom(HAL_COMM_HandleType handle)
+{
+    /* write() to the terminal does not queue here */
+    return (handle != NULL) ? HAL_COMM_PORT_TX_BUFFER_SIZE : 0U;
+}
+
+boolean HAL_COMM_PortReceiveByte(HAL_COMM_HandleType handle, uint8_t *data)
+{
+    struct pollfd pfd;
+
+    if ((handle == NULL) || (data == NULL))
+    {
+        return FALSE;
+    }
+
+    pfd.fd     = STDIN_FILENO;
+    pfd.events = POLLIN;
+    if ((poll(&pfd, 1, 0) <= 0) || (read(STDIN_FILENO, data, 1U) != 1))
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+uint8_t HAL_COMM_PortFlush(HAL_COMM_HandleType handle, uint32_t timeoutMs)
+{
+    (void)timeoutMs;
+
+    /* write() has already handed everything to the terminal */
+    return (handle != NULL) ? HAL_COMM_SUCCESS : HAL_COMM_ERROR_INVALID;
+}
+
+void HAL_COMM_SendMessage(const char *message)
+{
+    if ((isInitialized) && (message != NULL))
+    {
+        HAL_COMM_SendString(message);
+        HAL_COMM_SendString("\r\n");  /* Send CR+LF for new line */
+    }
+}
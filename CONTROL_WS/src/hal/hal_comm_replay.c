@@ -0,0 +1,587 @@
+/*============================================================================
+ *  Module      : HAL COMM
+ *  File Name   : hal_comm_replay.c
+ *  Description : Host (Linux) backend for the HAL_COMM API that replays a
+ *                recorded capture into the Control ECU command loop
+ *
+ *  Drop-in replacement for hal_comm.c when building the Control ECU as a
+ *  host process; not part of the IAR projects. Link exactly one backend.
+ *
+ *  Usage:
+ *    HAL_COMM_REPLAY=session.cap [HAL_COMM_REPLAY_OUT=out.cap] ./control
+ *
+ *  - The RX records of the capture (services/commrec.h format) are fed to
+ *    the application back to back, ignoring their timestamps, so the run
+ *    measures the command path itself rather than the original pacing.
+ *  - Every byte the application sends is counted and, if
+ *    HAL_COMM_REPLAY_OUT is set, written out as TX records stamped with
+ *    host milliseconds since start, for diffing against the original
+ *    capture's TX records.
+ *  - Once the input is exhausted and the application asks for more, a
+ *    summary (bytes, frames, elapsed time, frames/s) is printed on stderr
+ *    and the process exits with status 0.
+ *===========================================================================*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "hal/hal_comm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define HAL_COMM_REPLAY_ENV         "HAL_COMM_REPLAY"
+#define HAL_COMM_REPLAY_OUT_ENV     "HAL_COMM_REPLAY_OUT"
+
+/* One peer at the other end; the RS-485 bus needs the target backend */
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+#error "host backend supports point-to-point only (HAL_COMM_BUS_NONE)"
+#endif
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static boolean isInitialized = FALSE;
+
+/* RX bytes from the capture, in order */
+static uint8_t  *rxData = NULL;
+static uint32_t  rxCount = 0U;
+static uint32_t  rxPos = 0U;
+
+static FILE     *txOut = NULL;
+static uint32_t  txCount = 0U;
+
+static FRAME_ParserType frameParser;
+static uint32_t         framesDecoded = 0U;
+
+static struct timespec  startTime;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint64_t prv_elapsedUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)(now.tv_sec - startTime.tv_sec) * 1000000U) +
+           (uint64_t)((now.tv_nsec - startTime.tv_nsec) / 1000);
+}
+
+/* Input exhausted: report and stop the application */
+static void prv_finish(void)
+{
+    uint64_t us = prv_elapsedUs();
+
+    fprintf(stderr,
+            "HAL_COMM replay: %lu RX bytes, %lu frames, %lu TX bytes in %lu us",
+            (unsigned long)rxCount, (unsigned long)framesDecoded,
+            (unsigned long)txCount, (unsigned long)us);
+    if (us != 0U)
+    {
+        fprintf(stderr, " (%.1f frames/s)", (double)framesDecoded * 1e6 / (double)us);
+    }
+    fprintf(stderr, ", %lu CRC errors, %lu length errors\n",
+            (unsigned long)frameParser.crcErrors,
+            (unsigned long)frameParser.lengthErrors);
+
+    if (txOut != NULL)
+    {
+        (void)fclose(txOut);
+    }
+
+    exit(0);
+}
+
+static boolean prv_available(void)
+{
+    return (rxPos < rxCount) ? TRUE : FALSE;
+}
+
+static uint8_t prv_rxByte(void)
+{
+    if (!prv_available())
+    {
+        prv_finish();
+    }
+
+    return rxData[rxPos++];
+}
+
+static void prv_txByte(uint8_t data)
+{
+    COMMREC_RecordType rec;
+    uint8_t encoded[COMMREC_RECORD_SIZE];
+
+    txCount++;
+
+    if (txOut != NULL)
+    {
+        rec.tickMs = (uint32_t)(prv_elapsedUs() / 1000U);
+        rec.dir    = COMMREC_DIR_TX;
+        rec.data   = data;
+        COMMREC_Encode(&rec, encoded);
+        (void)fwrite(encoded, 1U, sizeof(encoded), txOut);
+    }
+}
+
+/* Encode and emit one frame as is (no link layer) */
+static uint8_t prv_sendRaw(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    uint8_t  frameBuf[FRAME_MAX_SIZE];
+    uint16_t frameLen;
+    uint16_t i;
+
+    frameLen = FRAME_Encode(cmd, payload, len, frameBuf, (uint16_t)sizeof(frameBuf));
+    if (frameLen == 0U)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    for (i = 0U; i < frameLen; i++)
+    {
+        prv_txByte(frameBuf[i]);
+    }
+
+    return HAL_COMM_SUCCESS;
+}
+
+/* Load the RX side of a capture into memory */
+static boolean prv_load(const char *path)
+{
+    FILE *in = fopen(path, "rb");
+    uint8_t encoded[COMMREC_RECORD_SIZE];
+    COMMREC_RecordType rec;
+    uint32_t capacity = 0U;
+    uint8_t *grown;
+
+    if (in == NULL)
+    {
+        return FALSE;
+    }
+
+    while (fread(encoded, 1U, sizeof(encoded), in) == sizeof(encoded))
+    {
+        if (!COMMREC_Decode(encoded, &rec) || (rec.dir != COMMREC_DIR_RX))
+        {
+            continue;
+        }
+
+        if (rxCount == capacity)
+        {
+            capacity = (capacity == 0U) ? 1024U : (capacity * 2U);
+            grown = (uint8_t *)realloc(rxData, capacity);
+            if (grown == NULL)
+            {
+                (void)fclose(in);
+                return FALSE;
+            }
+            rxData = grown;
+        }
+        rxData[rxCount++] = rec.data;
+    }
+
+    (void)fclose(in);
+    return TRUE;
+}
+
+/*======================================================================
+ *  API Implementations
+ *====================================================================*/
+
+uint8_t HAL_COMM_Init(void)
+{
+    const char *inPath  = getenv(HAL_COMM_REPLAY_ENV);
+    const char *outPath = getenv(HAL_COMM_REPLAY_OUT_ENV);
+
+    if ((inPath == NULL) || !prv_load(inPath))
+    {
+        fprintf(stderr, "HAL_COMM replay: set %s to a readable capture\n",
+                HAL_COMM_REPLAY_ENV);
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if (outPath != NULL)
+    {
+        txOut = fopen(outPath, "wb");
+    }
+
+    FRAME_ParserInit(&frameParser);
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+#if (HAL_COMM_RELIABLE != 0)
+    /* The capture holds the peer's SYNC from its own boot; ours only goes
+     * to HAL_COMM_REPLAY_OUT */
+    LINK_Init(prv_sendRaw, 0U);
+#endif
+
+    isInitialized = TRUE;
+
+    return HAL_COMM_SUCCESS;
+}
+
+void HAL_COMM_SendByte(uint8_t data)
+{
+    if (isInitialized)
+    {
+        prv_txByte(data);
+    }
+}
+
+uint8_t HAL_COMM_Flush(uint32_t timeoutMs)
+{
+    (void)timeoutMs;
+
+    return isInitialized ? HAL_COMM_SUCCESS : HAL_COMM_ERROR_INIT;
+}
+
+uint8_t HAL_COMM_ReceiveByte(void)
+{
+    return isInitialized ? prv_rxByte() : 0U;
+}
+
+uint8_t HAL_COMM_ReceiveByteTimeout(uint8_t *data, uint32_t timeoutMs)
+{
+    return HAL_COMM_ReceiveBytesTimeout(data, 1U, timeoutMs, NULL);
+}
+
+uint8_t HAL_COMM_ReceiveBytesTimeout(uint8_t *buffer, uint32_t len,
+                                     uint32_t timeoutMs, uint32_t *received)
+{
+    uint32_t count = 0U;
+
+    (void)timeoutMs;    /* Input never arrives later; it is either there or done */
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((buffer == NULL) && (len != 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    while ((count < len) && prv_available())
+    {
+        buffer[count++] = prv_rxByte();
+    }
+
+    if (received != NULL)
+    {
+        *received = count;
+    }
+
+    if (count < len)
+    {
+        prv_finish();
+    }
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint8_t HAL_COMM_SendBuffer(const uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if ((data == NULL) || (len == 0U))
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    for (i = 0U; i < len; i++)
+    {
+        prv_txByte(data[i]);
+    }
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint8_t HAL_COMM_ReceiveBuffer(uint8_t *buffer, uint32_t len)
+{
+    return HAL_COMM_ReceiveBytesTimeout(buffer, len, HAL_COMM_WAIT_FOREVER, NULL);
+}
+
+boolean HAL_COMM_IsSendComplete(void)
+{
+    return TRUE;
+}
+
+boolean HAL_COMM_IsReceiveComplete(void)
+{
+    return TRUE;
+}
+
+uint8_t HAL_COMM_SendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+#if (HAL_COMM_RELIABLE != 0)
+    /* The capture's ACKs cover our DATA while the replay follows the
+     * original run; if it diverges and the window fills, emit the frame
+     * unwrapped so the output still shows it */
+    if (LINK_Send(cmd, payload, len, (uint32_t)(prv_elapsedUs() / 1000U)) == LINK_ERROR_BUSY)
+    {
+        return prv_sendRaw(cmd, payload, len);
+    }
+    return HAL_COMM_SUCCESS;
+#else
+    return prv_sendRaw(cmd, payload, len);
+#endif
+}
+
+boolean HAL_COMM_PollFrame(FRAME_Type *frame)
+{
+#if (HAL_COMM_RELIABLE == 0)
+    uint8_t i;
+#endif
+
+    if ((!isInitialized) || (frame == NULL))
+    {
+        return FALSE;
+    }
+
+    if (!prv_available())
+    {
+        prv_finish();
+    }
+
+    while (prv_available())
+    {
+        if (FRAME_ParserFeed(&frameParser, prv_rxByte()) == FRAME_STATUS_COMPLETE)
+        {
+            framesDecoded++;
+
+            if (frameParser.frame.cmd == HAL_COMM_CMD_HEARTBEAT)
+            {
+                continue;
+            }
+#if (HAL_COMM_RELIABLE != 0)
+            if (LINK_OnFrame(&frameParser.frame, frame, (uint32_t)(prv_elapsedUs() / 1000U)))
+            {
+                return TRUE;
+            }
+#else
+            frame->cmd = frameParser.frame.cmd;
+            frame->len = frameParser.frame.len;
+            for (i = 0U; i < frame->len; i++)
+            {
+                frame->payload[i] = frameParser.frame.payload[i];
+            }
+            return TRUE;
+#endif
+        }
+    }
+
+    return FALSE;
+}
+
+uint8_t HAL_COMM_ReceiveFrameTimeout(FRAME_Type *frame, uint32_t timeoutMs)
+{
+    (void)timeoutMs;
+
+    if (!isInitialized)
+    {
+        return HAL_COMM_ERROR_INIT;
+    }
+
+    if (frame == NULL)
+    {
+        return HAL_COMM_ERROR_INVALID;
+    }
+
+    /* PollFrame() ends the run once the capture is used up */
+    while (!HAL_COMM_PollFrame(frame)) { }
+
+    return HAL_COMM_SUCCESS;
+}
+
+uint32_t HAL_COMM_NegotiateBaud(void)
+{
+    return HAL_COMM_BAUD_RATE;
+}
+
+void HAL_COMM_SetWaitHook(HAL_COMM_WaitHookType hook)
+{
+    /* Negotiation never waits here */
+    (void)hook;
+}
+
+uint32_t HAL_COMM_GetBaudRate(void)
+{
+    return HAL_COMM_BAUD_RATE;
+}
+
+void HAL_COMM_OnTick(void)
+{
+    /* Nothing to keep alive: the capture is the peer */
+}
+
+boolean HAL_COMM_IsPeerAlive(void)
+{
+    /* The run ends when the capture does */
+    return TRUE;
+}
+
+void HAL_COMM_SelectNode(uint8_t node)
+{
+    (void)node;
+}
+
+uint8_t HAL_COMM_GetSourceNode(void)
+{
+    return HAL_COMM_NODE_PEER;
+}
+
+boolean HAL_COMM_IsNodeAlive(uint8_t node)
+{
+    return (node == HAL_COMM_NODE_PEER) ? TRUE : FALSE;
+}
+
+void HAL_COMM_GetStats(HAL_COMM_StatsType *stats)
+{
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_StatsType link;
+#endif
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    /* A capture has no line errors, FIFO or ISR: those read 0 */
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->rxBytes         = rxPos;
+    stats->txBytes         = txCount;
+    stats->crcErrors       = frameParser.crcErrors;
+    stats->lengthErrors    = frameParser.lengthErrors;
+    stats->truncatedFrames = frameParser.truncatedFrames;
+
+#if (HAL_COMM_RELIABLE != 0)
+    LINK_GetStats(&link);
+    stats->retransmits     = link.retransmits;
+    stats->linkDropped     = link.dropped;
+#endif
+}
+
+void HAL_COMM_ResetStats(void)
+{
+    /* rxPos and txCount also drive the end-of-run summary; keep them */
+}
+
+void HAL_COMM_SendString(const char *str)
+{
+    if ((isInitialized) && (str != NULL))
+    {
+        while (*str != '\0')
+        {
+            prv_txByte((uint8_t)*str++);
+        }
+    }
+}
+
+uint32_t HAL_COMM_ReceiveString(char *buffer, uint32_t maxLen)
+{
+    uint32_t count = 0U;
+    char c;
+
+    if ((!isInitialized) || (buffer == NULL) || (maxLen == 0U))
+    {
+        return 0U;
+    }
+
+    while (count < (maxLen - 1U))
+    {
+        c = (char)prv_rxByte();
+        if ((c == '\r') || (c == '\n'))
+        {
+            break;
+        }
+        buffer[count++] = c;
+    }
+    buffer[count] = '\0';
+
+    return count;
+}
+
+boolean HAL_COMM_IsDataAvailable(void)
+{
+    if (isInitialized && !prv_available())
+    {
+        prv_finish();
+    }
+
+    return isInitialized ? prv_available() : FALSE;
+}
+
+uint16_t HAL_COMM_ReadRecording(COMMREC_RecordType *out, uint16_t max)
+{
+    (void)out;
+    (void)max;
+    return 0U;
+}
+
+HAL_COMM_HandleType HAL_COMM_Open(uint8_t port, uint32_t baudRate)
+{
+    /* A capture holds the link only */
+    (void)port;
+    (void)baudRate;
+    return NULL;
+}
+
+void HAL_COMM_PortSendByte(HAL_COMM_HandleType handle, uint8_t data)
+{
+    (void)handle;
+    (void)data;
+}
+
+void HAL_COMM_PortSendString(HAL_COMM_HandleType handle, const char *str)
+{
+    (void)handle;
+    (void)str;
+}
+
+uint16_t HAL_COMM_PortGetTxRoom(HAL_COMM_HandleType handle)
+{
+    (void)handle;
+    return 0U;
+}
+
+boolean HAL_COMM_PortReceiveByte(HAL_COMM_HandleType handle, uint8_t *data)
+{
+    (void)handle;
+    (void)data;
+    return FALSE;
+}
+
+uint8_t HAL_COMM_PortFlush(HAL_COMM_HandleType handle, uint32_t timeoutMs)
+{
+    (void)handle;
+    (void)timeoutMs;
+    return HAL_COMM_ERROR_INVALID;
+}
+
+void HAL_COMM_SendMessage(const char *message)
+{
+    if ((isInitialized) && (message != NULL))
+    {
+        HAL_COMM_SendString(message);
+        HAL_COMM_SendString("\r\n");  /* Send CR+LF for new line */
+    }
+}
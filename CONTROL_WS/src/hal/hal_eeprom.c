@@ -6,6 +6,7 @@
 
 #include "hal/hal_eeprom.h"
 #include "mcal/mcal_eeprom.h"
+#include "services/prof.h"
 
 #include <string.h>
 
@@ -36,6 +37,49 @@ static boolean prv_memcmp(const char *buf1, const char *buf2, uint8_t length)
     return TRUE;
 }
 
+/**
+ * @brief Check a password against the stored one (body of
+ *        HAL_EEPROM_VerifyPassword(), which profiles it).
+ *
+ * @param password  Password to check
+ * @param length    Its length
+ * @return TRUE if it matches the stored password, FALSE otherwise
+ */
+static boolean prv_verifyPassword(const char *password, uint8_t length)
+{
+    uint8_t result;
+    char storedPassword[HAL_EEPROM_PASSWORD_MAX_LENGTH + 1U];
+    uint8_t storedLength;
+    
+    /* Validate parameters */
+    if (password == NULL)
+    {
+        return FALSE;
+    }
+    
+    /* Check if password is set */
+    if (!HAL_EEPROM_IsPasswordSet())
+    {
+        return FALSE;
+    }
+    
+    /* Read stored password */
+    result = HAL_EEPROM_ReadPassword(storedPassword, &storedLength);
+    if (result != HAL_EEPROM_SUCCESS)
+    {
+        return FALSE;
+    }
+    
+    /* Check length first (quick reject) */
+    if (length != storedLength)
+    {
+        return FALSE;
+    }
+    
+    /* Compare passwords */
+    return prv_memcmp(password, storedPassword, length);
+}
+
 /*======================================================================
  *  API Implementations
  *====================================================================*/
@@ -186,37 +230,13 @@ uint8_t HAL_EEPROM_ReadPassword(char *buffer, uint8_t *pLength)
 
 boolean HAL_EEPROM_VerifyPassword(const char *password, uint8_t length)
 {
-    uint8_t result;
-    char storedPassword[HAL_EEPROM_PASSWORD_MAX_LENGTH + 1U];
-    uint8_t storedLength;
+    boolean match;
     
-    /* Validate parameters */
-    if (password == NULL)
-    {
-        return FALSE;
-    }
+    PROF_BEGIN(PROF_SITE_EEPROM_VERIFY);
+    match = prv_verifyPassword(password, length);
+    PROF_END(PROF_SITE_EEPROM_VERIFY);
     
-    /* Check if password is set */
-    if (!HAL_EEPROM_IsPasswordSet())
-    {
-        return FALSE;
-    }
-    
-    /* Read stored password */
-    result = HAL_EEPROM_ReadPassword(storedPassword, &storedLength);
-    if (result != HAL_EEPROM_SUCCESS)
-    {
-        return FALSE;
-    }
-    
-    /* Check length first (quick reject) */
-    if (length != storedLength)
-    {
-        return FALSE;
-    }
-    
-    /* Compare passwords */
-    return prv_memcmp(password, storedPassword, length);
+    return match;
 }
 
 boolean HAL_EEPROM_IsPasswordSet(void)
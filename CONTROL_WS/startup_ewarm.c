@@ -45,8 +45,18 @@ static void FaultISR(void);
 static void IntDefaultHandler(void);
 extern void systick_ISR (void);
 extern void PORTF_Handler(void) ;
+extern void UART0_Handler(void);
+extern void UART1_Handler(void);
+extern void UART2_Handler(void);
+extern void UART3_Handler(void);
+extern void UART4_Handler(void);
+extern void UART5_Handler(void);
+extern void UART6_Handler(void);
+extern void UART7_Handler(void);
+extern void uDMA_Error_Handler(void);
 extern void Timer0A_Handler(void);
 extern void WTimer2A_Handler(void);
+extern void WTimer0A_Handler(void);
 
 
 
@@ -108,8 +118,8 @@ __root const uVectorEntry __vector_table [] @ ".intvec" =
     IntDefaultHandler,                      // GPIO Port C
     IntDefaultHandler,                      // GPIO Port D
     IntDefaultHandler,                      // GPIO Port E
-    IntDefaultHandler,                      // UART0 Rx and Tx
-    IntDefaultHandler,                      // UART1 Rx and Tx
+    UART0_Handler,                          // UART0 Rx and Tx
+    UART1_Handler,                          // UART1 Rx and Tx
     IntDefaultHandler,                      // SSI0 Rx and Tx
     IntDefaultHandler,                      // I2C0 Master and Slave
     IntDefaultHandler,                      // PWM Fault
@@ -136,7 +146,7 @@ __root const uVectorEntry __vector_table [] @ ".intvec" =
     PORTF_Handler,                         // GPIO Port F
     IntDefaultHandler,                      // GPIO Port G
     IntDefaultHandler,                      // GPIO Port H
-    IntDefaultHandler,                      // UART2 Rx and Tx
+    UART2_Handler,                          // UART2 Rx and Tx
     IntDefaultHandler,                      // SSI1 Rx and Tx
     IntDefaultHandler,                      // Timer 3 subtimer A
     IntDefaultHandler,                      // Timer 3 subtimer B
@@ -150,7 +160,7 @@ __root const uVectorEntry __vector_table [] @ ".intvec" =
     IntDefaultHandler,                      // USB0
     IntDefaultHandler,                      // PWM Generator 3
     IntDefaultHandler,                      // uDMA Software Transfer
-    IntDefaultHandler,                      // uDMA Error
+    uDMA_Error_Handler,                     // uDMA Error
     IntDefaultHandler,                      // ADC1 Sequence 0
     IntDefaultHandler,                      // ADC1 Sequence 1
     IntDefaultHandler,                      // ADC1 Sequence 2
@@ -162,11 +172,11 @@ __root const uVectorEntry __vector_table [] @ ".intvec" =
     IntDefaultHandler,                      // GPIO Port L
     IntDefaultHandler,                      // SSI2 Rx and Tx
     IntDefaultHandler,                      // SSI3 Rx and Tx
-    IntDefaultHandler,                      // UART3 Rx and Tx
-    IntDefaultHandler,                      // UART4 Rx and Tx
-    IntDefaultHandler,                      // UART5 Rx and Tx
-    IntDefaultHandler,                      // UART6 Rx and Tx
-    IntDefaultHandler,                      // UART7 Rx and Tx
+    UART3_Handler,                          // UART3 Rx and Tx
+    UART4_Handler,                          // UART4 Rx and Tx
+    UART5_Handler,                          // UART5 Rx and Tx
+    UART6_Handler,                          // UART6 Rx and Tx
+    UART7_Handler,                          // UART7 Rx and Tx
     0,                                      // Reserved
     0,                                      // Reserved
     0,                                      // Reserved
@@ -197,7 +207,7 @@ __root const uVectorEntry __vector_table [] @ ".intvec" =
     0,                                      // Reserved
     IntDefaultHandler,                      // Timer 5 subtimer A
     IntDefaultHandler,                      // Timer 5 subtimer B
-    IntDefaultHandler,                      // Wide Timer 0 subtimer A
+    WTimer0A_Handler,                       // Wide Timer 0 subtimer A
     IntDefaultHandler,                      // Wide Timer 0 subtimer B
     IntDefaultHandler,                      // Wide Timer 1 subtimer A
     IntDefaultHandler,                      // Wide Timer 1 subtimer B
@@ -0,0 +1,49 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : ecu.h
+ *  Description : A whole ECU as a host process, on the TM4C123 model
+ *
+ *  The ECU's main.c, HAL and the Common sources are built unchanged with
+ *  main renamed to ECU_Main; HAL_COMM comes from one of the host backends
+ *  (hal_comm_pty.c, hal_comm_replay.c). ecu_main.c brings the model up
+ *  and hands over to the firmware; the ECU's board file (ecu_control.c,
+ *  ecu_himi.c) wires what sits outside the chip to the models.
+ *
+ *  Environment:
+ *    ECU_EEPROM=file   keep the EEPROM in file across runs (erased if absent)
+ *
+ *  With the pty backend the model runs in real time (see sim.h): the
+ *  backend keeps its timeouts with CLOCK_MONOTONIC and the peer is another
+ *  real process. A sleeping core wakes when a terminal it has open (the
+ *  pty, the console) has input, as it would on the UART receive interrupt.
+ *  The replay build (ECU_REALTIME_ENABLE=0) runs the model as fast as it
+ *  goes, so its summary is the cost of the command path.
+ *===========================================================================*/
+
+#ifndef ECU_H_
+#define ECU_H_
+
+#include "sim.h"
+#include "sim_board.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define ECU_EEPROM_ENV          "ECU_EEPROM"
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief The firmware's main(), renamed at compile time.
+ */
+int ECU_Main(void);
+
+/**
+ * @brief Connect the board around the chip; called after SIM_Init().
+ */
+void ECU_BoardInit(void);
+
+#endif /* ECU_H_ */
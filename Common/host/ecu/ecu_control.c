@@ -0,0 +1,123 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : ecu_control.c
+ *  Description : Control ECU board: door motor, buzzer, LEDs and the
+ *                AIN0 input
+ *
+ *  The outputs are logged on stderr when they change, once they have
+ *  been steady for ECU_SETTLE_CYCLES (the HAL writes one pin at a time):
+ *      [   1234.5 ms] door opening, buzzer off, led green
+ *===========================================================================*/
+
+#include "ecu.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* hal_motor.c: IN1 PB4, IN2 PB5, ENA PB6 */
+#define MOTOR_PORT              GPIO_PORTB_BASE
+#define MOTOR_IN1               (1U << 4)
+#define MOTOR_IN2               (1U << 5)
+#define MOTOR_ENA               (1U << 6)
+
+/* hal_buzzer.h: PD1; main.c: red PF1, green PF3 */
+#define BUZZER_PORT             GPIO_PORTD_BASE
+#define BUZZER_PIN              (1U << 1)
+#define LED_PORT                GPIO_PORTF_BASE
+#define LED_RED                 (1U << 1)
+#define LED_GREEN               (1U << 3)
+
+#define ECU_SETTLE_CYCLES       (SIM_CYCLES_PER_MS)
+#define ECU_AIN0_SAMPLE         (2048U)     /* Mid-scale */
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static char     shown[64];
+static uint64_t changedAt = SIM_NEVER;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static void describe(char *buf, size_t size)
+{
+    uint8_t     motor = SIM_GPIO_GetOutput(MOTOR_PORT);
+    uint8_t     led   = SIM_GPIO_GetOutput(LED_PORT);
+    const char *door  = "stopped";
+
+    if ((motor & MOTOR_ENA) != 0U)
+    {
+        door = ((motor & (MOTOR_IN1 | MOTOR_IN2)) == MOTOR_IN1) ? "opening"
+             : ((motor & (MOTOR_IN1 | MOTOR_IN2)) == MOTOR_IN2) ? "closing"
+             : "braked";
+    }
+
+    (void)snprintf(buf, size, "door %s, buzzer %s, led %s%s%s", door,
+                   ((SIM_GPIO_GetOutput(BUZZER_PORT) & BUZZER_PIN) != 0U) ? "on" : "off",
+                   ((led & LED_RED) != 0U) ? "red" : "",
+                   ((led & LED_GREEN) != 0U) ? "green" : "",
+                   ((led & (LED_RED | LED_GREEN)) == 0U) ? "off" : "");
+}
+
+static void onWrite(uint32_t portBase, uint8_t pins, uint8_t value)
+{
+    (void)pins;
+    (void)value;
+
+    if ((portBase == MOTOR_PORT) || (portBase == BUZZER_PORT) || (portBase == LED_PORT))
+    {
+        changedAt = SIM_Now();
+    }
+}
+
+static void reset(void)
+{
+    shown[0]  = '\0';
+    changedAt = SIM_NEVER;
+}
+
+static uint64_t nextEvent(void)
+{
+    return (changedAt == SIM_NEVER) ? SIM_NEVER : (changedAt + ECU_SETTLE_CYCLES);
+}
+
+static void process(uint64_t now)
+{
+    char state[sizeof(shown)];
+
+    if ((changedAt == SIM_NEVER) || (now < (changedAt + ECU_SETTLE_CYCLES)))
+    {
+        return;
+    }
+    changedAt = SIM_NEVER;
+
+    describe(state, sizeof(state));
+    if (strcmp(state, shown) != 0)
+    {
+        (void)strcpy(shown, state);
+        fprintf(stderr, "[%9.1f ms] %s\n", (double)now / SIM_CYCLES_PER_MS, shown);
+    }
+}
+
+static const SIM_ModelType model = { "control board", reset, nextEvent, process };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&model);
+}
+
+/*======================================================================
+ *  Board
+ *====================================================================*/
+
+void ECU_BoardInit(void)
+{
+    SIM_GPIO_SetWriteHook(onWrite);
+    SIM_ADC_SetSample(ECU_AIN0_SAMPLE);
+}
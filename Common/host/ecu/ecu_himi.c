@@ -0,0 +1,412 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : ecu_himi.c
+ *  Description : HMI ECU board: 16x2 LCD behind a PCF8574, 4x4 keypad and
+ *                the timeout potentiometer
+ *
+ *  LCD: the I2C bytes hal_lcd.c sends to the PCF8574 (P0 RS, P2 E,
+ *  P3 backlight, P4-P7 D4-D7) are latched on the falling edge of E into
+ *  an HD44780 model (8-bit reset, 4-bit mode, clear, home, DDRAM address,
+ *  data). The screen is printed on stderr whenever it has been steady
+ *  for ECU_SETTLE_CYCLES:
+ *      [   1234.5 ms] lcd |Enter PWD:      |*****           |
+ *
+ *  Keypad: HMI_KEYS scripts the key presses. Each character is one key
+ *  (0-9, A-D, * and #), pressed until hal_keypad.c has scanned it, held
+ *  ECU_KEY_HOLD_CYCLES longer and released for ECU_KEY_GAP_CYCLES.
+ *  "{text}" waits until text is on the screen (ECU_WAIT_CYCLES at most),
+ *  "." pauses 100 ms. When the script is done "keys: done" is printed;
+ *  a step that times out prints "keys: stuck at ..." and exits with 1.
+ *===========================================================================*/
+
+#include "ecu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define ECU_KEYS_ENV            "HMI_KEYS"
+
+#define LCD_ADDRESS             (0x27U)
+#define LCD_ROWS                (2U)
+#define LCD_COLS                (16U)
+#define LCD_RS                  (0x01U)
+#define LCD_E                   (0x04U)
+
+/* hal_keypad.h: columns PC4-PC7 driven, rows PA2-PA5 read */
+#define KEY_COL_PORT            GPIO_PORTC_BASE
+#define KEY_ROW_PORT            GPIO_PORTA_BASE
+#define KEY_COL_SHIFT           (4U)
+#define KEY_ROW_SHIFT           (2U)
+
+#define ECU_SETTLE_CYCLES       (20U * SIM_CYCLES_PER_MS)
+#define ECU_KEY_HOLD_CYCLES     (60U * SIM_CYCLES_PER_MS)
+#define ECU_KEY_GAP_CYCLES      (80U * SIM_CYCLES_PER_MS)
+#define ECU_PAUSE_CYCLES        (100U * SIM_CYCLES_PER_MS)
+#define ECU_WAIT_CYCLES         (10000U * SIM_CYCLES_PER_MS)
+#define ECU_POLL_CYCLES         (5U * SIM_CYCLES_PER_MS)
+#define ECU_POT_SAMPLE          (2048U)     /* Mid-scale */
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef enum
+{
+    STEP_NEXT = 0,          /* Take the next script character at stepAt */
+    STEP_PRESSED,           /* Key down, waiting for the scan */
+    STEP_HELD,              /* Scanned; released at stepAt */
+    STEP_WAIT_TEXT,         /* Until the screen shows waitText */
+    STEP_DONE
+} StepType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static const char keyMap[4][4] =
+{
+    { '1', '2', '3', 'A' },
+    { '4', '5', '6', 'B' },
+    { '7', '8', '9', 'C' },
+    { '*', '0', '#', 'D' }
+};
+
+/* HD44780 */
+static char     lcdText[LCD_ROWS][LCD_COLS + 1U];
+static char     lcdShown[LCD_ROWS][LCD_COLS + 1U];
+static uint8_t  lcdAddr;
+static bool     lcdFourBit;
+static bool     lcdHaveHigh;
+static uint8_t  lcdHigh;
+static uint8_t  lcdLastByte;
+static uint64_t lcdChangedAt;
+
+/* Key script */
+static const char *script;
+static StepType    step;
+static uint64_t    stepAt;
+static uint64_t    waitUntil;
+static char        waitText[LCD_COLS + 1U];
+static int         keyRow = -1;
+static int         keyCol = -1;
+
+/*======================================================================
+ *  LCD
+ *====================================================================*/
+
+static void lcdClear(void)
+{
+    uint32_t row;
+
+    for (row = 0U; row < LCD_ROWS; row++)
+    {
+        memset(lcdText[row], ' ', LCD_COLS);
+        lcdText[row][LCD_COLS] = '\0';
+    }
+    lcdAddr = 0U;
+}
+
+static void lcdByte(uint8_t data, bool rs)
+{
+    uint8_t row = (lcdAddr >= 0x40U) ? 1U : 0U;
+    uint8_t col = (uint8_t)(lcdAddr & 0x3FU);
+
+    if (rs)
+    {
+        if (col < LCD_COLS)
+        {
+            lcdText[row][col] = (char)(((data >= 0x20U) && (data < 0x7FU)) ? data : '?');
+        }
+        lcdAddr++;
+    }
+    else if ((data & 0x80U) != 0U)
+    {
+        lcdAddr = (uint8_t)(data & 0x7FU);
+    }
+    else if ((data & 0x20U) != 0U)
+    {
+        lcdFourBit  = ((data & 0x10U) == 0U);
+        lcdHaveHigh = false;
+    }
+    else if (data == 0x01U)
+    {
+        lcdClear();
+    }
+    else if ((data & 0xFEU) == 0x02U)
+    {
+        lcdAddr = 0U;
+    }
+    else
+    {
+        /* Entry mode, display on/off, shift: nothing to show */
+    }
+
+    lcdChangedAt = SIM_Now();
+}
+
+static void onI2c(uint8_t slaveAddr, uint8_t data)
+{
+    bool    falling = ((lcdLastByte & LCD_E) != 0U) && ((data & LCD_E) == 0U);
+    uint8_t nibble  = (uint8_t)(data & 0xF0U);
+
+    if (slaveAddr != LCD_ADDRESS)
+    {
+        return;
+    }
+    lcdLastByte = data;
+    if (!falling)
+    {
+        return;
+    }
+
+    if (!lcdFourBit)
+    {
+        lcdByte(nibble, (data & LCD_RS) != 0U);
+    }
+    else if (!lcdHaveHigh)
+    {
+        lcdHigh     = nibble;
+        lcdHaveHigh = true;
+    }
+    else
+    {
+        lcdHaveHigh = false;
+        lcdByte((uint8_t)(lcdHigh | (nibble >> 4)), (data & LCD_RS) != 0U);
+    }
+}
+
+static bool lcdShows(const char *text)
+{
+    uint32_t row;
+
+    for (row = 0U; row < LCD_ROWS; row++)
+    {
+        if (strstr(lcdShown[row], text) != NULL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*======================================================================
+ *  Keypad
+ *====================================================================*/
+
+/* Rows read low where the pressed key joins them to a driven-low column */
+static uint8_t onRead(uint32_t portBase, uint8_t outputs)
+{
+    uint8_t cols;
+
+    (void)outputs;
+
+    if ((portBase != KEY_ROW_PORT) || (keyRow < 0))
+    {
+        return 0xFFU;
+    }
+
+    cols = SIM_GPIO_GetOutput(KEY_COL_PORT);
+    if ((cols & (1U << (KEY_COL_SHIFT + (uint32_t)keyCol))) != 0U)
+    {
+        return 0xFFU;
+    }
+
+    if (step == STEP_PRESSED)
+    {
+        /* Held from the first scan that sees it */
+        step   = STEP_HELD;
+        stepAt = SIM_Now() + ECU_KEY_HOLD_CYCLES;
+    }
+    return (uint8_t)~(1U << (KEY_ROW_SHIFT + (uint32_t)keyRow));
+}
+
+static bool press(char key)
+{
+    int row;
+    int col;
+
+    for (row = 0; row < 4; row++)
+    {
+        for (col = 0; col < 4; col++)
+        {
+            if (keyMap[row][col] == key)
+            {
+                keyRow = row;
+                keyCol = col;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*======================================================================
+ *  Script
+ *====================================================================*/
+
+static void stuck(const char *what)
+{
+    fprintf(stderr, "keys: stuck at %s (script \"%s\")\n", what, script);
+    exit(1);
+}
+
+/* Start the next script step at now */
+static void nextStep(uint64_t now)
+{
+    const char *end;
+    size_t      len;
+
+    if ((script == NULL) || (*script == '\0'))
+    {
+        if (script != NULL)
+        {
+            fprintf(stderr, "keys: done\n");
+        }
+        step = STEP_DONE;
+        return;
+    }
+
+    if (*script == '{')
+    {
+        end = strchr(script, '}');
+        len = (end != NULL) ? (size_t)(end - script - 1) : 0U;
+        if ((end == NULL) || (len == 0U) || (len > LCD_COLS))
+        {
+            stuck("a bad {text}");
+        }
+        memcpy(waitText, script + 1, len);
+        waitText[len] = '\0';
+        script    = end + 1;
+        step      = STEP_WAIT_TEXT;
+        stepAt    = now;
+        waitUntil = now + ECU_WAIT_CYCLES;
+    }
+    else if (*script == '.')
+    {
+        script++;
+        step   = STEP_NEXT;
+        stepAt = now + ECU_PAUSE_CYCLES;
+    }
+    else if (press(*script))
+    {
+        script++;
+        step   = STEP_PRESSED;
+        stepAt = now + ECU_WAIT_CYCLES;
+    }
+    else
+    {
+        stuck("an unknown key");
+    }
+}
+
+/*======================================================================
+ *  Model
+ *====================================================================*/
+
+static void reset(void)
+{
+    lcdClear();
+    memcpy(lcdShown, lcdText, sizeof(lcdShown));
+    lcdFourBit   = false;
+    lcdHaveHigh  = false;
+    lcdLastByte  = 0U;
+    lcdChangedAt = SIM_NEVER;
+    keyRow       = -1;
+    keyCol       = -1;
+    script       = getenv(ECU_KEYS_ENV);
+    step         = STEP_NEXT;
+    stepAt       = 0U;
+}
+
+static uint64_t nextEvent(void)
+{
+    uint64_t next = (lcdChangedAt == SIM_NEVER) ? SIM_NEVER
+                                                : (lcdChangedAt + ECU_SETTLE_CYCLES);
+
+    if ((step != STEP_DONE) && (stepAt < next))
+    {
+        next = stepAt;
+    }
+    return next;
+}
+
+static void process(uint64_t now)
+{
+    uint32_t row;
+
+    if ((lcdChangedAt != SIM_NEVER) && (now >= (lcdChangedAt + ECU_SETTLE_CYCLES)))
+    {
+        lcdChangedAt = SIM_NEVER;
+        if (memcmp(lcdText, lcdShown, sizeof(lcdShown)) != 0)
+        {
+            memcpy(lcdShown, lcdText, sizeof(lcdShown));
+            fprintf(stderr, "[%9.1f ms] lcd |", (double)now / SIM_CYCLES_PER_MS);
+            for (row = 0U; row < LCD_ROWS; row++)
+            {
+                fprintf(stderr, "%s|", lcdShown[row]);
+            }
+            fputc('\n', stderr);
+        }
+    }
+
+    if ((step == STEP_DONE) || (now < stepAt))
+    {
+        return;
+    }
+
+    switch (step)
+    {
+        case STEP_PRESSED:
+            stuck("a key nobody scanned");
+            break;
+
+        case STEP_HELD:
+            keyRow = -1;
+            keyCol = -1;
+            step   = STEP_NEXT;
+            stepAt = now + ECU_KEY_GAP_CYCLES;
+            break;
+
+        case STEP_WAIT_TEXT:
+            if (lcdShows(waitText))
+            {
+                nextStep(now);
+            }
+            else if (now >= waitUntil)
+            {
+                stuck(waitText);
+            }
+            else
+            {
+                stepAt = now + ECU_POLL_CYCLES;
+            }
+            break;
+
+        default:
+            nextStep(now);
+            break;
+    }
+}
+
+static const SIM_ModelType model = { "hmi board", reset, nextEvent, process };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&model);
+}
+
+/*======================================================================
+ *  Board
+ *====================================================================*/
+
+void ECU_BoardInit(void)
+{
+    SIM_I2C_SetHook(onI2c);
+    SIM_GPIO_SetReadHook(onRead);
+    SIM_ADC_SetSample(ECU_POT_SAMPLE);
+}
@@ -0,0 +1,94 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : ecu_main.c
+ *  Description : Process entry for a host-built ECU
+ *===========================================================================*/
+
+#include "ecu.h"
+
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Paced to the wall clock for a live peer; off for the replay backend,
+ * whose peer is a file and whose run should take as little time as the
+ * model needs */
+#ifndef ECU_REALTIME_ENABLE
+#define ECU_REALTIME_ENABLE     (1)
+#endif
+
+#define ECU_MAX_FDS             (16)
+#define ECU_RESCAN_SLEEPS       (4000U)     /* About once a second */
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+#if (ECU_REALTIME_ENABLE != 0)
+static struct pollfd wakeFds[ECU_MAX_FDS];
+static nfds_t        wakeCount;
+static uint32_t      sleepsSinceScan = ECU_RESCAN_SLEEPS;
+#endif
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+#if (ECU_REALTIME_ENABLE != 0)
+/* The terminals the firmware has open; the backends open theirs during
+ * init, so the list is refreshed now and then */
+static void scanTerminals(void)
+{
+    int fd;
+
+    wakeCount = 0U;
+    for (fd = 0; fd < ECU_MAX_FDS; fd++)
+    {
+        if (isatty(fd))
+        {
+            wakeFds[wakeCount].fd     = fd;
+            wakeFds[wakeCount].events = POLLIN;
+            wakeCount++;
+        }
+    }
+    sleepsSinceScan = 0U;
+}
+
+/* Input waiting on any of them ends the WFI */
+static bool inputWaiting(void)
+{
+    if (++sleepsSinceScan >= ECU_RESCAN_SLEEPS)
+    {
+        scanTerminals();
+    }
+
+    return (wakeCount != 0U) && (poll(wakeFds, wakeCount, 0) > 0);
+}
+#endif
+
+/*======================================================================
+ *  Entry
+ *====================================================================*/
+
+int main(void)
+{
+    const char *eepromFile = getenv(ECU_EEPROM_ENV);
+
+    SIM_Init();
+    if (eepromFile != NULL)
+    {
+        SIM_EEPROM_UseFile(eepromFile);
+    }
+    ECU_BoardInit();
+
+#if (ECU_REALTIME_ENABLE != 0)
+    SIM_SetWakeHook(inputWaiting);
+    SIM_SetRealtime(true);
+#endif
+
+    return ECU_Main();
+}
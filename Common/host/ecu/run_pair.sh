@@ -0,0 +1,61 @@
+#!/bin/sh
+#=============================================================================
+#  Run the two host-built ECUs against each other over a pty
+#
+#  usage: run_pair.sh [build dir]
+#
+#  Control starts first and prints its pty; the HMI opens it and types the
+#  HMI_KEYS session on its keypad (default below: first password, three
+#  password changes, one wrong password). Then the HMI console's "req"
+#  command reports the requests and their round trip, Control's view of
+#  its board and the HMI's LCD are printed, and both are stopped.
+#
+#  PAIR_CAPTURE=file keeps Control's traffic as a commrec capture
+#  (HAL_COMM_PTY_RECORD), for make replay.
+#=============================================================================
+
+build=${1:-build}
+
+setup='{Set Password}12345#{Confirm PWD}12345#{+)Open}'
+change() { echo "B{Old Password}$1#{New Password}$2#{Confirm New}$2#{Changed}{+)Open}"; }
+wrong='A{Enter PWD}11111#{Wrong PWD}{+)Open}'
+keys=${HMI_KEYS:-$setup$(change 12345 54321)$(change 54321 12345)$(change 12345 54321)$wrong}
+
+dir=$(mktemp -d)
+control=
+himi=
+trap 'kill $control $himi 2>/dev/null; rm -rf "$dir"' EXIT
+
+${PAIR_CAPTURE:+env HAL_COMM_PTY_RECORD=$PAIR_CAPTURE} "$build/control_pty" </dev/null >"$dir/control.out" 2>"$dir/control.log" &
+control=$!
+
+pty=
+for i in $(seq 50); do
+    pty=$(sed -n 's/^HAL_COMM: pty slave //p' "$dir/control.log")
+    [ -n "$pty" ] && break
+    sleep 0.1
+done
+if [ -z "$pty" ]; then
+    echo "pair: Control did not open a pty" >&2
+    exit 1
+fi
+
+mkfifo "$dir/console"
+HAL_COMM_PTY=$pty HMI_KEYS=$keys "$build/himi_pty" <"$dir/console" >"$dir/himi.out" 2>"$dir/himi.log" &
+himi=$!
+exec 3>"$dir/console"
+
+while kill -0 $himi 2>/dev/null && ! grep -q '^keys: ' "$dir/himi.log"; do
+    sleep 0.2
+done
+printf 'req\r' >&3
+sleep 0.5
+
+echo "== Control"
+cat "$dir/control.log"
+echo "== HMI"
+cat "$dir/himi.log"
+echo "== HMI console: req"
+tr -d '\r' <"$dir/himi.out" | sed -n '/^sent /,/^rtt /p'
+
+grep -q '^keys: done' "$dir/himi.log" && tr -d '\r' <"$dir/himi.out" | grep -q '^rtt '
@@ -0,0 +1,184 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim.h
+ *  Description : Cycle-clocked TM4C123 model the firmware sources run on
+ *                in host tests
+ *
+ *  The firmware is compiled unchanged against the TivaWare stand-in in
+ *  ../tiva/ and linked with the models in this directory:
+ *
+ *  - Time is a 64-bit count of 16 MHz core cycles. It only moves when the
+ *    "CPU" does something: firmware objects are built with
+ *    -finstrument-functions and every function entry costs
+ *    SIM_CALL_CYCLES, every driverlib call SIM_DRIVER_CYCLES. Busy-wait
+ *    loops therefore advance time like they do on the target, and a run
+ *    is fully deterministic.
+ *  - Peripherals (sim_systick.c, sim_uart.c, sim_udma.c, sim_board.c) are
+ *    models that report their next state change and are brought up to
+ *    date whenever time passes it.
+ *  - The NVIC keeps enable, pending and interrupt-line bits and PRIMASK.
+ *    Pending, enabled interrupts are taken at the next function entry the
+ *    firmware makes, SysTick first and then by interrupt number, without
+ *    nesting (all priorities are equal in the firmware). CPUwfi() jumps
+ *    to the next model event until an interrupt is pending and counts
+ *    the cycles as sleep.
+ *  - Handlers are found by name, as in startup_ewarm.c (systick_ISR,
+ *    UARTn_Handler, ...); the ones not linked stay empty.
+ *
+ *  Test programs call the firmware directly, use SIM_Run() for work of
+ *  their own, and read the models' counters to check the result.
+ *
+ *  A whole ECU talking to something outside the process (ecu/) runs in
+ *  real time instead: model time is held back to the wall clock, and
+ *  CPUwfi() also returns when a wake hook reports outside input, as a
+ *  receive interrupt would on the target.
+ *===========================================================================*/
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim_tiva.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_CLOCK_HZ            (16000000U)
+#define SIM_CYCLES_PER_US       (SIM_CLOCK_HZ / 1000000U)
+#define SIM_CYCLES_PER_MS       (SIM_CLOCK_HZ / 1000U)
+
+/* Cost of one instrumented function call, one driverlib call, and of
+ * interrupt entry and exit (stacking, tail of the handler) */
+#define SIM_CALL_CYCLES         (20U)
+#define SIM_DRIVER_CYCLES       (10U)
+#define SIM_ISR_CYCLES          (24U)
+
+#define SIM_NEVER               (UINT64_MAX)
+
+/* Real-time mode: largest lead over the wall clock, and the step in
+ * which a sleeping core checks the wake hook */
+#define SIM_PACE_CYCLES         (250U * SIM_CYCLES_PER_US)
+
+#define SIM_MAX_MODELS          (8U)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+typedef struct
+{
+    const char *name;
+    void      (*reset)(void);               /* Power-on state */
+    uint64_t  (*nextEvent)(void);           /* Cycle of the next change, SIM_NEVER if none */
+    void      (*process)(uint64_t now);     /* Apply every change due at or before now */
+} SIM_ModelType;
+
+typedef uint32_t (*SIM_ReadType)(uint32_t key);
+typedef void     (*SIM_WriteType)(uint32_t key, uint32_t value);
+
+typedef struct
+{
+    uint64_t sleepCycles;                   /* Spent in CPUwfi() */
+    uint64_t isrCycles;                     /* Spent in handlers, entry and exit included */
+    uint64_t calls;                         /* Instrumented function entries */
+    uint32_t isrCount[NUM_INTERRUPTS];      /* Handler runs per vector */
+} SIM_StatsType;
+
+/*======================================================================
+ *  Core
+ *====================================================================*/
+
+/**
+ * @brief Reset the clock, the NVIC, the statistics and every linked model.
+ */
+void SIM_Init(void);
+
+/**
+ * @brief Add a model; the models call it from a constructor, so a test
+ *        gets exactly the models it links.
+ */
+void SIM_AddModel(const SIM_ModelType *model);
+
+/**
+ * @brief Current time in core cycles since SIM_Init().
+ */
+uint64_t SIM_Now(void);
+
+/**
+ * @brief Let cycles pass as busy thread code; interrupts are taken.
+ */
+void SIM_Run(uint64_t cycles);
+
+/**
+ * @brief Charge the cost of a modelled instruction sequence (driverlib
+ *        stand-ins, register accesses); same as SIM_Run().
+ */
+void SIM_Charge(uint32_t cycles);
+
+/**
+ * @brief Abort the test with a message once time passes this cycle, so a
+ *        firmware loop that never ends fails instead of hanging.
+ */
+void SIM_SetLimit(uint64_t cycle);
+
+/**
+ * @brief Print a message and exit with status 1.
+ */
+void SIM_Fail(const char *fmt, ...);
+
+void SIM_GetStats(SIM_StatsType *stats);
+
+/**
+ * @brief Hold model time to the wall clock from now on (never ahead of it
+ *        by more than SIM_PACE_CYCLES).
+ */
+void SIM_SetRealtime(bool enable);
+
+/**
+ * @brief In real time, asked while the core sleeps; returning true ends
+ *        the WFI as an interrupt would.
+ */
+void SIM_SetWakeHook(bool (*hook)(void));
+
+/*======================================================================
+ *  NVIC
+ *====================================================================*/
+
+/**
+ * @brief Set an interrupt pending (edge: stays pending until taken).
+ */
+void SIM_PendInt(uint32_t intNumber);
+
+/**
+ * @brief Drive a peripheral's interrupt line (level: pending while high).
+ */
+void SIM_SetIntLine(uint32_t intNumber, bool level);
+
+bool SIM_IsIntPending(uint32_t intNumber);
+
+/*======================================================================
+ *  Registers and bus
+ *====================================================================*/
+
+/**
+ * @brief Back a tm4c123gh6pm.h register with model functions.
+ */
+void SIM_MapReg(SIM_RegIdType id, SIM_ReadType read, SIM_WriteType write);
+
+/**
+ * @brief Back an address range (HWREG(), uDMA accesses) with model
+ *        functions; the key passed to them is the address.
+ */
+void SIM_MapBus(uint32_t base, uint32_t size, SIM_ReadType read, SIM_WriteType write);
+
+/**
+ * @brief Peripheral access from a bus master other than the CPU (uDMA).
+ *
+ * @return false if nothing is mapped at the address.
+ */
+bool SIM_BusRead(uint32_t address, uint32_t *value);
+bool SIM_BusWrite(uint32_t address, uint32_t value);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,857 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_board.c
+ *  Description : System control, GPIO, ADC0, EEPROM, I2C0, PWM0 and timer
+ *                models (driverlib/sysctl.h, gpio.h, eeprom.h, i2c.h,
+ *                pwm.h, timer.h and the ADC0 registers)
+ *===========================================================================*/
+
+#include "sim_board.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define GPIO_PORTS              (6U)
+#define TIMERS                  (4U)
+
+#define ADC_SS3                 (0x08U)
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef struct
+{
+    uint32_t base;
+    uint32_t intNumber;
+    uint32_t config;
+    bool     running;
+    uint32_t load;
+    uint32_t prescale;
+    uint32_t match;
+    uint64_t startAt;           /* Cycle the counter last loaded LOAD */
+    uint32_t im;
+    uint32_t ris;
+} TimerType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static const uint32_t portBases[GPIO_PORTS] = {
+    GPIO_PORTA_BASE, GPIO_PORTB_BASE, GPIO_PORTC_BASE,
+    GPIO_PORTD_BASE, GPIO_PORTE_BASE, GPIO_PORTF_BASE
+};
+
+static const uint32_t timerMap[TIMERS][2] = {
+    { TIMER0_BASE,  INT_TIMER0A  },
+    { WTIMER0_BASE, INT_WTIMER0A },
+    { WTIMER2_BASE, INT_WTIMER2A },
+    { WTIMER5_BASE, INT_WTIMER5A }
+};
+
+static uint32_t periphEnabled[32];      /* SYSCTL_PERIPH_* clocked so far */
+static uint32_t periphCount;
+
+static uint8_t gpioDir[GPIO_PORTS];
+static uint8_t gpioData[GPIO_PORTS];
+static uint8_t gpioInput[GPIO_PORTS];
+static uint8_t gpioRis[GPIO_PORTS];
+static uint8_t gpioCommit[GPIO_PORTS];
+static bool    gpioUnlocked[GPIO_PORTS];
+static SIM_GPIO_ReadHookType  gpioReadHook;
+static SIM_GPIO_WriteHookType gpioWriteHook;
+
+static uint16_t adcSample;
+static bool     adcBusy;
+static uint64_t adcDoneAt;
+static uint32_t adcRis;
+static uint32_t adcRegs[SIM_REG_COUNT];
+
+static uint8_t     eeprom[SIM_EEPROM_SIZE];
+static const char *eepromPath;
+
+static SIM_I2C_HookType i2cHook;
+static uint8_t          i2cSlave;
+static uint8_t          i2cData;
+static uint64_t         i2cDoneAt;
+
+static uint32_t pwmPeriod;
+static uint32_t pwmWidth;
+static bool     pwmEnabled;
+
+static TimerType timers[TIMERS];
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t portIndex(uint32_t base)
+{
+    uint32_t i;
+
+    for (i = 0U; i < GPIO_PORTS; i++)
+    {
+        if (portBases[i] == base)
+        {
+            return i;
+        }
+    }
+
+    SIM_Fail("sim_board: no GPIO port at 0x%08x", base);
+    return 0U;
+}
+
+static TimerType *timerOf(uint32_t base)
+{
+    uint32_t i;
+
+    for (i = 0U; i < TIMERS; i++)
+    {
+        if (timers[i].base == base)
+        {
+            return &timers[i];
+        }
+    }
+
+    SIM_Fail("sim_board: no timer at 0x%08x", base);
+    return NULL;
+}
+
+static bool isClocked(uint32_t peripheral)
+{
+    uint32_t i;
+
+    for (i = 0U; i < periphCount; i++)
+    {
+        if (periphEnabled[i] == peripheral)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool timerCounts(const TimerType *t)
+{
+    uint32_t mode = t->config & 0xFFU;
+
+    return t->running && ((mode == (TIMER_CFG_A_PERIODIC & 0xFFU)) ||
+                          (mode == (TIMER_CFG_A_ONE_SHOT & 0xFFU)));
+}
+
+static uint64_t timerPeriod(const TimerType *t)
+{
+    return ((uint64_t)t->load + 1U) * ((uint64_t)t->prescale + 1U);
+}
+
+static void eepromSave(void)
+{
+    FILE *f;
+
+    if (eepromPath == NULL)
+    {
+        return;
+    }
+    f = fopen(eepromPath, "wb");
+    if (f != NULL)
+    {
+        (void)fwrite(eeprom, 1U, sizeof(eeprom), f);
+        (void)fclose(f);
+    }
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    periphCount = 0U;
+    memset(gpioDir, 0, sizeof(gpioDir));
+    memset(gpioData, 0, sizeof(gpioData));
+    memset(gpioInput, 0xFF, sizeof(gpioInput));
+    memset(gpioRis, 0, sizeof(gpioRis));
+    memset(gpioCommit, 0xFF, sizeof(gpioCommit));
+    memset(gpioUnlocked, 0, sizeof(gpioUnlocked));
+    gpioReadHook  = NULL;
+    gpioWriteHook = NULL;
+
+    adcSample = 0U;
+    adcBusy   = false;
+    adcRis    = 0U;
+    memset(adcRegs, 0, sizeof(adcRegs));
+
+    if (eepromPath == NULL)
+    {
+        memset(eeprom, 0xFF, sizeof(eeprom));
+    }
+
+    i2cHook   = NULL;
+    i2cDoneAt = 0U;
+
+    pwmPeriod  = 0U;
+    pwmWidth   = 0U;
+    pwmEnabled = false;
+
+    memset(timers, 0, sizeof(timers));
+    for (i = 0U; i < TIMERS; i++)
+    {
+        timers[i].base      = timerMap[i][0];
+        timers[i].intNumber = timerMap[i][1];
+        timers[i].load      = 0xFFFFFFFFU;
+    }
+}
+
+static uint64_t nextEvent(void)
+{
+    uint64_t  next = SIM_NEVER;
+    uint64_t  t;
+    uint32_t  i;
+
+    if (adcBusy)
+    {
+        next = adcDoneAt;
+    }
+
+    for (i = 0U; i < TIMERS; i++)
+    {
+        if (timerCounts(&timers[i]))
+        {
+            t = timers[i].startAt + timerPeriod(&timers[i]);
+            if (t < next)
+            {
+                next = t;
+            }
+        }
+    }
+
+    return next;
+}
+
+static void process(uint64_t now)
+{
+    TimerType *t;
+    uint32_t   i;
+
+    if (adcBusy && (adcDoneAt <= now))
+    {
+        adcBusy = false;
+        adcRis |= ADC_SS3;
+        adcRegs[SIM_REG_ADC0_SSFIFO3] = adcSample & 0xFFFU;
+    }
+
+    for (i = 0U; i < TIMERS; i++)
+    {
+        t = &timers[i];
+        while (timerCounts(t) && ((t->startAt + timerPeriod(t)) <= now))
+        {
+            t->startAt += timerPeriod(t);
+            t->ris |= TIMER_TIMA_TIMEOUT;
+            if ((t->config & 0xFFU) == (TIMER_CFG_A_ONE_SHOT & 0xFFU))
+            {
+                t->running = false;
+            }
+        }
+        SIM_SetIntLine(t->intNumber, (t->ris & t->im) != 0U);
+    }
+}
+
+/*======================================================================
+ *  Registers (ADC0, GPIO lock/commit)
+ *====================================================================*/
+
+static uint32_t adcRead(uint32_t key)
+{
+    switch ((SIM_RegIdType)key)
+    {
+        case SIM_REG_ADC0_RIS:
+            return adcRis;
+        case SIM_REG_ADC0_ISC:
+        case SIM_REG_ADC0_PSSI:
+            /* Interrupts are not used: masked status reads 0, and PSSI is
+             * write-only, so any write reaches the model */
+            return 0U;
+        default:
+            return adcRegs[key];
+    }
+}
+
+static void adcWrite(uint32_t key, uint32_t value)
+{
+    switch ((SIM_RegIdType)key)
+    {
+        case SIM_REG_ADC0_PSSI:
+            if (((value & ADC_SS3) != 0U) && ((adcRegs[SIM_REG_ADC0_ACTSS] & ADC_SS3) != 0U))
+            {
+                adcBusy   = true;
+                adcDoneAt = SIM_Now() + SIM_ADC_CONV_CYCLES;
+            }
+            break;
+        case SIM_REG_ADC0_ISC:
+            adcRis &= ~value;
+            break;
+        case SIM_REG_ADC0_RIS:
+        case SIM_REG_ADC0_SSFIFO3:
+            break;
+        default:
+            adcRegs[key] = value;
+            break;
+    }
+}
+
+static uint32_t gpioBusRead(uint32_t address)
+{
+    uint32_t port = portIndex(address & ~0xFFFU);
+
+    switch (address & 0xFFFU)
+    {
+        case GPIO_O_LOCK:
+            return gpioUnlocked[port] ? 0U : 1U;
+        case GPIO_O_CR:
+            return gpioCommit[port];
+        default:
+            return 0U;
+    }
+}
+
+static void gpioBusWrite(uint32_t address, uint32_t value)
+{
+    uint32_t port = portIndex(address & ~0xFFFU);
+
+    switch (address & 0xFFFU)
+    {
+        case GPIO_O_LOCK:
+            gpioUnlocked[port] = (value == GPIO_LOCK_KEY);
+            break;
+        case GPIO_O_CR:
+            if (!gpioUnlocked[port])
+            {
+                SIM_Fail("sim_board: GPIOCR written while locked");
+            }
+            gpioCommit[port] = (uint8_t)value;
+            break;
+        default:
+            break;
+    }
+}
+
+static const SIM_ModelType model = { "board", reset, nextEvent, process };
+
+static __attribute__((constructor)) void attach(void)
+{
+    uint32_t i;
+
+    SIM_AddModel(&model);
+    for (i = SIM_REG_ADC0_ACTSS; i <= SIM_REG_ADC0_ISC; i++)
+    {
+        SIM_MapReg((SIM_RegIdType)i, adcRead, adcWrite);
+    }
+    for (i = 0U; i < GPIO_PORTS; i++)
+    {
+        SIM_MapBus(portBases[i], 0x1000U, gpioBusRead, gpioBusWrite);
+    }
+}
+
+/*======================================================================
+ *  Test side
+ *====================================================================*/
+
+void SIM_GPIO_SetInput(uint32_t portBase, uint8_t pins, uint8_t levels)
+{
+    uint32_t port = portIndex(portBase);
+
+    gpioInput[port] = (uint8_t)((gpioInput[port] & ~pins) | (levels & pins));
+}
+
+uint8_t SIM_GPIO_GetOutput(uint32_t portBase)
+{
+    uint32_t port = portIndex(portBase);
+
+    return gpioData[port] & gpioDir[port];
+}
+
+void SIM_GPIO_SetReadHook(SIM_GPIO_ReadHookType hook)
+{
+    gpioReadHook = hook;
+}
+
+void SIM_GPIO_SetWriteHook(SIM_GPIO_WriteHookType hook)
+{
+    gpioWriteHook = hook;
+}
+
+void SIM_GPIO_Edge(uint32_t portBase, uint8_t pins)
+{
+    gpioRis[portIndex(portBase)] |= pins;
+    if (portBase == GPIO_PORTF_BASE)
+    {
+        SIM_PendInt(INT_GPIOF);
+    }
+}
+
+void SIM_ADC_SetSample(uint16_t sample)
+{
+    adcSample = sample;
+}
+
+void SIM_EEPROM_UseFile(const char *path)
+{
+    FILE *f;
+
+    eepromPath = path;
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    f = fopen(path, "rb");
+    if (f != NULL)
+    {
+        (void)fread(eeprom, 1U, sizeof(eeprom), f);
+        (void)fclose(f);
+    }
+}
+
+uint8_t *SIM_EEPROM_Data(void)
+{
+    return eeprom;
+}
+
+void SIM_I2C_SetHook(SIM_I2C_HookType hook)
+{
+    i2cHook = hook;
+}
+
+void SIM_PWM_Get(uint32_t *period, uint32_t *width, bool *enabled)
+{
+    *period  = pwmPeriod;
+    *width   = pwmWidth;
+    *enabled = pwmEnabled;
+}
+
+/*======================================================================
+ *  driverlib/sysctl.h
+ *====================================================================*/
+
+uint32_t SysCtlClockGet(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return SIM_CLOCK_HZ;
+}
+
+void SysCtlDelay(uint32_t ui32Count)
+{
+    SIM_Charge(3U * ui32Count);
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if (!isClocked(ui32Peripheral) && (periphCount < 32U))
+    {
+        periphEnabled[periphCount++] = ui32Peripheral;
+    }
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return isClocked(ui32Peripheral);
+}
+
+void SysCtlPWMClockSet(uint32_t ui32Config)
+{
+    (void)ui32Config;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+/*======================================================================
+ *  driverlib/gpio.h
+ *====================================================================*/
+
+void GPIODirModeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO)
+{
+    uint32_t port = portIndex(ui32Port);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if (ui32PinIO == GPIO_DIR_MODE_OUT)
+    {
+        gpioDir[port] |= ui8Pins;
+    }
+    else
+    {
+        gpioDir[port] &= (uint8_t)~ui8Pins;
+    }
+}
+
+void GPIOPadConfigSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength,
+                      uint32_t ui32PadType)
+{
+    (void)ui32Strength;
+    (void)ui32PadType;
+    (void)ui8Pins;
+    (void)portIndex(ui32Port);
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    uint32_t port = portIndex(ui32Port);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    gpioData[port] = (uint8_t)((gpioData[port] & ~ui8Pins) | (ui8Val & ui8Pins));
+    if (gpioWriteHook != NULL)
+    {
+        gpioWriteHook(ui32Port, ui8Pins, ui8Val & ui8Pins);
+    }
+}
+
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    uint32_t port = portIndex(ui32Port);
+    uint8_t  outputs;
+    uint8_t  inputs;
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    outputs = gpioData[port] & gpioDir[port];
+    inputs  = (gpioReadHook != NULL) ? gpioReadHook(ui32Port, outputs) : gpioInput[port];
+
+    return (int32_t)(((outputs) | (inputs & (uint8_t)~gpioDir[port])) & ui8Pins);
+}
+
+void GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+    (void)ui32PinConfig;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+static void pinTypeHw(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    uint32_t port = portIndex(ui32Port);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    gpioDir[port] &= (uint8_t)~ui8Pins;
+}
+
+void GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    pinTypeHw(ui32Port, ui8Pins);
+}
+
+void GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    pinTypeHw(ui32Port, ui8Pins);
+}
+
+void GPIOPinTypeI2C(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    pinTypeHw(ui32Port, ui8Pins);
+}
+
+void GPIOPinTypeI2CSCL(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    pinTypeHw(ui32Port, ui8Pins);
+}
+
+void GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    pinTypeHw(ui32Port, ui8Pins);
+}
+
+void GPIOIntClear(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    gpioRis[portIndex(ui32Port)] &= (uint8_t)~ui32IntFlags;
+}
+
+uint32_t GPIOIntStatus(uint32_t ui32Port, bool bMasked)
+{
+    (void)bMasked;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return gpioRis[portIndex(ui32Port)];
+}
+
+/*======================================================================
+ *  driverlib/eeprom.h
+ *====================================================================*/
+
+uint32_t EEPROMInit(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return EEPROM_INIT_OK;
+}
+
+uint32_t EEPROMSizeGet(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return SIM_EEPROM_SIZE;
+}
+
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count)
+{
+    if (((ui32Address | ui32Count) & 3U) != 0U)
+    {
+        SIM_Fail("sim_board: EEPROMRead needs word-aligned address and count");
+    }
+    if ((ui32Address + ui32Count) > SIM_EEPROM_SIZE)
+    {
+        SIM_Fail("sim_board: EEPROMRead past the end");
+    }
+
+    SIM_Charge(SIM_DRIVER_CYCLES + (ui32Count / 4U) * 4U);
+    memcpy(pui32Data, &eeprom[ui32Address], ui32Count);
+}
+
+uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count)
+{
+    if (((ui32Address | ui32Count) & 3U) != 0U)
+    {
+        SIM_Fail("sim_board: EEPROMProgram needs word-aligned address and count");
+    }
+    if ((ui32Address + ui32Count) > SIM_EEPROM_SIZE)
+    {
+        SIM_Fail("sim_board: EEPROMProgram past the end");
+    }
+
+    SIM_Charge(SIM_DRIVER_CYCLES + ((ui32Count / 4U) * SIM_EEPROM_WORD_CYCLES));
+    memcpy(&eeprom[ui32Address], pui32Data, ui32Count);
+    eepromSave();
+    return 0U;
+}
+
+uint32_t EEPROMMassErase(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES + ((SIM_EEPROM_SIZE / 4U) * SIM_EEPROM_WORD_CYCLES));
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    eepromSave();
+    return 0U;
+}
+
+uint32_t EEPROMStatusGet(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return 0U;
+}
+
+/*======================================================================
+ *  driverlib/i2c.h
+ *====================================================================*/
+
+void I2CMasterInitExpClk(uint32_t ui32Base, uint32_t ui32I2CClk, bool bFast)
+{
+    (void)ui32Base;
+    (void)ui32I2CClk;
+    (void)bFast;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+void I2CMasterSlaveAddrSet(uint32_t ui32Base, uint8_t ui8SlaveAddr, bool bReceive)
+{
+    (void)ui32Base;
+    (void)bReceive;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    i2cSlave = ui8SlaveAddr;
+}
+
+void I2CMasterDataPut(uint32_t ui32Base, uint8_t ui8Data)
+{
+    (void)ui32Base;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    i2cData = ui8Data;
+}
+
+void I2CMasterControl(uint32_t ui32Base, uint32_t ui32Cmd)
+{
+    (void)ui32Base;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if (ui32Cmd == I2C_MASTER_CMD_SINGLE_SEND)
+    {
+        /* Address and data byte on the wire */
+        i2cDoneAt = SIM_Now() + (2U * SIM_I2C_BYTE_CYCLES);
+        if (i2cHook != NULL)
+        {
+            i2cHook(i2cSlave, i2cData);
+        }
+    }
+}
+
+bool I2CMasterBusy(uint32_t ui32Base)
+{
+    (void)ui32Base;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return SIM_Now() < i2cDoneAt;
+}
+
+/*======================================================================
+ *  driverlib/pwm.h
+ *====================================================================*/
+
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config)
+{
+    (void)ui32Base;
+    (void)ui32Gen;
+    (void)ui32Config;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period)
+{
+    (void)ui32Base;
+    (void)ui32Gen;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    pwmPeriod = ui32Period;
+}
+
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width)
+{
+    (void)ui32Base;
+    (void)ui32PWMOut;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    pwmWidth = ui32Width;
+}
+
+void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable)
+{
+    (void)ui32Base;
+    (void)ui32PWMOutBits;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    pwmEnabled = bEnable;
+}
+
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    (void)ui32Base;
+    (void)ui32Gen;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+/*======================================================================
+ *  driverlib/timer.h
+ *====================================================================*/
+
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    t->config  = ui32Config & ~TIMER_CFG_SPLIT_PAIR;
+    t->running = false;
+}
+
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if (!t->running)
+    {
+        t->running = true;
+        t->startAt = SIM_Now();
+    }
+}
+
+void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    timerOf(ui32Base)->running = false;
+}
+
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    t->load    = ui32Value;
+    t->startAt = SIM_Now();
+}
+
+uint32_t TimerLoadGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return timerOf(ui32Base)->load;
+}
+
+void TimerMatchSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    timerOf(ui32Base)->match = ui32Value;
+}
+
+void TimerPrescaleSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    timerOf(ui32Base)->prescale = ui32Value & 0xFFFFU;
+}
+
+void TimerControlEvent(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Event)
+{
+    (void)ui32Base;
+    (void)ui32Timer;
+    (void)ui32Event;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+void TimerControlLevel(uint32_t ui32Base, uint32_t ui32Timer, bool bInvert)
+{
+    (void)ui32Base;
+    (void)ui32Timer;
+    (void)bInvert;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+uint32_t TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    TimerType *t = timerOf(ui32Base);
+    uint64_t   steps;
+
+    (void)ui32Timer;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if (!timerCounts(t))
+    {
+        return t->load;
+    }
+
+    steps = ((SIM_Now() - t->startAt) / ((uint64_t)t->prescale + 1U)) % ((uint64_t)t->load + 1U);
+    return (uint32_t)(t->load - steps);
+}
+
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    t->im |= ui32IntFlags;
+    SIM_SetIntLine(t->intNumber, (t->ris & t->im) != 0U);
+}
+
+void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    t->im &= ~ui32IntFlags;
+    SIM_SetIntLine(t->intNumber, (t->ris & t->im) != 0U);
+}
+
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return bMasked ? (t->ris & t->im) : t->ris;
+}
+
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    TimerType *t = timerOf(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    t->ris &= ~ui32IntFlags;
+    SIM_SetIntLine(t->intNumber, (t->ris & t->im) != 0U);
+}
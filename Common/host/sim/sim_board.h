@@ -0,0 +1,78 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_board.h
+ *  Description : The rest of the board: system control, GPIO, ADC0,
+ *                EEPROM, I2C0 master, PWM0 and the general-purpose timers
+ *
+ *  - SysCtlClockGet() is SIM_CLOCK_HZ; SysCtlDelay(n) takes 3n cycles.
+ *  - GPIO keeps port outputs; input levels come from the test, directly
+ *    or through a read hook (a keypad matrix depends on the driven rows).
+ *  - ADC0 sequencer 3: a PSSI trigger completes SIM_ADC_CONV_CYCLES later
+ *    with the sample the test set.
+ *  - EEPROM: 2 KB, erased to 0xFF, optionally kept in a file across runs;
+ *    programming costs SIM_EEPROM_WORD_CYCLES per word.
+ *  - I2C0 master: each single-byte send goes to a hook and keeps the
+ *    master busy for the 9 bit times at 100 kHz.
+ *  - Timers count down from LOAD through the prescaler and raise the
+ *    timeout interrupt at each wrap (periodic and one-shot); capture and
+ *    PWM configurations are stored only.
+ *===========================================================================*/
+
+#ifndef SIM_BOARD_H_
+#define SIM_BOARD_H_
+
+#include "sim.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_ADC_CONV_CYCLES     (32U)
+#define SIM_EEPROM_SIZE         (2048U)
+#define SIM_EEPROM_WORD_CYCLES  (30U * SIM_CYCLES_PER_US)
+#define SIM_I2C_BYTE_CYCLES     (9U * (SIM_CLOCK_HZ / 100000U))
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Input levels of a port given what it drives (bit per pin) */
+typedef uint8_t (*SIM_GPIO_ReadHookType)(uint32_t portBase, uint8_t outputs);
+
+/* Pins of a port were written */
+typedef void (*SIM_GPIO_WriteHookType)(uint32_t portBase, uint8_t pins, uint8_t value);
+
+/* A byte the I2C master sent to a slave */
+typedef void (*SIM_I2C_HookType)(uint8_t slaveAddr, uint8_t data);
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+void    SIM_GPIO_SetInput(uint32_t portBase, uint8_t pins, uint8_t levels);
+uint8_t SIM_GPIO_GetOutput(uint32_t portBase);
+void    SIM_GPIO_SetReadHook(SIM_GPIO_ReadHookType hook);
+void    SIM_GPIO_SetWriteHook(SIM_GPIO_WriteHookType hook);
+
+/**
+ * @brief Raise a port's edge interrupt for some pins (buttons).
+ */
+void    SIM_GPIO_Edge(uint32_t portBase, uint8_t pins);
+
+void    SIM_ADC_SetSample(uint16_t sample);
+
+/**
+ * @brief Keep the EEPROM in a file: loaded now, written back on every
+ *        program or erase.
+ */
+void     SIM_EEPROM_UseFile(const char *path);
+uint8_t *SIM_EEPROM_Data(void);
+
+void    SIM_I2C_SetHook(SIM_I2C_HookType hook);
+
+/**
+ * @brief Last PWM0 generator 0 setting (period and width in PWM clocks).
+ */
+void    SIM_PWM_Get(uint32_t *period, uint32_t *width, bool *enabled);
+
+#endif /* SIM_BOARD_H_ */
@@ -0,0 +1,656 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_core.c
+ *  Description : Cycle clock, NVIC, PRIMASK/WFI, register staging and the
+ *                function-entry hook that drives them
+ *===========================================================================*/
+
+#include "sim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_MAX_BUS_RANGES      (24U)
+#define SIM_HW_SLOTS            (8U)
+
+/* A model still due after this many passes at one instant is stuck */
+#define SIM_MAX_PASSES          (100000U)
+
+#define SIM_NO_INSTRUMENT       __attribute__((no_instrument_function))
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+/* A register handed out to the firmware: the model's value at the read,
+ * and the word the firmware may have written since */
+typedef struct
+{
+    bool              valid;
+    uint32_t          key;
+    uint32_t          readValue;
+    volatile uint32_t word;
+    SIM_WriteType     write;
+} StageType;
+
+typedef struct
+{
+    uint32_t      base;
+    uint32_t      size;
+    SIM_ReadType  read;
+    SIM_WriteType write;
+} BusRangeType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint64_t now = 0U;
+static uint64_t limit = SIM_NEVER;
+
+static const SIM_ModelType *models[SIM_MAX_MODELS];
+static uint32_t modelCount = 0U;
+
+static uint8_t intEnabled[NUM_INTERRUPTS];
+static uint8_t intPending[NUM_INTERRUPTS];
+static uint8_t intLine[NUM_INTERRUPTS];
+static bool    primask = false;
+static bool    inIsr = false;
+
+static SIM_StatsType stats;
+
+/* Real-time mode: model cycle and wall clock (ns) at SIM_SetRealtime() */
+static bool     realtime = false;
+static uint64_t paceBaseCycle;
+static uint64_t paceBaseNs;
+static uint64_t paceNext;
+static bool   (*wakeHook)(void);
+
+static SIM_ReadType  regRead[SIM_REG_COUNT];
+static SIM_WriteType regWrite[SIM_REG_COUNT];
+static StageType     regStage[SIM_REG_COUNT];
+
+static BusRangeType busRanges[SIM_MAX_BUS_RANGES];
+static uint32_t     busRangeCount = 0U;
+static StageType    hwStage[SIM_HW_SLOTS];
+static uint32_t     hwNext = 0U;
+
+/*======================================================================
+ *  Vector table
+ *
+ *  Same handler names as startup_ewarm.c; weak so that a test links only
+ *  the drivers it needs.
+ *====================================================================*/
+
+extern void systick_ISR(void) __attribute__((weak));
+extern void PORTF_Handler(void) __attribute__((weak));
+extern void UART0_Handler(void) __attribute__((weak));
+extern void UART1_Handler(void) __attribute__((weak));
+extern void UART2_Handler(void) __attribute__((weak));
+extern void UART3_Handler(void) __attribute__((weak));
+extern void UART4_Handler(void) __attribute__((weak));
+extern void UART5_Handler(void) __attribute__((weak));
+extern void UART6_Handler(void) __attribute__((weak));
+extern void UART7_Handler(void) __attribute__((weak));
+extern void uDMA_Error_Handler(void) __attribute__((weak));
+extern void Timer0A_Handler(void) __attribute__((weak));
+extern void WTimer0A_Handler(void) __attribute__((weak));
+extern void WTimer2A_Handler(void) __attribute__((weak));
+
+typedef void (*VectorType)(void);
+
+static VectorType vectors[NUM_INTERRUPTS];
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static SIM_NO_INSTRUMENT void installVectors(void)
+{
+    memset(vectors, 0, sizeof(vectors));
+    vectors[FAULT_SYSTICK] = systick_ISR;
+    vectors[INT_GPIOF]     = PORTF_Handler;
+    vectors[INT_UART0]     = UART0_Handler;
+    vectors[INT_UART1]     = UART1_Handler;
+    vectors[INT_UART2]     = UART2_Handler;
+    vectors[INT_UART3]     = UART3_Handler;
+    vectors[INT_UART4]     = UART4_Handler;
+    vectors[INT_UART5]     = UART5_Handler;
+    vectors[INT_UART6]     = UART6_Handler;
+    vectors[INT_UART7]     = UART7_Handler;
+    vectors[INT_UDMAERR]   = uDMA_Error_Handler;
+    vectors[INT_TIMER0A]   = Timer0A_Handler;
+    vectors[INT_WTIMER0A]  = WTimer0A_Handler;
+    vectors[INT_WTIMER2A]  = WTimer2A_Handler;
+}
+
+/* Hand staged register writes to their models */
+static SIM_NO_INSTRUMENT void commitStage(StageType *stage)
+{
+    if (stage->valid)
+    {
+        stage->valid = false;
+        if ((stage->word != stage->readValue) && (stage->write != NULL))
+        {
+            stage->write(stage->key, stage->word);
+        }
+    }
+}
+
+static SIM_NO_INSTRUMENT void commitAll(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < SIM_REG_COUNT; i++)
+    {
+        commitStage(&regStage[i]);
+    }
+    for (i = 0U; i < SIM_HW_SLOTS; i++)
+    {
+        commitStage(&hwStage[i]);
+    }
+}
+
+static SIM_NO_INSTRUMENT uint64_t nextEvent(void)
+{
+    uint64_t next = SIM_NEVER;
+    uint64_t t;
+    uint32_t i;
+
+    for (i = 0U; i < modelCount; i++)
+    {
+        t = models[i]->nextEvent();
+        if (t < next)
+        {
+            next = t;
+        }
+    }
+
+    return next;
+}
+
+static SIM_NO_INSTRUMENT void processModels(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < modelCount; i++)
+    {
+        models[i]->process(now);
+    }
+}
+
+static SIM_NO_INSTRUMENT bool isActive(uint32_t n)
+{
+    return ((intPending[n] != 0U) || (intLine[n] != 0U)) && (intEnabled[n] != 0U);
+}
+
+/* Highest-priority active interrupt: SysTick, then by number */
+static SIM_NO_INSTRUMENT int32_t nextActive(void)
+{
+    uint32_t n;
+
+    for (n = FAULT_SYSTICK; n < NUM_INTERRUPTS; n++)
+    {
+        if (isActive(n))
+        {
+            return (int32_t)n;
+        }
+    }
+
+    return -1;
+}
+
+static SIM_NO_INSTRUMENT uint64_t wallNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* Sleep until the wall clock has caught up with model time */
+static SIM_NO_INSTRUMENT void pace(void)
+{
+    uint64_t modelNs = ((now - paceBaseCycle) * 1000ULL) / SIM_CYCLES_PER_US;
+    uint64_t wall    = wallNs() - paceBaseNs;
+    struct timespec ts;
+
+    if (modelNs > wall)
+    {
+        ts.tv_sec  = (time_t)((modelNs - wall) / 1000000000ULL);
+        ts.tv_nsec = (long)((modelNs - wall) % 1000000000ULL);
+        (void)nanosleep(&ts, NULL);
+    }
+    paceNext = now + SIM_PACE_CYCLES;
+}
+
+static void advanceTo(uint64_t target);
+
+static SIM_NO_INSTRUMENT void takeInterrupts(void)
+{
+    int32_t  n;
+    uint64_t start;
+
+    while (!primask && !inIsr && ((n = nextActive()) >= 0))
+    {
+        intPending[n] = 0U;
+        stats.isrCount[n]++;
+        start = now;
+        inIsr = true;
+
+        advanceTo(now + (SIM_ISR_CYCLES / 2U));
+        if (vectors[n] != NULL)
+        {
+            vectors[n]();
+        }
+        advanceTo(now + (SIM_ISR_CYCLES / 2U));
+
+        inIsr = false;
+        stats.isrCycles += now - start;
+    }
+}
+
+/* Move the clock to target, applying model events on the way and taking
+ * interrupts as they become pending */
+static SIM_NO_INSTRUMENT void advanceTo(uint64_t target)
+{
+    uint64_t next;
+    uint32_t passes = 0U;
+    uint64_t lastAt = SIM_NEVER;
+
+    commitAll();
+
+    for (;;)
+    {
+        takeInterrupts();
+
+        next = nextEvent();
+        if ((next > target) || (next == SIM_NEVER))
+        {
+            break;
+        }
+        if (next > now)
+        {
+            now = next;
+        }
+
+        passes = (now == lastAt) ? (passes + 1U) : 0U;
+        lastAt = now;
+        if (passes > SIM_MAX_PASSES)
+        {
+            SIM_Fail("sim: a model keeps an event due at cycle %llu",
+                     (unsigned long long)now);
+        }
+        processModels();
+    }
+
+    if (target > now)
+    {
+        now = target;
+    }
+    if (realtime && (now >= paceNext))
+    {
+        pace();
+    }
+    if (now > limit)
+    {
+        SIM_Fail("sim: time limit reached at %.3f ms (firmware stuck?)",
+                 (double)now / SIM_CYCLES_PER_MS);
+    }
+}
+
+static SIM_NO_INSTRUMENT const BusRangeType *findBus(uint32_t address)
+{
+    uint32_t i;
+
+    for (i = 0U; i < busRangeCount; i++)
+    {
+        if ((address >= busRanges[i].base) &&
+            ((address - busRanges[i].base) < busRanges[i].size))
+        {
+            return &busRanges[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*======================================================================
+ *  Core
+ *====================================================================*/
+
+SIM_NO_INSTRUMENT void SIM_Init(void)
+{
+    uint32_t i;
+
+    now     = 0U;
+    limit   = SIM_NEVER;
+    primask = false;
+    inIsr   = false;
+    memset(intEnabled, 0, sizeof(intEnabled));
+    memset(intPending, 0, sizeof(intPending));
+    memset(intLine, 0, sizeof(intLine));
+    memset(&stats, 0, sizeof(stats));
+    memset(regStage, 0, sizeof(regStage));
+    memset(hwStage, 0, sizeof(hwStage));
+
+    /* System exceptions cannot be disabled in the NVIC */
+    intEnabled[FAULT_SYSTICK] = 1U;
+
+    installVectors();
+
+    for (i = 0U; i < modelCount; i++)
+    {
+        models[i]->reset();
+    }
+}
+
+SIM_NO_INSTRUMENT void SIM_AddModel(const SIM_ModelType *model)
+{
+    if (modelCount >= SIM_MAX_MODELS)
+    {
+        SIM_Fail("sim: too many models (%s)", model->name);
+    }
+    models[modelCount++] = model;
+}
+
+SIM_NO_INSTRUMENT uint64_t SIM_Now(void)
+{
+    return now;
+}
+
+SIM_NO_INSTRUMENT void SIM_Run(uint64_t cycles)
+{
+    advanceTo(now + cycles);
+}
+
+SIM_NO_INSTRUMENT void SIM_Charge(uint32_t cycles)
+{
+    advanceTo(now + cycles);
+}
+
+SIM_NO_INSTRUMENT void SIM_SetLimit(uint64_t cycle)
+{
+    limit = cycle;
+}
+
+SIM_NO_INSTRUMENT void SIM_Fail(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+SIM_NO_INSTRUMENT void SIM_GetStats(SIM_StatsType *out)
+{
+    *out = stats;
+}
+
+SIM_NO_INSTRUMENT void SIM_SetRealtime(bool enable)
+{
+    realtime      = enable;
+    paceBaseCycle = now;
+    paceBaseNs    = wallNs();
+    paceNext      = now + SIM_PACE_CYCLES;
+}
+
+SIM_NO_INSTRUMENT void SIM_SetWakeHook(bool (*hook)(void))
+{
+    wakeHook = hook;
+}
+
+/*======================================================================
+ *  NVIC
+ *====================================================================*/
+
+SIM_NO_INSTRUMENT void SIM_PendInt(uint32_t intNumber)
+{
+    if (intNumber < NUM_INTERRUPTS)
+    {
+        intPending[intNumber] = 1U;
+    }
+}
+
+SIM_NO_INSTRUMENT void SIM_SetIntLine(uint32_t intNumber, bool level)
+{
+    if (intNumber < NUM_INTERRUPTS)
+    {
+        intLine[intNumber] = level ? 1U : 0U;
+    }
+}
+
+SIM_NO_INSTRUMENT bool SIM_IsIntPending(uint32_t intNumber)
+{
+    return (intNumber < NUM_INTERRUPTS) &&
+           ((intPending[intNumber] != 0U) || (intLine[intNumber] != 0U));
+}
+
+/*======================================================================
+ *  Registers and bus
+ *====================================================================*/
+
+SIM_NO_INSTRUMENT void SIM_MapReg(SIM_RegIdType id, SIM_ReadType read, SIM_WriteType write)
+{
+    regRead[id]  = read;
+    regWrite[id] = write;
+}
+
+SIM_NO_INSTRUMENT void SIM_MapBus(uint32_t base, uint32_t size, SIM_ReadType read,
+                                  SIM_WriteType write)
+{
+    if (busRangeCount >= SIM_MAX_BUS_RANGES)
+    {
+        SIM_Fail("sim: too many bus ranges");
+    }
+    busRanges[busRangeCount].base  = base;
+    busRanges[busRangeCount].size  = size;
+    busRanges[busRangeCount].read  = read;
+    busRanges[busRangeCount].write = write;
+    busRangeCount++;
+}
+
+SIM_NO_INSTRUMENT bool SIM_BusRead(uint32_t address, uint32_t *value)
+{
+    const BusRangeType *range = findBus(address);
+
+    if ((range == NULL) || (range->read == NULL))
+    {
+        return false;
+    }
+    *value = range->read(address);
+    return true;
+}
+
+SIM_NO_INSTRUMENT bool SIM_BusWrite(uint32_t address, uint32_t value)
+{
+    const BusRangeType *range = findBus(address);
+
+    if ((range == NULL) || (range->write == NULL))
+    {
+        return false;
+    }
+    range->write(address, value);
+    return true;
+}
+
+/* Register accesses cost a bus cycle; the previous one is committed first,
+ * so a write followed by a read of the same register sees the write */
+SIM_NO_INSTRUMENT volatile uint32_t *SIM_Reg(SIM_RegIdType id)
+{
+    StageType *stage = &regStage[id];
+
+    advanceTo(now + 1U);
+
+    stage->valid     = true;
+    stage->key       = (uint32_t)id;
+    stage->readValue = (regRead[id] != NULL) ? regRead[id]((uint32_t)id) : 0U;
+    stage->word      = stage->readValue;
+    stage->write     = regWrite[id];
+
+    return &stage->word;
+}
+
+SIM_NO_INSTRUMENT volatile uint32_t *SIM_HwReg(uint32_t address)
+{
+    const BusRangeType *range;
+    StageType          *stage;
+
+    advanceTo(now + 1U);
+
+    range = findBus(address);
+    stage = &hwStage[hwNext];
+    hwNext = (hwNext + 1U) % SIM_HW_SLOTS;
+
+    stage->valid     = true;
+    stage->key       = address;
+    stage->readValue = ((range != NULL) && (range->read != NULL)) ? range->read(address) : 0U;
+    stage->word      = stage->readValue;
+    stage->write     = (range != NULL) ? range->write : NULL;
+
+    return &stage->word;
+}
+
+/*======================================================================
+ *  CPU and interrupt controller (driverlib/cpu.h, interrupt.h)
+ *====================================================================*/
+
+SIM_NO_INSTRUMENT uint32_t CPUcpsid(void)
+{
+    uint32_t was = primask ? 1U : 0U;
+
+    advanceTo(now + 1U);
+    primask = true;
+    return was;
+}
+
+SIM_NO_INSTRUMENT uint32_t CPUcpsie(void)
+{
+    uint32_t was = primask ? 1U : 0U;
+
+    primask = false;
+    advanceTo(now + 1U);
+    return was;
+}
+
+SIM_NO_INSTRUMENT uint32_t CPUprimask(void)
+{
+    return primask ? 1U : 0U;
+}
+
+SIM_NO_INSTRUMENT void CPUwfi(void)
+{
+    uint64_t next;
+
+    commitAll();
+
+    /* Wakes on any pending, enabled interrupt, even with PRIMASK set */
+    while (nextActive() < 0)
+    {
+        next = nextEvent();
+        if (realtime)
+        {
+            /* Sleep in steps, so outside input can wake the core */
+            if ((next == SIM_NEVER) || (next > (now + SIM_PACE_CYCLES)))
+            {
+                next = now + SIM_PACE_CYCLES;
+            }
+        }
+        else if (next == SIM_NEVER)
+        {
+            SIM_Fail("sim: WFI with nothing left to wake the core");
+        }
+        if (next > now)
+        {
+            stats.sleepCycles += next - now;
+            now = next;
+        }
+        processModels();
+
+        if (realtime)
+        {
+            pace();
+            if ((wakeHook != NULL) && wakeHook())
+            {
+                break;
+            }
+        }
+    }
+
+    advanceTo(now + 1U);
+}
+
+SIM_NO_INSTRUMENT void IntEnable(uint32_t ui32Interrupt)
+{
+    if (ui32Interrupt < NUM_INTERRUPTS)
+    {
+        intEnabled[ui32Interrupt] = 1U;
+    }
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+SIM_NO_INSTRUMENT void IntDisable(uint32_t ui32Interrupt)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if ((ui32Interrupt < NUM_INTERRUPTS) && (ui32Interrupt != FAULT_SYSTICK))
+    {
+        intEnabled[ui32Interrupt] = 0U;
+    }
+}
+
+SIM_NO_INSTRUMENT uint32_t IntIsEnabled(uint32_t ui32Interrupt)
+{
+    return (ui32Interrupt < NUM_INTERRUPTS) ? intEnabled[ui32Interrupt] : 0U;
+}
+
+SIM_NO_INSTRUMENT void IntPendSet(uint32_t ui32Interrupt)
+{
+    SIM_PendInt(ui32Interrupt);
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+SIM_NO_INSTRUMENT void IntPendClear(uint32_t ui32Interrupt)
+{
+    if (ui32Interrupt < NUM_INTERRUPTS)
+    {
+        intPending[ui32Interrupt] = 0U;
+    }
+}
+
+SIM_NO_INSTRUMENT bool IntMasterEnable(void)
+{
+    return CPUcpsie() != 0U;
+}
+
+SIM_NO_INSTRUMENT bool IntMasterDisable(void)
+{
+    return CPUcpsid() != 0U;
+}
+
+/*======================================================================
+ *  Function-entry hook (-finstrument-functions)
+ *====================================================================*/
+
+SIM_NO_INSTRUMENT void __cyg_profile_func_enter(void *fn, void *site)
+{
+    (void)fn;
+    (void)site;
+    stats.calls++;
+    advanceTo(now + SIM_CALL_CYCLES);
+}
+
+SIM_NO_INSTRUMENT void __cyg_profile_func_exit(void *fn, void *site)
+{
+    (void)fn;
+    (void)site;
+}
@@ -0,0 +1,272 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_systick.c
+ *  Description : SysTick timer model (driverlib/systick.h and the
+ *                NVIC_ST_* / NVIC_INT_CTRL registers)
+ *
+ *  ARMv7-M behaviour the tickless sleep depends on:
+ *  - the counter counts down one per core cycle; on the clock after it
+ *    reaches 0 it reloads from RELOAD, and reaching 0 by counting (not by
+ *    a write) sets COUNTFLAG and pends the exception if TICKINT is set;
+ *  - a write to CURRENT clears it to 0 without pending anything, so the
+ *    counter reloads on the next clock;
+ *  - a RELOAD of 0 stops the counter at 0 once it gets there.
+ *===========================================================================*/
+
+#include "sim.h"
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static bool     running;        /* CTRL.ENABLE */
+static bool     tickInt;        /* CTRL.TICKINT */
+static bool     countFlag;
+static uint32_t reload;         /* 24-bit RELOAD */
+
+/* Counter state: loadValue at cycle loadAt, counting down from there */
+static uint64_t loadAt;
+static uint32_t loadValue;
+static bool     zeroDone;       /* This period's 0 has been handled */
+static bool     stalled;        /* At 0 with RELOAD 0 */
+static uint32_t frozen;         /* Counter value while disabled */
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t currentValue(void)
+{
+    uint64_t elapsed;
+
+    if (!running)
+    {
+        return frozen;
+    }
+
+    elapsed = SIM_Now() - loadAt;
+    return (elapsed >= loadValue) ? 0U : (uint32_t)(loadValue - elapsed);
+}
+
+/* Counter at 0 now (written, enabled at 0, or a new RELOAD while
+ * stalled): reloads on the next clock, no interrupt */
+static void restartFromZero(void)
+{
+    loadAt    = SIM_Now();
+    loadValue = 0U;
+    zeroDone  = true;
+    stalled   = false;
+}
+
+static void reset(void)
+{
+    running   = false;
+    tickInt   = false;
+    countFlag = false;
+    reload    = 0U;
+    frozen    = 0U;
+    loadAt    = 0U;
+    loadValue = 0U;
+    zeroDone  = true;
+    stalled   = false;
+}
+
+static uint64_t nextEvent(void)
+{
+    if (!running || stalled)
+    {
+        return SIM_NEVER;
+    }
+
+    return zeroDone ? (loadAt + loadValue + 1U) : (loadAt + loadValue);
+}
+
+static void process(uint64_t now)
+{
+    while (running && !stalled)
+    {
+        if (!zeroDone)
+        {
+            if ((loadAt + loadValue) > now)
+            {
+                break;
+            }
+            zeroDone  = true;
+            countFlag = true;
+            if (tickInt)
+            {
+                SIM_PendInt(FAULT_SYSTICK);
+            }
+        }
+        else
+        {
+            if ((loadAt + loadValue + 1U) > now)
+            {
+                break;
+            }
+            loadAt    = loadAt + loadValue + 1U;
+            loadValue = reload;
+            if (reload == 0U)
+            {
+                stalled = true;
+            }
+            else
+            {
+                zeroDone = false;
+            }
+        }
+    }
+}
+
+static void setEnabled(bool enable)
+{
+    if (enable && !running)
+    {
+        running   = true;
+        loadAt    = SIM_Now();
+        loadValue = frozen;
+        zeroDone  = (frozen == 0U);
+        stalled   = false;
+    }
+    else if (!enable && running)
+    {
+        frozen  = currentValue();
+        running = false;
+    }
+}
+
+static void setReload(uint32_t value)
+{
+    reload = value & 0x00FFFFFFU;
+    if (running && stalled && (reload != 0U))
+    {
+        restartFromZero();
+    }
+}
+
+/*======================================================================
+ *  Registers
+ *====================================================================*/
+
+static uint32_t readReg(uint32_t key)
+{
+    uint32_t value = 0U;
+
+    switch ((SIM_RegIdType)key)
+    {
+        case SIM_REG_ST_CTRL:
+            value = NVIC_ST_CTRL_CLK_SRC |
+                    (running ? NVIC_ST_CTRL_ENABLE : 0U) |
+                    (tickInt ? NVIC_ST_CTRL_INTEN : 0U) |
+                    (countFlag ? NVIC_ST_CTRL_COUNT : 0U);
+            countFlag = false;
+            break;
+        case SIM_REG_ST_RELOAD:
+            value = reload;
+            break;
+        case SIM_REG_ST_CURRENT:
+            value = currentValue();
+            break;
+        case SIM_REG_INT_CTRL:
+            value = SIM_IsIntPending(FAULT_SYSTICK) ? NVIC_INT_CTRL_PEND_SYST : 0U;
+            break;
+        default:
+            break;
+    }
+
+    return value;
+}
+
+static void writeReg(uint32_t key, uint32_t value)
+{
+    switch ((SIM_RegIdType)key)
+    {
+        case SIM_REG_ST_CTRL:
+            tickInt = ((value & NVIC_ST_CTRL_INTEN) != 0U);
+            setEnabled((value & NVIC_ST_CTRL_ENABLE) != 0U);
+            break;
+        case SIM_REG_ST_RELOAD:
+            setReload(value);
+            break;
+        case SIM_REG_ST_CURRENT:
+            countFlag = false;
+            if (running)
+            {
+                restartFromZero();
+            }
+            else
+            {
+                frozen = 0U;
+            }
+            break;
+        case SIM_REG_INT_CTRL:
+            if ((value & NVIC_INT_CTRL_PENDSTCLR) != 0U)
+            {
+                IntPendClear(FAULT_SYSTICK);
+            }
+            else if ((value & NVIC_INT_CTRL_PEND_SYST) != 0U)
+            {
+                SIM_PendInt(FAULT_SYSTICK);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static const SIM_ModelType model = { "systick", reset, nextEvent, process };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&model);
+    SIM_MapReg(SIM_REG_ST_CTRL, readReg, writeReg);
+    SIM_MapReg(SIM_REG_ST_RELOAD, readReg, writeReg);
+    SIM_MapReg(SIM_REG_ST_CURRENT, readReg, writeReg);
+    SIM_MapReg(SIM_REG_INT_CTRL, readReg, writeReg);
+}
+
+/*======================================================================
+ *  driverlib/systick.h
+ *====================================================================*/
+
+void SysTickEnable(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    setEnabled(true);
+}
+
+void SysTickDisable(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    setEnabled(false);
+}
+
+void SysTickIntEnable(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    tickInt = true;
+}
+
+void SysTickIntDisable(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    tickInt = false;
+}
+
+void SysTickPeriodSet(uint32_t ui32Period)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    setReload(ui32Period - 1U);
+}
+
+uint32_t SysTickPeriodGet(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return reload + 1U;
+}
+
+uint32_t SysTickValueGet(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return currentValue();
+}
@@ -0,0 +1,873 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_uart.c
+ *  Description : UART0-UART7 model (driverlib/uart.h and the UART register
+ *                block on the bus, for the uDMA)
+ *===========================================================================*/
+
+#include "sim_uart.h"
+#include "sim_udma.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define FR_TXFE                 (0x80U)
+#define FR_RXFF                 (0x40U)
+#define FR_TXFF                 (0x20U)
+#define FR_RXFE                 (0x10U)
+#define FR_BUSY                 (0x08U)
+#define FR_CTS                  (0x01U)
+
+#define RX_ERROR_BITS           (UART_DR_OE | UART_DR_BE | UART_DR_PE | UART_DR_FE)
+
+/* Receive timeout: 32 bit periods without a new character */
+#define RT_BITS                 (32U)
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef struct
+{
+    uint32_t base;
+    uint32_t intNumber;
+    uint32_t rxAssign;
+    uint32_t txAssign;
+
+    bool     enabled;
+    uint32_t baud;              /* Actual rate after divisor rounding */
+    uint32_t config;            /* UART_CONFIG_* */
+    uint32_t frameCycles;
+    uint32_t bitCycles;
+
+    uint32_t im;
+    uint32_t ris;
+    uint8_t  txLevel;           /* Interrupt trigger levels in entries */
+    uint8_t  rxLevel;
+    bool     eotMode;
+    uint32_t flow;              /* UART_FLOWCONTROL_* */
+    uint32_t dma;               /* UART_DMA_* */
+    uint32_t rsr;               /* Errors of the last character read */
+
+    uint16_t rxFifo[SIM_UART_FIFO_DEPTH];
+    uint8_t  rxHead;
+    uint8_t  rxCount;
+    uint16_t rxNextErr;         /* OE carried by the next stored character */
+    uint64_t lastRxAt;
+    bool     rtArmed;
+
+    uint8_t  txFifo[SIM_UART_FIFO_DEPTH];
+    uint8_t  txHead;
+    uint8_t  txCount;
+    bool     shiftBusy;
+    uint8_t  shiftData;
+    uint64_t shiftDoneAt;
+    bool     ctsWaiting;
+
+    int8_t                 peer;
+    SIM_UART_TxHookType    hook;
+    SIM_UART_NoiseHookType noise;
+    bool                   ctsInput;
+
+    uint8_t  *injData;
+    uint64_t *injAt;
+    uint32_t  injCap;
+    uint32_t  injHead;
+    uint32_t  injCount;
+    uint32_t  injBaud;
+    bool      injHonourRts;
+    bool      injBusy;
+    uint64_t  injDoneAt;
+
+    bool      rtsWasReady;
+    uint64_t  rtsHeldSince;
+
+    SIM_UART_StatsType stats;
+} UartType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static const uint32_t uartMap[SIM_UART_COUNT][4] = {
+    { UART0_BASE, INT_UART0, UDMA_CH8_UART0RX,  UDMA_CH9_UART0TX  },
+    { UART1_BASE, INT_UART1, UDMA_CH22_UART1RX, UDMA_CH23_UART1TX },
+    { UART2_BASE, INT_UART2, UDMA_CH12_UART2RX, UDMA_CH13_UART2TX },
+    { UART3_BASE, INT_UART3, UDMA_CH16_UART3RX, UDMA_CH17_UART3TX },
+    { UART4_BASE, INT_UART4, UDMA_CH18_UART4RX, UDMA_CH19_UART4TX },
+    { UART5_BASE, INT_UART5, UDMA_CH6_UART5RX,  UDMA_CH7_UART5TX  },
+    { UART6_BASE, INT_UART6, UDMA_CH10_UART6RX, UDMA_CH11_UART6TX },
+    { UART7_BASE, INT_UART7, UDMA_CH20_UART7RX, UDMA_CH21_UART7TX }
+};
+
+/* FIFO trigger levels in entries for the 1/8 .. 7/8 selections */
+static const uint8_t fifoLevels[5] = { 2U, 4U, 8U, 12U, 14U };
+
+static UartType uarts[SIM_UART_COUNT];
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static UartType *fromBase(uint32_t base)
+{
+    uint32_t index = (base - UART0_BASE) >> 12;
+
+    if ((base < UART0_BASE) || (index >= SIM_UART_COUNT))
+    {
+        SIM_Fail("sim_uart: no UART at 0x%08x", base);
+    }
+
+    return &uarts[index];
+}
+
+static uint8_t indexOf(const UartType *u)
+{
+    return (uint8_t)(u - uarts);
+}
+
+static uint32_t frameBits(uint32_t config)
+{
+    uint32_t bits = 1U + 5U + ((config & UART_CONFIG_WLEN_MASK) >> 5);
+
+    bits += ((config & UART_CONFIG_PAR_MASK) != 0U) ? 1U : 0U;
+    bits += ((config & UART_CONFIG_STOP_MASK) != 0U) ? 2U : 1U;
+
+    return bits;
+}
+
+static uint32_t cyclesFor(uint32_t baud, uint32_t bits)
+{
+    return (uint32_t)((((uint64_t)SIM_CLOCK_HZ * bits) + (baud / 2U)) / baud);
+}
+
+static bool rtsReady(const UartType *u)
+{
+    return ((u->flow & UART_FLOWCONTROL_RX) == 0U) || (u->rxCount < u->rxLevel);
+}
+
+static bool ctsReady(const UartType *u)
+{
+    if ((u->flow & UART_FLOWCONTROL_TX) == 0U)
+    {
+        return true;
+    }
+
+    return (u->peer >= 0) ? rtsReady(&uarts[u->peer]) : u->ctsInput;
+}
+
+static bool baudMatches(uint32_t a, uint32_t b)
+{
+    uint32_t diff = (a > b) ? (a - b) : (b - a);
+
+    return ((uint64_t)diff * 100U) <= ((uint64_t)b * SIM_UART_BAUD_TOLERANCE);
+}
+
+static void updateLine(UartType *u)
+{
+    bool ready = rtsReady(u);
+
+    if (ready != u->rtsWasReady)
+    {
+        if (ready)
+        {
+            u->stats.rtsHeldCycles += SIM_Now() - u->rtsHeldSince;
+        }
+        else
+        {
+            u->rtsHeldSince = SIM_Now();
+        }
+        u->rtsWasReady = ready;
+    }
+
+    SIM_SetIntLine(u->intNumber, (u->ris & u->im) != 0U);
+}
+
+/* A character arrives on u's RX line */
+static void receiveChar(UartType *u, uint8_t data, uint32_t baud, uint32_t config)
+{
+    uint16_t entry = data;
+
+    u->stats.rxBytes++;
+    if (!u->enabled)
+    {
+        u->stats.rxIgnored++;
+        return;
+    }
+
+    if (!baudMatches(baud, u->baud) || (frameBits(config) != frameBits(u->config)))
+    {
+        /* Sampled at the wrong bit boundaries: garbage, no valid stop bit */
+        entry = (uint16_t)(((uint8_t)((data * 7U) + 1U)) | UART_DR_FE);
+        u->ris |= UART_INT_FE;
+        u->stats.rxFramingErrors++;
+    }
+
+    if (u->rxCount >= SIM_UART_FIFO_DEPTH)
+    {
+        u->stats.rxOverruns++;
+        u->rxNextErr |= UART_DR_OE;
+        u->ris |= UART_INT_OE;
+        return;
+    }
+
+    entry |= u->rxNextErr;
+    u->rxNextErr = 0U;
+    u->rxFifo[(u->rxHead + u->rxCount) % SIM_UART_FIFO_DEPTH] = entry;
+    u->rxCount++;
+    if (u->rxCount > u->stats.rxFifoMax)
+    {
+        u->stats.rxFifoMax = u->rxCount;
+    }
+    if (u->rxCount == u->rxLevel)
+    {
+        u->ris |= UART_INT_RX;
+    }
+    u->lastRxAt = SIM_Now();
+    u->rtArmed  = true;
+}
+
+static int32_t popRx(UartType *u)
+{
+    uint16_t entry;
+
+    if (u->rxCount == 0U)
+    {
+        return -1;
+    }
+
+    entry = u->rxFifo[u->rxHead];
+    u->rxHead = (uint8_t)((u->rxHead + 1U) % SIM_UART_FIFO_DEPTH);
+    u->rxCount--;
+    u->rsr = (entry & RX_ERROR_BITS) >> 8;
+
+    if (u->rxCount < u->rxLevel)
+    {
+        u->ris &= ~UART_INT_RX;
+    }
+    if (u->rxCount == 0U)
+    {
+        u->ris &= ~UART_INT_RT;
+        u->rtArmed = false;
+    }
+
+    return (int32_t)entry;
+}
+
+static bool pushTx(UartType *u, uint8_t data)
+{
+    if (u->txCount >= SIM_UART_FIFO_DEPTH)
+    {
+        return false;
+    }
+
+    u->txFifo[(u->txHead + u->txCount) % SIM_UART_FIFO_DEPTH] = data;
+    u->txCount++;
+    return true;
+}
+
+static void service(UartType *u);
+
+/* u's transmitter finished a character */
+static void deliver(UartType *u, uint8_t data)
+{
+    u->stats.txBytes++;
+
+    if (u->noise != NULL)
+    {
+        data = u->noise(indexOf(u), data, u->baud);
+    }
+
+    if (u->peer >= 0)
+    {
+        receiveChar(&uarts[u->peer], data, u->baud, u->config);
+        service(&uarts[u->peer]);
+    }
+    else if (u->hook != NULL)
+    {
+        u->hook(indexOf(u), data);
+    }
+}
+
+static bool injectReady(const UartType *u)
+{
+    return (u->injCount != 0U) && (!u->injHonourRts || rtsReady(u));
+}
+
+static uint32_t injectBaud(const UartType *u)
+{
+    return (u->injBaud != 0U) ? u->injBaud : u->baud;
+}
+
+/* Apply everything due at the current time */
+static void service(UartType *u)
+{
+    uint64_t now = SIM_Now();
+    uint8_t  data;
+    uint8_t  before;
+
+    if (u->shiftBusy && (u->shiftDoneAt <= now))
+    {
+        u->shiftBusy = false;
+        deliver(u, u->shiftData);
+        if (u->eotMode && (u->txCount == 0U))
+        {
+            u->ris |= UART_INT_TX;
+        }
+    }
+
+    if (u->injBusy && (u->injDoneAt <= now))
+    {
+        u->injBusy = false;
+        receiveChar(u, u->injData[u->injHead], injectBaud(u), u->config);
+        u->injHead = (u->injHead + 1U) % u->injCap;
+        u->injCount--;
+    }
+
+    /* uDMA: RX requests while data waits, TX requests while there is room */
+    while (((u->dma & UART_DMA_RX) != 0U) && (u->rxCount != 0U) &&
+           SIM_UDMA_Request(u->rxAssign, u->intNumber))
+    {
+    }
+    while (((u->dma & UART_DMA_TX) != 0U) && (u->txCount < SIM_UART_FIFO_DEPTH) &&
+           SIM_UDMA_Request(u->txAssign, u->intNumber))
+    {
+    }
+
+    if (u->rtArmed && (u->rxCount != 0U) && ((u->lastRxAt + (RT_BITS * u->bitCycles)) <= now))
+    {
+        u->ris |= UART_INT_RT;
+        u->rtArmed = false;
+    }
+
+    if (u->enabled && !u->shiftBusy && (u->txCount != 0U))
+    {
+        if (ctsReady(u))
+        {
+            before = u->txCount;
+            data   = u->txFifo[u->txHead];
+            u->txHead = (uint8_t)((u->txHead + 1U) % SIM_UART_FIFO_DEPTH);
+            u->txCount--;
+            u->shiftBusy   = true;
+            u->shiftData   = data;
+            u->shiftDoneAt = now + u->frameCycles;
+            u->ctsWaiting  = false;
+            if (!u->eotMode && (before > u->txLevel) && (u->txCount <= u->txLevel))
+            {
+                u->ris |= UART_INT_TX;
+            }
+        }
+        else if (!u->ctsWaiting)
+        {
+            u->ctsWaiting = true;
+            u->stats.ctsStalls++;
+        }
+    }
+
+    if (u->enabled && !u->injBusy && injectReady(u) && (u->injAt[u->injHead] <= now))
+    {
+        u->injBusy   = true;
+        u->injDoneAt = now + cyclesFor(injectBaud(u), frameBits(u->config));
+    }
+
+    updateLine(u);
+}
+
+/* Space freed in u's RX FIFO: whoever feeds it may go on */
+static void rxDrained(UartType *u)
+{
+    service(u);
+    if (u->peer >= 0)
+    {
+        service(&uarts[u->peer]);
+    }
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < SIM_UART_COUNT; i++)
+    {
+        free(uarts[i].injData);
+        free(uarts[i].injAt);
+        memset(&uarts[i], 0, sizeof(uarts[i]));
+        uarts[i].base        = uartMap[i][0];
+        uarts[i].intNumber   = uartMap[i][1];
+        uarts[i].rxAssign    = uartMap[i][2];
+        uarts[i].txAssign    = uartMap[i][3];
+        uarts[i].baud        = 115200U;
+        uarts[i].config      = UART_CONFIG_WLEN_8;
+        uarts[i].frameCycles = cyclesFor(115200U, 10U);
+        uarts[i].bitCycles   = cyclesFor(115200U, 1U);
+        uarts[i].txLevel     = fifoLevels[2];
+        uarts[i].rxLevel     = fifoLevels[2];
+        uarts[i].peer        = -1;
+        uarts[i].ctsInput    = true;
+        uarts[i].rtsWasReady = true;
+    }
+}
+
+static uint64_t nextEvent(void)
+{
+    uint64_t next = SIM_NEVER;
+    uint64_t t;
+    uint32_t i;
+    const UartType *u;
+
+    for (i = 0U; i < SIM_UART_COUNT; i++)
+    {
+        u = &uarts[i];
+
+        /* Due now: a character may start, or an armed uDMA channel has a
+         * request waiting for it */
+        if ((u->enabled && !u->shiftBusy && (u->txCount != 0U) && ctsReady(u)) ||
+            (((u->dma & UART_DMA_RX) != 0U) && (u->rxCount != 0U) &&
+             SIM_UDMA_Ready(u->rxAssign)) ||
+            (((u->dma & UART_DMA_TX) != 0U) && (u->txCount < SIM_UART_FIFO_DEPTH) &&
+             SIM_UDMA_Ready(u->txAssign)))
+        {
+            return SIM_Now();
+        }
+
+        if (u->shiftBusy && (u->shiftDoneAt < next))
+        {
+            next = u->shiftDoneAt;
+        }
+        if (u->injBusy && (u->injDoneAt < next))
+        {
+            next = u->injDoneAt;
+        }
+        if (u->enabled && !u->injBusy && injectReady(u))
+        {
+            t = u->injAt[u->injHead];
+            if (t < SIM_Now())
+            {
+                t = SIM_Now();
+            }
+            if (t < next)
+            {
+                next = t;
+            }
+        }
+        if (u->rtArmed && (u->rxCount != 0U))
+        {
+            t = u->lastRxAt + (RT_BITS * u->bitCycles);
+            if (t < next)
+            {
+                next = t;
+            }
+        }
+    }
+
+    return next;
+}
+
+static void process(uint64_t now)
+{
+    uint32_t i;
+
+    (void)now;
+    for (i = 0U; i < SIM_UART_COUNT; i++)
+    {
+        service(&uarts[i]);
+    }
+}
+
+/*======================================================================
+ *  Bus (uDMA access to the data and flag registers)
+ *====================================================================*/
+
+static uint32_t flags(const UartType *u)
+{
+    uint32_t fr = 0U;
+
+    fr |= (u->txCount == 0U) ? FR_TXFE : 0U;
+    fr |= (u->rxCount >= SIM_UART_FIFO_DEPTH) ? FR_RXFF : 0U;
+    fr |= (u->txCount >= SIM_UART_FIFO_DEPTH) ? FR_TXFF : 0U;
+    fr |= (u->rxCount == 0U) ? FR_RXFE : 0U;
+    fr |= (u->shiftBusy || (u->txCount != 0U)) ? FR_BUSY : 0U;
+    fr |= ctsReady(u) ? FR_CTS : 0U;
+
+    return fr;
+}
+
+static uint32_t busRead(uint32_t address)
+{
+    UartType *u = fromBase(address & ~0xFFFU);
+    int32_t   entry;
+
+    switch (address & 0xFFFU)
+    {
+        case UART_O_DR:
+            entry = popRx(u);
+            if (entry >= 0)
+            {
+                updateLine(u);
+            }
+            return (entry >= 0) ? (uint32_t)entry : 0U;
+        case UART_O_FR:
+            return flags(u);
+        default:
+            return 0U;
+    }
+}
+
+static void busWrite(uint32_t address, uint32_t value)
+{
+    UartType *u = fromBase(address & ~0xFFFU);
+
+    if ((address & 0xFFFU) == UART_O_DR)
+    {
+        (void)pushTx(u, (uint8_t)value);
+    }
+}
+
+static const SIM_ModelType model = { "uart", reset, nextEvent, process };
+
+static __attribute__((constructor)) void attach(void)
+{
+    uint32_t i;
+
+    SIM_AddModel(&model);
+    for (i = 0U; i < SIM_UART_COUNT; i++)
+    {
+        SIM_MapBus(uartMap[i][0], 0x1000U, busRead, busWrite);
+    }
+}
+
+/*======================================================================
+ *  Test side
+ *====================================================================*/
+
+void SIM_UART_Connect(uint8_t a, uint8_t b)
+{
+    uarts[a].peer = (int8_t)b;
+    uarts[b].peer = (int8_t)a;
+}
+
+void SIM_UART_SetTxHook(uint8_t uart, SIM_UART_TxHookType hook)
+{
+    uarts[uart].hook = hook;
+}
+
+void SIM_UART_SetNoise(uint8_t uart, SIM_UART_NoiseHookType hook)
+{
+    uarts[uart].noise = hook;
+}
+
+void SIM_UART_Inject(uint8_t uart, const uint8_t *data, uint32_t len, uint64_t notBefore)
+{
+    UartType *u = &uarts[uart];
+    uint32_t  i;
+    uint32_t  cap;
+    uint8_t  *newData;
+    uint64_t *newAt;
+
+    if ((u->injCount + len) > u->injCap)
+    {
+        cap = (u->injCap == 0U) ? 256U : u->injCap;
+        while (cap < (u->injCount + len))
+        {
+            cap *= 2U;
+        }
+        newData = malloc(cap);
+        newAt   = malloc(cap * sizeof(uint64_t));
+        if ((newData == NULL) || (newAt == NULL))
+        {
+            SIM_Fail("sim_uart: out of memory");
+        }
+        for (i = 0U; i < u->injCount; i++)
+        {
+            newData[i] = u->injData[(u->injHead + i) % u->injCap];
+            newAt[i]   = u->injAt[(u->injHead + i) % u->injCap];
+        }
+        free(u->injData);
+        free(u->injAt);
+        u->injData = newData;
+        u->injAt   = newAt;
+        u->injCap  = cap;
+        u->injHead = 0U;
+    }
+
+    for (i = 0U; i < len; i++)
+    {
+        u->injData[(u->injHead + u->injCount) % u->injCap] = data[i];
+        u->injAt[(u->injHead + u->injCount) % u->injCap]   = notBefore;
+        u->injCount++;
+    }
+}
+
+void SIM_UART_SetInjectLine(uint8_t uart, uint32_t baud, bool honourRts)
+{
+    uarts[uart].injBaud      = baud;
+    uarts[uart].injHonourRts = honourRts;
+}
+
+uint32_t SIM_UART_InjectPending(uint8_t uart)
+{
+    return uarts[uart].injCount;
+}
+
+void SIM_UART_SetCts(uint8_t uart, bool ready)
+{
+    uarts[uart].ctsInput = ready;
+    service(&uarts[uart]);
+}
+
+bool SIM_UART_IsRtsReady(uint8_t uart)
+{
+    return rtsReady(&uarts[uart]);
+}
+
+uint32_t SIM_UART_GetBaud(uint8_t uart)
+{
+    return uarts[uart].enabled ? uarts[uart].baud : 0U;
+}
+
+void SIM_UART_GetStats(uint8_t uart, SIM_UART_StatsType *stats)
+{
+    UartType *u = &uarts[uart];
+
+    *stats = u->stats;
+    if (!u->rtsWasReady)
+    {
+        stats->rtsHeldCycles += SIM_Now() - u->rtsHeldSince;
+    }
+}
+
+/*======================================================================
+ *  driverlib/uart.h
+ *====================================================================*/
+
+void UARTEnable(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->enabled = true;
+    service(u);
+}
+
+void UARTDisable(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    /* TivaWare waits for the transmitter to finish first */
+    while (u->shiftBusy || (u->txCount != 0U))
+    {
+        SIM_Charge(SIM_DRIVER_CYCLES);
+    }
+    u->enabled = false;
+}
+
+void UARTFIFOEnable(uint32_t ui32Base)
+{
+    (void)fromBase(ui32Base);
+    SIM_Charge(SIM_DRIVER_CYCLES);
+}
+
+void UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud,
+                         uint32_t ui32Config)
+{
+    UartType *u = fromBase(ui32Base);
+    uint32_t  div;
+    uint32_t  hse = 1U;
+
+    UARTDisable(ui32Base);
+
+    /* Same divisor arithmetic as TivaWare, high-speed mode above clk/16 */
+    if ((ui32Baud * 16U) > ui32UARTClk)
+    {
+        hse = 2U;
+        ui32Baud /= 2U;
+    }
+    div = (((ui32UARTClk * 8U) / ui32Baud) + 1U) / 2U;
+    if (div == 0U)
+    {
+        SIM_Fail("sim_uart: baud divisor 0");
+    }
+
+    u->baud        = (uint32_t)(((uint64_t)ui32UARTClk * 4U * hse) / div);
+    u->config      = ui32Config;
+    u->frameCycles = cyclesFor(u->baud, frameBits(ui32Config));
+    u->bitCycles   = cyclesFor(u->baud, 1U);
+
+    UARTEnable(ui32Base);
+}
+
+void UARTConfigGetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t *pui32Baud,
+                         uint32_t *pui32Config)
+{
+    UartType *u = fromBase(ui32Base);
+
+    (void)ui32UARTClk;
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    *pui32Baud   = u->baud;
+    *pui32Config = u->config;
+}
+
+void UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->txLevel = fifoLevels[(ui32TxLevel & 0x7U) % 5U];
+    u->rxLevel = fifoLevels[((ui32RxLevel >> 3) & 0x7U) % 5U];
+    service(u);
+}
+
+bool UARTCharsAvail(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return u->rxCount != 0U;
+}
+
+bool UARTSpaceAvail(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return u->txCount < SIM_UART_FIFO_DEPTH;
+}
+
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+    int32_t   entry;
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    entry = popRx(u);
+    if (entry >= 0)
+    {
+        rxDrained(u);
+    }
+    return entry;
+}
+
+int32_t UARTCharGet(uint32_t ui32Base)
+{
+    int32_t entry;
+
+    while ((entry = UARTCharGetNonBlocking(ui32Base)) < 0)
+    {
+    }
+    return entry;
+}
+
+bool UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData)
+{
+    UartType *u = fromBase(ui32Base);
+    bool      ok;
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    ok = pushTx(u, ucData);
+    service(u);
+    return ok;
+}
+
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    while (!UARTCharPutNonBlocking(ui32Base, ucData))
+    {
+    }
+}
+
+bool UARTBusy(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return u->shiftBusy || (u->txCount != 0U);
+}
+
+void UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->im |= ui32IntFlags;
+    updateLine(u);
+}
+
+void UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->im &= ~ui32IntFlags;
+    updateLine(u);
+}
+
+uint32_t UARTIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return bMasked ? (u->ris & u->im) : u->ris;
+}
+
+void UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->ris &= ~ui32IntFlags;
+    updateLine(u);
+}
+
+void UARTTxIntModeSet(uint32_t ui32Base, uint32_t ui32Mode)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->eotMode = (ui32Mode == UART_TXINT_MODE_EOT);
+}
+
+void UARTFlowControlSet(uint32_t ui32Base, uint32_t ui32Mode)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->flow = ui32Mode & (UART_FLOWCONTROL_TX | UART_FLOWCONTROL_RX);
+    service(u);
+}
+
+void UARTDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->dma |= ui32DMAFlags;
+    service(u);
+}
+
+void UARTDMADisable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->dma &= ~ui32DMAFlags;
+}
+
+uint32_t UARTRxErrorGet(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return u->rsr;
+}
+
+void UARTRxErrorClear(uint32_t ui32Base)
+{
+    UartType *u = fromBase(ui32Base);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    u->rsr = 0U;
+}
@@ -0,0 +1,114 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_uart.h
+ *  Description : UART0-UART7 model and the test side of their lines
+ *
+ *  Each UART has the TM4C123 16-entry RX and TX FIFOs, FIFO-level RX/TX
+ *  interrupts, the 32-bit-time receive timeout, overrun/framing status
+ *  stored with each received character, BUSY, RTS/CTS flow control and
+ *  uDMA requests. Characters take their real time on the line at the
+ *  programmed baud and frame format.
+ *
+ *  A UART's line goes to one of:
+ *  - another modelled UART (SIM_UART_Connect(), null modem with RTS and
+ *    CTS crossed); a baud or format mismatch arrives as framing errors;
+ *  - the test: what the UART sends goes to a hook, and the test queues
+ *    bytes to arrive with SIM_UART_Inject(), paced by the line rate and,
+ *    when asked to, by the UART's RTS.
+ *
+ *  A noise hook on a UART sees each character it sends, with the line
+ *  rate, and returns what arrives (bit errors that leave the framing
+ *  intact), to either end.
+ *===========================================================================*/
+
+#ifndef SIM_UART_H_
+#define SIM_UART_H_
+
+#include "sim.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_UART_COUNT          (8U)
+#define SIM_UART_FIFO_DEPTH     (16U)
+
+/* Receivers tolerate this much baud difference (percent) */
+#define SIM_UART_BAUD_TOLERANCE (3U)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+typedef struct
+{
+    uint32_t txBytes;           /* Characters that left the shift register */
+    uint32_t rxBytes;           /* Characters that arrived on the line */
+    uint32_t rxOverruns;        /* Arrived with the RX FIFO full: lost */
+    uint32_t rxFramingErrors;   /* Arrived at the wrong baud or format */
+    uint32_t rxIgnored;         /* Arrived while the UART was disabled */
+    uint16_t rxFifoMax;         /* Deepest RX FIFO fill */
+    uint32_t ctsStalls;         /* Characters held back by CTS */
+    uint64_t rtsHeldCycles;     /* Time RTS told the sender to wait */
+} SIM_UART_StatsType;
+
+/* Character the UART sent, for lines that end in the test */
+typedef void (*SIM_UART_TxHookType)(uint8_t uart, uint8_t data);
+
+/* Character the UART sent at baud, as it arrives at the far end */
+typedef uint8_t (*SIM_UART_NoiseHookType)(uint8_t uart, uint8_t data, uint32_t baud);
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Wire two UARTs to each other (TX to RX, RTS to CTS, both ways).
+ */
+void SIM_UART_Connect(uint8_t a, uint8_t b);
+
+/**
+ * @brief Send what the UART transmits to a hook (NULL: discard).
+ */
+void SIM_UART_SetTxHook(uint8_t uart, SIM_UART_TxHookType hook);
+
+/**
+ * @brief Pass what the UART transmits through a noise hook (NULL: clean).
+ */
+void SIM_UART_SetNoise(uint8_t uart, SIM_UART_NoiseHookType hook);
+
+/**
+ * @brief Queue bytes to arrive on the UART's RX line, back to back at the
+ *        line rate, the first not before cycle notBefore.
+ */
+void SIM_UART_Inject(uint8_t uart, const uint8_t *data, uint32_t len, uint64_t notBefore);
+
+/**
+ * @brief Line rate of injected bytes (0: the UART's own rate) and whether
+ *        the sender waits for the UART's RTS (a peer with CTS wired).
+ */
+void SIM_UART_SetInjectLine(uint8_t uart, uint32_t baud, bool honourRts);
+
+/**
+ * @brief Bytes queued by SIM_UART_Inject() that have not yet arrived.
+ */
+uint32_t SIM_UART_InjectPending(uint8_t uart);
+
+/**
+ * @brief CTS input of a UART whose line ends in the test (default ready).
+ */
+void SIM_UART_SetCts(uint8_t uart, bool ready);
+
+/**
+ * @brief RTS output: true while the UART is ready to receive.
+ */
+bool SIM_UART_IsRtsReady(uint8_t uart);
+
+/**
+ * @brief Actual line rate after the divisor rounding, 0 if not configured.
+ */
+uint32_t SIM_UART_GetBaud(uint8_t uart);
+
+void SIM_UART_GetStats(uint8_t uart, SIM_UART_StatsType *stats);
+
+#endif /* SIM_UART_H_ */
@@ -0,0 +1,363 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_udma.c
+ *  Description : uDMA controller model (driverlib/udma.h)
+ *===========================================================================*/
+
+#include "sim_udma.h"
+
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define CHANNELS                (32U)
+
+#define CTL_DSTINC_S            (30U)
+#define CTL_DSTSIZE_S           (28U)
+#define CTL_SRCINC_S            (26U)
+#define CTL_SRCSIZE_S           (24U)
+#define CTL_INC_NONE            (3U)
+
+/* Bits uDMAChannelControlSet() replaces */
+#define CTL_SET_MASK            (0xFF03C008U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static bool              masterEnabled;
+static tDMAControlTable *table;
+static uint32_t          enabledMask;
+static uint32_t          reqMaskMask;
+static uint32_t          altMask;
+static uint8_t           assignEnc[CHANNELS];
+static uint32_t          errorStatus;
+
+static SIM_UDMA_StatsType stats;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static tDMAControlTable *entry(uint32_t index)
+{
+    if (table == NULL)
+    {
+        SIM_Fail("sim_udma: channel table used before uDMAControlBaseSet()");
+    }
+    if ((index & UDMA_ALT_SELECT) != 0U)
+    {
+        SIM_Fail("sim_udma: alternate structures are not modelled");
+    }
+
+    return &table[index & 0x1FU];
+}
+
+/* Address of item `item` counting back from the end pointer */
+static uintptr_t itemAddress(volatile void *end, uint32_t incCode, uint32_t remaining)
+{
+    uintptr_t address = (uintptr_t)end;
+
+    if (incCode != CTL_INC_NONE)
+    {
+        address -= (uintptr_t)(remaining - 1U) << incCode;
+    }
+
+    return address;
+}
+
+static bool readItem(uintptr_t address, uint32_t sizeCode, uint32_t *value)
+{
+    if ((address >> 32) == 0U)
+    {
+        if (SIM_BusRead((uint32_t)address, value))
+        {
+            return true;
+        }
+    }
+    else
+    {
+        switch (sizeCode)
+        {
+            case 0U:
+                *value = *(volatile uint8_t *)address;
+                return true;
+            case 1U:
+                *value = *(volatile uint16_t *)address;
+                return true;
+            default:
+                *value = *(volatile uint32_t *)address;
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static bool writeItem(uintptr_t address, uint32_t sizeCode, uint32_t value)
+{
+    if ((address >> 32) == 0U)
+    {
+        return SIM_BusWrite((uint32_t)address, value);
+    }
+
+    switch (sizeCode)
+    {
+        case 0U:
+            *(volatile uint8_t *)address = (uint8_t)value;
+            break;
+        case 1U:
+            *(volatile uint16_t *)address = (uint16_t)value;
+            break;
+        default:
+            *(volatile uint32_t *)address = value;
+            break;
+    }
+
+    return true;
+}
+
+static bool channelReady(uint32_t assign)
+{
+    uint32_t ch  = assign & 0x1FU;
+    uint32_t bit = 1UL << ch;
+
+    return masterEnabled && (table != NULL) &&
+           ((enabledMask & bit) != 0U) && ((reqMaskMask & bit) == 0U) &&
+           ((altMask & bit) == 0U) &&
+           (assignEnc[ch] == ((assign >> 16) & 0xFU)) &&
+           ((table[ch].ui32Control & UDMA_MODE_M) != UDMA_MODE_STOP);
+}
+
+static void reset(void)
+{
+    masterEnabled = false;
+    table         = NULL;
+    enabledMask   = 0U;
+    reqMaskMask   = 0U;
+    altMask       = 0U;
+    errorStatus   = 0U;
+    memset(assignEnc, 0, sizeof(assignEnc));
+    memset(&stats, 0, sizeof(stats));
+}
+
+static uint64_t nextEvent(void)
+{
+    return SIM_NEVER;
+}
+
+static void process(uint64_t now)
+{
+    (void)now;
+}
+
+static const SIM_ModelType model = { "udma", reset, nextEvent, process };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&model);
+}
+
+/*======================================================================
+ *  Peripheral side
+ *====================================================================*/
+
+bool SIM_UDMA_Ready(uint32_t assign)
+{
+    return channelReady(assign);
+}
+
+bool SIM_UDMA_Request(uint32_t assign, uint32_t intNumber)
+{
+    uint32_t          ch = assign & 0x1FU;
+    tDMAControlTable *e;
+    uint32_t          ctl;
+    uint32_t          remaining;
+    uint32_t          value = 0U;
+    uintptr_t         src;
+    uintptr_t         dst;
+
+    if (!channelReady(assign))
+    {
+        return false;
+    }
+
+    e         = &table[ch];
+    ctl       = e->ui32Control;
+    remaining = ((ctl & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1U;
+
+    src = itemAddress(e->pvSrcEndAddr, (ctl >> CTL_SRCINC_S) & 3U, remaining);
+    dst = itemAddress(e->pvDstEndAddr, (ctl >> CTL_DSTINC_S) & 3U, remaining);
+
+    if (!readItem(src, (ctl >> CTL_SRCSIZE_S) & 3U, &value) ||
+        !writeItem(dst, (ctl >> CTL_DSTSIZE_S) & 3U, value))
+    {
+        stats.busErrors++;
+        errorStatus = 1U;
+        enabledMask &= ~(1UL << ch);
+        SIM_PendInt(INT_UDMAERR);
+        return false;
+    }
+
+    stats.requests++;
+    stats.items++;
+    stats.channelItems[ch]++;
+
+    if (remaining == 1U)
+    {
+        /* Done: back to STOP with a zero count, channel off, tell the peripheral */
+        e->ui32Control = ctl & ~(UDMA_CHCTL_XFERSIZE_M | UDMA_MODE_M);
+        enabledMask &= ~(1UL << ch);
+        stats.transfersDone++;
+        SIM_PendInt(intNumber);
+    }
+    else
+    {
+        e->ui32Control = ctl - (1UL << UDMA_CHCTL_XFERSIZE_S);
+    }
+
+    return true;
+}
+
+void SIM_UDMA_GetStats(SIM_UDMA_StatsType *out)
+{
+    *out = stats;
+}
+
+/*======================================================================
+ *  driverlib/udma.h
+ *====================================================================*/
+
+void uDMAEnable(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    masterEnabled = true;
+}
+
+void uDMADisable(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    masterEnabled = false;
+}
+
+void uDMAControlBaseSet(void *pControlTable)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if (((uintptr_t)pControlTable & 0x3FFU) != 0U)
+    {
+        SIM_Fail("sim_udma: control table %p is not 1024-byte aligned", pControlTable);
+    }
+    table = (tDMAControlTable *)pControlTable;
+}
+
+void uDMAChannelAssign(uint32_t ui32Mapping)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    assignEnc[ui32Mapping & 0x1FU] = (uint8_t)((ui32Mapping >> 16) & 0xFU);
+}
+
+void uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    uint32_t bit = 1UL << (ui32ChannelNum & 0x1FU);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    reqMaskMask |= ((ui32Attr & UDMA_ATTR_REQMASK) != 0U) ? bit : 0U;
+    altMask     |= ((ui32Attr & UDMA_ATTR_ALTSELECT) != 0U) ? bit : 0U;
+}
+
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    uint32_t bit = 1UL << (ui32ChannelNum & 0x1FU);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    reqMaskMask &= ((ui32Attr & UDMA_ATTR_REQMASK) != 0U) ? ~bit : ~0UL;
+    altMask     &= ((ui32Attr & UDMA_ATTR_ALTSELECT) != 0U) ? ~bit : ~0UL;
+}
+
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    tDMAControlTable *e = entry(ui32ChannelStructIndex);
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    e->ui32Control = (e->ui32Control & ~CTL_SET_MASK) | ui32Control;
+}
+
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                            void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize)
+{
+    tDMAControlTable *e = entry(ui32ChannelStructIndex);
+    uint32_t          ctl;
+    uint32_t          inc;
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    if ((ui32TransferSize == 0U) || (ui32TransferSize > 1024U))
+    {
+        SIM_Fail("sim_udma: transfer size %u out of range", ui32TransferSize);
+    }
+
+    ctl  = e->ui32Control & ~(UDMA_CHCTL_XFERSIZE_M | UDMA_MODE_M);
+    ctl |= ((ui32TransferSize - 1U) << UDMA_CHCTL_XFERSIZE_S) | (ui32Mode & UDMA_MODE_M);
+    e->ui32Control = ctl;
+
+    /* TivaWare stores end pointers: the address of the last item */
+    inc = (ctl >> CTL_SRCINC_S) & 3U;
+    e->pvSrcEndAddr = (inc == CTL_INC_NONE) ? pvSrcAddr
+                    : (void *)((uintptr_t)pvSrcAddr + ((uintptr_t)(ui32TransferSize - 1U) << inc));
+    inc = (ctl >> CTL_DSTINC_S) & 3U;
+    e->pvDstEndAddr = (inc == CTL_INC_NONE) ? pvDstAddr
+                    : (void *)((uintptr_t)pvDstAddr + ((uintptr_t)(ui32TransferSize - 1U) << inc));
+
+    stats.transfersSet++;
+}
+
+void uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    enabledMask |= 1UL << (ui32ChannelNum & 0x1FU);
+}
+
+void uDMAChannelDisable(uint32_t ui32ChannelNum)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    enabledMask &= ~(1UL << (ui32ChannelNum & 0x1FU));
+}
+
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return (enabledMask & (1UL << (ui32ChannelNum & 0x1FU))) != 0U;
+}
+
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return entry(ui32ChannelStructIndex)->ui32Control & UDMA_MODE_M;
+}
+
+uint32_t uDMAChannelSizeGet(uint32_t ui32ChannelStructIndex)
+{
+    uint32_t ctl;
+
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    ctl = entry(ui32ChannelStructIndex)->ui32Control & (UDMA_CHCTL_XFERSIZE_M | UDMA_MODE_M);
+    if (ctl == 0U)
+    {
+        return 0U;
+    }
+
+    return ((ctl & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1U;
+}
+
+uint32_t uDMAErrorStatusGet(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    return errorStatus;
+}
+
+void uDMAErrorStatusClear(void)
+{
+    SIM_Charge(SIM_DRIVER_CYCLES);
+    errorStatus = 0U;
+}
@@ -0,0 +1,59 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_udma.h
+ *  Description : uDMA controller model working on the firmware's own
+ *                channel control table
+ *
+ *  uDMAControlBaseSet() hands the model the table the MCAL allocated (it
+ *  must be 1024-byte aligned, as on the target). The driverlib stand-ins
+ *  fill its primary structures exactly like TivaWare does (end pointers,
+ *  XFERSIZE = n - 1, transfer mode), and every request a peripheral
+ *  raises moves one item and counts XFERSIZE down in the table. After the
+ *  last item the structure is back in STOP mode, the channel is disabled
+ *  and the peripheral's interrupt is pended, which is how completion is
+ *  signalled on peripheral channels. Basic mode on the primary structure
+ *  only; an access to an unmapped peripheral address is a bus error.
+ *===========================================================================*/
+
+#ifndef SIM_UDMA_H_
+#define SIM_UDMA_H_
+
+#include "sim.h"
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+typedef struct
+{
+    uint32_t transfersSet;      /* uDMAChannelTransferSet() calls */
+    uint32_t transfersDone;     /* Reached the end of their count */
+    uint32_t items;             /* Items moved */
+    uint32_t requests;          /* Peripheral requests served */
+    uint32_t busErrors;
+    uint32_t channelItems[32];  /* Items moved per channel */
+} SIM_UDMA_StatsType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Peripheral request on a channel: move one item if the channel is
+ *        enabled, routed to this peripheral and not yet done.
+ *
+ * @param assign    Channel assignment (UDMA_CHn_xxx) of the requester
+ * @param intNumber Interrupt pended when the transfer completes
+ * @return true if an item moved
+ */
+bool SIM_UDMA_Request(uint32_t assign, uint32_t intNumber);
+
+/**
+ * @brief Whether SIM_UDMA_Request() would move an item (a request line
+ *        held high is served as soon as the channel is armed).
+ */
+bool SIM_UDMA_Ready(uint32_t assign);
+
+void SIM_UDMA_GetStats(SIM_UDMA_StatsType *stats);
+
+#endif /* SIM_UDMA_H_ */
@@ -0,0 +1,124 @@
+/*============================================================================
+ *  Module      : Host benchmarks
+ *  File Name   : bench_cobs.c
+ *  Description : COBS_Encode / COBS_DecoderFeed throughput
+ *
+ *  cobs.c is built plain (no model underneath), so the figures are host
+ *  nanoseconds, for comparing packet sizes and changes to the codec.
+ *  Packets are random with 1 byte in 64 zero; the all-zero row is the
+ *  worst case for block handling (one block per byte). Every decoded
+ *  packet is compared with what was encoded.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <string.h>
+#include <time.h>
+#include "services/cobs.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define BENCH_BYTES             (20000000U)     /* Per size, so rows take alike */
+#define BENCH_MAX_LEN           (1024U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t packet[BENCH_MAX_LEN];
+static uint8_t wire[COBS_MAX_ENCODED(BENCH_MAX_LEN)];
+static uint8_t decoded[BENCH_MAX_LEN];
+
+/* Keeps the optimiser from dropping the timed loops */
+static volatile uint32_t sink;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void run(uint16_t len, boolean allZero)
+{
+    COBS_DecoderType decoder;
+    uint16_t         size;
+    uint64_t         start;
+    uint64_t         encodeNs;
+    uint64_t         decodeNs;
+    uint32_t         packets = BENCH_BYTES / len;
+    uint32_t         n;
+    uint32_t         complete = 0U;
+    uint32_t         sum      = 0U;
+    uint16_t         i;
+
+    srand(len);
+    for (i = 0U; i < len; i++)
+    {
+        packet[i] = (allZero || ((rand() % 64) == 0)) ? 0U : (uint8_t)(1 + (rand() % 255));
+    }
+
+    size = COBS_Encode(packet, len, wire, (uint16_t)sizeof(wire));
+    TEST_CHECK((size != 0U) && (size <= COBS_MAX_ENCODED(len)), "len %u: encoded %u bytes",
+               len, size);
+
+    start = nowNs();
+    for (n = 0U; n < packets; n++)
+    {
+        sum += COBS_Encode(packet, len, wire, (uint16_t)sizeof(wire));
+    }
+    encodeNs = nowNs() - start;
+    sink = sum;
+
+    COBS_DecoderInit(&decoder, decoded, (uint16_t)sizeof(decoded));
+    start = nowNs();
+    for (n = 0U; n < packets; n++)
+    {
+        for (i = 0U; i < size; i++)
+        {
+            if (COBS_DecoderFeed(&decoder, wire[i]) == COBS_STATUS_COMPLETE)
+            {
+                complete++;
+            }
+        }
+    }
+    decodeNs = nowNs() - start;
+
+    printf("  %5u  %-5s  %5u  %9.1f  %9.1f  %7.2f  %7.2f  %8.1f\n",
+           len, allZero ? "zeros" : "mixed", size,
+           (double)encodeNs / packets,
+           (double)decodeNs / packets,
+           (double)encodeNs / ((double)packets * len),
+           (double)decodeNs / ((double)packets * size),
+           ((double)packets * size * 1000.0) / (double)decodeNs);
+
+    TEST_CHECK(complete == packets, "len %u: %u of %u packets decoded", len, complete, packets);
+    TEST_CHECK((decoder.length == len) && (memcmp(decoded, packet, len) == 0),
+               "len %u: decoded packet differs from the encoded one", len);
+    TEST_CHECK(decoder.errors == 0U, "len %u: %u decode errors", len, decoder.errors);
+}
+
+int main(void)
+{
+    static const uint16_t lens[] = { 8U, 32U, 254U, 255U, BENCH_MAX_LEN };
+    uint32_t i;
+
+    printf("bench_cobs: %u packet bytes per size, host time\n", BENCH_BYTES);
+    printf("  %5s  %-5s  %5s  %9s  %9s  %7s  %7s  %8s\n",
+           "len", "data", "wire", "enc ns", "dec ns", "enc/B", "dec/B", "dec MB/s");
+
+    for (i = 0U; i < (sizeof(lens) / sizeof(lens[0])); i++)
+    {
+        run(lens[i], FALSE);
+    }
+    run(BENCH_MAX_LEN, TRUE);
+
+    return TEST_END();
+}
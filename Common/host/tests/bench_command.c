@@ -0,0 +1,175 @@
+/*============================================================================
+ *  Module      : Host benchmarks
+ *  File Name   : bench_command.c
+ *  Description : Caller time of one HMI command frame: blocking TX (the
+ *                old sendByte() path) against the TX ring
+ *
+ *  Each command is built as the HMI sends it (link DATA frame carrying
+ *  the request SEQ and the passwords) and handed byte by byte to UART1,
+ *  as HAL_COMM_SendFrame() does. "Caller" is the time until the last
+ *  sendByte() returns: what the HMI main loop spends on the command.
+ *  "Wire" is the time until the last stop bit has left. The ring is as
+ *  large as HAL_COMM_TX_BUFFER_SIZE, so every command fits.
+ *
+ *  While the FIFO has room both paths cost the same; past 16 bytes the
+ *  blocking caller waits for the wire and the ring caller does not.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <string.h>
+#include "mcal/mcal_uart.h"
+#include "services/frame.h"
+#include "services/link.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define TX_RING_SIZE            (128U)
+#define UART_FIFO_DEPTH         (16U)
+
+/* At 921600 the wire outpaces the caller and blocking seldom waits; the
+ * ring may then lose the cost of an interrupt or two, never more */
+#define RING_SLACK_CYCLES       (256U)
+#define CMD_OPEN_DOOR           ('O')
+#define CMD_CHANGE_PASSWORD     ('C')
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef struct
+{
+    const char *name;
+    uint8_t     cmd;
+    uint8_t     passwords;      /* Length-prefixed passwords in the payload */
+    uint8_t     digits;         /* Digits each */
+} CommandType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static const CommandType commands[] =
+{
+    { "open door",       CMD_OPEN_DOOR,       1U, 5U  },
+    { "change password", CMD_CHANGE_PASSWORD, 3U, 5U  },
+    { "change password", CMD_CHANGE_PASSWORD, 3U, 16U }
+};
+
+static uint8_t  wire[FRAME_MAX_SIZE];
+static uint16_t wireLen;
+static uint8_t  txRing[TX_RING_SIZE];
+static uint32_t baud;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+/* [link SEQ][CMD][request SEQ][len][digits]... in a link DATA frame */
+static void build(const CommandType *command)
+{
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t len = 0U;
+    uint8_t p;
+    uint8_t i;
+
+    payload[len++] = 1U;
+    payload[len++] = command->cmd;
+    payload[len++] = 1U;
+    for (p = 0U; p < command->passwords; p++)
+    {
+        payload[len++] = command->digits;
+        for (i = 0U; i < command->digits; i++)
+        {
+            payload[len++] = (uint8_t)('0' + ((i + p) % 10U));
+        }
+    }
+
+    wireLen = FRAME_Encode(LINK_CMD_DATA, payload, len, wire, (uint16_t)sizeof(wire));
+}
+
+/* Hand the frame to UART1; returns the caller time in cycles */
+static uint64_t run(boolean useRing)
+{
+    UART_ConfigType cfg = { 0 };
+    uint64_t        start;
+    uint64_t        caller;
+    uint64_t        onWire;
+    uint16_t        i;
+
+    SIM_Init();
+    SIM_SetLimit(1000U * SIM_CYCLES_PER_MS);
+
+    cfg.clockFreq = SysCtlClockGet();
+    cfg.uartBase  = UART1_BASE;
+    cfg.baudRate  = baud;
+    cfg.dataBits  = 8U;
+    cfg.stopBits  = 1U;
+    if (useRing)
+    {
+        cfg.txBuffer     = txRing;
+        cfg.txBufferSize = TX_RING_SIZE;
+    }
+    UART_init(&cfg);
+    IntMasterEnable();
+
+    start = SIM_Now();
+    for (i = 0U; i < wireLen; i++)
+    {
+        sendByte(UART1_BASE, wire[i]);
+    }
+    caller = SIM_Now() - start;
+
+    while (!UART_IsTxIdle(UART1_BASE))
+    {
+    }
+    onWire = SIM_Now() - start;
+
+    printf("  %7u  %-8s  %9.1f  %9.1f\n", baud, useRing ? "TX ring" : "blocking",
+           (double)caller / SIM_CYCLES_PER_US, (double)onWire / SIM_CYCLES_PER_US);
+    return caller;
+}
+
+static void compare(void)
+{
+    uint64_t blocking = run(FALSE);
+    uint64_t ring     = run(TRUE);
+
+    TEST_CHECK(ring <= (blocking + RING_SLACK_CYCLES), "%u bytes at %u: ring %u cycles, "
+               "blocking %u", wireLen, baud, (unsigned)ring, (unsigned)blocking);
+    if ((wireLen > UART_FIFO_DEPTH) && (baud <= 115200U))
+    {
+        TEST_CHECK((ring * 4U) < blocking, "%u bytes at %u: ring %u cycles, blocking %u",
+                   wireLen, baud, (unsigned)ring, (unsigned)blocking);
+    }
+}
+
+int main(void)
+{
+    static const uint32_t bauds[] = { 115200U, 921600U };
+    uint32_t c;
+    uint32_t b;
+
+    printf("bench_command: one command frame to UART1 at 16 MHz, %u-byte TX ring\n",
+           TX_RING_SIZE);
+
+    for (c = 0U; c < (sizeof(commands) / sizeof(commands[0])); c++)
+    {
+        build(&commands[c]);
+        printf("  %s, %u x %u digits: %u bytes\n", commands[c].name, commands[c].passwords,
+               commands[c].digits, wireLen);
+        printf("  %7s  %-8s  %9s  %9s\n", "baud", "mode", "caller us", "wire us");
+
+        for (b = 0U; b < (sizeof(bauds) / sizeof(bauds[0])); b++)
+        {
+            baud = bauds[b];
+            TEST_Isolated(compare);
+        }
+    }
+
+    return TEST_END();
+}
@@ -0,0 +1,146 @@
+/*============================================================================
+ *  Module      : Host benchmarks
+ *  File Name   : bench_frame.c
+ *  Description : FRAME_Encode / FRAME_ParserFeed throughput
+ *
+ *  frame.c and crc16.c are built plain (no model underneath), so the
+ *  figures are host nanoseconds: useful to compare payload sizes and
+ *  changes to the codec, not as target timings. Every decoded frame is
+ *  compared with what was encoded, so a faster but wrong codec fails.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <string.h>
+#include <time.h>
+#include "services/frame.h"
+#include "services/crc16.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define BENCH_FRAMES            (200000U)
+#define BENCH_CMD               (0x21U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t payload[FRAME_MAX_PAYLOAD];
+static uint8_t wire[FRAME_MAX_SIZE];
+
+/* Keeps the optimiser from dropping the timed loops */
+static volatile uint32_t sink;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void run(uint8_t len)
+{
+    FRAME_ParserType parser;
+    uint16_t         size;
+    uint64_t         start;
+    uint64_t         encodeNs;
+    uint64_t         decodeNs;
+    uint32_t         frames;
+    uint32_t         complete = 0U;
+    uint32_t         wrong    = 0U;
+    uint32_t         sum      = 0U;
+    uint16_t         i;
+
+    size = FRAME_Encode(BENCH_CMD, payload, len, wire, sizeof(wire));
+    TEST_CHECK(size == (uint16_t)(len + FRAME_OVERHEAD), "len %u: encoded %u bytes", len, size);
+
+    start = nowNs();
+    for (frames = 0U; frames < BENCH_FRAMES; frames++)
+    {
+        payload[0] = (uint8_t)frames;
+        sum += FRAME_Encode(BENCH_CMD, payload, len, wire, sizeof(wire));
+    }
+    encodeNs = nowNs() - start;
+    sink = sum;
+
+    FRAME_ParserInit(&parser);
+    start = nowNs();
+    for (frames = 0U; frames < BENCH_FRAMES; frames++)
+    {
+        for (i = 0U; i < size; i++)
+        {
+            if (FRAME_ParserFeed(&parser, wire[i]) == FRAME_STATUS_COMPLETE)
+            {
+                complete++;
+            }
+        }
+    }
+    decodeNs = nowNs() - start;
+
+    if ((parser.frame.cmd != BENCH_CMD) || (parser.frame.len != len) ||
+        (memcmp(parser.frame.payload, payload, len) != 0))
+    {
+        wrong++;
+    }
+
+    printf("  %5u  %6u  %9.1f  %9.1f  %8.2f  %9.1f\n",
+           len, size,
+           (double)encodeNs / BENCH_FRAMES,
+           (double)decodeNs / BENCH_FRAMES,
+           (double)decodeNs / ((double)BENCH_FRAMES * size),
+           ((double)BENCH_FRAMES * size * 1000.0) / (double)decodeNs);
+
+    TEST_CHECK(complete == BENCH_FRAMES, "len %u: %u of %u frames decoded",
+               len, complete, BENCH_FRAMES);
+    TEST_CHECK(wrong == 0U, "len %u: decoded frame differs from the encoded one", len);
+    TEST_CHECK((parser.crcErrors == 0U) && (parser.lengthErrors == 0U),
+               "len %u: %u CRC / %u length errors", len, parser.crcErrors, parser.lengthErrors);
+}
+
+static void runCorrupt(void)
+{
+    FRAME_ParserType parser;
+    uint16_t         size;
+    uint16_t         i;
+
+    /* One flipped payload bit must be caught and the parser re-armed */
+    size = FRAME_Encode(BENCH_CMD, payload, 32U, wire, sizeof(wire));
+    wire[10] ^= 0x04U;
+    FRAME_ParserInit(&parser);
+    for (i = 0U; i < size; i++)
+    {
+        (void)FRAME_ParserFeed(&parser, wire[i]);
+    }
+    TEST_CHECK(parser.crcErrors == 1U, "corrupt frame: %u CRC errors", parser.crcErrors);
+    TEST_CHECK(!FRAME_ParserIsBusy(&parser), "parser not re-armed after a CRC error");
+}
+
+int main(void)
+{
+    static const uint8_t lens[] = { 0U, 8U, 16U, 32U, FRAME_MAX_PAYLOAD };
+    uint32_t i;
+
+    for (i = 0U; i < FRAME_MAX_PAYLOAD; i++)
+    {
+        payload[i] = (uint8_t)((i * 29U) + 3U);
+    }
+
+    printf("bench_frame: %u frames per size, host time\n", BENCH_FRAMES);
+    printf("  %5s  %6s  %9s  %9s  %8s  %9s\n",
+           "len", "wire", "enc ns", "dec ns", "ns/byte", "dec MB/s");
+
+    for (i = 0U; i < sizeof(lens); i++)
+    {
+        run(lens[i]);
+    }
+    runCorrupt();
+
+    return TEST_END();
+}
@@ -0,0 +1,125 @@
+/*============================================================================
+ *  Module      : Host benchmarks
+ *  File Name   : bench_swtimer.c
+ *  Description : SWTIMER_Process() cost per tick at 10, 100 and 1000
+ *                armed timers
+ *
+ *  swtimer.c is built plain, so the figures are host nanoseconds, for
+ *  comparing timer counts and changes to the wheel. The timers are
+ *  periodic, 5 ms to 10 s (debounce steps up to heartbeats and door
+ *  timeouts), with random phases, and the wheel is turned one tick per
+ *  call as the main loop does. Every SWTIMER_WHEEL_SLOTS ticks one
+ *  higher-level slot is cascaded; those ticks are also shown on their
+ *  own. The fires column is callbacks per tick.
+ *  The wheel runs in the main loop (swtimer.h), so this is what each
+ *  loop pass pays, not interrupt time.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <time.h>
+#include "services/swtimer.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define BENCH_TICKS             (2000000U)
+#define BENCH_MAX_TIMERS        (1000U)
+#define BENCH_MIN_PERIOD_MS     (5U)
+#define BENCH_MAX_PERIOD_MS     (10000U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static SWTIMER_Type timers[BENCH_MAX_TIMERS];
+static uint32_t     fires;
+static uint32_t     seed = 1U;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void onExpiry(void *context)
+{
+    (void)context;
+    fires++;
+}
+
+static void run(uint32_t count)
+{
+    uint64_t start;
+    uint64_t cascadeStart;
+    uint64_t cascadeNs = 0U;
+    uint64_t totalNs;
+    uint32_t cascades = 0U;
+    uint32_t tick;
+    uint32_t period;
+    uint32_t i;
+
+    SWTIMER_Init(0U);
+    for (i = 0U; i < count; i++)
+    {
+        period = BENCH_MIN_PERIOD_MS + (nextRandom() % (BENCH_MAX_PERIOD_MS - BENCH_MIN_PERIOD_MS));
+        SWTIMER_Setup(&timers[i], onExpiry, NULL);
+        SWTIMER_Start(&timers[i], 1U + (nextRandom() % period), period);
+    }
+    fires = 0U;
+
+    /* Only the cascading ticks are timed one by one (clock read included) */
+    start = nowNs();
+    for (tick = 1U; tick <= BENCH_TICKS; tick++)
+    {
+        if ((tick % SWTIMER_WHEEL_SLOTS) != 0U)
+        {
+            SWTIMER_Process(tick);
+            continue;
+        }
+        cascadeStart = nowNs();
+        SWTIMER_Process(tick);
+        cascadeNs += nowNs() - cascadeStart;
+        cascades++;
+    }
+    totalNs = nowNs() - start;
+
+    printf("  %6u  %9.1f  %11.1f  %7.3f\n", count, (double)totalNs / BENCH_TICKS,
+           (double)cascadeNs / cascades, (double)fires / BENCH_TICKS);
+
+    for (i = 0U; i < count; i++)
+    {
+        TEST_CHECK(SWTIMER_IsActive(&timers[i]), "%u timers: timer %u no longer armed", count, i);
+    }
+    TEST_CHECK(fires > 0U, "%u timers: nothing fired", count);
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = { 10U, 100U, BENCH_MAX_TIMERS };
+    uint32_t i;
+
+    printf("bench_swtimer: %u ticks per count, periods %u..%u ms, host time\n",
+           BENCH_TICKS, BENCH_MIN_PERIOD_MS, BENCH_MAX_PERIOD_MS);
+    printf("  %6s  %9s  %11s  %7s\n", "timers", "ns/tick", "cascade ns", "fires");
+
+    for (i = 0U; i < (sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        run(counts[i]);
+    }
+
+    return TEST_END();
+}
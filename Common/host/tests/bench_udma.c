@@ -0,0 +1,171 @@
+/*============================================================================
+ *  Module      : Host benchmarks
+ *  File Name   : bench_udma.c
+ *  Description : CPU cost of a 4 KB UART transmit: blocking, TX ring, uDMA
+ *
+ *  Each mode hands 4096 bytes to UART1 and the clock stops when the last
+ *  byte is in the hardware (FIFO or shift register). The thread sleeps in
+ *  CPUwfi() whenever it has nothing to do, so "CPU" is the time the core
+ *  was awake: thread work, busy-waiting and interrupt handlers.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include "mcal/mcal_uart.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define BENCH_BYTES             (4096U)
+#define TX_RING_SIZE            (256U)
+
+typedef enum
+{
+    MODE_BLOCKING = 0,
+    MODE_RING,
+    MODE_DMA
+} ModeType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static const char *const modeNames[] = { "blocking", "TX ring", "uDMA" };
+
+static uint8_t  data[BENCH_BYTES];
+static uint8_t  txRing[TX_RING_SIZE];
+static uint32_t baud;
+static ModeType mode;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+/* Sleep unless the condition already cleared; checked with interrupts
+ * masked so a handler cannot clear it between the check and the WFI */
+static void sleepWhile(uint8_t (*cond)(uint32_t))
+{
+    (void)CPUcpsid();
+    if (cond(UART1_BASE))
+    {
+        CPUwfi();
+    }
+    (void)CPUcpsie();
+}
+
+static uint8_t ringFull(uint32_t base)
+{
+    return (UART_GetTxPending(base) >= TX_RING_SIZE) ? 1U : 0U;
+}
+
+static uint8_t ringBusy(uint32_t base)
+{
+    return (UART_GetTxPending(base) != 0U) ? 1U : 0U;
+}
+
+static void run(void)
+{
+    UART_ConfigType cfg = { 0 };
+    SIM_StatsType   before;
+    SIM_StatsType   after;
+    uint64_t        start;
+    uint64_t        elapsed;
+    uint64_t        awake;
+    uint32_t        isrRuns;
+    uint32_t        sent = 0U;
+
+    SIM_Init();
+    SIM_SetLimit(10000U * SIM_CYCLES_PER_MS);
+
+    cfg.clockFreq = SysCtlClockGet();
+    cfg.uartBase  = UART1_BASE;
+    cfg.baudRate  = baud;
+    cfg.dataBits  = 8U;
+    cfg.stopBits  = 1U;
+    if (mode == MODE_RING)
+    {
+        cfg.txBuffer     = txRing;
+        cfg.txBufferSize = TX_RING_SIZE;
+    }
+    UART_init(&cfg);
+    IntMasterEnable();
+
+    SIM_GetStats(&before);
+    start = SIM_Now();
+
+    switch (mode)
+    {
+        case MODE_BLOCKING:
+            while (sent < BENCH_BYTES)
+            {
+                sendByte(UART1_BASE, data[sent++]);
+            }
+            break;
+
+        case MODE_RING:
+            while (sent < BENCH_BYTES)
+            {
+                while ((sent < BENCH_BYTES) && (UART_GetTxPending(UART1_BASE) < TX_RING_SIZE))
+                {
+                    sendByte(UART1_BASE, data[sent++]);
+                }
+                sleepWhile(ringFull);
+            }
+            while (ringBusy(UART1_BASE))
+            {
+                sleepWhile(ringBusy);
+            }
+            break;
+
+        case MODE_DMA:
+            (void)UART_StartDmaTx(UART1_BASE, data, BENCH_BYTES);
+            while (UART_IsDmaTxBusy(UART1_BASE))
+            {
+                sleepWhile(UART_IsDmaTxBusy);
+            }
+            break;
+    }
+
+    elapsed = SIM_Now() - start;
+    SIM_GetStats(&after);
+    awake   = elapsed - (after.sleepCycles - before.sleepCycles);
+    isrRuns = after.isrCount[INT_UART1] - before.isrCount[INT_UART1];
+
+    printf("  %7u  %-8s  %8.2f  %8.3f  %6.2f%%  %6u  %8.1f\n",
+           baud, modeNames[mode],
+           (double)elapsed / SIM_CYCLES_PER_MS,
+           (double)awake / SIM_CYCLES_PER_MS,
+           100.0 * (double)awake / (double)elapsed,
+           isrRuns,
+           (double)awake / BENCH_BYTES);
+}
+
+int main(void)
+{
+    static const uint32_t bauds[] = { 115200U, 921600U };
+    uint32_t b;
+    uint32_t i;
+
+    for (i = 0U; i < BENCH_BYTES; i++)
+    {
+        data[i] = (uint8_t)(i * 7U);
+    }
+
+    printf("bench_udma: %u bytes to UART1 at 16 MHz\n", BENCH_BYTES);
+    printf("  %7s  %-8s  %8s  %8s  %7s  %6s  %8s\n",
+           "baud", "mode", "wall ms", "CPU ms", "CPU", "ISRs", "cyc/byte");
+
+    for (b = 0U; b < (sizeof(bauds) / sizeof(bauds[0])); b++)
+    {
+        baud = bauds[b];
+        for (mode = MODE_BLOCKING; mode <= MODE_DMA; mode++)
+        {
+            TEST_Isolated(run);
+        }
+    }
+
+    return TEST_END();
+}
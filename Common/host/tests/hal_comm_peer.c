@@ -0,0 +1,48 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : hal_comm_peer.c
+ *  Description : The HMI's hal_comm.c built again as PEER_HAL_COMM_* on
+ *                UART2 (see hal_comm_peer.h)
+ *
+ *  Listed as firmware (<name>_FW), so it is instrumented like the
+ *  instance it talks to.
+ *===========================================================================*/
+
+#define HAL_COMM_PORT   HAL_COMM_PORT_UART2
+
+#define HAL_COMM_Flush               PEER_HAL_COMM_Flush
+#define HAL_COMM_GetBaudRate         PEER_HAL_COMM_GetBaudRate
+#define HAL_COMM_GetSourceNode       PEER_HAL_COMM_GetSourceNode
+#define HAL_COMM_GetStats            PEER_HAL_COMM_GetStats
+#define HAL_COMM_Init                PEER_HAL_COMM_Init
+#define HAL_COMM_IsDataAvailable     PEER_HAL_COMM_IsDataAvailable
+#define HAL_COMM_IsNodeAlive         PEER_HAL_COMM_IsNodeAlive
+#define HAL_COMM_IsPeerAlive         PEER_HAL_COMM_IsPeerAlive
+#define HAL_COMM_IsReceiveComplete   PEER_HAL_COMM_IsReceiveComplete
+#define HAL_COMM_IsSendComplete      PEER_HAL_COMM_IsSendComplete
+#define HAL_COMM_NegotiateBaud       PEER_HAL_COMM_NegotiateBaud
+#define HAL_COMM_OnTick              PEER_HAL_COMM_OnTick
+#define HAL_COMM_Open                PEER_HAL_COMM_Open
+#define HAL_COMM_PollFrame           PEER_HAL_COMM_PollFrame
+#define HAL_COMM_PortFlush           PEER_HAL_COMM_PortFlush
+#define HAL_COMM_PortGetTxRoom       PEER_HAL_COMM_PortGetTxRoom
+#define HAL_COMM_PortReceiveByte     PEER_HAL_COMM_PortReceiveByte
+#define HAL_COMM_PortSendByte        PEER_HAL_COMM_PortSendByte
+#define HAL_COMM_PortSendString      PEER_HAL_COMM_PortSendString
+#define HAL_COMM_ReadRecording       PEER_HAL_COMM_ReadRecording
+#define HAL_COMM_ReceiveBuffer       PEER_HAL_COMM_ReceiveBuffer
+#define HAL_COMM_ReceiveByte         PEER_HAL_COMM_ReceiveByte
+#define HAL_COMM_ReceiveByteTimeout  PEER_HAL_COMM_ReceiveByteTimeout
+#define HAL_COMM_ReceiveBytesTimeout PEER_HAL_COMM_ReceiveBytesTimeout
+#define HAL_COMM_ReceiveFrameTimeout PEER_HAL_COMM_ReceiveFrameTimeout
+#define HAL_COMM_ReceiveString       PEER_HAL_COMM_ReceiveString
+#define HAL_COMM_ResetStats          PEER_HAL_COMM_ResetStats
+#define HAL_COMM_SelectNode          PEER_HAL_COMM_SelectNode
+#define HAL_COMM_SendBuffer          PEER_HAL_COMM_SendBuffer
+#define HAL_COMM_SendByte            PEER_HAL_COMM_SendByte
+#define HAL_COMM_SendFrame           PEER_HAL_COMM_SendFrame
+#define HAL_COMM_SendMessage         PEER_HAL_COMM_SendMessage
+#define HAL_COMM_SendString          PEER_HAL_COMM_SendString
+#define HAL_COMM_SetWaitHook         PEER_HAL_COMM_SetWaitHook
+
+#include "../../../HIMI_WS/src/hal_comm.c"
@@ -0,0 +1,27 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : hal_comm_peer.h
+ *  Description : A second HAL_COMM instance, for the far end in tests
+ *
+ *  hal_comm.c keeps its state in file statics, so one process holds one
+ *  end of the link. hal_comm_peer.c builds the HMI's copy a second time
+ *  on UART2 with the API renamed to PEER_HAL_COMM_*; wired to UART1 with
+ *  SIM_UART_Connect(), it is the HMI to the test's Control. Both are
+ *  built with the same hal_comm.h settings (the program's _DEFS).
+ *===========================================================================*/
+
+#ifndef HAL_COMM_PEER_H_
+#define HAL_COMM_PEER_H_
+
+#include "hal/hal_comm.h"
+
+uint8_t  PEER_HAL_COMM_Init(void);
+boolean  PEER_HAL_COMM_PollFrame(FRAME_Type *frame);
+uint8_t  PEER_HAL_COMM_SendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len);
+uint32_t PEER_HAL_COMM_NegotiateBaud(void);
+void     PEER_HAL_COMM_SetWaitHook(HAL_COMM_WaitHookType hook);
+uint32_t PEER_HAL_COMM_GetBaudRate(void);
+void     PEER_HAL_COMM_OnTick(void);
+void     PEER_HAL_COMM_GetStats(HAL_COMM_StatsType *stats);
+
+#endif /* HAL_COMM_PEER_H_ */
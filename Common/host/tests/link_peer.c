@@ -0,0 +1,14 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : link_peer.c
+ *  Description : link.c built again as PEER_LINK_* (see link_peer.h)
+ *===========================================================================*/
+
+#define LINK_Init       PEER_LINK_Init
+#define LINK_Send       PEER_LINK_Send
+#define LINK_OnFrame    PEER_LINK_OnFrame
+#define LINK_Tick       PEER_LINK_Tick
+#define LINK_IsIdle     PEER_LINK_IsIdle
+#define LINK_GetStats   PEER_LINK_GetStats
+
+#include "../../src/services/link.c"
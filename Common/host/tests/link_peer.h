@@ -0,0 +1,23 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : link_peer.h
+ *  Description : A second link layer instance, for the far end in tests
+ *
+ *  link.c keeps its state in file statics, so one process holds one end.
+ *  link_peer.c builds link.c a second time with the API renamed to
+ *  PEER_LINK_*, giving the test both ends of the link.
+ *===========================================================================*/
+
+#ifndef LINK_PEER_H_
+#define LINK_PEER_H_
+
+#include "services/link.h"
+
+void    PEER_LINK_Init(LINK_SendFnType sendFn, uint32_t nowMs);
+uint8_t PEER_LINK_Send(uint8_t cmd, const uint8_t *payload, uint8_t len, uint32_t nowMs);
+boolean PEER_LINK_OnFrame(const FRAME_Type *in, FRAME_Type *out, uint32_t nowMs);
+void    PEER_LINK_Tick(uint32_t nowMs);
+boolean PEER_LINK_IsIdle(void);
+void    PEER_LINK_GetStats(LINK_StatsType *stats);
+
+#endif /* LINK_PEER_H_ */
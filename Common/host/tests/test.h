@@ -0,0 +1,64 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test.h
+ *  Description : Check and report helpers shared by the host tests
+ *
+ *  A failed TEST_CHECK prints where and why and is counted; TEST_END()
+ *  turns the count into the exit status, so make stops at the first
+ *  failing program.
+ *
+ *  Firmware modules keep their state in statics that nothing resets, so
+ *  a scenario that needs a freshly booted firmware runs through
+ *  TEST_Isolated(), in a child process of its own.
+ *===========================================================================*/
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static unsigned int testFailures = 0U;
+
+#define TEST_CHECK(cond, ...)                                               \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            fprintf(stderr, "%s:%d: FAIL: ", __FILE__, __LINE__);           \
+            fprintf(stderr, __VA_ARGS__);                                   \
+            fputc('\n', stderr);                                            \
+            testFailures++;                                                 \
+        }                                                                   \
+    } while (0)
+
+/* Run fn in a child process and add its failures to ours */
+static inline void TEST_Isolated(void (*fn)(void))
+{
+    pid_t pid;
+    int   status = 0;
+
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if (pid == 0)
+    {
+        fn();
+        exit((testFailures > 100U) ? 100 : (int)testFailures);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status))
+    {
+        fprintf(stderr, "FAIL: scenario did not finish\n");
+        testFailures++;
+        return;
+    }
+    testFailures += (unsigned int)WEXITSTATUS(status);
+}
+
+#define TEST_END()                                                          \
+    ((testFailures == 0U) ? (printf("PASS\n"), 0)                           \
+                          : (printf("FAILED (%u)\n", testFailures), 1))
+
+#endif /* TEST_H_ */
@@ -0,0 +1,322 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_baud.c
+ *  Description : Baud negotiation between two hal_comm.c instances over a
+ *                noisy line
+ *
+ *  Control's hal_comm.c on UART1 proposes, the HMI's (hal_comm_peer.c) on
+ *  UART2 answers, the two UARTs wired as a null modem. Each runs on its
+ *  own stack: Control in HAL_COMM_NegotiateBaud(), the HMI in its main
+ *  loop around PEER_HAL_COMM_PollFrame(); each side's wait hook hands
+ *  over to the other. The line flips bits at a rate of its own per baud
+ *  (BER_NOISY above cleanUpTo, none at or below), both ways.
+ *
+ *  - Clean up to 921600: both settle on 921600, cached in the EEPROM.
+ *  - Cached 460800, all clean: only the cached rate is tried and kept.
+ *  - Cached 2000000, now noisy: dropped, the probe settles on 921600.
+ *  - All noisy: both stay at the base rate and the cache is cleared. A
+ *    renegotiation within HAL_COMM_BAUD_REPROBE_MS sends nothing; one
+ *    after it, with the line clean again, probes and settles.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <string.h>
+#include <ucontext.h>
+#include "hal_comm_peer.h"
+#include "mcal/mcal_eeprom.h"
+#include "mcal/mcal_systick.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_UART1               (1U)
+#define SIM_UART2               (2U)
+#define BER_NOISY               (0.01)          /* Bit errors per bit on a noisy rate */
+#define STACK_SIZE              (64U * 1024U)
+#define MAX_TRIED               (8U)
+#define MINUTE_MS               (60U * 1000U)
+#define BAUD_TOLERANCE_PCT      (3U)            /* The divisors' rounding error */
+
+#if (HAL_COMM_RELIABLE != 0)
+#error "test_baud drives the raw frame layer (HAL_COMM_RELIABLE=0, Makefile)"
+#endif
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static ucontext_t mainCtx;
+static ucontext_t ctrlCtx;
+static ucontext_t hmiCtx;
+static uint8_t    ctrlStack[STACK_SIZE];
+static uint8_t    hmiStack[STACK_SIZE];
+
+static uint32_t cleanUpTo;                  /* Fastest rate without bit errors */
+static uint32_t seed;
+static uint32_t tried[MAX_TRIED];           /* Rates Control sent at, in order */
+static uint32_t triedCount;
+static uint32_t negotiated;                 /* HAL_COMM_NegotiateBaud() result */
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+/* The nominal rate the UART's divisors stand for (0: none of them) */
+static uint32_t nominal(uint32_t baud)
+{
+    static const uint32_t rates[] = HAL_COMM_BAUD_CANDIDATES;
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        if (((baud * 100U) >= (rates[i] * (100U - BAUD_TOLERANCE_PCT))) &&
+            ((baud * 100U) <= (rates[i] * (100U + BAUD_TOLERANCE_PCT))))
+        {
+            return rates[i];
+        }
+    }
+
+    return ((baud * 100U) >= (HAL_COMM_BAUD_RATE * (100U - BAUD_TOLERANCE_PCT))) ?
+           HAL_COMM_BAUD_RATE : 0U;
+}
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+static uint8_t noise(uint8_t uart, uint8_t data, uint32_t baud)
+{
+    uint8_t bit;
+
+    baud = nominal(baud);
+    if ((uart == SIM_UART1) && (baud != HAL_COMM_BAUD_RATE) &&
+        ((triedCount == 0U) || (tried[triedCount - 1U] != baud)) && (triedCount < MAX_TRIED))
+    {
+        tried[triedCount++] = baud;
+    }
+
+    if (baud > cleanUpTo)
+    {
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            if ((nextRandom() % 1000000U) < (uint32_t)(BER_NOISY * 1000000.0))
+            {
+                data ^= (uint8_t)(1U << bit);
+            }
+        }
+    }
+
+    return data;
+}
+
+/* Each side waits by letting the other run */
+static void ctrlWait(void)
+{
+    swapcontext(&ctrlCtx, &hmiCtx);
+}
+
+static void hmiWait(void)
+{
+    swapcontext(&hmiCtx, &ctrlCtx);
+}
+
+static void hmiMain(void)
+{
+    FRAME_Type frame;
+
+    for (;;)
+    {
+        (void)PEER_HAL_COMM_PollFrame(&frame);
+        hmiWait();
+    }
+}
+
+static void ctrlNegotiate(void)
+{
+    negotiated = HAL_COMM_NegotiateBaud();
+}
+
+static uint32_t cachedBaud(void)
+{
+    uint32_t word = 0xFFFFFFFFU;
+
+    (void)MCAL_EEPROM_ReadWord(HAL_COMM_BAUD_CACHE_ADDR, &word);
+    return word;
+}
+
+/* Boot both ends with the cache word as given */
+static void boot(uint32_t cache, uint32_t clean)
+{
+    SIM_Init();
+    SIM_SetLimit(2ULL * 60U * MINUTE_MS * SIM_CYCLES_PER_MS);
+    SIM_UART_Connect(SIM_UART1, SIM_UART2);
+    SIM_UART_SetNoise(SIM_UART1, noise);
+    SIM_UART_SetNoise(SIM_UART2, noise);
+    cleanUpTo = clean;
+    seed      = 7U;
+
+    MCAL_SysTick_Init();
+    (void)MCAL_EEPROM_Init();
+    (void)MCAL_EEPROM_WriteWord(HAL_COMM_BAUD_CACHE_ADDR, cache);
+    (void)HAL_COMM_Init();
+    (void)PEER_HAL_COMM_Init();
+    HAL_COMM_SetWaitHook(ctrlWait);
+    PEER_HAL_COMM_SetWaitHook(hmiWait);
+    IntMasterEnable();
+
+    getcontext(&hmiCtx);
+    hmiCtx.uc_stack.ss_sp   = hmiStack;
+    hmiCtx.uc_stack.ss_size = sizeof(hmiStack);
+    hmiCtx.uc_link          = NULL;
+    makecontext(&hmiCtx, hmiMain, 0);
+}
+
+/* One HAL_COMM_NegotiateBaud() on Control, the HMI answering */
+static void negotiate(void)
+{
+    triedCount = 0U;
+
+    getcontext(&ctrlCtx);
+    ctrlCtx.uc_stack.ss_sp   = ctrlStack;
+    ctrlCtx.uc_stack.ss_size = sizeof(ctrlStack);
+    ctrlCtx.uc_link          = &mainCtx;
+    makecontext(&ctrlCtx, ctrlNegotiate, 0);
+    swapcontext(&mainCtx, &ctrlCtx);
+}
+
+/* Let the tick run on to ms with nothing on the line */
+static void sleepUntil(uint32_t ms)
+{
+    while (MCAL_SysTick_GetTickMs() < ms)
+    {
+        MCAL_SysTick_Sleep(ms - MCAL_SysTick_GetTickMs());
+    }
+}
+
+static void report(const char *name)
+{
+    uint32_t i;
+
+    printf("  %-13s: %7u baud, cache %7u, tried", name, negotiated, cachedBaud());
+    for (i = 0U; i < triedCount; i++)
+    {
+        printf(" %u", tried[i]);
+    }
+    printf("%s\n", (triedCount == 0U) ? " nothing" : "");
+}
+
+static void checkAgreed(const char *name, uint32_t baud)
+{
+    TEST_CHECK(negotiated == baud, "%s: negotiated %u, expected %u", name, negotiated, baud);
+    TEST_CHECK((HAL_COMM_GetBaudRate() == baud) && (PEER_HAL_COMM_GetBaudRate() == baud),
+               "%s: Control at %u, HMI at %u, expected %u", name, HAL_COMM_GetBaudRate(),
+               PEER_HAL_COMM_GetBaudRate(), baud);
+    TEST_CHECK((nominal(SIM_UART_GetBaud(SIM_UART1)) == baud) &&
+               (nominal(SIM_UART_GetBaud(SIM_UART2)) == baud),
+               "%s: UART1 at %u, UART2 at %u, expected %u", name,
+               SIM_UART_GetBaud(SIM_UART1), SIM_UART_GetBaud(SIM_UART2), baud);
+}
+
+static void checkTried(const char *name, const uint32_t *expected, uint32_t count)
+{
+    TEST_CHECK((triedCount == count) &&
+               (memcmp(tried, expected, count * sizeof(tried[0])) == 0),
+               "%s: %u rates tried, expected %u", name, triedCount, count);
+}
+
+static void testClean(void)
+{
+    static const uint32_t expected[] = { 2000000U, 1000000U, 921600U };
+
+    boot(0U, 921600U);
+    negotiate();
+    report("fresh");
+
+    checkAgreed("fresh", 921600U);
+    checkTried("fresh", expected, 3U);
+    TEST_CHECK(cachedBaud() == 921600U, "fresh: cache %u", cachedBaud());
+}
+
+static void testCached(void)
+{
+    static const uint32_t expected[] = { 460800U };
+
+    boot(460800U, 2000000U);
+    negotiate();
+    report("cached");
+
+    checkAgreed("cached", 460800U);
+    checkTried("cached", expected, 1U);
+    TEST_CHECK(cachedBaud() == 460800U, "cached: cache %u", cachedBaud());
+}
+
+static void testStale(void)
+{
+    static const uint32_t expected[] = { 2000000U, 1000000U, 921600U };
+
+    boot(2000000U, 921600U);
+    negotiate();
+    report("stale cache");
+
+    checkAgreed("stale cache", 921600U);
+    checkTried("stale cache", expected, 3U);
+    TEST_CHECK(cachedBaud() == 921600U, "stale cache: cache %u", cachedBaud());
+}
+
+static void testNoisy(void)
+{
+    static const uint32_t expected[] = { 460800U, 2000000U, 1000000U, 921600U, 230400U };
+    static const uint32_t again[]    = { 2000000U, 1000000U, 921600U };
+    SIM_UART_StatsType before;
+    SIM_UART_StatsType after;
+    uint32_t           failedMs;
+
+    boot(460800U, HAL_COMM_BAUD_RATE);
+    negotiate();
+    failedMs = MCAL_SysTick_GetTickMs();
+    report("all noisy");
+
+    checkAgreed("all noisy", HAL_COMM_BAUD_RATE);
+    checkTried("all noisy", expected, 5U);
+    TEST_CHECK(cachedBaud() == 0U, "all noisy: cache %u", cachedBaud());
+
+    /* Within the backoff: not a byte on the line */
+    sleepUntil(failedMs + (59U * MINUTE_MS));
+    SIM_UART_GetStats(SIM_UART1, &before);
+    negotiate();
+    SIM_UART_GetStats(SIM_UART1, &after);
+    report("+59 min");
+
+    checkAgreed("+59 min", HAL_COMM_BAUD_RATE);
+    TEST_CHECK(after.txBytes == before.txBytes, "+59 min: %u bytes sent",
+               after.txBytes - before.txBytes);
+
+    /* Past it, on a line that has cleared up */
+    cleanUpTo = 921600U;
+    sleepUntil(failedMs + (61U * MINUTE_MS));
+    negotiate();
+    report("+61 min");
+
+    checkAgreed("+61 min", 921600U);
+    checkTried("+61 min", again, 3U);
+    TEST_CHECK(cachedBaud() == 921600U, "+61 min: cache %u", cachedBaud());
+}
+
+int main(void)
+{
+    printf("test_baud: Control (UART1) proposes to the HMI (UART2) from %u baud, "
+           "bit error rate %g above the clean rates\n", HAL_COMM_BAUD_RATE, BER_NOISY);
+
+    TEST_Isolated(testClean);
+    TEST_Isolated(testCached);
+    TEST_Isolated(testStale);
+    TEST_Isolated(testNoisy);
+
+    return TEST_END();
+}
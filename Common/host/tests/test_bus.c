@@ -0,0 +1,272 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_bus.c
+ *  Description : One bus slave (hal_comm.c) among eight RS-485 panels
+ *
+ *  hal_comm.c runs unchanged as panel BUS_PANEL of HAL_COMM_BUS_NODES on
+ *  UART1 at 115200. Everything else on the bus is modelled here: the
+ *  master polls the panels round-robin and gives each HAL_COMM_BUS_REPLY_MS
+ *  after its poll to answer; the seven other panels answer their polls
+ *  after a latency of their own (panelLatencyUs), the slowest not at all.
+ *  The panel under test answers from its main loop, which only gets round
+ *  to HAL_COMM_PollFrame() between stretches of other work.
+ *
+ *  - Prompt: the main loop comes back within 1 ms. Every turn is answered.
+ *  - Sluggish: stretches of up to 16 ms, longer than the reply window, so
+ *    polls are often read after the master has moved on, behind other
+ *    panels' traffic or alone in the ring. An answer must never start
+ *    outside the panel's own turn; some turns are still answered.
+ *
+ *  The master's side, Control's hal_comm.c against modelled panels, is
+ *  test_bus_master.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <string.h>
+#include "hal/hal_comm.h"
+#include "mcal/mcal_systick.h"
+#include "services/frame.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_UART1               (1U)
+#define BUS_PANEL               (HAL_COMM_NODE_ADDRESS)
+#define BUS_RUN_MS              (3000U)
+#define BUS_TURN_GAP_CYCLES     (100U * SIM_CYCLES_PER_US)  /* Master between turns */
+#define BUS_NO_ANSWER           (0xFFFFFFFFU)
+
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_SLAVE) || (HAL_COMM_BUS_NODES != 8U)
+#error "test_bus needs hal_comm.h built as a slave on an 8-panel bus (Makefile)"
+#endif
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef enum
+{
+    BUS_POLL = 0,           /* Master polls the next panel at nextAt */
+    BUS_TURN                /* Turn over at nextAt, unless answered sooner */
+} BusPhaseType;
+
+typedef struct
+{
+    uint32_t turns;
+    uint32_t answers;
+} PanelStatsType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+/* Reply latency of each panel after the end of its poll; BUS_PANEL is
+ * the firmware, and the last panel is too slow to ever answer */
+static const uint32_t panelLatencyUs[HAL_COMM_BUS_NODES] =
+{
+    300U, 1200U, 0U, 2500U, 600U, 4000U, 1800U, BUS_NO_ANSWER
+};
+
+static BusPhaseType     phase;
+static uint64_t         nextAt;
+static uint8_t          turnNode;
+static uint64_t         turnDeadline;   /* Master gives up waiting */
+static uint64_t         charCycles;
+static PanelStatsType   panels[HAL_COMM_BUS_NODES];
+static FRAME_ParserType answerParser;   /* What the firmware panel sends */
+static boolean          answerStarted;
+static uint32_t         collisions;
+static uint32_t         seed;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+/* Queue an addressed frame on the bus from cycle at; returns its end */
+static uint64_t busPut(uint8_t addr, uint8_t cmd, uint64_t at)
+{
+    uint8_t  wire[FRAME_MAX_SIZE];
+    uint16_t len = FRAME_Encode(cmd, &addr, 1U, wire, (uint16_t)sizeof(wire));
+
+    SIM_UART_Inject(SIM_UART1, wire, len, at);
+    return at + (len * charCycles);
+}
+
+static void startTurn(uint64_t now)
+{
+    uint64_t pollEnd;
+    uint32_t latency;
+
+    turnNode = (uint8_t)((turnNode % HAL_COMM_BUS_NODES) + 1U);
+    latency  = panelLatencyUs[turnNode - 1U];
+    panels[turnNode - 1U].turns++;
+
+    pollEnd       = busPut(turnNode, HAL_COMM_CMD_POLL, now);
+    turnDeadline  = pollEnd + ((uint64_t)HAL_COMM_BUS_REPLY_MS * SIM_CYCLES_PER_MS);
+    answerStarted = FALSE;
+    phase         = BUS_TURN;
+    nextAt        = turnDeadline;
+
+    /* Modelled panels keep to the same rule as the firmware */
+    if ((turnNode != BUS_PANEL) &&
+        (latency < ((HAL_COMM_BUS_REPLY_MS / 2U) * 1000U)))
+    {
+        nextAt = busPut(turnNode, HAL_COMM_CMD_HEARTBEAT,
+                        pollEnd + ((uint64_t)latency * SIM_CYCLES_PER_US));
+        panels[turnNode - 1U].answers++;
+    }
+}
+
+/* Bytes from the firmware panel: an answer must start inside its turn */
+static void onTx(uint8_t uart, uint8_t data)
+{
+    uint64_t now = SIM_Now();
+
+    (void)uart;
+
+    if (!FRAME_ParserIsBusy(&answerParser))
+    {
+        if ((phase != BUS_TURN) || (turnNode != BUS_PANEL) || answerStarted ||
+            ((now - charCycles) > turnDeadline))
+        {
+            collisions++;
+        }
+        answerStarted = TRUE;
+    }
+
+    if ((FRAME_ParserFeed(&answerParser, data) == FRAME_STATUS_COMPLETE) &&
+        (turnNode == BUS_PANEL) && (phase == BUS_TURN))
+    {
+        /* Heard: the master moves on at once */
+        panels[BUS_PANEL - 1U].answers++;
+        nextAt = now;
+    }
+}
+
+static void busReset(void)
+{
+    phase    = BUS_POLL;
+    nextAt   = 0U;
+    turnNode = 0U;
+    FRAME_ParserInit(&answerParser);
+}
+
+static uint64_t busNextEvent(void)
+{
+    return nextAt;
+}
+
+static void busProcess(uint64_t now)
+{
+    if (now < nextAt)
+    {
+        return;
+    }
+
+    if (phase == BUS_POLL)
+    {
+        startTurn(now);
+    }
+    else
+    {
+        phase  = BUS_POLL;
+        nextAt = now + BUS_TURN_GAP_CYCLES;
+    }
+}
+
+static const SIM_ModelType busModel = { "rs485 bus", busReset, busNextEvent, busProcess };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&busModel);
+}
+
+/* Boot the panel and run its main loop with stretches of up to maxBusyUs */
+static void run(uint32_t maxBusyUs, uint32_t rngSeed)
+{
+    FRAME_Type frame;
+    uint64_t   end;
+
+    SIM_Init();
+    SIM_SetLimit((BUS_RUN_MS + 1000U) * SIM_CYCLES_PER_MS);
+    memset(panels, 0, sizeof(panels));
+    collisions = 0U;
+    seed       = rngSeed;
+
+    MCAL_SysTick_Init();
+    (void)HAL_COMM_Init();
+    IntMasterEnable();
+    charCycles = (10U * SIM_CLOCK_HZ) / SIM_UART_GetBaud(SIM_UART1);
+    SIM_UART_SetTxHook(SIM_UART1, onTx);
+
+    end = SIM_Now() + ((uint64_t)BUS_RUN_MS * SIM_CYCLES_PER_MS);
+    while (SIM_Now() < end)
+    {
+        (void)HAL_COMM_PollFrame(&frame);
+        SIM_Run((uint64_t)(nextRandom() % (maxBusyUs + 1U)) * SIM_CYCLES_PER_US);
+    }
+}
+
+static void report(const char *name)
+{
+    uint32_t i;
+
+    printf("  %-8s: panel %u answered %3u of %3u turns, %u collisions; others",
+           name, BUS_PANEL, panels[BUS_PANEL - 1U].answers, panels[BUS_PANEL - 1U].turns,
+           collisions);
+    for (i = 0U; i < HAL_COMM_BUS_NODES; i++)
+    {
+        if ((i + 1U) != BUS_PANEL)
+        {
+            printf(" %u/%u", panels[i].answers, panels[i].turns);
+        }
+    }
+    printf("\n");
+}
+
+static void testPrompt(void)
+{
+    const PanelStatsType *own = &panels[BUS_PANEL - 1U];
+
+    run(1000U, 3U);
+    report("prompt");
+
+    TEST_CHECK(collisions == 0U, "prompt: %u answers outside the panel's turn", collisions);
+    TEST_CHECK((own->turns > 50U) && ((own->answers + 1U) >= own->turns),
+               "prompt: answered %u of %u turns", own->answers, own->turns);
+}
+
+static void testSluggish(void)
+{
+    const PanelStatsType *own = &panels[BUS_PANEL - 1U];
+
+    run(16000U, 5U);
+    report("sluggish");
+
+    TEST_CHECK(collisions == 0U, "sluggish: %u answers outside the panel's turn", collisions);
+    TEST_CHECK(own->answers > 0U, "sluggish: no turn answered in %u", own->turns);
+    TEST_CHECK(own->answers < own->turns, "sluggish: every one of %u turns answered",
+               own->turns);
+}
+
+int main(void)
+{
+    printf("test_bus: panel %u of %u at %u baud, %u ms reply window, the master "
+           "and the other panels modelled\n", BUS_PANEL, HAL_COMM_BUS_NODES,
+           HAL_COMM_BAUD_RATE, HAL_COMM_BUS_REPLY_MS);
+
+    TEST_Isolated(testPrompt);
+    TEST_Isolated(testSluggish);
+
+    return TEST_END();
+}
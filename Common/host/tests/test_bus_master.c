@@ -0,0 +1,363 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_bus_master.c
+ *  Description : Control's hal_comm.c as the master of eight RS-485 panels
+ *
+ *  hal_comm.c runs unchanged as the bus master on UART1 at 115200; the
+ *  test's main loop is Control's, sending each panel a request and taking
+ *  the answers from HAL_COMM_PollFrame() between stretches of other work.
+ *  The panels are modelled here: each answers what is addressed to it
+ *  (a request with a response, a poll with a heartbeat) after a latency
+ *  of its own with up to half of it again as jitter; the last panel never
+ *  answers. Request to response is timed per panel on the sim clock, from
+ *  HAL_COMM_SendFrame() to the HAL_COMM_PollFrame() that returns it.
+ *
+ *  - Prompt: the main loop comes back within 200 us.
+ *  - Busy: stretches of up to 4 ms; turns are only handed on from
+ *    HAL_COMM_PollFrame(), so the round gets longer, never unfair.
+ *  Either way the master must never transmit while a panel answers, every
+ *  answering panel must get each request within one round, and the silent
+ *  panel must cost the others no more than its reply window.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <string.h>
+#include "hal/hal_comm.h"
+#include "mcal/mcal_systick.h"
+#include "services/frame.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_UART1               (1U)
+#define BUS_RUN_MS              (3000U)
+#define BUS_NO_ANSWER           (0xFFFFFFFFU)
+#define CMD_REQUEST             ('Q')
+#define RESP_REQUEST            ('R')
+#define REQUEST_TIMEOUT_MS      (200U)          /* The application gives up */
+#define REQUEST_GAP_MAX_US      (100000U)       /* Before a panel's next request */
+
+#if (HAL_COMM_BUS_MODE != HAL_COMM_BUS_MASTER) || (HAL_COMM_BUS_NODES != 8U)
+#error "test_bus_master needs hal_comm.h built as the master of 8 panels (Makefile)"
+#endif
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef struct
+{
+    /* Application side */
+    boolean  pending;
+    uint8_t  seq;
+    uint64_t sentAt;
+    uint64_t nextAt;
+    uint32_t sent;
+    uint32_t answered;
+    uint32_t timeouts;
+    uint64_t minCycles;
+    uint64_t maxCycles;
+    uint64_t sumCycles;
+
+    /* Bus side */
+    uint32_t polls;
+} PanelType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+/* Answer latency of each panel after the end of the frame addressed to
+ * it, jitter on top; the last panel is not there */
+static const uint32_t panelLatencyUs[HAL_COMM_BUS_NODES] =
+{
+    100U, 300U, 600U, 1000U, 1500U, 2500U, 4000U, BUS_NO_ANSWER
+};
+
+static PanelType        panels[HAL_COMM_BUS_NODES];
+static FRAME_ParserType masterParser;   /* What the firmware master sends */
+static uint64_t         charCycles;
+static uint8_t          answerWire[FRAME_MAX_SIZE];
+static uint16_t         answerLen;
+static uint64_t         answerAt = SIM_NEVER;   /* Next answer due on the line */
+static uint64_t         answerStart;            /* Last answer on the line ... */
+static uint64_t         answerEnd;              /* ... until here */
+static uint32_t         collisions;
+static uint32_t         seed;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+/* A frame from the master: the addressed panel answers it, if it is there */
+static void panelAnswer(const FRAME_Type *frame, uint64_t now)
+{
+    uint8_t  payload[FRAME_MAX_PAYLOAD];
+    uint8_t  node = frame->payload[0];
+    uint32_t latency;
+    uint8_t  cmd;
+
+    if ((frame->len < 1U) || (node < 1U) || (node > HAL_COMM_BUS_NODES))
+    {
+        return;     /* Broadcast, or nothing for a panel */
+    }
+
+    if (frame->cmd == HAL_COMM_CMD_POLL)
+    {
+        panels[node - 1U].polls++;
+        cmd = HAL_COMM_CMD_HEARTBEAT;
+    }
+    else if (frame->cmd == CMD_REQUEST)
+    {
+        cmd = RESP_REQUEST;
+    }
+    else
+    {
+        return;
+    }
+
+    latency = panelLatencyUs[node - 1U];
+    if (latency == BUS_NO_ANSWER)
+    {
+        return;
+    }
+    latency += nextRandom() % ((latency / 2U) + 1U);
+
+    /* [own address][the request's payload back] */
+    memcpy(payload, frame->payload, frame->len);
+    answerLen = FRAME_Encode(cmd, payload, (cmd == HAL_COMM_CMD_HEARTBEAT) ? 1U : frame->len,
+                             answerWire, (uint16_t)sizeof(answerWire));
+    answerAt  = now + ((uint64_t)latency * SIM_CYCLES_PER_US);
+}
+
+/* Bytes from the firmware master: none may share the line with an answer */
+static void onTx(uint8_t uart, uint8_t data)
+{
+    uint64_t now = SIM_Now();
+
+    (void)uart;
+
+    if (((now - charCycles) < answerEnd) && (now > answerStart))
+    {
+        collisions++;
+    }
+
+    if (FRAME_ParserFeed(&masterParser, data) == FRAME_STATUS_COMPLETE)
+    {
+        panelAnswer(&masterParser.frame, now);
+    }
+}
+
+static void busReset(void)
+{
+    answerAt    = SIM_NEVER;
+    answerStart = 0U;
+    answerEnd   = 0U;
+    FRAME_ParserInit(&masterParser);
+}
+
+static uint64_t busNextEvent(void)
+{
+    return answerAt;
+}
+
+static void busProcess(uint64_t now)
+{
+    if (now < answerAt)
+    {
+        return;
+    }
+
+    SIM_UART_Inject(SIM_UART1, answerWire, answerLen, now);
+    answerStart = now;
+    answerEnd   = now + (answerLen * charCycles);
+    answerAt    = SIM_NEVER;
+}
+
+static const SIM_ModelType busModel = { "rs485 panels", busReset, busNextEvent, busProcess };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&busModel);
+}
+
+/* Control's side: a request to every panel that is due one */
+static void sendRequests(uint64_t now)
+{
+    PanelType *panel;
+    uint8_t    node;
+
+    for (node = 1U; node <= HAL_COMM_BUS_NODES; node++)
+    {
+        panel = &panels[node - 1U];
+
+        if (panel->pending &&
+            ((now - panel->sentAt) >= ((uint64_t)REQUEST_TIMEOUT_MS * SIM_CYCLES_PER_MS)))
+        {
+            panel->pending = FALSE;
+            panel->timeouts++;
+        }
+        if (panel->pending || (now < panel->nextAt))
+        {
+            continue;
+        }
+
+        panel->seq++;
+        HAL_COMM_SelectNode(node);
+        if (HAL_COMM_SendFrame(CMD_REQUEST, &panel->seq, 1U) == HAL_COMM_SUCCESS)
+        {
+            panel->pending = TRUE;
+            panel->sentAt  = SIM_Now();
+            panel->sent++;
+        }
+    }
+}
+
+/* Control's side: match the answers to their requests */
+static void takeAnswers(void)
+{
+    FRAME_Type frame;
+    PanelType *panel;
+    uint64_t   took;
+
+    while (HAL_COMM_PollFrame(&frame))
+    {
+        panel = &panels[HAL_COMM_GetSourceNode() - 1U];
+        if ((frame.cmd != RESP_REQUEST) || (frame.len < 1U) || !panel->pending ||
+            (frame.payload[0] != panel->seq))
+        {
+            continue;
+        }
+
+        took = SIM_Now() - panel->sentAt;
+        panel->minCycles  = (panel->answered == 0U) ? took :
+                            ((took < panel->minCycles) ? took : panel->minCycles);
+        panel->maxCycles  = (took > panel->maxCycles) ? took : panel->maxCycles;
+        panel->sumCycles += took;
+        panel->answered++;
+        panel->pending = FALSE;
+        panel->nextAt  = SIM_Now() +
+                         ((uint64_t)(nextRandom() % REQUEST_GAP_MAX_US) * SIM_CYCLES_PER_US);
+    }
+}
+
+/* Boot the master and run Control's main loop with stretches of up to maxBusyUs */
+static void run(uint32_t maxBusyUs, uint32_t rngSeed)
+{
+    uint64_t end;
+
+    SIM_Init();
+    SIM_SetLimit((BUS_RUN_MS + 1000U) * SIM_CYCLES_PER_MS);
+    memset(panels, 0, sizeof(panels));
+    collisions = 0U;
+    seed       = rngSeed;
+
+    MCAL_SysTick_Init();
+    (void)HAL_COMM_Init();
+    IntMasterEnable();
+    charCycles = (10U * SIM_CLOCK_HZ) / SIM_UART_GetBaud(SIM_UART1);
+    SIM_UART_SetTxHook(SIM_UART1, onTx);
+
+    end = SIM_Now() + ((uint64_t)BUS_RUN_MS * SIM_CYCLES_PER_MS);
+    while (SIM_Now() < end)
+    {
+        sendRequests(SIM_Now());
+        takeAnswers();
+        SIM_Run((uint64_t)(nextRandom() % (maxBusyUs + 1U)) * SIM_CYCLES_PER_US);
+    }
+}
+
+/* Table of the run; checks what every scenario must meet */
+static void report(const char *name, uint32_t maxBusyUs)
+{
+    const PanelType *panel;
+    uint64_t boundCycles = 0U;
+    uint64_t slotCycles;
+    uint64_t slotMax = 0U;
+    uint32_t node;
+
+    /* A request waits for at most the turn in progress and one round:
+     * per turn a frame each way (2 bytes of payload), the panel's slowest
+     * answer or the reply window, and a main-loop stretch */
+    for (node = 1U; node <= HAL_COMM_BUS_NODES; node++)
+    {
+        slotCycles = (2U * (FRAME_OVERHEAD + 2U) * charCycles) +
+                     ((uint64_t)maxBusyUs * SIM_CYCLES_PER_US) +
+                     ((panelLatencyUs[node - 1U] == BUS_NO_ANSWER) ?
+                      ((uint64_t)HAL_COMM_BUS_REPLY_MS * SIM_CYCLES_PER_MS) :
+                      ((uint64_t)(panelLatencyUs[node - 1U] * 3U / 2U) * SIM_CYCLES_PER_US));
+        boundCycles += slotCycles;
+        slotMax      = (slotCycles > slotMax) ? slotCycles : slotMax;
+    }
+    boundCycles += slotMax;
+
+    printf("  %s, %u collisions\n", name, collisions);
+    printf("    panel  latency us  sent  answered  polls     min us    mean us     max us\n");
+    for (node = 1U; node <= HAL_COMM_BUS_NODES; node++)
+    {
+        panel = &panels[node - 1U];
+        if (panelLatencyUs[node - 1U] == BUS_NO_ANSWER)
+        {
+            printf("    %5u  %10s  %4u  %8u  %5u  %u timed out\n", node, "-", panel->sent,
+                   panel->answered, panel->polls, panel->timeouts);
+            TEST_CHECK((panel->answered == 0U) && (panel->timeouts > 0U),
+                       "%s: silent panel %u answered %u, %u timed out", name, node,
+                       panel->answered, panel->timeouts);
+            continue;
+        }
+
+        printf("    %5u  %10u  %4u  %8u  %5u  %9.1f  %9.1f  %9.1f\n", node,
+               panelLatencyUs[node - 1U], panel->sent, panel->answered, panel->polls,
+               (double)panel->minCycles / SIM_CYCLES_PER_US,
+               (panel->answered != 0U) ?
+                   ((double)panel->sumCycles / panel->answered / SIM_CYCLES_PER_US) : 0.0,
+               (double)panel->maxCycles / SIM_CYCLES_PER_US);
+
+        TEST_CHECK((panel->answered > 20U) && ((panel->answered + 1U) >= panel->sent) &&
+                   (panel->timeouts == 0U), "%s: panel %u answered %u of %u, %u timed out",
+                   name, node, panel->answered, panel->sent, panel->timeouts);
+        TEST_CHECK(panel->minCycles >= ((uint64_t)panelLatencyUs[node - 1U] * SIM_CYCLES_PER_US),
+                   "%s: panel %u answered in %u cycles", name, node,
+                   (unsigned)panel->minCycles);
+        TEST_CHECK(panel->maxCycles <= boundCycles, "%s: panel %u took up to %.1f us, "
+                   "one round is %.1f us", name, node,
+                   (double)panel->maxCycles / SIM_CYCLES_PER_US,
+                   (double)boundCycles / SIM_CYCLES_PER_US);
+    }
+
+    TEST_CHECK(collisions == 0U, "%s: master sent over %u answers", name, collisions);
+}
+
+static void testPrompt(void)
+{
+    run(200U, 3U);
+    report("prompt", 200U);
+}
+
+static void testBusy(void)
+{
+    run(4000U, 5U);
+    report("busy", 4000U);
+}
+
+int main(void)
+{
+    printf("test_bus_master: master of %u panels at %u baud, %u ms reply window, "
+           "request to response per panel\n", HAL_COMM_BUS_NODES, HAL_COMM_BAUD_RATE,
+           HAL_COMM_BUS_REPLY_MS);
+
+    TEST_Isolated(testPrompt);
+    TEST_Isolated(testBusy);
+
+    return TEST_END();
+}
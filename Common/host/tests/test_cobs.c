@@ -0,0 +1,313 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_cobs.c
+ *  Description : COBS codec round trips and decoder fuzzing (cobs.c)
+ *
+ *  - Round trip: random packets of 0..COBS_TEST_MAX_LEN bytes, with zero
+ *    densities from none to all, and the 254-byte block edges. The wire
+ *    form must hold no zero before the delimiter, fit COBS_MAX_ENCODED()
+ *    and decode to the packet.
+ *  - Short destination: every dstSize below the encoded size returns 0
+ *    and writes nothing past dstSize.
+ *  - Fuzz: random byte streams, and valid streams with bytes flipped,
+ *    dropped or inserted. The decoder must never write past its buffer
+ *    (guard bytes around it), never report more than it holds, and be
+ *    back in step with the first intact packet after a delimiter.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <string.h>
+#include "services/cobs.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define COBS_TEST_MAX_LEN       (600U)
+#define COBS_TEST_ROUNDS        (20000U)
+#define COBS_FUZZ_BYTES         (2000000U)
+#define COBS_DECODE_SIZE        (300U)
+#define COBS_GUARD              (16U)
+#define COBS_GUARD_BYTE         (0xA5U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t  packet[COBS_TEST_MAX_LEN];
+static uint8_t  wire[COBS_MAX_ENCODED(COBS_TEST_MAX_LEN) + COBS_GUARD];
+static uint8_t  decoded[COBS_GUARD + COBS_TEST_MAX_LEN + COBS_GUARD];
+static uint32_t seed = 1U;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+/* Own generator, so the sequences are the same on every host */
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+/* Packet of len bytes, each zero with probability zeroPct % */
+static void fillPacket(uint16_t len, uint32_t zeroPct)
+{
+    uint16_t i;
+
+    for (i = 0U; i < len; i++)
+    {
+        packet[i] = ((nextRandom() % 100U) < zeroPct) ? 0U
+                                                      : (uint8_t)(1U + (nextRandom() % 255U));
+    }
+}
+
+static void armGuards(void)
+{
+    memset(decoded, COBS_GUARD_BYTE, sizeof(decoded));
+}
+
+static boolean guardsIntact(uint16_t size)
+{
+    uint32_t i;
+
+    for (i = 0U; i < COBS_GUARD; i++)
+    {
+        if ((decoded[i] != COBS_GUARD_BYTE) ||
+            (decoded[COBS_GUARD + size + i] != COBS_GUARD_BYTE))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Encode packet[0..len), check the wire form and decode it back */
+static void roundTrip(uint16_t len, const char *what)
+{
+    COBS_DecoderType decoder;
+    COBS_StatusType  status = COBS_STATUS_PENDING;
+    uint16_t         size;
+    uint16_t         i;
+    uint16_t         zeros = 0U;
+
+    size = COBS_Encode(packet, len, wire, (uint16_t)sizeof(wire));
+    TEST_CHECK((size != 0U) && (size <= COBS_MAX_ENCODED(len)),
+               "%s len %u: encoded %u bytes, limit %u", what, len, size,
+               (unsigned)COBS_MAX_ENCODED(len));
+    if (size == 0U)
+    {
+        return;
+    }
+    for (i = 0U; i < (uint16_t)(size - 1U); i++)
+    {
+        zeros += (wire[i] == 0U) ? 1U : 0U;
+    }
+    TEST_CHECK((zeros == 0U) && (wire[size - 1U] == COBS_DELIMITER),
+               "%s len %u: %u zeros inside the packet", what, len, zeros);
+
+    armGuards();
+    COBS_DecoderInit(&decoder, &decoded[COBS_GUARD], COBS_TEST_MAX_LEN);
+    for (i = 0U; i < size; i++)
+    {
+        status = COBS_DecoderFeed(&decoder, wire[i]);
+        if ((status != COBS_STATUS_PENDING) && (i != (uint16_t)(size - 1U)))
+        {
+            break;
+        }
+    }
+    TEST_CHECK((status == COBS_STATUS_COMPLETE) && (decoder.length == len) &&
+               (memcmp(&decoded[COBS_GUARD], packet, len) == 0),
+               "%s len %u: decoded %u bytes, status %d", what, len, decoder.length,
+               (int)status);
+}
+
+static void testRoundTrip(void)
+{
+    static const uint32_t zeroPct[] = { 0U, 1U, 10U, 50U, 100U };
+    static const uint16_t edges[] = { 0U, 1U, 253U, 254U, 255U, 507U, 508U, 509U,
+                                      COBS_TEST_MAX_LEN };
+    uint32_t round;
+    uint32_t i;
+    uint16_t len;
+
+    for (i = 0U; i < (sizeof(edges) / sizeof(edges[0])); i++)
+    {
+        fillPacket(edges[i], 0U);
+        roundTrip(edges[i], "no zeros");
+        fillPacket(edges[i], 100U);
+        roundTrip(edges[i], "all zeros");
+        if (edges[i] != 0U)
+        {
+            /* A zero right at a block edge */
+            fillPacket(edges[i], 0U);
+            packet[edges[i] - 1U] = 0U;
+            roundTrip(edges[i], "trailing zero");
+        }
+    }
+
+    for (round = 0U; round < COBS_TEST_ROUNDS; round++)
+    {
+        len = (uint16_t)(nextRandom() % (COBS_TEST_MAX_LEN + 1U));
+        fillPacket(len, zeroPct[round % (sizeof(zeroPct) / sizeof(zeroPct[0]))]);
+        roundTrip(len, "random");
+    }
+}
+
+static void testShortDestination(void)
+{
+    uint16_t len;
+    uint16_t full;
+    uint16_t dstSize;
+    uint16_t i;
+    uint32_t overruns = 0U;
+    uint32_t accepted = 0U;
+
+    for (len = 0U; len <= 300U; len += 7U)
+    {
+        fillPacket(len, 5U);
+        full = COBS_Encode(packet, len, wire, (uint16_t)sizeof(wire));
+        for (dstSize = 0U; dstSize < full; dstSize++)
+        {
+            memset(wire, COBS_GUARD_BYTE, sizeof(wire));
+            accepted += (COBS_Encode(packet, len, wire, dstSize) != 0U) ? 1U : 0U;
+            for (i = dstSize; i < (uint16_t)(dstSize + COBS_GUARD); i++)
+            {
+                overruns += (wire[i] != COBS_GUARD_BYTE) ? 1U : 0U;
+            }
+        }
+    }
+
+    TEST_CHECK(accepted == 0U, "%u encodes into a too-small buffer succeeded", accepted);
+    TEST_CHECK(overruns == 0U, "%u bytes written past dstSize", overruns);
+}
+
+/* Feed a stream; count completes, check the guards and the lengths */
+static void feedChecked(COBS_DecoderType *decoder, const uint8_t *data, uint32_t len,
+                        uint32_t *complete, uint32_t *bad)
+{
+    uint32_t i;
+
+    for (i = 0U; i < len; i++)
+    {
+        if (COBS_DecoderFeed(decoder, data[i]) == COBS_STATUS_COMPLETE)
+        {
+            (*complete)++;
+            if (decoder->length > COBS_DECODE_SIZE)
+            {
+                (*bad)++;
+            }
+        }
+    }
+}
+
+static void testFuzzRandom(void)
+{
+    COBS_DecoderType decoder;
+    uint8_t          chunk[256];
+    uint32_t         complete = 0U;
+    uint32_t         bad      = 0U;
+    uint32_t         fed;
+    uint32_t         i;
+
+    armGuards();
+    COBS_DecoderInit(&decoder, &decoded[COBS_GUARD], COBS_DECODE_SIZE);
+
+    for (fed = 0U; fed < COBS_FUZZ_BYTES; fed += sizeof(chunk))
+    {
+        /* Zeros as often as 1 in 4 or as rarely as 1 in 1024 */
+        for (i = 0U; i < sizeof(chunk); i++)
+        {
+            chunk[i] = ((nextRandom() % (((fed >> 16) & 1U) ? 1024U : 4U)) == 0U)
+                       ? 0U : (uint8_t)nextRandom();
+        }
+        feedChecked(&decoder, chunk, sizeof(chunk), &complete, &bad);
+    }
+
+    printf("  random  : %u bytes, %u packets, %u errors\n",
+           COBS_FUZZ_BYTES, complete, decoder.errors);
+    TEST_CHECK(guardsIntact(COBS_DECODE_SIZE), "random stream wrote outside the buffer");
+    TEST_CHECK(bad == 0U, "%u packets longer than the buffer", bad);
+    TEST_CHECK(decoder.errors > 0U, "random stream raised no errors");
+}
+
+/* Valid packets with damage between them; the next intact one must decode */
+static void testFuzzDamaged(void)
+{
+    COBS_DecoderType decoder;
+    COBS_StatusType  status;
+    uint32_t         complete = 0U;
+    uint32_t         bad      = 0U;
+    uint32_t         missed   = 0U;
+    uint32_t         round;
+    uint16_t         size;
+    uint16_t         len;
+    uint16_t         pos;
+    uint16_t         i;
+
+    armGuards();
+    COBS_DecoderInit(&decoder, &decoded[COBS_GUARD], COBS_DECODE_SIZE);
+
+    for (round = 0U; round < COBS_TEST_ROUNDS; round++)
+    {
+        /* A damaged packet, some up to twice the buffer */
+        len  = (uint16_t)(nextRandom() % (2U * COBS_DECODE_SIZE));
+        fillPacket(len, 10U);
+        size = COBS_Encode(packet, len, wire, (uint16_t)sizeof(wire));
+        pos  = (uint16_t)(nextRandom() % size);
+        switch (round % 3U)
+        {
+            case 0U:
+                wire[pos] ^= (uint8_t)(1U + (nextRandom() % 255U));
+                break;
+            case 1U:
+                memmove(&wire[pos], &wire[pos + 1U], (size_t)(size - pos - 1U));
+                size--;
+                break;
+            default:
+                memmove(&wire[pos + 1U], &wire[pos], (size_t)(size - pos));
+                wire[pos] = (uint8_t)nextRandom();
+                size++;
+                break;
+        }
+        feedChecked(&decoder, wire, size, &complete, &bad);
+        if (wire[size - 1U] != COBS_DELIMITER)
+        {
+            (void)COBS_DecoderFeed(&decoder, COBS_DELIMITER);    /* Cut mid-packet */
+        }
+
+        /* Then an intact one */
+        len    = (uint16_t)(nextRandom() % (COBS_DECODE_SIZE + 1U));
+        fillPacket(len, 10U);
+        size   = COBS_Encode(packet, len, wire, (uint16_t)sizeof(wire));
+        status = COBS_STATUS_PENDING;
+        for (i = 0U; i < size; i++)
+        {
+            status = COBS_DecoderFeed(&decoder, wire[i]);
+        }
+        if ((status != COBS_STATUS_COMPLETE) || (decoder.length != len) ||
+            (memcmp(&decoded[COBS_GUARD], packet, len) != 0))
+        {
+            missed++;
+        }
+    }
+
+    printf("  damaged : %u rounds, %u damaged packets still decoded, %u errors\n",
+           COBS_TEST_ROUNDS, complete, decoder.errors);
+    TEST_CHECK(guardsIntact(COBS_DECODE_SIZE), "damaged stream wrote outside the buffer");
+    TEST_CHECK(bad == 0U, "%u packets longer than the buffer", bad);
+    TEST_CHECK(missed == 0U, "%u intact packets lost after damage", missed);
+}
+
+int main(void)
+{
+    printf("test_cobs\n");
+
+    testRoundTrip();
+    testShortDestination();
+    testFuzzRandom();
+    testFuzzDamaged();
+
+    return TEST_END();
+}
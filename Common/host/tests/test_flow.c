@@ -0,0 +1,198 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_flow.c
+ *  Description : Slow consumer behind UART flow control (mcal_uart.c)
+ *
+ *  UART1 at 115200 8N1 with a 128-byte RX ring; the peer has 3000 bytes
+ *  to send, back to back (11.5 bytes/ms), and the application takes at
+ *  most 5 bytes out of the ring each millisecond. The ring fills within
+ *  about 20 ms, so the sender must be held off for most of the run:
+ *  - UART_FLOW_NONE: negative control, bytes must be lost;
+ *  - UART_FLOW_RTS_CTS: the peer's CTS is wired to our RTS;
+ *  - UART_FLOW_XON_XOFF: the peer is modelled here, on our TX line, and
+ *    stops within a character of receiving XOFF.
+ *  With flow control every byte must arrive, in order, with no ring or
+ *  FIFO overrun, and the driver must have throttled the sender.
+ *
+ *  XON and XOFF are taken out of the RX stream by the driver, so the data
+ *  is printable text.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <stdlib.h>
+#include "mcal/mcal_uart.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define STREAM_BYTES            (3000U)
+#define BAUD                    (115200U)
+#define RING_SIZE               (128U)
+#define SIM_UART1               (1U)
+
+#define CONSUME_PERIOD_US       (1000U)
+#define CONSUME_BYTES           (5U)
+#define CHAR_US                 (87U)       /* One 10-bit character */
+#define IDLE_LIMIT_MS           (50U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t rxRing[RING_SIZE];
+static uint8_t stream[STREAM_BYTES];
+
+/* XON/XOFF peer */
+static bool     peerPaused;
+static uint32_t peerSent;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static void onTx(uint8_t uart, uint8_t data)
+{
+    (void)uart;
+
+    if (data == UART_XOFF_CHAR)
+    {
+        peerPaused = true;
+    }
+    else if (data == UART_XON_CHAR)
+    {
+        peerPaused = false;
+    }
+}
+
+static void setup(uint8_t flow)
+{
+    UART_ConfigType cfg = { 0 };
+
+    SIM_Init();
+    SIM_SetLimit(2000U * SIM_CYCLES_PER_MS);
+
+    SysTickPeriodSet(16000U);
+    SysTickEnable();
+
+    cfg.clockFreq    = SysCtlClockGet();
+    cfg.uartBase     = UART1_BASE;
+    cfg.baudRate     = BAUD;
+    cfg.dataBits     = 8U;
+    cfg.parity       = 0U;
+    cfg.stopBits     = 1U;
+    cfg.rxBuffer     = rxRing;
+    cfg.rxBufferSize = RING_SIZE;
+    cfg.flowControl  = flow;
+    UART_init(&cfg);
+    IntMasterEnable();
+
+    peerPaused = false;
+    peerSent   = 0U;
+    SIM_UART_SetTxHook(SIM_UART1, onTx);
+    SIM_UART_SetInjectLine(SIM_UART1, 0U, flow == UART_FLOW_RTS_CTS);
+    if (flow != UART_FLOW_XON_XOFF)
+    {
+        SIM_UART_Inject(SIM_UART1, stream, STREAM_BYTES, SIM_Now());
+        peerSent = STREAM_BYTES;
+    }
+}
+
+/* The XON/XOFF peer: one character at a time while not paused */
+static void peerSend(uint8_t flow)
+{
+    if ((flow == UART_FLOW_XON_XOFF) && !peerPaused && (peerSent < STREAM_BYTES) &&
+        (SIM_UART_InjectPending(SIM_UART1) == 0U))
+    {
+        SIM_UART_Inject(SIM_UART1, &stream[peerSent], 1U, SIM_Now());
+        peerSent++;
+    }
+}
+
+static void run(uint8_t flow, const char *name)
+{
+    UART_StatsType     fw;
+    SIM_UART_StatsType hw;
+    uint32_t           received   = 0U;
+    uint32_t           mismatches = 0U;
+    uint32_t           taken;
+    uint64_t           nextConsume;
+    uint64_t           idleSince;
+    uint8_t            data;
+
+    setup(flow);
+
+    nextConsume = SIM_Now() + ((uint64_t)CONSUME_PERIOD_US * SIM_CYCLES_PER_US);
+    idleSince   = SIM_Now();
+    while ((received < STREAM_BYTES) &&
+           ((SIM_Now() - idleSince) < ((uint64_t)IDLE_LIMIT_MS * SIM_CYCLES_PER_MS)))
+    {
+        peerSend(flow);
+        SIM_Run((uint64_t)CHAR_US * SIM_CYCLES_PER_US);
+        if (SIM_Now() < nextConsume)
+        {
+            continue;
+        }
+        nextConsume += (uint64_t)CONSUME_PERIOD_US * SIM_CYCLES_PER_US;
+
+        for (taken = 0U; (taken < CONSUME_BYTES) && isDataAvailable(UART1_BASE); taken++)
+        {
+            data = receiveByte(UART1_BASE);
+            if ((received < STREAM_BYTES) && (data != stream[received]))
+            {
+                mismatches++;
+            }
+            received++;
+        }
+        if (taken != 0U)
+        {
+            idleSince = SIM_Now();
+        }
+    }
+
+    UART_GetStats(UART1_BASE, &fw);
+    SIM_UART_GetStats(SIM_UART1, &hw);
+
+    printf("  %-9s: %4u of %u bytes in %4.0f ms, %4u lost, %3u throttles, "
+           "RTS held %5.1f ms\n",
+           name, received, STREAM_BYTES, (double)SIM_Now() / SIM_CYCLES_PER_MS,
+           fw.rxRingOverruns + hw.rxOverruns, fw.rxThrottles,
+           (double)hw.rtsHeldCycles / SIM_CYCLES_PER_MS);
+
+    if (flow == UART_FLOW_NONE)
+    {
+        TEST_CHECK((fw.rxRingOverruns + hw.rxOverruns) > 0U,
+                   "%s: a slow consumer without flow control should lose bytes", name);
+        return;
+    }
+
+    TEST_CHECK(received == STREAM_BYTES, "%s: received %u of %u", name, received, STREAM_BYTES);
+    TEST_CHECK(mismatches == 0U, "%s: %u bytes out of order", name, mismatches);
+    TEST_CHECK(fw.rxRingOverruns == 0U, "%s: %u ring overruns", name, fw.rxRingOverruns);
+    TEST_CHECK(fw.rxFifoOverruns == 0U, "%s: %u FIFO overruns (driver)", name, fw.rxFifoOverruns);
+    TEST_CHECK(hw.rxOverruns == 0U, "%s: %u FIFO overruns (line)", name, hw.rxOverruns);
+    TEST_CHECK(fw.rxThrottles > 0U, "%s: the sender was never held off", name);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    srand(1U);
+    for (i = 0U; i < STREAM_BYTES; i++)
+    {
+        stream[i] = (uint8_t)(' ' + (rand() % 95));
+    }
+
+    printf("test_flow: %u bytes at %u baud, consumer %u bytes/ms, %u-byte ring\n",
+           STREAM_BYTES, BAUD, CONSUME_BYTES, RING_SIZE);
+
+    run(UART_FLOW_NONE, "none");
+    run(UART_FLOW_RTS_CTS, "RTS/CTS");
+    run(UART_FLOW_XON_XOFF, "XON/XOFF");
+
+    return TEST_END();
+}
@@ -0,0 +1,290 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_link.c
+ *  Description : Both ends of the reliable link (link.c) over a modelled
+ *                wire with latency and loss
+ *
+ *  The local end is link.c, the far end the same code as PEER_LINK_*
+ *  (link_peer.c). Each direction of the wire is a queue of frames that
+ *  arrive WIRE_LATENCY_MS after being sent, or never, with a set loss.
+ *  Both ends send numbered application frames as fast as their windows
+ *  allow; a receiver must see the numbers strictly increasing.
+ *
+ *  - Lossy: 10% of frames lost each way; every frame delivered once, in
+ *    order, with no resync.
+ *  - Peer reboot: the far end restarts mid-stream. The local end must be
+ *    told (RESYNC) and be delivering again within a few round trips, not
+ *    after LINK_MAX_RETRIES timeouts; nothing may arrive twice, and every
+ *    frame lost in the reboot must be counted as dropped.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <string.h>
+#include "services/link.h"
+#include "link_peer.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define WIRE_DEPTH              (64U)
+#define WIRE_LATENCY_MS         (2U)
+#define APP_CMD                 (0x30U)
+#define APP_FRAMES              (500U)
+#define REBOOT_AT_MS            (200U)
+#define RUN_LIMIT_MS            (20000U)
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+typedef struct
+{
+    FRAME_Type frame;
+    uint32_t   atMs;
+} WireFrameType;
+
+/* One direction of the wire */
+typedef struct
+{
+    WireFrameType q[WIRE_DEPTH];
+    uint8_t       head;
+    uint8_t       count;
+    uint32_t      lossPct;
+} WireType;
+
+/* One end's application traffic */
+typedef struct
+{
+    uint32_t nextToSend;        /* Number of the next frame to queue */
+    uint32_t lastSeen;          /* Highest number delivered to this end + 1 */
+    uint32_t delivered;
+    uint32_t outOfOrder;        /* Repeated or gone backwards */
+} AppType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static WireType toPeer;
+static WireType toLocal;
+static AppType  local;
+static AppType  peer;
+static uint32_t nowMs;
+static uint32_t seed;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+static void wirePut(WireType *wire, uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    WireFrameType *slot;
+
+    if ((wire->count >= WIRE_DEPTH) || ((nextRandom() % 100U) < wire->lossPct))
+    {
+        return;
+    }
+
+    slot = &wire->q[(wire->head + wire->count) % WIRE_DEPTH];
+    slot->frame.cmd = cmd;
+    slot->frame.len = len;
+    memcpy(slot->frame.payload, payload, len);
+    slot->atMs = nowMs + WIRE_LATENCY_MS;
+    wire->count++;
+}
+
+static uint8_t localSend(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    wirePut(&toPeer, cmd, payload, len);
+    return 0U;
+}
+
+static uint8_t peerSend(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    wirePut(&toLocal, cmd, payload, len);
+    return 0U;
+}
+
+static void appReceive(AppType *app, const FRAME_Type *frame)
+{
+    uint32_t number;
+
+    if ((frame->cmd != APP_CMD) || (frame->len != 4U))
+    {
+        app->outOfOrder++;
+        return;
+    }
+
+    memcpy(&number, frame->payload, sizeof(number));
+    if (number < app->lastSeen)
+    {
+        app->outOfOrder++;
+        return;
+    }
+    app->lastSeen = number + 1U;
+    app->delivered++;
+}
+
+/* Frames due by now, to one end */
+static void wireDeliver(WireType *wire, boolean toThePeer)
+{
+    FRAME_Type out;
+
+    while ((wire->count != 0U) && (wire->q[wire->head].atMs <= nowMs))
+    {
+        if (toThePeer)
+        {
+            if (PEER_LINK_OnFrame(&wire->q[wire->head].frame, &out, nowMs))
+            {
+                appReceive(&peer, &out);
+            }
+        }
+        else if (LINK_OnFrame(&wire->q[wire->head].frame, &out, nowMs))
+        {
+            appReceive(&local, &out);
+        }
+        wire->head = (uint8_t)((wire->head + 1U) % WIRE_DEPTH);
+        wire->count--;
+    }
+}
+
+/* Queue the next numbered frame if the window has room */
+static void appSend(AppType *app, boolean fromPeer)
+{
+    uint8_t payload[4];
+    uint8_t result;
+
+    if (app->nextToSend >= APP_FRAMES)
+    {
+        return;
+    }
+
+    memcpy(payload, &app->nextToSend, sizeof(payload));
+    result = fromPeer ? PEER_LINK_Send(APP_CMD, payload, 4U, nowMs)
+                      : LINK_Send(APP_CMD, payload, 4U, nowMs);
+    if (result == LINK_SUCCESS)
+    {
+        app->nextToSend++;
+    }
+}
+
+static void reset(uint32_t lossPct, uint32_t rngSeed)
+{
+    memset(&toPeer, 0, sizeof(toPeer));
+    memset(&toLocal, 0, sizeof(toLocal));
+    memset(&local, 0, sizeof(local));
+    memset(&peer, 0, sizeof(peer));
+    toPeer.lossPct  = lossPct;
+    toLocal.lossPct = lossPct;
+    seed  = rngSeed;
+    nowMs = 0U;
+
+    LINK_Init(localSend, nowMs);
+    PEER_LINK_Init(peerSend, nowMs);
+}
+
+static void step(void)
+{
+    nowMs++;
+    wireDeliver(&toPeer, TRUE);
+    wireDeliver(&toLocal, FALSE);
+    LINK_Tick(nowMs);
+    PEER_LINK_Tick(nowMs);
+    appSend(&local, FALSE);
+    appSend(&peer, TRUE);
+}
+
+static boolean allDone(void)
+{
+    return (local.nextToSend >= APP_FRAMES) && (peer.nextToSend >= APP_FRAMES) &&
+           LINK_IsIdle() && PEER_LINK_IsIdle();
+}
+
+static void testLossy(void)
+{
+    LINK_StatsType ls;
+    LINK_StatsType ps;
+
+    reset(10U, 7U);
+    while (!allDone() && (nowMs < RUN_LIMIT_MS))
+    {
+        step();
+    }
+
+    LINK_GetStats(&ls);
+    PEER_LINK_GetStats(&ps);
+    printf("  lossy 10%% : %u ms, %u + %u retransmits, %u + %u resyncs\n",
+           nowMs, ls.retransmits, ps.retransmits, ls.resyncs, ps.resyncs);
+
+    TEST_CHECK(allDone(), "lossy: not finished after %u ms", nowMs);
+    TEST_CHECK((peer.delivered == APP_FRAMES) && (local.delivered == APP_FRAMES),
+               "lossy: delivered %u and %u of %u", peer.delivered, local.delivered, APP_FRAMES);
+    TEST_CHECK((peer.outOfOrder == 0U) && (local.outOfOrder == 0U),
+               "lossy: %u + %u frames repeated or out of order",
+               peer.outOfOrder, local.outOfOrder);
+    TEST_CHECK((ls.dropped == 0U) && (ps.dropped == 0U), "lossy: %u + %u frames dropped",
+               ls.dropped, ps.dropped);
+}
+
+static void testPeerReboot(void)
+{
+    LINK_StatsType ls;
+    uint32_t       sentAtReboot;
+    uint32_t       resumedMs = 0U;
+
+    reset(0U, 11U);
+    while (nowMs < REBOOT_AT_MS)
+    {
+        step();
+    }
+
+    /* The far end's link starts over; the test's numbering carries on,
+     * so gaps show as lost frames and repeats as out of order */
+    PEER_LINK_Init(peerSend, nowMs);
+    sentAtReboot = local.nextToSend;
+
+    while (!allDone() && (nowMs < RUN_LIMIT_MS))
+    {
+        step();
+        if ((resumedMs == 0U) && (peer.lastSeen > sentAtReboot))
+        {
+            resumedMs = nowMs - REBOOT_AT_MS;
+        }
+    }
+
+    LINK_GetStats(&ls);
+    printf("  peer reboot: delivering again after %u ms, %u resync(s), %u frame(s) dropped\n",
+           resumedMs, ls.resyncs, ls.dropped);
+
+    TEST_CHECK(allDone(), "reboot: not finished after %u ms", nowMs);
+    TEST_CHECK((resumedMs != 0U) && (resumedMs < LINK_RTO_MS),
+               "reboot: %u ms to deliver again, limit %u", resumedMs, LINK_RTO_MS);
+    TEST_CHECK(ls.resyncs == 1U, "reboot: %u resyncs", ls.resyncs);
+    TEST_CHECK((peer.outOfOrder == 0U) && (local.outOfOrder == 0U),
+               "reboot: %u + %u frames repeated or out of order",
+               peer.outOfOrder, local.outOfOrder);
+    TEST_CHECK((APP_FRAMES - peer.delivered) <= ls.dropped,
+               "reboot: %u frames lost, %u counted as dropped",
+               APP_FRAMES - peer.delivered, ls.dropped);
+    TEST_CHECK(ls.dropped <= LINK_WINDOW_SIZE, "reboot: %u dropped, more than a window",
+               ls.dropped);
+}
+
+int main(void)
+{
+    printf("test_link: %u frames each way, %u ms each way on the wire\n",
+           APP_FRAMES, WIRE_LATENCY_MS);
+
+    testLossy();
+    testPeerReboot();
+
+    return TEST_END();
+}
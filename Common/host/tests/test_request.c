@@ -0,0 +1,169 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_request.c
+ *  Description : Request tracker SEQ handling and payload limits (request.c)
+ *
+ *  The transmit hook is a stand-in that records the last frame and can be
+ *  told to refuse, as HAL_COMM_SendFrame() does when the link window or
+ *  the TX ring is full; TIME_GetUs() is a stand-in clock the test sets.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <string.h>
+#include "services/request.h"
+#include "services/link.h"
+#include "services/timebase.h"
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t    refuse;
+static uint32_t   sendCalls;
+static FRAME_Type lastSent;
+static uint32_t   nowUs;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+uint32_t TIME_GetUs(void)
+{
+    return nowUs;
+}
+
+static uint8_t onSend(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    sendCalls++;
+    if (refuse != 0U)
+    {
+        return 1U;
+    }
+    lastSent.cmd = cmd;
+    lastSent.len = len;
+    memcpy(lastSent.payload, payload, len);
+    return 0U;
+}
+
+static void testSeqAfterRefusal(void)
+{
+    REQ_StatsType stats;
+    uint8_t       handle;
+    uint8_t       firstSeq;
+
+    REQ_Init(onSend, FRAME_MAX_PAYLOAD);
+
+    handle = REQ_Send(0x10U, NULL, 0U, 100U, 0U);
+    TEST_CHECK(handle != REQ_INVALID_HANDLE, "first send");
+    firstSeq = lastSent.payload[0];
+    REQ_Release(handle);
+
+    /* Three refused sends must not use up sequence numbers or slots */
+    refuse = 1U;
+    TEST_CHECK(REQ_Send(0x10U, NULL, 0U, 100U, 0U) == REQ_INVALID_HANDLE, "refused 1");
+    TEST_CHECK(REQ_Send(0x10U, NULL, 0U, 100U, 0U) == REQ_INVALID_HANDLE, "refused 2");
+    TEST_CHECK(REQ_Send(0x10U, NULL, 0U, 100U, 0U) == REQ_INVALID_HANDLE, "refused 3");
+    refuse = 0U;
+
+    handle = REQ_Send(0x10U, NULL, 0U, 100U, 0U);
+    TEST_CHECK(handle != REQ_INVALID_HANDLE, "send after refusals");
+    TEST_CHECK(lastSent.payload[0] == (uint8_t)(firstSeq + 1U),
+               "SEQ %u after refusals, expected %u", lastSent.payload[0], firstSeq + 1U);
+
+    REQ_GetStats(&stats);
+    TEST_CHECK(stats.sent == 2U, "%u counted as sent", stats.sent);
+}
+
+static void testSeqWrap(void)
+{
+    uint32_t i;
+    uint8_t  handle;
+    uint8_t  zeroSeen = 0U;
+
+    REQ_Init(onSend, FRAME_MAX_PAYLOAD);
+    for (i = 0U; i < 600U; i++)
+    {
+        handle = REQ_Send(0x10U, NULL, 0U, 100U, 0U);
+        if (lastSent.payload[0] == REQ_SEQ_UNSOLICITED)
+        {
+            zeroSeen = 1U;
+        }
+        REQ_Release(handle);
+    }
+    TEST_CHECK(zeroSeen == 0U, "a request went out with SEQ 0");
+}
+
+static void testLimits(void)
+{
+    static const uint8_t payload[FRAME_MAX_PAYLOAD] = { 0U };
+    uint8_t handle;
+
+    /* Reliable link: the link header leaves LINK_MAX_PAYLOAD - 1 for requests */
+    REQ_Init(onSend, LINK_MAX_PAYLOAD);
+    TEST_CHECK(REQ_GetMaxPayload() == (LINK_MAX_PAYLOAD - 1U), "limit %u on the link",
+               REQ_GetMaxPayload());
+    sendCalls = 0U;
+    TEST_CHECK(REQ_Send(0x10U, payload, LINK_MAX_PAYLOAD, 100U, 0U) == REQ_INVALID_HANDLE,
+               "over-long request accepted");
+    TEST_CHECK(sendCalls == 0U, "over-long request reached the transport");
+    TEST_CHECK(REQ_Reply(5U, 0x90U, payload, LINK_MAX_PAYLOAD) == 0xFFU,
+               "over-long reply accepted");
+    handle = REQ_Send(0x10U, payload, LINK_MAX_PAYLOAD - 1U, 100U, 0U);
+    TEST_CHECK(handle != REQ_INVALID_HANDLE, "largest request refused");
+    TEST_CHECK(lastSent.len == LINK_MAX_PAYLOAD, "frame of %u bytes", lastSent.len);
+
+    /* Plain frames carry the full FRAME_MAX_PAYLOAD */
+    REQ_Init(onSend, FRAME_MAX_PAYLOAD);
+    TEST_CHECK(REQ_GetMaxPayload() == REQ_MAX_PAYLOAD, "limit %u on plain frames",
+               REQ_GetMaxPayload());
+    TEST_CHECK(REQ_Send(0x10U, payload, REQ_MAX_PAYLOAD, 100U, 0U) != REQ_INVALID_HANDLE,
+               "largest plain request refused");
+}
+
+/* Answer the request last sent, rttUs after it went out */
+static void reply(uint32_t rttUs)
+{
+    FRAME_Type response;
+
+    nowUs += rttUs;
+    response.cmd        = 0x90U;
+    response.len        = 1U;
+    response.payload[0] = lastSent.payload[0];
+    TEST_CHECK(REQ_OnFrame(&response) == TRUE, "reply to SEQ %u not matched",
+               lastSent.payload[0]);
+}
+
+static void testRoundTrip(void)
+{
+    REQ_StatsType stats;
+
+    REQ_Init(onSend, FRAME_MAX_PAYLOAD);
+    nowUs = 0xFFFFFF00U;        /* The microsecond clock wraps mid-test */
+
+    REQ_Release(REQ_Send(0x10U, NULL, 0U, 100U, 0U));
+    (void)REQ_Send(0x10U, NULL, 0U, 100U, 0U);
+    reply(700U);
+    (void)REQ_Send(0x10U, NULL, 0U, 100U, 0U);
+    reply(300U);
+    (void)REQ_Send(0x10U, NULL, 0U, 100U, 0U);
+    reply(500U);
+
+    REQ_GetStats(&stats);
+    TEST_CHECK(stats.completed == 3U, "%u completed", stats.completed);
+    TEST_CHECK(stats.rttMinUs == 300U, "min %u us", stats.rttMinUs);
+    TEST_CHECK(stats.rttMaxUs == 700U, "max %u us", stats.rttMaxUs);
+    TEST_CHECK(stats.rttTotalUs == 1500U, "total %u us", (unsigned)stats.rttTotalUs);
+}
+
+int main(void)
+{
+    printf("test_request\n");
+
+    testSeqAfterRefusal();
+    testSeqWrap();
+    testLimits();
+    testRoundTrip();
+
+    return TEST_END();
+}
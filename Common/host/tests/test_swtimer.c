@@ -0,0 +1,334 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_swtimer.c
+ *  Description : Timer wheel (swtimer.c) against a reference model
+ *
+ *  Every timer's expected state (armed, expiry, period) is kept beside
+ *  the wheel. Timers are started with delays spread over all four levels
+ *  (and past SWTIMER_MAX_DELAY_MS, which must be clamped), stopped and
+ *  restarted at random, also from inside callbacks, and the clock starts
+ *  just short of the 32-bit wrap.
+ *
+ *  - Same tick: timers due together all fire, except one a callback
+ *    stops first; a callback restarting itself is not run twice.
+ *  - Exact: SWTIMER_Process() every millisecond; each callback must run
+ *    at exactly its expiry tick, and SWTIMER_GetIdleMs() must match the
+ *    model.
+ *  - Catch-up: the loop comes back after up to 500 ms; every due
+ *    callback runs, in expiry order, and none early.
+ *===========================================================================*/
+
+#include "test.h"
+
+#include <string.h>
+#include "services/swtimer.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define TIMERS                  (200U)
+#define RUN_TICKS               (1500000U)
+#define START_MS                (0xFFF00000U)   /* Wraps 1048576 ticks in */
+#define CATCH_UP_MAX_MS         (500U)
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+/* What one timer should be doing */
+typedef struct
+{
+    boolean  armed;
+    uint32_t expiryMs;
+    uint32_t periodMs;
+} ModelType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static SWTIMER_Type timers[TIMERS];
+static ModelType    model[TIMERS];
+static uint32_t     nowMs;
+static uint32_t     seed = 1U;
+
+/* Checks made from the callbacks */
+static boolean  exact;          /* Process() is called for every tick */
+static uint32_t lastFiredMs;    /* Expiry of the previous callback */
+static uint32_t wrongTick;
+static uint32_t outOfOrder;
+static uint32_t notArmed;
+static uint32_t fires;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+/* Delays across every wheel level, now and then past the longest */
+static uint32_t randomDelay(void)
+{
+    switch (nextRandom() % 8U)
+    {
+        case 0U:  return nextRandom() % 3U;                          /* 0 counts as 1 */
+        case 1U:
+        case 2U:  return 1U + (nextRandom() % 70U);                  /* Level 0 edge */
+        case 3U:
+        case 4U:  return 60U + (nextRandom() % 5000U);               /* Level 1 */
+        case 5U:  return 4000U + (nextRandom() % 300000U);           /* Level 2 */
+        case 6U:  return 250000U + (nextRandom() % SWTIMER_MAX_DELAY_MS);
+        default:  return SWTIMER_MAX_DELAY_MS + (nextRandom() % 1000U);
+    }
+}
+
+static uint32_t clampDelay(uint32_t ms)
+{
+    return (ms > SWTIMER_MAX_DELAY_MS) ? SWTIMER_MAX_DELAY_MS : ms;
+}
+
+/* Start timer i at tick atMs (the tick being processed, or the last one) */
+static void startTimer(uint32_t i, uint32_t atMs)
+{
+    uint32_t delay  = randomDelay();
+    uint32_t period = ((nextRandom() % 3U) == 0U) ? (nextRandom() % 400U) : 0U;
+
+    SWTIMER_Start(&timers[i], delay, period);
+    model[i].armed    = TRUE;
+    model[i].expiryMs = atMs + ((delay == 0U) ? 1U : clampDelay(delay));
+    model[i].periodMs = clampDelay(period);
+}
+
+static void stopTimer(uint32_t i)
+{
+    SWTIMER_Stop(&timers[i]);
+    model[i].armed = FALSE;
+}
+
+static void onExpiry(void *context)
+{
+    uint32_t   i = (uint32_t)(uintptr_t)context;
+    ModelType *m = &model[i];
+    uint32_t   tick;
+    uint32_t   other;
+
+    fires++;
+    if (!m->armed)
+    {
+        notArmed++;
+        return;
+    }
+
+    /* A correct wheel runs us at our expiry, so that is the current tick */
+    tick = m->expiryMs;
+    if (exact ? (tick != nowMs) : ((int32_t)(nowMs - tick) < 0))
+    {
+        wrongTick++;
+    }
+    if ((int32_t)(tick - lastFiredMs) < 0)
+    {
+        outOfOrder++;
+    }
+    lastFiredMs = tick;
+
+    if (m->periodMs != 0U)
+    {
+        m->expiryMs = tick + m->periodMs;
+    }
+    else
+    {
+        m->armed = FALSE;
+    }
+
+    /* Now and then restart ourselves, or stop or restart another */
+    other = nextRandom() % TIMERS;
+    switch (nextRandom() % 8U)
+    {
+        case 0U:  startTimer(i, tick);     break;
+        case 1U:  stopTimer(other);        break;
+        case 2U:  startTimer(other, tick); break;
+        default:  break;
+    }
+}
+
+static void reset(uint32_t startMs)
+{
+    uint32_t i;
+
+    nowMs       = startMs;
+    lastFiredMs = startMs;
+    wrongTick   = 0U;
+    outOfOrder  = 0U;
+    notArmed    = 0U;
+    fires       = 0U;
+    memset(model, 0, sizeof(model));
+
+    SWTIMER_Init(nowMs);
+    for (i = 0U; i < TIMERS; i++)
+    {
+        SWTIMER_Setup(&timers[i], onExpiry, (void *)(uintptr_t)i);
+    }
+}
+
+/* SWTIMER_GetIdleMs() by brute force over the model */
+static uint32_t modelIdleMs(uint32_t maxMs)
+{
+    uint32_t ahead;
+    uint32_t i;
+
+    if (maxMs > SWTIMER_WHEEL_SLOTS)
+    {
+        maxMs = SWTIMER_WHEEL_SLOTS;
+    }
+    for (ahead = 1U; ahead < maxMs; ahead++)
+    {
+        if (((nowMs + ahead) % SWTIMER_WHEEL_SLOTS) == 0U)
+        {
+            return ahead;
+        }
+        for (i = 0U; i < TIMERS; i++)
+        {
+            if (model[i].armed && (model[i].expiryMs == (nowMs + ahead)))
+            {
+                return ahead;
+            }
+        }
+    }
+    return maxMs;
+}
+
+/* Run with the loop coming back after 1..maxStepMs ms */
+static void run(uint32_t maxStepMs, const char *name)
+{
+    uint32_t end        = nowMs + RUN_TICKS;
+    uint32_t missed     = 0U;
+    uint32_t idleBad    = 0U;
+    uint32_t wrongState = 0U;
+    uint32_t maxMs;
+    uint32_t i;
+
+    exact = (maxStepMs == 1U) ? TRUE : FALSE;
+
+    while ((int32_t)(end - nowMs) > 0)
+    {
+        /* The application starts and stops a few timers per pass */
+        i = nextRandom() % TIMERS;
+        if ((nextRandom() % 4U) == 0U)
+        {
+            stopTimer(i);
+        }
+        else if (!model[i].armed || ((nextRandom() % 4U) == 0U))
+        {
+            startTimer(i, nowMs);
+        }
+        if (SWTIMER_IsActive(&timers[i]) != model[i].armed)
+        {
+            wrongState++;
+        }
+
+        lastFiredMs = nowMs;
+        nowMs += 1U + (nextRandom() % maxStepMs);
+        SWTIMER_Process(nowMs);
+
+        /* Nothing due may be left behind */
+        for (i = 0U; i < TIMERS; i++)
+        {
+            if (model[i].armed && ((int32_t)(nowMs - model[i].expiryMs) >= 0))
+            {
+                missed++;
+                model[i].armed = FALSE;
+                SWTIMER_Stop(&timers[i]);
+            }
+        }
+
+        if (exact && ((nowMs & 0x3FFU) < 64U))
+        {
+            maxMs = 1U + (nextRandom() % 100U);
+            if (SWTIMER_GetIdleMs(nowMs, maxMs) != modelIdleMs(maxMs))
+            {
+                idleBad++;
+            }
+        }
+    }
+
+    printf("  %-8s: %u ticks from 0x%08X, %u callbacks\n", name, RUN_TICKS,
+           (unsigned)(end - RUN_TICKS), fires);
+
+    TEST_CHECK(fires > 1000U, "%s: only %u callbacks", name, fires);
+    TEST_CHECK(wrongTick == 0U, "%s: %u callbacks at the wrong tick", name, wrongTick);
+    TEST_CHECK(outOfOrder == 0U, "%s: %u callbacks out of expiry order", name, outOfOrder);
+    TEST_CHECK(notArmed == 0U, "%s: %u callbacks of stopped timers", name, notArmed);
+    TEST_CHECK(missed == 0U, "%s: %u timers due and not run", name, missed);
+    TEST_CHECK(wrongState == 0U, "%s: SWTIMER_IsActive() wrong %u times", name, wrongState);
+    TEST_CHECK(idleBad == 0U, "%s: SWTIMER_GetIdleMs() wrong %u times", name, idleBad);
+}
+
+/* Calls of the same-tick timers, in order */
+static uint32_t sameTickCalls[4];
+static uint32_t sameTickCount;
+
+static void onSameTick(void *context)
+{
+    uint32_t i = (uint32_t)(uintptr_t)context;
+
+    sameTickCalls[i]++;
+    sameTickCount++;
+    if (i == 0U)
+    {
+        SWTIMER_Stop(&timers[1]);           /* Due now too, not yet run */
+        SWTIMER_Start(&timers[0], 0U, 0U);  /* Next tick, not again now */
+    }
+}
+
+static void testSameTick(void)
+{
+    uint32_t i;
+
+    SWTIMER_Init(START_MS);
+    for (i = 0U; i < 4U; i++)
+    {
+        sameTickCalls[i] = 0U;
+        SWTIMER_Setup(&timers[i], onSameTick, (void *)(uintptr_t)i);
+    }
+    sameTickCount = 0U;
+
+    /* Pushed to the front of one level-0 slot, so 0 runs before 1 */
+    SWTIMER_Start(&timers[3], 10U, 0U);
+    SWTIMER_Start(&timers[2], 10U, 0U);
+    SWTIMER_Start(&timers[1], 10U, 0U);
+    SWTIMER_Start(&timers[0], 10U, 0U);
+
+    SWTIMER_Process(START_MS + 10U);
+    TEST_CHECK((sameTickCalls[0] == 1U) && (sameTickCalls[1] == 0U) &&
+               (sameTickCalls[2] == 1U) && (sameTickCalls[3] == 1U),
+               "same tick: calls %u %u %u %u", sameTickCalls[0], sameTickCalls[1],
+               sameTickCalls[2], sameTickCalls[3]);
+    TEST_CHECK(SWTIMER_IsActive(&timers[0]) && !SWTIMER_IsActive(&timers[1]),
+               "same tick: restarted timer not armed, or stopped one still armed");
+
+    SWTIMER_Process(START_MS + 11U);
+    TEST_CHECK((sameTickCalls[0] == 2U) && (sameTickCount == 4U),
+               "same tick: restarted timer ran %u times, %u calls in all",
+               sameTickCalls[0], sameTickCount);
+}
+
+int main(void)
+{
+    printf("test_swtimer: %u timers, %u levels of %u slots\n",
+           TIMERS, SWTIMER_LEVELS, SWTIMER_WHEEL_SLOTS);
+
+    testSameTick();
+
+    reset(START_MS);
+    run(1U, "exact");
+
+    reset(START_MS);
+    run(CATCH_UP_MAX_MS, "catch-up");
+
+    return TEST_END();
+}
@@ -0,0 +1,297 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_tick.c
+ *  Description : Tickless sleep and idle accounting (mcal_systick.c) on
+ *                the SysTick model
+ *
+ *  The main loop is modelled as busy stretches of up to BUSY_MAX_CYCLES
+ *  (SIM_Run) followed by MCAL_SysTick_Sleep(1..SLEEP_MAX_MS), as the
+ *  Control loop sleeps to its next deadline. After every step the phase
+ *  of the tick is taken: model cycles to the next tick, against where
+ *  the tick count says that tick should be.
+ *
+ *  - Ticks only: no other interrupt. The phase must never move (no
+ *    drift however long the sleeps), and the callback runs once per ms.
+ *  - Early wakes: a GPIO interrupt at random, on average every ~1.5 ms,
+ *    ends most sleeps early. The tick is re-timed each time; the phase
+ *    may move by at most WAKE_DRIFT_CYCLES per early wake.
+ *  - Both: MCAL_SysTick_GetIdleMs() matches the model's sleep cycles,
+ *    never exceeds the time that passed in any 1 s window, and
+ *    MCAL_SysTick_TakeBusyMaxCycles() sees the longest stretch.
+ *  - Delay: MCAL_SysTick_DelayMs() lasts its ms and sleeps through 90 %
+ *    of them.
+ *
+ *  Reading the pending flag before the counter, in the sleep or in the
+ *  busy-time stamps, shows here as ticks counted a whole long period too
+ *  early or as busy stretches of ~2^32 cycles.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "test.h"
+
+#include "Types.h"
+#include "mcal/mcal_systick.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define STEPS                   (20000U)
+#define BUSY_MAX_CYCLES         (3000U)
+#define SLEEP_MAX_MS            (40U)
+#define WAKE_MAX_GAP_CYCLES     (50000U)
+#define WINDOW_MS               (1000U)
+
+/* What the code costs here, at SIM_CALL_CYCLES a call: re-timing the tick
+ * after an early wake (the counter read to the write), the driver's own
+ * work inside a sleep that it counts as idle, and what a stretch adds to
+ * the busy time given (sleep exit, interrupts, and the tick ISR catching
+ * up the ticks of a long sleep, one callback each) */
+#define WAKE_DRIFT_CYCLES       (12U)
+#define IDLE_SLACK_CYCLES       (400U)
+#define BUSY_OVERHEAD_CYCLES    (4000U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint32_t seed;
+
+/* External interrupt source */
+static boolean  wakesOn;
+static uint64_t nextWake;
+
+/* Checks made from the tick callback */
+static uint32_t callbacks;
+static uint32_t windowIdleStart;
+static uint32_t windowIdleMax;
+static uint32_t busyMaxSeen;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint32_t nextRandom(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+static void wakeReset(void)
+{
+    nextWake = SIM_NEVER;
+}
+
+static uint64_t wakeNextEvent(void)
+{
+    return wakesOn ? nextWake : SIM_NEVER;
+}
+
+static void wakeProcess(uint64_t now)
+{
+    if (wakesOn && (now >= nextWake))
+    {
+        SIM_PendInt(INT_GPIOF);
+        nextWake = now + 1U + (nextRandom() % WAKE_MAX_GAP_CYCLES);
+    }
+}
+
+static const SIM_ModelType wakeModel = { "gpio wakes", wakeReset, wakeNextEvent, wakeProcess };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&wakeModel);
+}
+
+/* Every WINDOW_MS ticks: idle time of the window and the busy maximum */
+static void onTick(void)
+{
+    uint32_t idle;
+    uint32_t busyMax;
+
+    callbacks++;
+    if ((callbacks % WINDOW_MS) != 0U)
+    {
+        return;
+    }
+
+    idle = MCAL_SysTick_GetIdleMs();
+    if ((idle - windowIdleStart) > windowIdleMax)
+    {
+        windowIdleMax = idle - windowIdleStart;
+    }
+    windowIdleStart = idle;
+
+    busyMax = MCAL_SysTick_TakeBusyMaxCycles();
+    if (busyMax > busyMaxSeen)
+    {
+        busyMaxSeen = busyMax;
+    }
+}
+
+/* Cycles to the next tick, against where the tick count puts it */
+static int64_t tickPhase(void)
+{
+    uint32_t tick;
+    uint32_t current;
+    uint64_t now;
+
+    do
+    {
+        tick    = MCAL_SysTick_GetTickMs();
+        current = SysTickValueGet();
+        now     = SIM_Now();
+    } while (tick != MCAL_SysTick_GetTickMs());
+
+    return (int64_t)(now + current) - ((int64_t)(tick + 1U) * SIM_CYCLES_PER_MS);
+}
+
+static void boot(boolean wakes, uint32_t rngSeed)
+{
+    SIM_Init();
+    SIM_SetLimit((uint64_t)STEPS * SLEEP_MAX_MS * SIM_CYCLES_PER_MS);
+    seed            = rngSeed;
+    callbacks       = 0U;
+    windowIdleStart = 0U;
+    windowIdleMax   = 0U;
+    busyMaxSeen     = 0U;
+
+    MCAL_SysTick_Init();
+    MCAL_SysTick_SetCallback(onTick);
+    IntMasterEnable();
+
+    wakesOn = wakes;
+    if (wakes)
+    {
+        IntEnable(INT_GPIOF);
+        nextWake = SIM_Now() + 1U + (nextRandom() % WAKE_MAX_GAP_CYCLES);
+    }
+}
+
+static void run(boolean wakes, const char *name)
+{
+    SIM_StatsType stats;
+    uint32_t      busy;
+    uint32_t      busyMax = 0U;
+    uint32_t      step;
+    uint32_t      idleMs;
+    uint32_t      sleepMs;
+    uint32_t      early;
+    uint32_t      slackMs;
+    uint64_t      wallMs;
+    int64_t       phase;
+    int64_t       phaseMin;
+    int64_t       phaseMax;
+
+    boot(wakes, wakes ? 17U : 13U);
+    phaseMin = tickPhase();
+    phaseMax = phaseMin;
+
+    for (step = 0U; step < STEPS; step++)
+    {
+        busy = nextRandom() % (BUSY_MAX_CYCLES + 1U);
+        if (busy > busyMax)
+        {
+            busyMax = busy;
+        }
+        SIM_Run(busy);
+        MCAL_SysTick_Sleep(1U + (nextRandom() % SLEEP_MAX_MS));
+
+        phase = tickPhase();
+        if (phase < phaseMin)
+        {
+            phaseMin = phase;
+        }
+        if (phase > phaseMax)
+        {
+            phaseMax = phase;
+        }
+    }
+
+    SIM_GetStats(&stats);
+    idleMs  = MCAL_SysTick_GetIdleMs();
+    sleepMs = (uint32_t)(stats.sleepCycles / SIM_CYCLES_PER_MS);
+    wallMs  = SIM_Now() / SIM_CYCLES_PER_MS;
+    early   = stats.isrCount[INT_GPIOF];
+    slackMs = (STEPS * IDLE_SLACK_CYCLES) / SIM_CYCLES_PER_MS;
+
+    printf("  %-8s: %u ms, %u ticks, %u early wakes, phase %lld..%lld cycles, "
+           "idle %u ms (model %u), busy max %u cycles\n",
+           name, (unsigned)wallMs, MCAL_SysTick_GetTickMs(), early,
+           (long long)phaseMin, (long long)phaseMax, idleMs, sleepMs, busyMaxSeen);
+
+    TEST_CHECK((wallMs - MCAL_SysTick_GetTickMs()) <=
+               (1U + ((uint64_t)(phaseMax - phaseMin) / SIM_CYCLES_PER_MS)),
+               "%s: %u ticks in %u ms", name, MCAL_SysTick_GetTickMs(), (unsigned)wallMs);
+    TEST_CHECK(callbacks == MCAL_SysTick_GetTickMs(), "%s: %u callbacks for %u ticks", name,
+               callbacks, MCAL_SysTick_GetTickMs());
+    if (wakes)
+    {
+        TEST_CHECK(early > (STEPS / 2U), "%s: only %u early wakes", name, early);
+        TEST_CHECK((uint64_t)(phaseMax - phaseMin) <= ((uint64_t)early * WAKE_DRIFT_CYCLES),
+                   "%s: tick moved %lld cycles in %u early wakes", name,
+                   (long long)(phaseMax - phaseMin), early);
+    }
+    else
+    {
+        TEST_CHECK(phaseMin == phaseMax, "%s: tick moved %lld cycles", name,
+                   (long long)(phaseMax - phaseMin));
+    }
+    TEST_CHECK((idleMs <= (sleepMs + slackMs)) && ((idleMs + 1U) >= sleepMs),
+               "%s: %u ms idle counted, %u ms slept", name, idleMs, sleepMs);
+    TEST_CHECK(windowIdleMax <= (WINDOW_MS + 1U), "%s: %u ms idle in a %u ms window", name,
+               windowIdleMax, WINDOW_MS);
+    TEST_CHECK((busyMaxSeen >= busyMax) && (busyMaxSeen <= (busyMax + BUSY_OVERHEAD_CYCLES)),
+               "%s: busy max %u cycles, longest stretch %u", name, busyMaxSeen, busyMax);
+}
+
+static void testTicksOnly(void)
+{
+    run(FALSE, "ticks");
+}
+
+static void testEarlyWakes(void)
+{
+    run(TRUE, "wakes");
+}
+
+static void testDelay(void)
+{
+    SIM_StatsType stats;
+    uint64_t      start;
+    uint64_t      slept;
+    uint32_t      tick;
+    uint32_t      ms;
+
+    boot(FALSE, 19U);
+
+    for (ms = 1U; ms <= 50U; ms += 7U)
+    {
+        SIM_Run(nextRandom() % SIM_CYCLES_PER_MS);
+        SIM_GetStats(&stats);
+        start = stats.sleepCycles;
+        tick  = MCAL_SysTick_GetTickMs();
+
+        MCAL_SysTick_DelayMs(ms);
+
+        SIM_GetStats(&stats);
+        slept = stats.sleepCycles - start;
+        TEST_CHECK((MCAL_SysTick_GetTickMs() - tick) == ms, "delay %u: %u ticks", ms,
+                   MCAL_SysTick_GetTickMs() - tick);
+        /* Started anywhere in a ms: only the ms - 1 after it are certain */
+        TEST_CHECK((slept * 10U) >= (((uint64_t)ms - 1U) * 9U * SIM_CYCLES_PER_MS),
+                   "delay %u: slept only %u cycles", ms, (unsigned)slept);
+    }
+}
+
+int main(void)
+{
+    printf("test_tick: %u steps of up to %u cycles busy, sleeps of 1..%u ms\n",
+           STEPS, BUSY_MAX_CYCLES, SLEEP_MAX_MS);
+
+    TEST_Isolated(testTicksOnly);
+    TEST_Isolated(testEarlyWakes);
+    TEST_Isolated(testDelay);
+
+    return TEST_END();
+}
@@ -0,0 +1,270 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_trace.c
+ *  Description : Event trace from TRACE() to the Chrome JSON of
+ *                trace_export.c
+ *
+ *  trace.c records as the HMI on the timer and SysTick models, the
+ *  timebase read just before and after each TRACE() bounding its stamp:
+ *  an LCD string, 20 marks 1 ms apart, a 50 ms sleep in WFI and a
+ *  request/response pair. Its packets are written to a capture file with
+ *  console text around them, as "trace on" leaves them on the UART, and
+ *  trace_export.c (built in here, main() renamed) turns the file into
+ *  JSON in a child process.
+ *
+ *  Every record must come out once, in order, at its stamp relative to
+ *  the first; the gap across the sleep must be the time slept.
+ *===========================================================================*/
+
+#define main EXPORT_Main
+#include "../trace_export.c"
+#undef main
+
+#include "sim.h"
+#include "test.h"
+
+#include <unistd.h>
+#include <sys/wait.h>
+#include "mcal/mcal_systick.h"
+#include "services/timebase.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define MARKS                   (20U)
+#define SLEEP_MS                (50U)
+#define LCD_BUSY_US             (300U)
+#define REQUEST_BUSY_US         (2000U)
+#define CAPTURE_PATH            "build/test_trace.bin"
+#define JSON_PATH               "build/test_trace.json"
+#define JSON_LINE_MAX           (256U)
+#define JSON_NO_TS              (-1.0e9)        /* nextTs(): no such event */
+
+#if (TRACE_ENABLE == 0)
+#error "test_trace needs TRACE_ENABLE=1 (Makefile)"
+#endif
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+/* One TRACE() call and the timebase around it */
+typedef struct
+{
+    const char *ph;         /* JSON phase and name it must come out as */
+    char        name[16];
+    uint64_t    before;
+    uint64_t    after;
+} ExpectType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static ExpectType expects[MARKS + 4U];
+static uint32_t   expectCount;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+#define RECORD(phase, label, event, arg8, arg16) \
+    do { \
+        ExpectType *e_ = &expects[expectCount++]; \
+        e_->ph = (phase); \
+        (void)snprintf(e_->name, sizeof(e_->name), "%s", (label)); \
+        e_->before = TIME_GetUs64(); \
+        TRACE((event), (arg8), (arg16)); \
+        e_->after = TIME_GetUs64(); \
+    } while (0)
+
+static void busyUs(uint32_t us)
+{
+    SIM_Run((uint64_t)us * SIM_CYCLES_PER_US);
+}
+
+/* Sleep in WFI with nothing else due until ms have passed */
+static void sleepMs(uint32_t ms)
+{
+    uint32_t until = MCAL_SysTick_GetTickMs() + ms;
+
+    while (MCAL_SysTick_GetTickMs() < until)
+    {
+        MCAL_SysTick_Sleep(until - MCAL_SysTick_GetTickMs());
+    }
+}
+
+static void traceHmi(void)
+{
+    char     label[16];
+    uint32_t i;
+
+    RECORD("B", "LCD string", TRACE_EVT_LCD_BEGIN, TRACE_LCD_STRING, 0U);
+    busyUs(LCD_BUSY_US);
+    RECORD("E", "", TRACE_EVT_LCD_END, TRACE_LCD_STRING, 16U);
+
+    for (i = 0U; i < MARKS; i++)
+    {
+        sleepMs(1U);
+        (void)snprintf(label, sizeof(label), "mark %u/0/%u", (unsigned)TRACE_EVT_MARK, i);
+        RECORD("i", label, TRACE_EVT_MARK, 0U, i);
+    }
+
+    sleepMs(SLEEP_MS);
+    RECORD("b", "'O'", TRACE_EVT_REQ_SEND, 'O', 1U);
+    busyUs(REQUEST_BUSY_US);
+    RECORD("e", "'O'", TRACE_EVT_RESP_RECV, 'Y', 1U);
+}
+
+/* Drain the ring to the capture, console text between the packets */
+static uint32_t capture(void)
+{
+    static const char prompt[] = "hmi> trace on\r\n";
+    uint8_t  packet[TRACE_PACKET_MAX_SIZE];
+    uint16_t len;
+    uint32_t packets = 0U;
+    FILE    *file = fopen(CAPTURE_PATH, "wb");
+
+    if (file == NULL)
+    {
+        return 0U;
+    }
+
+    (void)fwrite(prompt, 1U, sizeof(prompt) - 1U, file);
+    while ((len = TRACE_BuildPacket(packet, (uint16_t)sizeof(packet))) != 0U)
+    {
+        (void)fwrite(packet, 1U, len, file);
+        (void)fwrite(prompt, 1U, sizeof(prompt) - 1U, file);
+        packets++;
+    }
+    (void)fclose(file);
+
+    return packets;
+}
+
+/* Run the exporter on the capture, its JSON into JSON_PATH */
+static int exportJson(void)
+{
+    char *argv[] = { "trace_export", CAPTURE_PATH, NULL };
+    int   status = -1;
+    pid_t pid;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0)
+    {
+        if (freopen(JSON_PATH, "w", stdout) == NULL)
+        {
+            _exit(2);
+        }
+        status = EXPORT_Main(2, argv);
+        fflush(stdout);
+        _exit(status);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status))
+    {
+        return -1;
+    }
+
+    return WEXITSTATUS(status);
+}
+
+/* Timestamp of the next JSON event of this phase and name on the HMI's
+ * main thread, or JSON_NO_TS if there is none */
+static double nextTs(FILE *json, const ExpectType *expect)
+{
+    char        line[JSON_LINE_MAX];
+    char        head[64];
+    const char *ts;
+
+    (void)snprintf(head, sizeof(head), "{\"ph\":\"%s\",\"name\":\"%s\",\"pid\":1,\"tid\":1,",
+                   expect->ph, expect->name);
+    while (fgets(line, sizeof(line), json) != NULL)
+    {
+        ts = strstr(line, "\"ts\":");
+        if ((strncmp(line, head, strlen(head)) == 0) && (ts != NULL))
+        {
+            return strtod(ts + 5, NULL);
+        }
+    }
+
+    return JSON_NO_TS;
+}
+
+static void testExport(void)
+{
+    const ExpectType *first = &expects[0];
+    const ExpectType *e;
+    uint32_t packets;
+    uint32_t i;
+    double   ts;
+    double   sleptTs = 0.0;
+    FILE    *json;
+
+    SIM_Init();
+    SIM_SetLimit(1000U * SIM_CYCLES_PER_MS);
+    expectCount = 0U;
+
+    MCAL_SysTick_Init();
+    TIME_Init();
+    TRACE_Init(TRACE_ECU_HMI);
+    IntMasterEnable();
+
+    TRACE_Start();
+    traceHmi();
+    TRACE_Stop();
+    packets = capture();
+
+    printf("  %u records in %u packets, %u ms asleep\n", expectCount, packets,
+           MCAL_SysTick_GetIdleMs());
+    TEST_CHECK(packets == ((expectCount + TRACE_RECORDS_PER_PACKET - 1U) /
+                           TRACE_RECORDS_PER_PACKET), "%u packets for %u records",
+               packets, expectCount);
+    TEST_CHECK(exportJson() == 0, "trace_export failed");
+
+    json = fopen(JSON_PATH, "r");
+    TEST_CHECK(json != NULL, "no %s", JSON_PATH);
+    if (json == NULL)
+    {
+        return;
+    }
+
+    /* Stamp minus the first stamp, both bounded by their reads */
+    for (i = 0U; i < expectCount; i++)
+    {
+        e  = &expects[i];
+        ts = nextTs(json, e);
+        TEST_CHECK((ts >= (double)(int64_t)(e->before - first->after)) &&
+                   (ts <= (double)(e->after - first->before)),
+                   "record %u (%s \"%s\") at %.0f us, stamped in %llu..%llu", i, e->ph,
+                   e->name, ts, (unsigned long long)(e->before - first->after),
+                   (unsigned long long)(e->after - first->before));
+
+        if (i == (MARKS + 1U))
+        {
+            sleptTs = ts;
+        }
+        else if (i == (MARKS + 2U))
+        {
+            printf("  last mark at %.0f us, request sent %.0f us after it\n", sleptTs,
+                   ts - sleptTs);
+            TEST_CHECK((ts - sleptTs) >= (SLEEP_MS * 1000.0), "%.0f us across a %u ms "
+                       "sleep", ts - sleptTs, SLEEP_MS);
+        }
+        else
+        {
+            /* Nothing more for the other records */
+        }
+    }
+    (void)fclose(json);
+}
+
+int main(void)
+{
+    printf("test_trace: HMI trace at %u Hz, through trace_export\n", TRACE_STAMP_HZ);
+
+    TEST_Isolated(testExport);
+
+    return TEST_END();
+}
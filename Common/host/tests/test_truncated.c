@@ -0,0 +1,498 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_truncated.c
+ *  Description : Truncated frames and short payloads: hal_comm.c and the
+ *                Control ECU's command handlers on the UART model
+ *
+ *  Control's hal_comm.c runs point-to-point on UART1 at 115200, without
+ *  the reliable link (HAL_COMM_RELIABLE 0), so what the test injects is
+ *  what the frame parser sees.
+ *
+ *  - Bytes: HAL_COMM_ReceiveBytesTimeout() on a short burst times out
+ *    with the bytes that did arrive counted and kept.
+ *  - Frame: HAL_COMM_ReceiveFrameTimeout() on half a frame times out;
+ *    once the line has been quiet HAL_COMM_FRAME_GAP_MS the fragment is
+ *    dropped and counted, and the next frame is returned.
+ *  - Gap: fragments cut after every byte position, each followed by a
+ *    quiet gap and a whole frame, into HAL_COMM_PollFrame(). None is
+ *    dropped before the gap has passed, each is counted once after it,
+ *    and every whole frame decodes.
+ *  - Control: CONTROL_WS/main.c runs whole (main renamed CONTROL_Main)
+ *    against a scripted HMI. Commands whose payload is shorter than its
+ *    length bytes claim are answered 'N' and never count as a wrong
+ *    password; commands sent again after a fragment of themselves are
+ *    carried out; 'H' reports the fragments as truncatedFrames.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <string.h>
+#include "hal/hal_comm.h"
+#include "mcal/mcal_systick.h"
+#include "services/frame.h"
+#include "services/request.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_UART1               (1U)
+#define CMD_TEST                ('O')
+#define FRAG_GAP_CYCLES         ((HAL_COMM_FRAME_GAP_MS + 5U) * SIM_CYCLES_PER_MS)
+#define POLL_STEP_CYCLES        (100U * SIM_CYCLES_PER_US)
+
+/* Control protocol (CONTROL_WS/main.c) */
+#define CMD_SETUP_PASSWORD      ('S')
+#define CMD_OPEN_DOOR           ('O')
+#define CMD_CHANGE_PASSWORD     ('C')
+#define CMD_SET_TIMEOUT         ('T')
+#define CMD_HEALTH              ('H')
+#define RESP_SUCCESS            ('Y')
+#define RESP_FAILURE            ('N')
+#define RESP_READY              ('R')
+#define RESP_HEALTH             ('H')
+#define HEALTH_TRUNCATED_AT     (1U + (10U * 4U))   /* SEQ, then the 11th counter */
+
+#define SCRIPT_REPLY_CYCLES     (500U * SIM_CYCLES_PER_MS)
+#define SCRIPT_PAUSE_CYCLES     (2U * SIM_CYCLES_PER_MS)
+#define SCRIPT_TX_MAX           (1024U)
+
+#if (HAL_COMM_RELIABLE != 0) || (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+#error "test_truncated needs hal_comm.h point-to-point without the link layer (Makefile)"
+#endif
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+/* One command of the scripted HMI; payload after the SEQ byte */
+typedef struct
+{
+    const char *name;
+    uint8_t     fragment;       /* Leading bytes sent alone first, 0 for none */
+    uint8_t     cmd;
+    const char *payload;
+    uint8_t     len;
+    uint8_t     expect;         /* Response command */
+} StepType;
+
+typedef enum
+{
+    SCRIPT_READY = 0,           /* Waiting for Control's unsolicited Ready */
+    SCRIPT_SEND,                /* Next command goes out at nextAt */
+    SCRIPT_REPLY                /* Waiting for its response until nextAt */
+} ScriptPhaseType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+#define STEP(name, fragment, cmd, payload, expect) \
+    { (name), (fragment), (cmd), (payload), (uint8_t)(sizeof(payload) - 1U), (expect) }
+
+static const StepType steps[] =
+{
+    STEP("open, empty",                0U, CMD_OPEN_DOOR,       "",                     RESP_FAILURE),
+    STEP("open, 2 of 5 digits",        0U, CMD_OPEN_DOOR,       "\x05" "12",            RESP_FAILURE),
+    STEP("open, 4 of 5 digits",        0U, CMD_OPEN_DOOR,       "\x05" "1234",          RESP_FAILURE),
+    STEP("open, length only",          0U, CMD_OPEN_DOOR,       "\x05",                 RESP_FAILURE),
+    STEP("setup, one password",        0U, CMD_SETUP_PASSWORD,  "\x05" "12345",         RESP_FAILURE),
+    STEP("setup, second cut",          0U, CMD_SETUP_PASSWORD,  "\x05" "12345\x05" "123", RESP_FAILURE),
+    STEP("change, two passwords",      0U, CMD_CHANGE_PASSWORD, "\x05" "12345\x05" "54321", RESP_FAILURE),
+    STEP("timeout, no password",       0U, CMD_SET_TIMEOUT,     "\x0A",                 RESP_FAILURE),
+    STEP("timeout, 2 of 5 digits",     0U, CMD_SET_TIMEOUT,     "\x0A\x05" "12",        RESP_FAILURE),
+    STEP("setup after a fragment",     7U, CMD_SETUP_PASSWORD,  "\x05" "12345\x05" "12345", RESP_SUCCESS),
+    STEP("timeout after a fragment",   2U, CMD_SET_TIMEOUT,     "\x0A\x05" "12345",     RESP_SUCCESS),
+    STEP("open after a fragment",      1U, CMD_OPEN_DOOR,       "\x05" "12345",         RESP_SUCCESS),
+    STEP("health",                     0U, CMD_HEALTH,          "",                     RESP_HEALTH)
+};
+
+#define STEP_COUNT              (sizeof(steps) / sizeof(steps[0]))
+
+static uint8_t  stepWire[STEP_COUNT][FRAME_MAX_SIZE];
+static uint16_t stepWireLen[STEP_COUNT];
+static uint8_t  heartbeatWire[FRAME_MAX_SIZE];
+static uint16_t heartbeatLen;
+static uint32_t fragmentsSent;
+
+/* Scripted HMI */
+static boolean         scriptOn;
+static ScriptPhaseType phase;
+static uint64_t        nextAt;         /* Send time, or the reply deadline */
+static boolean         txPending;      /* Control sent something not yet parsed */
+static uint32_t        step;
+static uint8_t         txBuf[SCRIPT_TX_MAX];
+static uint32_t        txLen;
+
+/*======================================================================
+ *  Prototypes
+ *====================================================================*/
+
+int CONTROL_Main(void);
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint64_t wireCycles(uint16_t len)
+{
+    return (uint64_t)len * ((10U * SIM_CLOCK_HZ) / HAL_COMM_BAUD_RATE);
+}
+
+static void boot(void)
+{
+    SIM_Init();
+    SIM_SetLimit(10000U * SIM_CYCLES_PER_MS);
+
+    MCAL_SysTick_Init();
+    (void)HAL_COMM_Init();
+    IntMasterEnable();
+}
+
+/* Poll for up to cycles; TRUE with the frame as soon as one is returned */
+static boolean pollFor(FRAME_Type *frame, uint64_t cycles)
+{
+    uint64_t end = SIM_Now() + cycles;
+
+    while (SIM_Now() < end)
+    {
+        if (HAL_COMM_PollFrame(frame))
+        {
+            return TRUE;
+        }
+        SIM_Run(POLL_STEP_CYCLES);
+    }
+    return FALSE;
+}
+
+static uint32_t truncatedFrames(void)
+{
+    HAL_COMM_StatsType stats;
+
+    HAL_COMM_GetStats(&stats);
+    return stats.truncatedFrames;
+}
+
+static void testBytes(void)
+{
+    static const uint8_t data[] = { 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U, 0x88U };
+    uint8_t  buf[sizeof(data)];
+    uint32_t received = 0xFFFFFFFFU;
+    uint8_t  result;
+
+    boot();
+
+    SIM_UART_Inject(SIM_UART1, data, 5U, SIM_Now());
+    memset(buf, 0, sizeof(buf));
+    result = HAL_COMM_ReceiveBytesTimeout(buf, sizeof(buf), 20U, &received);
+    TEST_CHECK(result == HAL_COMM_ERROR_TIMEOUT, "bytes: short read returned %u", result);
+    TEST_CHECK(received == 5U, "bytes: %u of 5 counted", received);
+    TEST_CHECK(memcmp(buf, data, 5U) == 0, "bytes: short read kept the wrong bytes");
+
+    /* Nothing at all: a timeout with none counted */
+    result = HAL_COMM_ReceiveBytesTimeout(buf, 1U, 5U, &received);
+    TEST_CHECK((result == HAL_COMM_ERROR_TIMEOUT) && (received == 0U),
+               "bytes: empty read returned %u with %u", result, received);
+
+    SIM_UART_Inject(SIM_UART1, data, sizeof(data), SIM_Now());
+    result = HAL_COMM_ReceiveBytesTimeout(buf, sizeof(buf), 20U, &received);
+    TEST_CHECK((result == HAL_COMM_SUCCESS) && (received == sizeof(data)) &&
+               (memcmp(buf, data, sizeof(data)) == 0),
+               "bytes: full read returned %u with %u", result, received);
+}
+
+static void testFrame(void)
+{
+    static const uint8_t payload[] = { 1U, 5U, '1', '2', '3', '4', '5' };
+    uint8_t    wire[FRAME_MAX_SIZE];
+    uint16_t   len;
+    FRAME_Type frame;
+    uint8_t    result;
+
+    boot();
+    len = FRAME_Encode(CMD_TEST, payload, sizeof(payload), wire, (uint16_t)sizeof(wire));
+
+    /* Half a frame, then silence shorter than the gap: still pending */
+    SIM_UART_Inject(SIM_UART1, wire, len / 2U, SIM_Now());
+    result = HAL_COMM_ReceiveFrameTimeout(&frame, HAL_COMM_FRAME_GAP_MS / 2U);
+    TEST_CHECK(result == HAL_COMM_ERROR_TIMEOUT, "frame: half a frame returned %u", result);
+    TEST_CHECK(truncatedFrames() == 0U, "frame: fragment dropped before the gap");
+
+    /* The gap passes inside the next wait */
+    result = HAL_COMM_ReceiveFrameTimeout(&frame, HAL_COMM_FRAME_GAP_MS);
+    TEST_CHECK(result == HAL_COMM_ERROR_TIMEOUT, "frame: quiet line returned %u", result);
+    TEST_CHECK(truncatedFrames() == 1U, "frame: %u fragments counted, 1 sent", truncatedFrames());
+
+    SIM_UART_Inject(SIM_UART1, wire, len, SIM_Now());
+    result = HAL_COMM_ReceiveFrameTimeout(&frame, 20U);
+    TEST_CHECK((result == HAL_COMM_SUCCESS) && (frame.cmd == CMD_TEST) &&
+               (frame.len == sizeof(payload)) &&
+               (memcmp(frame.payload, payload, sizeof(payload)) == 0),
+               "frame: next frame returned %u, cmd 0x%02X len %u", result, frame.cmd, frame.len);
+}
+
+static void testGap(void)
+{
+    static const uint8_t payload[] = { 7U, 5U, '5', '4', '3', '2', '1' };
+    uint8_t    wire[FRAME_MAX_SIZE];
+    uint16_t   len;
+    uint16_t   cut;
+    uint32_t   decoded = 0U;
+    FRAME_Type frame;
+
+    boot();
+    len = FRAME_Encode(CMD_TEST, payload, sizeof(payload), wire, (uint16_t)sizeof(wire));
+
+    for (cut = 1U; cut < len; cut++)
+    {
+        SIM_UART_Inject(SIM_UART1, wire, cut, SIM_Now());
+
+        /* Quiet for a little less than the gap: the fragment waits */
+        TEST_CHECK(!pollFor(&frame, wireCycles(cut) +
+                            ((HAL_COMM_FRAME_GAP_MS - 2U) * SIM_CYCLES_PER_MS)),
+                   "gap: %u-byte fragment returned a frame", cut);
+        TEST_CHECK(truncatedFrames() == (cut - 1U), "gap: %u-byte fragment dropped early", cut);
+
+        /* Past it: dropped, and the whole frame after it decodes */
+        TEST_CHECK(!pollFor(&frame, 5U * SIM_CYCLES_PER_MS), "gap: %u-byte fragment decoded",
+                   cut);
+        TEST_CHECK(truncatedFrames() == cut, "gap: %u fragments counted after %u", truncatedFrames(),
+                   cut);
+
+        SIM_UART_Inject(SIM_UART1, wire, len, SIM_Now());
+        if (pollFor(&frame, wireCycles(len) + SIM_CYCLES_PER_MS) && (frame.cmd == CMD_TEST) &&
+            (frame.len == sizeof(payload)) &&
+            (memcmp(frame.payload, payload, sizeof(payload)) == 0))
+        {
+            decoded++;
+        }
+    }
+
+    printf("  gap     : %u fragments of 1..%u bytes, %u dropped, %u of %u frames after them\n",
+           len - 1U, len - 1U, truncatedFrames(), decoded, len - 1U);
+    TEST_CHECK(decoded == (len - 1U), "gap: %u of %u frames decoded", decoded, len - 1U);
+}
+
+/*--------------------------------------------------------------------
+ *  Scripted HMI for the Control ECU. It runs as a model, so it only
+ *  touches the UART model: frames are encoded before Control boots,
+ *  and responses are split by their LEN byte as they arrive.
+ *------------------------------------------------------------------*/
+
+static void scriptFinish(void)
+{
+    printf("  control : %u commands, %u after a fragment of themselves\n",
+           (unsigned)STEP_COUNT, fragmentsSent);
+    fflush(stdout);
+    exit((testFailures > 100U) ? 100 : (int)testFailures);
+}
+
+static void scriptSend(uint64_t now)
+{
+    const StepType *s   = &steps[step];
+    uint64_t        at  = now;
+
+    if (s->fragment != 0U)
+    {
+        SIM_UART_Inject(SIM_UART1, stepWire[step], s->fragment, at);
+        at += wireCycles(s->fragment) + FRAG_GAP_CYCLES;
+        fragmentsSent++;
+    }
+    SIM_UART_Inject(SIM_UART1, stepWire[step], stepWireLen[step], at);
+
+    txLen  = 0U;
+    phase  = SCRIPT_REPLY;
+    nextAt = at + wireCycles(stepWireLen[step]) + SCRIPT_REPLY_CYCLES;
+}
+
+/* A response to the current step, or to the wait for Ready */
+static void scriptOnResponse(const uint8_t *wire, uint8_t cmd, uint8_t len, uint64_t now)
+{
+    const StepType *s = &steps[step];
+
+    if (phase == SCRIPT_READY)
+    {
+        if (cmd == RESP_READY)
+        {
+            phase  = SCRIPT_SEND;
+            nextAt = now + SCRIPT_PAUSE_CYCLES;
+        }
+        return;
+    }
+
+    /* Unsolicited frames (door events, Ready) carry SEQ 0 */
+    if ((phase != SCRIPT_REPLY) || (len < 1U) || (wire[3] == REQ_SEQ_UNSOLICITED))
+    {
+        return;
+    }
+
+    TEST_CHECK(cmd == s->expect, "control: %s answered '%c', expected '%c'", s->name, cmd,
+               s->expect);
+    TEST_CHECK(wire[3] == (uint8_t)(step + 1U), "control: %s answered SEQ %u", s->name,
+               wire[3]);
+    if ((cmd == RESP_HEALTH) && (len >= (HEALTH_TRUNCATED_AT + 4U)))
+    {
+        const uint8_t *p = &wire[3U + HEALTH_TRUNCATED_AT];
+        uint32_t truncated = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                             ((uint32_t)p[2] << 8) | p[3];
+
+        TEST_CHECK(truncated == fragmentsSent, "control: 'H' reports %u truncated frames, "
+                   "%u fragments sent", truncated, fragmentsSent);
+    }
+
+    step++;
+    if (step >= STEP_COUNT)
+    {
+        scriptFinish();
+    }
+    phase  = SCRIPT_SEND;
+    nextAt = now + SCRIPT_PAUSE_CYCLES;
+}
+
+/* Split what Control sent into frames; link control (below 0x20) is skipped */
+static void scriptParse(uint64_t now)
+{
+    uint32_t start = 0U;
+    uint32_t size;
+
+    while (start < txLen)
+    {
+        if (txBuf[start] != FRAME_SOF)
+        {
+            start++;
+            continue;
+        }
+        if ((start + 3U) > txLen)
+        {
+            break;
+        }
+        size = (uint32_t)txBuf[start + 1U] + FRAME_OVERHEAD;
+        if ((start + size) > txLen)
+        {
+            break;
+        }
+        if (txBuf[start + 2U] >= 0x20U)
+        {
+            scriptOnResponse(&txBuf[start], txBuf[start + 2U], txBuf[start + 1U], now);
+        }
+        start += size;
+    }
+
+    memmove(txBuf, &txBuf[start], txLen - start);
+    txLen -= start;
+}
+
+static void onTx(uint8_t uart, uint8_t data)
+{
+    (void)uart;
+
+    if (txLen < SCRIPT_TX_MAX)
+    {
+        txBuf[txLen++] = data;
+    }
+    txPending = TRUE;
+}
+
+static void scriptReset(void)
+{
+    scriptOn  = FALSE;
+    txPending = FALSE;
+    nextAt    = SIM_NEVER;
+}
+
+static uint64_t scriptNextEvent(void)
+{
+    if (!scriptOn)
+    {
+        return SIM_NEVER;
+    }
+    return txPending ? SIM_Now() : nextAt;
+}
+
+static void scriptProcess(uint64_t now)
+{
+    if (!scriptOn)
+    {
+        return;
+    }
+
+    if (txPending)
+    {
+        txPending = FALSE;
+        scriptParse(now);
+    }
+
+    if (now < nextAt)
+    {
+        return;
+    }
+
+    if (phase == SCRIPT_SEND)
+    {
+        scriptSend(now);
+    }
+    else
+    {
+        TEST_CHECK(FALSE, "control: no answer to %s",
+                   (phase == SCRIPT_READY) ? "the HMI coming up" : steps[step].name);
+        scriptFinish();
+    }
+}
+
+static const SIM_ModelType scriptModel = { "hmi script", scriptReset, scriptNextEvent,
+                                           scriptProcess };
+
+static __attribute__((constructor)) void attach(void)
+{
+    SIM_AddModel(&scriptModel);
+}
+
+static void testControl(void)
+{
+    uint8_t  payload[FRAME_MAX_PAYLOAD];
+    uint32_t i;
+
+    SIM_Init();
+    SIM_SetLimit(10000U * SIM_CYCLES_PER_MS);
+
+    /* Each command carries its step number as SEQ */
+    for (i = 0U; i < STEP_COUNT; i++)
+    {
+        payload[0] = (uint8_t)(i + 1U);
+        memcpy(&payload[1], steps[i].payload, steps[i].len);
+        stepWireLen[i] = FRAME_Encode(steps[i].cmd, payload, (uint8_t)(steps[i].len + 1U),
+                                      stepWire[i], (uint16_t)sizeof(stepWire[i]));
+    }
+    heartbeatLen = FRAME_Encode(HAL_COMM_CMD_HEARTBEAT, NULL, 0U, heartbeatWire,
+                                (uint16_t)sizeof(heartbeatWire));
+
+    fragmentsSent = 0U;
+    step          = 0U;
+    txLen         = 0U;
+    phase         = SCRIPT_READY;
+    scriptOn      = TRUE;
+    SIM_UART_SetTxHook(SIM_UART1, onTx);
+
+    /* The HMI is heard once Control is up; Control negotiates the rate
+     * (nobody answers, so it stays at the base rate) and sends Ready */
+    nextAt = SIM_Now() + (100U * SIM_CYCLES_PER_MS);
+    SIM_UART_Inject(SIM_UART1, heartbeatWire, heartbeatLen, nextAt);
+    nextAt += 2U * SCRIPT_REPLY_CYCLES;
+
+    (void)CONTROL_Main();
+}
+
+int main(void)
+{
+    printf("test_truncated: hal_comm.c point-to-point at %u baud, %u ms frame gap\n",
+           HAL_COMM_BAUD_RATE, HAL_COMM_FRAME_GAP_MS);
+
+    TEST_Isolated(testBytes);
+    TEST_Isolated(testFrame);
+    TEST_Isolated(testGap);
+    TEST_Isolated(testControl);
+
+    return TEST_END();
+}
@@ -0,0 +1,184 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_uart_burst.c
+ *  Description : 10,000-byte bursts into the interrupt-driven UART RX ring
+ *
+ *  mcal_uart.c runs unchanged on the UART model: UART1 at 115200 8N1 with
+ *  a 128-byte ring, and a peer that sends 10,000 bytes back to back.
+ *  The "application" drains the ring only between stretches of other work
+ *  (SIM_Run), from 1 ms up to 10 ms, which is most of the ring at this
+ *  rate. Every run must deliver all bytes in order with no ring overrun,
+ *  no FIFO overrun counted by the driver, and none seen by the model.
+ *
+ *  Negative control: with interrupts masked for longer than the FIFO
+ *  lasts (16 characters = 1.39 ms) the overrun must be seen and counted.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "test.h"
+
+#include <stdlib.h>
+#include "mcal/mcal_uart.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define BURST_BYTES             (10000U)
+#define BAUD                    (115200U)
+#define RING_SIZE               (128U)
+#define SIM_UART1               (1U)
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t rxRing[RING_SIZE];
+static uint8_t burst[BURST_BYTES];
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static void setup(void)
+{
+    UART_ConfigType cfg = { 0 };
+
+    SIM_Init();
+    SIM_SetLimit(10U * 1000U * SIM_CYCLES_PER_MS);
+
+    /* SysTick free-running so the driver can time its ISR */
+    SysTickPeriodSet(16000U);
+    SysTickEnable();
+
+    cfg.clockFreq    = SysCtlClockGet();
+    cfg.uartBase     = UART1_BASE;
+    cfg.baudRate     = BAUD;
+    cfg.dataBits     = 8U;
+    cfg.parity       = 0U;
+    cfg.stopBits     = 1U;
+    cfg.rxBuffer     = rxRing;
+    cfg.rxBufferSize = RING_SIZE;
+    cfg.flowControl  = UART_FLOW_NONE;
+    UART_init(&cfg);
+    IntMasterEnable();
+}
+
+/* Drain everything waiting; returns the number of bytes out of order */
+static uint32_t drain(uint32_t *received)
+{
+    uint32_t mismatches = 0U;
+    uint8_t  data;
+
+    while (isDataAvailable(UART1_BASE))
+    {
+        data = receiveByte(UART1_BASE);
+        if ((*received < BURST_BYTES) && (data != burst[*received]))
+        {
+            mismatches++;
+        }
+        (*received)++;
+    }
+
+    return mismatches;
+}
+
+static void runBurst(uint32_t workUs)
+{
+    UART_StatsType     fw;
+    SIM_UART_StatsType hw;
+    uint32_t           received   = 0U;
+    uint32_t           mismatches = 0U;
+    uint64_t           idleSince;
+
+    setup();
+    SIM_UART_Inject(SIM_UART1, burst, BURST_BYTES, SIM_Now());
+
+    idleSince = SIM_Now();
+    while ((received < BURST_BYTES) &&
+           ((SIM_Now() - idleSince) < (50U * SIM_CYCLES_PER_MS)))
+    {
+        SIM_Run((uint64_t)workUs * SIM_CYCLES_PER_US);
+        if (isDataAvailable(UART1_BASE))
+        {
+            mismatches += drain(&received);
+            idleSince = SIM_Now();
+        }
+    }
+
+    UART_GetStats(UART1_BASE, &fw);
+    SIM_UART_GetStats(SIM_UART1, &hw);
+
+    printf("  work %5u us: %5u bytes, ring high-water %3u/%u, burst max %2u, "
+           "ISR max %4u cycles\n",
+           workUs, received, fw.rxHighWater, RING_SIZE, fw.rxBurstMax, fw.isrMaxCycles);
+
+    TEST_CHECK(received == BURST_BYTES, "work %u us: received %u of %u",
+               workUs, received, BURST_BYTES);
+    TEST_CHECK(mismatches == 0U, "work %u us: %u bytes out of order", workUs, mismatches);
+    TEST_CHECK(fw.rxRingOverruns == 0U, "work %u us: %u ring overruns",
+               workUs, fw.rxRingOverruns);
+    TEST_CHECK(fw.rxFifoOverruns == 0U, "work %u us: %u FIFO overruns (driver)",
+               workUs, fw.rxFifoOverruns);
+    TEST_CHECK(hw.rxOverruns == 0U, "work %u us: %u FIFO overruns (line)",
+               workUs, hw.rxOverruns);
+    TEST_CHECK(fw.rxBytes == BURST_BYTES, "work %u us: driver counted %u bytes",
+               workUs, fw.rxBytes);
+}
+
+static void runMasked(void)
+{
+    UART_StatsType     fw;
+    SIM_UART_StatsType hw;
+    uint32_t           received = 0U;
+    uint32_t           primask;
+
+    setup();
+    SIM_UART_Inject(SIM_UART1, burst, 64U, SIM_Now());
+
+    /* 2 ms with interrupts off: 23 characters arrive, 16 fit the FIFO */
+    primask = CPUcpsid();
+    SIM_Run(2U * SIM_CYCLES_PER_MS);
+    if (primask == 0U)
+    {
+        CPUcpsie();
+    }
+
+    SIM_Run(10U * SIM_CYCLES_PER_MS);
+    (void)drain(&received);
+
+    UART_GetStats(UART1_BASE, &fw);
+    SIM_UART_GetStats(SIM_UART1, &hw);
+
+    printf("  masked 2 ms : %u of 64 bytes, %u lost on the line, driver saw %u overrun(s)\n",
+           received, hw.rxOverruns, fw.rxFifoOverruns);
+
+    TEST_CHECK(hw.rxOverruns > 0U, "masked run should overrun the FIFO");
+    TEST_CHECK(fw.rxFifoOverruns > 0U, "driver did not count the overrun");
+    TEST_CHECK(received == (64U - hw.rxOverruns), "received %u, expected %u",
+               received, 64U - hw.rxOverruns);
+}
+
+int main(void)
+{
+    static const uint32_t workUs[] = { 1000U, 2500U, 5000U, 7500U, 10000U };
+    uint32_t i;
+
+    srand(1U);
+    for (i = 0U; i < BURST_BYTES; i++)
+    {
+        burst[i] = (uint8_t)rand();
+    }
+
+    printf("test_uart_burst: %u bytes at %u baud into a %u-byte ring\n",
+           BURST_BYTES, BAUD, RING_SIZE);
+
+    for (i = 0U; i < (sizeof(workUs) / sizeof(workUs[0])); i++)
+    {
+        runBurst(workUs[i]);
+    }
+    runMasked();
+
+    return TEST_END();
+}
@@ -0,0 +1,238 @@
+/*============================================================================
+ *  Module      : Host tests
+ *  File Name   : test_udma.c
+ *  Description : uDMA transfer accounting (mcal_udma.c, UART bulk paths)
+ *
+ *  The uDMA model works on the MCAL's own channel control table, so the
+ *  checks compare three views of every transfer: what the MCAL counted
+ *  (Udma_StatsType), what the controller moved (SIM_UDMA_StatsType) and
+ *  the bytes that actually crossed the UART line.
+ *===========================================================================*/
+
+#include "sim.h"
+#include "sim_uart.h"
+#include "sim_udma.h"
+#include "test.h"
+
+#include <string.h>
+#include "mcal/mcal_uart.h"
+#include "mcal/mcal_udma.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SIM_UART1               (1U)
+#define TX_BYTES                (3000U)     /* Three chunks: 1024 + 1024 + 952 */
+#define RX_BYTES                (2500U)
+#define SW_CHANNEL              (30U)       /* Software channel, no peripheral */
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static uint8_t  txData[TX_BYTES];
+static uint8_t  lineData[TX_BYTES];
+static uint32_t lineCount;
+static uint8_t  rxData[RX_BYTES];
+static uint8_t  rxBuffer[RX_BYTES];
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static void onLine(uint8_t uart, uint8_t data)
+{
+    (void)uart;
+    if (lineCount < TX_BYTES)
+    {
+        lineData[lineCount] = data;
+    }
+    lineCount++;
+}
+
+static void setup(void)
+{
+    UART_ConfigType cfg = { 0 };
+
+    SIM_Init();
+    SIM_SetLimit(5000U * SIM_CYCLES_PER_MS);
+    SIM_UART_SetTxHook(SIM_UART1, onLine);
+    lineCount = 0U;
+
+    cfg.clockFreq = SysCtlClockGet();
+    cfg.uartBase  = UART1_BASE;
+    cfg.baudRate  = 115200U;
+    cfg.dataBits  = 8U;
+    cfg.stopBits  = 1U;
+    UART_init(&cfg);
+    IntMasterEnable();
+}
+
+/* Sleep until cond() is false or the deadline passes */
+static void waitWhile(uint8_t (*cond)(uint32_t), uint32_t ms)
+{
+    uint64_t end = SIM_Now() + ((uint64_t)ms * SIM_CYCLES_PER_MS);
+
+    while (cond(UART1_BASE) && (SIM_Now() < end))
+    {
+        SIM_Run(100U * SIM_CYCLES_PER_US);
+    }
+}
+
+static void testInit(void)
+{
+    SIM_Init();
+
+    TEST_CHECK(!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA), "uDMA clocked before init");
+    MCAL_UDMA_Init();
+    TEST_CHECK(SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA), "init did not clock the uDMA");
+    TEST_CHECK(IntIsEnabled(INT_UDMAERR), "uDMA error interrupt not enabled");
+}
+
+static void testTx(void)
+{
+    Udma_StatsType     fw;
+    SIM_UDMA_StatsType hw;
+    UART_StatsType     uart;
+
+    setup();
+
+    TEST_CHECK(UART_StartDmaTx(UART1_BASE, txData, TX_BYTES) == UART_SUCCESS, "TX start");
+    TEST_CHECK(UART_StartDmaTx(UART1_BASE, txData, 1U) == UART_ERROR_BUSY,
+               "second TX while one is active");
+    waitWhile(UART_IsDmaTxBusy, 1000U);
+    SIM_Run(2U * SIM_CYCLES_PER_MS);    /* Let the FIFO empty onto the line */
+
+    MCAL_UDMA_GetStats(&fw);
+    SIM_UDMA_GetStats(&hw);
+    UART_GetStats(UART1_BASE, &uart);
+
+    printf("  TX %u bytes: %u transfers started, %u completed, %u bytes; "
+           "controller moved %u items\n",
+           TX_BYTES, fw.transfersStarted, fw.transfersCompleted, fw.bytesCompleted, hw.items);
+
+    TEST_CHECK(!UART_IsDmaTxBusy(UART1_BASE), "TX still busy");
+    TEST_CHECK(fw.transfersStarted == 3U, "started %u transfers, expected 3",
+               fw.transfersStarted);
+    TEST_CHECK(fw.transfersCompleted == 3U, "completed %u transfers, expected 3",
+               fw.transfersCompleted);
+    TEST_CHECK(fw.bytesCompleted == TX_BYTES, "MCAL counted %u bytes", fw.bytesCompleted);
+    TEST_CHECK(hw.items == TX_BYTES, "controller moved %u items", hw.items);
+    TEST_CHECK(hw.channelItems[UDMA_CHANNEL_UART1TX] == TX_BYTES, "wrong channel");
+    TEST_CHECK(uart.txBytes == TX_BYTES, "UART counted %u TX bytes", uart.txBytes);
+    TEST_CHECK(lineCount == TX_BYTES, "%u bytes on the line", lineCount);
+    TEST_CHECK(memcmp(lineData, txData, TX_BYTES) == 0, "line data differs");
+}
+
+static void testRx(void)
+{
+    Udma_StatsType     fw;
+    SIM_UDMA_StatsType hw;
+
+    setup();
+
+    TEST_CHECK(UART_StartDmaRx(UART1_BASE, rxBuffer, RX_BYTES) == UART_SUCCESS, "RX start");
+    SIM_UART_Inject(SIM_UART1, rxData, RX_BYTES, SIM_Now());
+    waitWhile(UART_IsDmaRxBusy, 1000U);
+
+    MCAL_UDMA_GetStats(&fw);
+    SIM_UDMA_GetStats(&hw);
+
+    printf("  RX %u bytes: %u transfers completed, %u bytes\n",
+           RX_BYTES, fw.transfersCompleted, fw.bytesCompleted);
+
+    TEST_CHECK(!UART_IsDmaRxBusy(UART1_BASE), "RX still busy");
+    TEST_CHECK(fw.transfersStarted == 3U, "started %u transfers", fw.transfersStarted);
+    TEST_CHECK(fw.transfersCompleted == 3U, "completed %u transfers", fw.transfersCompleted);
+    TEST_CHECK(fw.bytesCompleted == RX_BYTES, "MCAL counted %u bytes", fw.bytesCompleted);
+    TEST_CHECK(hw.channelItems[UDMA_CHANNEL_UART1RX] == RX_BYTES, "controller moved %u",
+               hw.channelItems[UDMA_CHANNEL_UART1RX]);
+    TEST_CHECK(memcmp(rxBuffer, rxData, RX_BYTES) == 0, "RX data differs");
+}
+
+static void testAbort(void)
+{
+    Udma_StatsType fw;
+    uint8_t        channel = UDMA_CHANNEL_UART1RX;
+    uint16_t       moved;
+
+    SIM_Init();
+    MCAL_UDMA_Init();
+    MCAL_UDMA_AssignChannel(UDMA_CH22_UART1RX);
+    UARTConfigSetExpClk(UART1_BASE, SysCtlClockGet(), 115200U, UART_CONFIG_WLEN_8);
+    UARTDMAEnable(UART1_BASE, UART_DMA_RX);
+
+    TEST_CHECK(MCAL_UDMA_StartTransfer(channel, UDMA_DIR_PERIPH_TO_MEM,
+                                       (volatile void *)(UART1_BASE + UART_O_DR),
+                                       rxBuffer, 100U) == UDMA_SUCCESS, "start");
+    TEST_CHECK(MCAL_UDMA_StartTransfer(channel, UDMA_DIR_PERIPH_TO_MEM,
+                                       (volatile void *)(UART1_BASE + UART_O_DR),
+                                       rxBuffer, 100U) == UDMA_ERROR_BUSY, "busy");
+    TEST_CHECK(MCAL_UDMA_StartTransfer(channel, UDMA_DIR_PERIPH_TO_MEM,
+                                       (volatile void *)(UART1_BASE + UART_O_DR),
+                                       rxBuffer, 0U) == UDMA_ERROR_INVALID_PARAM, "size 0");
+    TEST_CHECK(MCAL_UDMA_StartTransfer(channel, UDMA_DIR_PERIPH_TO_MEM,
+                                       (volatile void *)(UART1_BASE + UART_O_DR),
+                                       rxBuffer, 1025U) == UDMA_ERROR_INVALID_PARAM,
+               "size 1025");
+
+    /* 40 characters arrive, then the transfer is stopped */
+    SIM_UART_Inject(SIM_UART1, rxData, 40U, SIM_Now());
+    SIM_Run(5U * SIM_CYCLES_PER_MS);
+    TEST_CHECK(MCAL_UDMA_PollComplete(channel) == 0U, "complete after 40 of 100");
+
+    moved = MCAL_UDMA_Abort(channel);
+    MCAL_UDMA_GetStats(&fw);
+
+    printf("  abort after 40 of 100: %u reported moved\n", moved);
+
+    TEST_CHECK(moved == 40U, "abort reported %u bytes", moved);
+    TEST_CHECK(!MCAL_UDMA_IsBusy(channel), "busy after abort");
+    TEST_CHECK(fw.transfersCompleted == 0U, "aborted transfer counted as completed");
+    TEST_CHECK(MCAL_UDMA_Abort(channel) == 0U, "second abort");
+}
+
+static void testBusError(void)
+{
+    Udma_StatsType fw;
+
+    SIM_Init();
+    MCAL_UDMA_Init();
+    MCAL_UDMA_AssignChannel(SW_CHANNEL);
+    IntMasterEnable();
+
+    /* Nothing is mapped at the "peripheral" address: the first request faults */
+    TEST_CHECK(MCAL_UDMA_StartTransfer(SW_CHANNEL, UDMA_DIR_PERIPH_TO_MEM,
+                                       (volatile void *)0x40001000U,
+                                       rxBuffer, 4U) == UDMA_SUCCESS, "start");
+    TEST_CHECK(!SIM_UDMA_Request(SW_CHANNEL, 0U), "request to nowhere moved data");
+    SIM_Run(100U);
+
+    MCAL_UDMA_GetStats(&fw);
+    TEST_CHECK(fw.busErrors == 1U, "%u bus errors counted", fw.busErrors);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < TX_BYTES; i++)
+    {
+        txData[i] = (uint8_t)((i * 131U) + (i >> 8));
+    }
+    for (i = 0U; i < RX_BYTES; i++)
+    {
+        rxData[i] = (uint8_t)((i * 37U) ^ 0x5AU);
+    }
+
+    printf("test_udma\n");
+
+    TEST_Isolated(testInit);
+    TEST_Isolated(testTx);
+    TEST_Isolated(testRx);
+    TEST_Isolated(testAbort);
+    TEST_Isolated(testBusError);
+
+    return TEST_END();
+}
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/cpu.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_CPU_H_
+#define DRIVERLIB_CPU_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/eeprom.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_EEPROM_H_
+#define DRIVERLIB_EEPROM_H_
+#include "../sim_tiva.h"
+#endif
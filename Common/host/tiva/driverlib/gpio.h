@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/gpio.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_GPIO_H_
+#define DRIVERLIB_GPIO_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/i2c.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_I2C_H_
+#define DRIVERLIB_I2C_H_
+#include "../sim_tiva.h"
+#endif
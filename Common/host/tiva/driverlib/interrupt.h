@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/interrupt.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_INTERRUPT_H_
+#define DRIVERLIB_INTERRUPT_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/pin_map.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_PIN_MAP_H_
+#define DRIVERLIB_PIN_MAP_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/pwm.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_PWM_H_
+#define DRIVERLIB_PWM_H_
+#include "../sim_tiva.h"
+#endif
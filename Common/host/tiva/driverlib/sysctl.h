@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/sysctl.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_SYSCTL_H_
+#define DRIVERLIB_SYSCTL_H_
+#include "../sim_tiva.h"
+#endif
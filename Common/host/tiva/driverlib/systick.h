@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/systick.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_SYSTICK_H_
+#define DRIVERLIB_SYSTICK_H_
+#include "../sim_tiva.h"
+#endif
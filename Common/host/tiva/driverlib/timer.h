@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/timer.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_TIMER_H_
+#define DRIVERLIB_TIMER_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/uart.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_UART_H_
+#define DRIVERLIB_UART_H_
+#include "../sim_tiva.h"
+#endif
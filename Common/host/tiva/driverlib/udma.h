@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare driverlib/udma.h; see ../sim_tiva.h */
+#ifndef DRIVERLIB_UDMA_H_
+#define DRIVERLIB_UDMA_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare inc/hw_types.h; see ../sim_tiva.h */
+#ifndef SIM_INC_HW_TYPES_H_
+#define SIM_INC_HW_TYPES_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare inc/hw_uart.h; see ../sim_tiva.h */
+#ifndef SIM_INC_HW_UART_H_
+#define SIM_INC_HW_UART_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,5 @@
+/* Host stand-in for TivaWare inc/tm4c123gh6pm.h (register macros); see ../sim_tiva.h */
+#ifndef SIM_INC_TM4C123GH6PM_H_
+#define SIM_INC_TM4C123GH6PM_H_
+#include "../sim_tiva.h"
+#endif
@@ -0,0 +1,518 @@
+/*============================================================================
+ *  Module      : Host simulation
+ *  File Name   : sim_tiva.h
+ *  Description : TivaWare / CMSIS stand-in for host builds of the firmware
+ *
+ *  Every TivaWare header the firmware includes (driverlib/..., inc/hw_...,
+ *  tm4c123gh6pm.h, hw_types.h, hw_nvic.h) is a one-line wrapper around this
+ *  file. Names, values and prototypes are TivaWare's for everything the
+ *  tree uses, so the sources compile unchanged; the functions and the
+ *  memory-mapped registers are implemented by the models in ../sim/.
+ *
+ *  Registers the firmware touches directly are routed through
+ *  SIM_Reg() / SIM_HwReg(), which hand out a word the model fills on read
+ *  and picks up on the next simulator entry if it was written.
+ *===========================================================================*/
+
+#ifndef SIM_TIVA_H_
+#define SIM_TIVA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*======================================================================
+ *  Register access (hw_types.h, tm4c123gh6pm.h)
+ *====================================================================*/
+
+typedef enum
+{
+    SIM_REG_ST_CTRL = 0,
+    SIM_REG_ST_RELOAD,
+    SIM_REG_ST_CURRENT,
+    SIM_REG_INT_CTRL,
+    SIM_REG_ADC0_ACTSS,
+    SIM_REG_ADC0_EMUX,
+    SIM_REG_ADC0_SSMUX3,
+    SIM_REG_ADC0_SSCTL3,
+    SIM_REG_ADC0_SAC,
+    SIM_REG_ADC0_CTL,
+    SIM_REG_ADC0_PSSI,
+    SIM_REG_ADC0_RIS,
+    SIM_REG_ADC0_SSFIFO3,
+    SIM_REG_ADC0_ISC,
+    SIM_REG_COUNT
+} SIM_RegIdType;
+
+volatile uint32_t *SIM_Reg(SIM_RegIdType id);
+volatile uint32_t *SIM_HwReg(uint32_t address);
+
+#define HWREG(x)                (*SIM_HwReg((uint32_t)(x)))
+
+#define NVIC_ST_CTRL_R          (*SIM_Reg(SIM_REG_ST_CTRL))
+#define NVIC_ST_RELOAD_R        (*SIM_Reg(SIM_REG_ST_RELOAD))
+#define NVIC_ST_CURRENT_R       (*SIM_Reg(SIM_REG_ST_CURRENT))
+#define NVIC_INT_CTRL_R         (*SIM_Reg(SIM_REG_INT_CTRL))
+#define ADC0_ACTSS_R            (*SIM_Reg(SIM_REG_ADC0_ACTSS))
+#define ADC0_EMUX_R             (*SIM_Reg(SIM_REG_ADC0_EMUX))
+#define ADC0_SSMUX3_R           (*SIM_Reg(SIM_REG_ADC0_SSMUX3))
+#define ADC0_SSCTL3_R           (*SIM_Reg(SIM_REG_ADC0_SSCTL3))
+#define ADC0_SAC_R              (*SIM_Reg(SIM_REG_ADC0_SAC))
+#define ADC0_CTL_R              (*SIM_Reg(SIM_REG_ADC0_CTL))
+#define ADC0_PSSI_R             (*SIM_Reg(SIM_REG_ADC0_PSSI))
+#define ADC0_RIS_R              (*SIM_Reg(SIM_REG_ADC0_RIS))
+#define ADC0_SSFIFO3_R          (*SIM_Reg(SIM_REG_ADC0_SSFIFO3))
+#define ADC0_ISC_R              (*SIM_Reg(SIM_REG_ADC0_ISC))
+
+#define NVIC_ST_CTRL_COUNT      0x00010000
+#define NVIC_ST_CTRL_CLK_SRC    0x00000004
+#define NVIC_ST_CTRL_INTEN      0x00000002
+#define NVIC_ST_CTRL_ENABLE     0x00000001
+#define NVIC_INT_CTRL_PEND_SYST 0x04000000
+#define NVIC_INT_CTRL_PENDSTCLR 0x02000000
+
+/* hw_nvic.h */
+#define NVIC_ST_CTRL            0xE000E010
+#define NVIC_ST_RELOAD          0xE000E014
+#define NVIC_ST_CURRENT         0xE000E018
+#define NVIC_CPAC               0xE000ED88
+#define NVIC_CPAC_CP11_M        0x00C00000
+#define NVIC_CPAC_CP10_M        0x00300000
+#define NVIC_CPAC_CP11_FULL     0x00C00000
+#define NVIC_CPAC_CP10_FULL     0x00300000
+
+/*======================================================================
+ *  Memory map (hw_memmap.h)
+ *====================================================================*/
+
+#define GPIO_PORTA_BASE         0x40004000
+#define GPIO_PORTB_BASE         0x40005000
+#define GPIO_PORTC_BASE         0x40006000
+#define GPIO_PORTD_BASE         0x40007000
+#define GPIO_PORTE_BASE         0x40024000
+#define GPIO_PORTF_BASE         0x40025000
+#define UART0_BASE              0x4000C000
+#define UART1_BASE              0x4000D000
+#define UART2_BASE              0x4000E000
+#define UART3_BASE              0x4000F000
+#define UART4_BASE              0x40010000
+#define UART5_BASE              0x40011000
+#define UART6_BASE              0x40012000
+#define UART7_BASE              0x40013000
+#define I2C0_BASE               0x40020000
+#define PWM0_BASE               0x40028000
+#define TIMER0_BASE             0x40030000
+#define WTIMER0_BASE            0x40036000
+#define WTIMER1_BASE            0x40037000
+#define WTIMER2_BASE            0x4004C000
+#define WTIMER5_BASE            0x4004F000
+#define UDMA_BASE               0x400FF000
+
+/*======================================================================
+ *  Interrupt numbers (hw_ints.h)
+ *====================================================================*/
+
+#define FAULT_SYSTICK           15
+#define INT_UART0               21
+#define INT_UART1               22
+#define INT_TIMER0A             35
+#define INT_GPIOF               46
+#define INT_UART2               49
+#define INT_UDMA                62
+#define INT_UDMAERR             63
+#define INT_UART3               75
+#define INT_UART4               76
+#define INT_UART5               77
+#define INT_UART6               78
+#define INT_UART7               79
+#define INT_WTIMER0A            110
+#define INT_WTIMER1A            112
+#define INT_WTIMER2A            114
+#define INT_WTIMER5A            120
+#define NUM_INTERRUPTS          155
+
+/*======================================================================
+ *  CPU, interrupt controller (driverlib/cpu.h, interrupt.h)
+ *====================================================================*/
+
+uint32_t CPUcpsid(void);
+uint32_t CPUcpsie(void);
+uint32_t CPUprimask(void);
+void     CPUwfi(void);
+
+void     IntEnable(uint32_t ui32Interrupt);
+void     IntDisable(uint32_t ui32Interrupt);
+uint32_t IntIsEnabled(uint32_t ui32Interrupt);
+void     IntPendSet(uint32_t ui32Interrupt);
+void     IntPendClear(uint32_t ui32Interrupt);
+bool     IntMasterEnable(void);
+bool     IntMasterDisable(void);
+
+/*======================================================================
+ *  System control (driverlib/sysctl.h)
+ *====================================================================*/
+
+#define SYSCTL_PERIPH_GPIOA     0xf0000800
+#define SYSCTL_PERIPH_GPIOB     0xf0000801
+#define SYSCTL_PERIPH_GPIOC     0xf0000802
+#define SYSCTL_PERIPH_GPIOD     0xf0000803
+#define SYSCTL_PERIPH_GPIOE     0xf0000804
+#define SYSCTL_PERIPH_GPIOF     0xf0000805
+#define SYSCTL_PERIPH_UDMA      0xf0000c00
+#define SYSCTL_PERIPH_UART0     0xf0001800
+#define SYSCTL_PERIPH_UART1     0xf0001801
+#define SYSCTL_PERIPH_UART2     0xf0001802
+#define SYSCTL_PERIPH_UART3     0xf0001803
+#define SYSCTL_PERIPH_UART4     0xf0001804
+#define SYSCTL_PERIPH_UART5     0xf0001805
+#define SYSCTL_PERIPH_UART6     0xf0001806
+#define SYSCTL_PERIPH_UART7     0xf0001807
+#define SYSCTL_PERIPH_I2C0      0xf0002000
+#define SYSCTL_PERIPH_ADC0      0xf0003800
+#define SYSCTL_PERIPH_PWM0      0xf0004000
+#define SYSCTL_PERIPH_TIMER0    0xf0000400
+#define SYSCTL_PERIPH_WTIMER0   0xf0005c00
+#define SYSCTL_PERIPH_WTIMER1   0xf0005c01
+#define SYSCTL_PERIPH_WTIMER2   0xf0005c02
+#define SYSCTL_PERIPH_WTIMER5   0xf0005c05
+#define SYSCTL_PERIPH_EEPROM0   0xf0005800
+
+#define SYSCTL_PWMDIV_1         0x00000000
+#define SYSCTL_PWMDIV_64        0x001E0000
+
+uint32_t SysCtlClockGet(void);
+void     SysCtlDelay(uint32_t ui32Count);
+void     SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+bool     SysCtlPeripheralReady(uint32_t ui32Peripheral);
+void     SysCtlPWMClockSet(uint32_t ui32Config);
+
+/*======================================================================
+ *  SysTick (driverlib/systick.h)
+ *====================================================================*/
+
+void     SysTickEnable(void);
+void     SysTickDisable(void);
+void     SysTickIntEnable(void);
+void     SysTickIntDisable(void);
+void     SysTickPeriodSet(uint32_t ui32Period);
+uint32_t SysTickPeriodGet(void);
+uint32_t SysTickValueGet(void);
+
+/*======================================================================
+ *  GPIO (driverlib/gpio.h, pin_map.h, inc/hw_gpio.h)
+ *====================================================================*/
+
+#define GPIO_PIN_0              0x00000001
+#define GPIO_PIN_1              0x00000002
+#define GPIO_PIN_2              0x00000004
+#define GPIO_PIN_3              0x00000008
+#define GPIO_PIN_4              0x00000010
+#define GPIO_PIN_5              0x00000020
+#define GPIO_PIN_6              0x00000040
+#define GPIO_PIN_7              0x00000080
+
+#define GPIO_DIR_MODE_IN        0x00000000
+#define GPIO_DIR_MODE_OUT       0x00000001
+#define GPIO_DIR_MODE_HW        0x00000002
+
+#define GPIO_STRENGTH_2MA       0x00000001
+#define GPIO_PIN_TYPE_STD       0x00000008
+#define GPIO_PIN_TYPE_STD_WPU   0x0000000A
+#define GPIO_PIN_TYPE_STD_WPD   0x0000000C
+
+#define GPIO_O_LOCK             0x00000520
+#define GPIO_O_CR               0x00000524
+#define GPIO_LOCK_KEY           0x4C4F434B
+
+#define GPIO_PA0_U0RX           0x00000001
+#define GPIO_PA1_U0TX           0x00000401
+#define GPIO_PB0_U1RX           0x00010001
+#define GPIO_PB1_U1TX           0x00010401
+#define GPIO_PB2_I2C0SCL        0x00010803
+#define GPIO_PB3_I2C0SDA        0x00010C03
+#define GPIO_PB6_M0PWM0         0x00011804
+#define GPIO_PC4_U1RX           0x00021002
+#define GPIO_PC4_U4RX           0x00021001
+#define GPIO_PC4_U1RTS          0x00021008
+#define GPIO_PC5_U1TX           0x00021402
+#define GPIO_PC5_U4TX           0x00021401
+#define GPIO_PC5_U1CTS          0x00021408
+#define GPIO_PC6_U3RX           0x00021801
+#define GPIO_PC7_U3TX           0x00021C01
+#define GPIO_PD4_U6RX           0x00031001
+#define GPIO_PD5_U6TX           0x00031401
+#define GPIO_PD6_U2RX           0x00031801
+#define GPIO_PD7_U2TX           0x00031C01
+#define GPIO_PE0_U7RX           0x00040001
+#define GPIO_PE1_U7TX           0x00040401
+#define GPIO_PE4_U5RX           0x00041001
+#define GPIO_PE5_U5TX           0x00041401
+#define GPIO_PF0_U1RTS          0x00050001
+#define GPIO_PF1_U1CTS          0x00050401
+
+void    GPIODirModeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO);
+void    GPIOPadConfigSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength,
+                         uint32_t ui32PadType);
+void    GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins);
+void    GPIOPinConfigure(uint32_t ui32PinConfig);
+void    GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins);
+void    GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins);
+void    GPIOPinTypeI2C(uint32_t ui32Port, uint8_t ui8Pins);
+void    GPIOPinTypeI2CSCL(uint32_t ui32Port, uint8_t ui8Pins);
+void    GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins);
+void    GPIOIntClear(uint32_t ui32Port, uint32_t ui32IntFlags);
+uint32_t GPIOIntStatus(uint32_t ui32Port, bool bMasked);
+
+/*======================================================================
+ *  UART (driverlib/uart.h, inc/hw_uart.h)
+ *====================================================================*/
+
+#define UART_CONFIG_WLEN_MASK   0x00000060
+#define UART_CONFIG_WLEN_8      0x00000060
+#define UART_CONFIG_WLEN_7      0x00000040
+#define UART_CONFIG_WLEN_6      0x00000020
+#define UART_CONFIG_WLEN_5      0x00000000
+#define UART_CONFIG_STOP_MASK   0x00000008
+#define UART_CONFIG_STOP_ONE    0x00000000
+#define UART_CONFIG_STOP_TWO    0x00000008
+#define UART_CONFIG_PAR_MASK    0x00000086
+#define UART_CONFIG_PAR_NONE    0x00000000
+#define UART_CONFIG_PAR_EVEN    0x00000006
+#define UART_CONFIG_PAR_ODD     0x00000002
+#define UART_CONFIG_PAR_ONE     0x00000082
+#define UART_CONFIG_PAR_ZERO    0x00000086
+
+#define UART_INT_DMATX          0x00020000
+#define UART_INT_DMARX          0x00010000
+#define UART_INT_OE             0x00000400
+#define UART_INT_BE             0x00000200
+#define UART_INT_PE             0x00000100
+#define UART_INT_FE             0x00000080
+#define UART_INT_RT             0x00000040
+#define UART_INT_TX             0x00000020
+#define UART_INT_RX             0x00000010
+#define UART_INT_CTS            0x00000002
+
+#define UART_FIFO_TX1_8         0x00000000
+#define UART_FIFO_TX2_8         0x00000001
+#define UART_FIFO_TX4_8         0x00000002
+#define UART_FIFO_TX6_8         0x00000003
+#define UART_FIFO_TX7_8         0x00000004
+#define UART_FIFO_RX1_8         0x00000000
+#define UART_FIFO_RX2_8         0x00000008
+#define UART_FIFO_RX4_8         0x00000010
+#define UART_FIFO_RX6_8         0x00000018
+#define UART_FIFO_RX7_8         0x00000020
+
+#define UART_TXINT_MODE_FIFO    0x00000000
+#define UART_TXINT_MODE_EOT     0x00000010
+
+#define UART_FLOWCONTROL_TX     0x00008000
+#define UART_FLOWCONTROL_RX     0x00004000
+#define UART_FLOWCONTROL_NONE   0x00000000
+
+#define UART_DMA_ERR_RXSTOP     0x00000004
+#define UART_DMA_TX             0x00000002
+#define UART_DMA_RX             0x00000001
+
+#define UART_O_DR               0x00000000
+#define UART_O_FR               0x00000018
+#define UART_DR_OE              0x00000800
+#define UART_DR_BE              0x00000400
+#define UART_DR_PE              0x00000200
+#define UART_DR_FE              0x00000100
+#define UART_DR_DATA_M          0x000000FF
+
+void     UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud,
+                             uint32_t ui32Config);
+void     UARTConfigGetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t *pui32Baud,
+                             uint32_t *pui32Config);
+void     UARTEnable(uint32_t ui32Base);
+void     UARTDisable(uint32_t ui32Base);
+void     UARTFIFOEnable(uint32_t ui32Base);
+void     UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel);
+bool     UARTCharsAvail(uint32_t ui32Base);
+bool     UARTSpaceAvail(uint32_t ui32Base);
+int32_t  UARTCharGetNonBlocking(uint32_t ui32Base);
+int32_t  UARTCharGet(uint32_t ui32Base);
+bool     UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData);
+void     UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+bool     UARTBusy(uint32_t ui32Base);
+void     UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void     UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t UARTIntStatus(uint32_t ui32Base, bool bMasked);
+void     UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+void     UARTTxIntModeSet(uint32_t ui32Base, uint32_t ui32Mode);
+void     UARTFlowControlSet(uint32_t ui32Base, uint32_t ui32Mode);
+void     UARTDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags);
+void     UARTDMADisable(uint32_t ui32Base, uint32_t ui32DMAFlags);
+uint32_t UARTRxErrorGet(uint32_t ui32Base);
+void     UARTRxErrorClear(uint32_t ui32Base);
+
+/*======================================================================
+ *  uDMA (driverlib/udma.h, inc/hw_udma.h)
+ *====================================================================*/
+
+#define UDMA_ATTR_USEBURST      0x00000001
+#define UDMA_ATTR_ALTSELECT     0x00000002
+#define UDMA_ATTR_HIGH_PRIORITY 0x00000004
+#define UDMA_ATTR_REQMASK       0x00000008
+#define UDMA_ATTR_ALL           0x0000000F
+
+#define UDMA_MODE_STOP          0x00000000
+#define UDMA_MODE_BASIC         0x00000001
+#define UDMA_MODE_AUTO          0x00000002
+#define UDMA_MODE_PINGPONG      0x00000003
+#define UDMA_MODE_M             0x00000007
+
+#define UDMA_DST_INC_8          0x00000000
+#define UDMA_DST_INC_16         0x40000000
+#define UDMA_DST_INC_32         0x80000000
+#define UDMA_DST_INC_NONE       0xc0000000
+#define UDMA_SRC_INC_8          0x00000000
+#define UDMA_SRC_INC_16         0x04000000
+#define UDMA_SRC_INC_32         0x08000000
+#define UDMA_SRC_INC_NONE       0x0c000000
+#define UDMA_SIZE_8             0x00000000
+#define UDMA_SIZE_16            0x11000000
+#define UDMA_SIZE_32            0x22000000
+#define UDMA_ARB_1              0x00000000
+#define UDMA_ARB_4              0x00008000
+#define UDMA_ARB_8              0x0000c000
+
+#define UDMA_CHCTL_XFERSIZE_M   0x00003FF0
+#define UDMA_CHCTL_XFERSIZE_S   4
+
+#define UDMA_PRI_SELECT         0x00000000
+#define UDMA_ALT_SELECT         0x00000020
+
+#define UDMA_CHANNEL_UART1RX    22
+#define UDMA_CHANNEL_UART1TX    23
+
+#define UDMA_CH6_UART5RX        0x00020006
+#define UDMA_CH7_UART5TX        0x00020007
+#define UDMA_CH8_UART0RX        0x00000008
+#define UDMA_CH9_UART0TX        0x00000009
+#define UDMA_CH10_UART6RX       0x0002000A
+#define UDMA_CH11_UART6TX       0x0002000B
+#define UDMA_CH12_UART2RX       0x0001000C
+#define UDMA_CH13_UART2TX       0x0001000D
+#define UDMA_CH16_UART3RX       0x00020010
+#define UDMA_CH17_UART3TX       0x00020011
+#define UDMA_CH18_UART4RX       0x00020012
+#define UDMA_CH19_UART4TX       0x00020013
+#define UDMA_CH20_UART7RX       0x00020014
+#define UDMA_CH21_UART7TX       0x00020015
+#define UDMA_CH22_UART1RX       0x00000016
+#define UDMA_CH23_UART1TX       0x00000017
+
+typedef struct
+{
+    volatile void     *pvSrcEndAddr;
+    volatile void     *pvDstEndAddr;
+    volatile uint32_t  ui32Control;
+    volatile uint32_t  ui32Spare;
+} tDMAControlTable;
+
+void     uDMAEnable(void);
+void     uDMADisable(void);
+void     uDMAControlBaseSet(void *pControlTable);
+void     uDMAChannelAssign(uint32_t ui32Mapping);
+void     uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+void     uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+void     uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control);
+void     uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                                void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize);
+void     uDMAChannelEnable(uint32_t ui32ChannelNum);
+void     uDMAChannelDisable(uint32_t ui32ChannelNum);
+bool     uDMAChannelIsEnabled(uint32_t ui32ChannelNum);
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex);
+uint32_t uDMAChannelSizeGet(uint32_t ui32ChannelStructIndex);
+uint32_t uDMAErrorStatusGet(void);
+void     uDMAErrorStatusClear(void);
+
+/*======================================================================
+ *  General-purpose timers (driverlib/timer.h)
+ *====================================================================*/
+
+#define TIMER_CFG_ONE_SHOT      0x00000021
+#define TIMER_CFG_ONE_SHOT_UP   0x00000031
+#define TIMER_CFG_PERIODIC      0x00000022
+#define TIMER_CFG_PERIODIC_UP   0x00000032
+#define TIMER_CFG_SPLIT_PAIR    0x04000000
+#define TIMER_CFG_A_ONE_SHOT    0x00000021
+#define TIMER_CFG_A_PERIODIC    0x00000022
+#define TIMER_CFG_A_PERIODIC_UP 0x00000032
+#define TIMER_CFG_A_CAP_TIME    0x00000007
+#define TIMER_CFG_A_PWM         0x0000000A
+
+#define TIMER_A                 0x000000ff
+#define TIMER_B                 0x0000ff00
+#define TIMER_BOTH              0x0000ffff
+
+#define TIMER_EVENT_POS_EDGE    0x00000000
+#define TIMER_EVENT_NEG_EDGE    0x00000404
+#define TIMER_EVENT_BOTH_EDGES  0x00000C0C
+
+#define TIMER_TIMA_TIMEOUT      0x00000001
+#define TIMER_CAPA_EVENT        0x00000004
+#define TIMER_TIMA_MATCH        0x00000010
+
+void     TimerConfigure(uint32_t ui32Base, uint32_t ui32Config);
+void     TimerEnable(uint32_t ui32Base, uint32_t ui32Timer);
+void     TimerDisable(uint32_t ui32Base, uint32_t ui32Timer);
+void     TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+uint32_t TimerLoadGet(uint32_t ui32Base, uint32_t ui32Timer);
+void     TimerMatchSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+void     TimerPrescaleSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+void     TimerControlEvent(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Event);
+void     TimerControlLevel(uint32_t ui32Base, uint32_t ui32Timer, bool bInvert);
+uint32_t TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer);
+void     TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void     TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked);
+void     TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+
+/*======================================================================
+ *  EEPROM (driverlib/eeprom.h)
+ *====================================================================*/
+
+#define EEPROM_INIT_OK          0
+#define EEPROM_INIT_ERROR       2
+
+uint32_t EEPROMInit(void);
+uint32_t EEPROMSizeGet(void);
+void     EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count);
+uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count);
+uint32_t EEPROMMassErase(void);
+uint32_t EEPROMStatusGet(void);
+
+/*======================================================================
+ *  I2C (driverlib/i2c.h)
+ *====================================================================*/
+
+#define I2C_MASTER_CMD_SINGLE_SEND  0x00000007
+
+void I2CMasterInitExpClk(uint32_t ui32Base, uint32_t ui32I2CClk, bool bFast);
+void I2CMasterSlaveAddrSet(uint32_t ui32Base, uint8_t ui8SlaveAddr, bool bReceive);
+void I2CMasterDataPut(uint32_t ui32Base, uint8_t ui8Data);
+void I2CMasterControl(uint32_t ui32Base, uint32_t ui32Cmd);
+bool I2CMasterBusy(uint32_t ui32Base);
+
+/*======================================================================
+ *  PWM (driverlib/pwm.h)
+ *====================================================================*/
+
+#define PWM_GEN_0               0x00000040
+#define PWM_OUT_0               0x00000040
+#define PWM_OUT_0_BIT           0x00000001
+#define PWM_GEN_MODE_DOWN       0x00000000
+#define PWM_GEN_MODE_NO_SYNC    0x00000000
+
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config);
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period);
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width);
+void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable);
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen);
+
+#endif /* SIM_TIVA_H_ */
@@ -0,0 +1,607 @@
+/*============================================================================
+ *  Module      : Host tools
+ *  File Name   : trace_export.c
+ *  Description : Convert event-trace captures (services/trace.h) of both
+ *                ECUs into one Chrome / Perfetto trace (JSON)
+ *
+ *  Host (Linux) program; not part of the IAR projects. Build from the
+ *  repository root:
+ *    cc -std=c99 -O2 -ICommon/inc -o trace_export Common/host/trace_export.c \
+ *       Common/src/services/cobs.c Common/src/services/crc16.c
+ *
+ *  Capture (both ECUs built with TRACE_ENABLE=1), one console per ECU:
+ *    stty -F /dev/ttyACM0 115200 raw -echo
+ *    cat /dev/ttyACM0 > hmi.bin &
+ *    printf 'trace on\r' > /dev/ttyACM0
+ *  and the same for the Control ECU into control.bin; open the door, then
+ *  stop the captures ("trace off" is optional). Then:
+ *    ./trace_export hmi.bin control.bin > door.json
+ *  and load door.json in ui.perfetto.dev or chrome://tracing.
+ *
+ *  - Console text in a capture is skipped; only packets with a valid
+ *    magic, version and CRC are used, and the ECU comes from the packet.
+ *  - Each record is placed on its ECU's microsecond timebase from the
+ *    packet's NOW_CLK/NOW_US/CLK_HZ. The Control timeline is then shifted
+ *    onto the HMI one: a request is received after it is sent, and its
+ *    response received after it is sent, which bounds the offset between
+ *    the two clocks; the midpoint of the bounds is used. Request and
+ *    response records of the two ECUs are paired by command, SEQ and
+ *    order, so a capture should stay under 255 requests (one SEQ lap).
+ *  - Output: one process per ECU with a main-loop and a UART1 ISR thread.
+ *    ISR, EEPROM and LCD records become slices, motor changes and
+ *    unsolicited frames instants, and each request a round-trip span on
+ *    the HMI and a handling span on Control, joined by flow arrows.
+ *  - Packet SEQ gaps and the DROPPED counter are reported on stderr.
+ *===========================================================================*/
+
+#include "services/trace.h"
+#include "services/cobs.h"
+#include "services/crc16.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define EXPORT_NUM_ECUS         (2U)
+#define EXPORT_ECU_HMI          (0U)
+#define EXPORT_ECU_CONTROL      (1U)
+
+#define EXPORT_TID_MAIN         (1U)
+#define EXPORT_TID_ISR          (2U)
+
+#define EXPORT_SEQ_UNSOLICITED  (0U)
+
+/*======================================================================
+ *  Local Types
+ *====================================================================*/
+
+/* One record on its ECU's timebase */
+typedef struct
+{
+    double   us;
+    uint8_t  event;
+    uint8_t  arg8;
+    uint16_t arg16;
+    uint32_t flow;          /* Flow id once paired, 0 = none */
+} Export_EventType;
+
+typedef struct
+{
+    Export_EventType *events;
+    uint32_t          count;
+    uint32_t          capacity;
+    uint32_t          packets;
+    uint32_t          seqGaps;
+    uint32_t          dropped;
+    boolean           haveSeq;
+    uint16_t          lastSeq;
+} Export_EcuType;
+
+/*======================================================================
+ *  Local Variables
+ *====================================================================*/
+
+static Export_EcuType ecus[EXPORT_NUM_ECUS];
+static const char * const ecuNames[EXPORT_NUM_ECUS] = { "HMI ECU", "Control ECU" };
+static uint32_t nextFlowId = 1U;
+static boolean  firstJsonEvent = TRUE;
+
+/*======================================================================
+ *  Local Functions
+ *====================================================================*/
+
+static uint16_t prv_getU16(const uint8_t *buf)
+{
+    return (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);
+}
+
+static uint32_t prv_getU32(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+           ((uint32_t)buf[2] << 8) | (uint32_t)buf[3];
+}
+
+static void prv_append(Export_EcuType *ecu, const Export_EventType *event)
+{
+    if (ecu->count == ecu->capacity)
+    {
+        ecu->capacity = (ecu->capacity != 0U) ? (ecu->capacity * 2U) : 1024U;
+        ecu->events   = realloc(ecu->events, ecu->capacity * sizeof(*ecu->events));
+        if (ecu->events == NULL)
+        {
+            fprintf(stderr, "trace_export: out of memory\n");
+            exit(1);
+        }
+    }
+    ecu->events[ecu->count++] = *event;
+}
+
+/* Validate one decoded packet body and take its records */
+static void prv_takePacket(const uint8_t *body, uint16_t len)
+{
+    Export_EcuType  *ecu;
+    Export_EventType event;
+    const uint8_t   *rec;
+    uint32_t clkHz;
+    uint32_t nowClk;
+    uint16_t seq;
+    uint8_t  count;
+    uint8_t  i;
+    double   nowUs;
+
+    if ((len < (TRACE_HEADER_SIZE + TRACE_CRC_SIZE)) ||
+        (body[0] != TRACE_MAGIC_0) || (body[1] != TRACE_MAGIC_1) ||
+        (body[2] != TRACE_VERSION))
+    {
+        return;
+    }
+    count = body[TRACE_HEADER_SIZE - 1U];
+    if (len != (TRACE_HEADER_SIZE + ((uint16_t)count * TRACE_RECORD_SIZE) + TRACE_CRC_SIZE))
+    {
+        return;
+    }
+    if (CRC16_Compute(body, (uint16_t)(len - TRACE_CRC_SIZE)) !=
+        prv_getU16(&body[len - TRACE_CRC_SIZE]))
+    {
+        return;
+    }
+
+    switch (body[3])
+    {
+        case TRACE_ECU_HMI:     ecu = &ecus[EXPORT_ECU_HMI];     break;
+        case TRACE_ECU_CONTROL: ecu = &ecus[EXPORT_ECU_CONTROL]; break;
+        default:                return;
+    }
+
+    seq       = prv_getU16(&body[4]);
+    clkHz     = prv_getU32(&body[6]);
+    nowClk    = prv_getU32(&body[10]);
+    nowUs     = ((double)prv_getU32(&body[14]) * 4294967296.0) +
+                (double)prv_getU32(&body[18]);
+    if (clkHz == 0U)
+    {
+        return;
+    }
+
+    if (ecu->haveSeq && (seq != (uint16_t)(ecu->lastSeq + 1U)))
+    {
+        ecu->seqGaps++;
+    }
+    ecu->haveSeq = TRUE;
+    ecu->lastSeq = seq;
+    ecu->dropped = prv_getU32(&body[22]);
+    ecu->packets++;
+
+    for (i = 0U; i < count; i++)
+    {
+        rec = &body[TRACE_HEADER_SIZE + ((uint16_t)i * TRACE_RECORD_SIZE)];
+
+        /* Age in clocks is exact modulo 2^32, whatever the counter did */
+        event.us    = nowUs - ((double)(uint32_t)(nowClk - prv_getU32(rec)) * 1e6 /
+                               (double)clkHz);
+        event.event = rec[4];
+        event.arg8  = rec[5];
+        event.arg16 = prv_getU16(&rec[6]);
+        event.flow  = 0U;
+        prv_append(ecu, &event);
+    }
+}
+
+/* Decode every packet of one capture file */
+static boolean prv_load(const char *path)
+{
+    static uint8_t   body[TRACE_BODY_MAX_SIZE];
+    COBS_DecoderType decoder;
+    FILE *file;
+    int   ch;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    COBS_DecoderInit(&decoder, body, (uint16_t)sizeof(body));
+    while ((ch = fgetc(file)) != EOF)
+    {
+        if (COBS_DecoderFeed(&decoder, (uint8_t)ch) == COBS_STATUS_COMPLETE)
+        {
+            prv_takePacket(body, decoder.length);
+        }
+    }
+
+    (void)fclose(file);
+    return TRUE;
+}
+
+/* Index of the n-th (0-based) event of a kind with this SEQ, or -1 */
+static long prv_findNth(const Export_EcuType *ecu, uint8_t kind, uint16_t seq, uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0U; i < ecu->count; i++)
+    {
+        if ((ecu->events[i].event == kind) && (ecu->events[i].arg16 == seq))
+        {
+            if (n == 0U)
+            {
+                return (long)i;
+            }
+            n--;
+        }
+    }
+    return -1;
+}
+
+/* Occurrence number of event i among those of its kind and SEQ */
+static uint32_t prv_occurrence(const Export_EcuType *ecu, uint32_t i)
+{
+    uint32_t j;
+    uint32_t n = 0U;
+
+    for (j = 0U; j < i; j++)
+    {
+        if ((ecu->events[j].event == ecu->events[i].event) &&
+            (ecu->events[j].arg16 == ecu->events[i].arg16))
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+/*
+ * Pair "from" events on one ECU with "to" events on the other (send with
+ * receive), give each pair a flow id and tighten the offset bounds:
+ * to.us + offset >= from.us when the sender is the HMI, and
+ * from.us + offset <= to.us when the sender is Control.
+ */
+static void prv_pair(uint32_t fromEcu, uint8_t fromKind, uint8_t toKind,
+                     double *lower, boolean *haveLower,
+                     double *upper, boolean *haveUpper)
+{
+    Export_EcuType *src = &ecus[fromEcu];
+    Export_EcuType *dst = &ecus[fromEcu ^ 1U];
+    Export_EventType *from;
+    Export_EventType *to;
+    uint32_t i;
+    long     j;
+    double   bound;
+
+    for (i = 0U; i < src->count; i++)
+    {
+        from = &src->events[i];
+        if ((from->event != fromKind) || (from->arg16 == EXPORT_SEQ_UNSOLICITED))
+        {
+            continue;
+        }
+        j = prv_findNth(dst, toKind, from->arg16, prv_occurrence(src, i));
+        if ((j < 0) || (dst->events[j].arg8 != from->arg8))
+        {
+            continue;
+        }
+        to = &dst->events[j];
+        from->flow = nextFlowId;
+        to->flow   = nextFlowId;
+        nextFlowId++;
+
+        if (fromEcu == EXPORT_ECU_HMI)
+        {
+            bound = from->us - to->us;
+            if (!*haveLower || (bound > *lower))
+            {
+                *lower = bound;
+            }
+            *haveLower = TRUE;
+        }
+        else
+        {
+            bound = to->us - from->us;
+            if (!*haveUpper || (bound < *upper))
+            {
+                *upper = bound;
+            }
+            *haveUpper = TRUE;
+        }
+    }
+}
+
+/* Offset that moves Control times onto the HMI timebase */
+static double prv_align(void)
+{
+    double  lower = 0.0;
+    double  upper = 0.0;
+    boolean haveLower = FALSE;
+    boolean haveUpper = FALSE;
+
+    prv_pair(EXPORT_ECU_HMI, TRACE_EVT_REQ_SEND, TRACE_EVT_REQ_RECV,
+             &lower, &haveLower, &upper, &haveUpper);
+    prv_pair(EXPORT_ECU_CONTROL, TRACE_EVT_RESP_SEND, TRACE_EVT_RESP_RECV,
+             &lower, &haveLower, &upper, &haveUpper);
+
+    if (haveLower && haveUpper)
+    {
+        if (lower > upper)
+        {
+            fprintf(stderr, "trace_export: clock bounds cross by %.1f us (drift?)\n",
+                    lower - upper);
+        }
+        else
+        {
+            fprintf(stderr, "trace_export: Control clock offset %.1f us (+/- %.1f)\n",
+                    (lower + upper) / 2.0, (upper - lower) / 2.0);
+        }
+        return (lower + upper) / 2.0;
+    }
+    if (haveLower || haveUpper)
+    {
+        return haveLower ? lower : upper;
+    }
+
+    if ((ecus[EXPORT_ECU_HMI].count != 0U) && (ecus[EXPORT_ECU_CONTROL].count != 0U))
+    {
+        fprintf(stderr, "trace_export: no request seen by both ECUs; clocks not aligned\n");
+    }
+    return 0.0;
+}
+
+/* Command or response byte: 'O' when printable, 0x1F otherwise */
+static const char *prv_cmdName(uint8_t cmd)
+{
+    static char name[8];
+
+    if ((cmd >= 0x20U) && (cmd < 0x7FU) && (cmd != '"') && (cmd != '\\'))
+    {
+        (void)snprintf(name, sizeof(name), "'%c'", cmd);
+    }
+    else
+    {
+        (void)snprintf(name, sizeof(name), "0x%02X", cmd);
+    }
+    return name;
+}
+
+/* Start one JSON event object; the caller adds the rest and the brace */
+static void prv_begin(const char *ph, const char *name, uint32_t pid,
+                      uint32_t tid, double ts)
+{
+    printf("%s\n{\"ph\":\"%s\",\"name\":\"%s\",\"pid\":%lu,\"tid\":%lu,\"ts\":%.3f",
+           firstJsonEvent ? "" : ",", ph, name, (unsigned long)pid,
+           (unsigned long)tid, ts);
+    firstJsonEvent = FALSE;
+}
+
+static void prv_metadata(uint32_t pid, uint32_t tid, const char *kind, const char *value)
+{
+    printf("%s\n{\"ph\":\"M\",\"name\":\"%s\",\"pid\":%lu,\"tid\":%lu,"
+           "\"args\":{\"name\":\"%s\"}}",
+           firstJsonEvent ? "" : ",", kind, (unsigned long)pid,
+           (unsigned long)tid, value);
+    firstJsonEvent = FALSE;
+}
+
+/* A 1 us slice with a flow arrow end, so every viewer has a slice to bind */
+static void prv_flowPoint(const Export_EventType *ev, const char *name,
+                          uint32_t pid, double ts, boolean start)
+{
+    char label[48];
+
+    (void)snprintf(label, sizeof(label), "%s %s #%u", name, prv_cmdName(ev->arg8),
+                   (unsigned)ev->arg16);
+    prv_begin("X", label, pid, EXPORT_TID_MAIN, ts);
+    printf(",\"dur\":1}");
+
+    if (ev->flow != 0U)
+    {
+        prv_begin(start ? "s" : "f", "request", pid, EXPORT_TID_MAIN, ts);
+        printf(",\"cat\":\"link\",\"id\":%lu%s}", (unsigned long)ev->flow,
+               start ? "" : ",\"bp\":\"e\"");
+    }
+}
+
+/* Command of the request that event i closes: the last one opened before
+ * it on the same ECU with the same SEQ */
+static uint8_t prv_openedBy(const Export_EcuType *ecu, uint32_t i, uint8_t kind)
+{
+    uint16_t seq = ecu->events[i].arg16;
+
+    while (i > 0U)
+    {
+        i--;
+        if ((ecu->events[i].event == kind) && (ecu->events[i].arg16 == seq))
+        {
+            return ecu->events[i].arg8;
+        }
+    }
+    return 0U;
+}
+
+/* Async span on the main thread, keyed by the request SEQ */
+static void prv_span(const char *ph, const char *name, uint32_t pid, double ts,
+                     uint16_t seq)
+{
+    prv_begin(ph, name, pid, EXPORT_TID_MAIN, ts);
+    printf(",\"cat\":\"request\",\"id\":\"%lu-%u\"}", (unsigned long)pid, (unsigned)seq);
+}
+
+static void prv_emitEcu(uint32_t index, double shift)
+{
+    static const char * const motorNames[] = { "motor stop", "motor forward", "motor backward" };
+    const Export_EcuType   *ecu = &ecus[index];
+    const Export_EventType *ev;
+    uint32_t pid = index + 1U;
+    uint32_t i;
+    double   ts;
+    char     label[48];
+
+    if (ecu->count == 0U)
+    {
+        return;
+    }
+
+    prv_metadata(pid, EXPORT_TID_MAIN, "process_name", ecuNames[index]);
+    prv_metadata(pid, EXPORT_TID_MAIN, "thread_name", "main loop");
+    prv_metadata(pid, EXPORT_TID_ISR, "thread_name", "UART ISR");
+
+    for (i = 0U; i < ecu->count; i++)
+    {
+        ev = &ecu->events[i];
+        ts = ev->us + shift;
+
+        switch (ev->event)
+        {
+            case TRACE_EVT_ISR_ENTER:
+                (void)snprintf(label, sizeof(label), "UART%u ISR", (unsigned)ev->arg8);
+                prv_begin("B", label, pid, EXPORT_TID_ISR, ts);
+                printf("}");
+                break;
+
+            case TRACE_EVT_ISR_EXIT:
+                prv_begin("E", "", pid, EXPORT_TID_ISR, ts);
+                printf("}");
+                break;
+
+            case TRACE_EVT_REQ_SEND:
+                prv_span("b", prv_cmdName(ev->arg8), pid, ts, ev->arg16);
+                prv_flowPoint(ev, "send", pid, ts, TRUE);
+                break;
+
+            case TRACE_EVT_RESP_RECV:
+                prv_flowPoint(ev, "response", pid, ts, FALSE);
+                prv_span("e", prv_cmdName(prv_openedBy(ecu, i, TRACE_EVT_REQ_SEND)),
+                         pid, ts, ev->arg16);
+                break;
+
+            case TRACE_EVT_REQ_RECV:
+                prv_span("b", prv_cmdName(ev->arg8), pid, ts, ev->arg16);
+                prv_flowPoint(ev, "receive", pid, ts, FALSE);
+                break;
+
+            case TRACE_EVT_RESP_SEND:
+                if (ev->arg16 == EXPORT_SEQ_UNSOLICITED)
+                {
+                    (void)snprintf(label, sizeof(label), "unsolicited %s",
+                                   prv_cmdName(ev->arg8));
+                    prv_begin("i", label, pid, EXPORT_TID_MAIN, ts);
+                    printf(",\"s\":\"t\"}");
+                }
+                else
+                {
+                    prv_flowPoint(ev, "reply", pid, ts, TRUE);
+                    prv_span("e", prv_cmdName(prv_openedBy(ecu, i, TRACE_EVT_REQ_RECV)),
+                             pid, ts, ev->arg16);
+                }
+                break;
+
+            case TRACE_EVT_EEPROM_BEGIN:
+                prv_begin("B", "EEPROM write", pid, EXPORT_TID_MAIN, ts);
+                printf(",\"args\":{\"address\":%u}}", (unsigned)ev->arg16);
+                break;
+
+            case TRACE_EVT_EEPROM_END:
+                prv_begin("E", "", pid, EXPORT_TID_MAIN, ts);
+                printf(",\"args\":{\"bytes\":%u,\"failed\":%u}}",
+                       (unsigned)ev->arg16, (unsigned)ev->arg8);
+                break;
+
+            case TRACE_EVT_MOTOR:
+                prv_begin("i", (ev->arg8 < 3U) ? motorNames[ev->arg8] : "motor ?",
+                          pid, EXPORT_TID_MAIN, ts);
+                printf(",\"s\":\"p\"}");
+                break;
+
+            case TRACE_EVT_LCD_BEGIN:
+                prv_begin("B", (ev->arg8 == TRACE_LCD_CLEAR) ? "LCD clear" : "LCD string",
+                          pid, EXPORT_TID_MAIN, ts);
+                printf("}");
+                break;
+
+            case TRACE_EVT_LCD_END:
+                prv_begin("E", "", pid, EXPORT_TID_MAIN, ts);
+                printf(",\"args\":{\"chars\":%u}}", (unsigned)ev->arg16);
+                break;
+
+            case TRACE_EVT_MARK:
+            default:
+                (void)snprintf(label, sizeof(label), "mark %u/%u/%u", (unsigned)ev->event,
+                               (unsigned)ev->arg8, (unsigned)ev->arg16);
+                prv_begin("i", label, pid, EXPORT_TID_MAIN, ts);
+                printf(",\"s\":\"t\"}");
+                break;
+        }
+    }
+}
+
+/*======================================================================
+ *  Main
+ *====================================================================*/
+
+int main(int argc, char *argv[])
+{
+    double   offset;
+    double   origin = 0.0;
+    boolean  haveOrigin = FALSE;
+    uint32_t e;
+    int      i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s capture... > trace.json\n", argv[0]);
+        return 2;
+    }
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!prv_load(argv[i]))
+        {
+            return 1;
+        }
+    }
+
+    for (e = 0U; e < EXPORT_NUM_ECUS; e++)
+    {
+        if (ecus[e].packets != 0U)
+        {
+            fprintf(stderr, "trace_export: %s: %lu packets, %lu records, "
+                    "%lu SEQ gaps, %lu dropped on target\n",
+                    ecuNames[e], (unsigned long)ecus[e].packets,
+                    (unsigned long)ecus[e].count, (unsigned long)ecus[e].seqGaps,
+                    (unsigned long)ecus[e].dropped);
+        }
+    }
+    if ((ecus[EXPORT_ECU_HMI].count == 0U) && (ecus[EXPORT_ECU_CONTROL].count == 0U))
+    {
+        fprintf(stderr, "trace_export: no trace packets found\n");
+        return 1;
+    }
+
+    offset = prv_align();
+
+    /* Start the timeline at the first record of either ECU */
+    for (e = 0U; e < EXPORT_NUM_ECUS; e++)
+    {
+        if ((ecus[e].count != 0U) &&
+            (!haveOrigin ||
+             ((ecus[e].events[0].us + ((e == EXPORT_ECU_CONTROL) ? offset : 0.0)) < origin)))
+        {
+            origin     = ecus[e].events[0].us + ((e == EXPORT_ECU_CONTROL) ? offset : 0.0);
+            haveOrigin = TRUE;
+        }
+    }
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    prv_emitEcu(EXPORT_ECU_HMI, -origin);
+    prv_emitEcu(EXPORT_ECU_CONTROL, offset - origin);
+    printf("\n]}\n");
+
+    for (e = 0U; e < EXPORT_NUM_ECUS; e++)
+    {
+        free(ecus[e].events);
+    }
+    return 0;
+}
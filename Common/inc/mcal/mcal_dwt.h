@@ -0,0 +1,30 @@
+/*============================================================================
+ *  Module      : MCAL DWT
+ *  File Name   : mcal_dwt.h
+ *  Description : Cortex-M4 DWT cycle counter (CYCCNT)
+ *
+ *  A free-running 32-bit count of core clock cycles, read with a single
+ *  load, for timestamps and cycle measurements. It wraps every 2^32
+ *  cycles (~268 s at 16 MHz) and stops while the core sleeps in WFI.
+ *===========================================================================*/
+
+#ifndef MCAL_DWT_H_
+#define MCAL_DWT_H_
+
+#include <stdint.h>
+
+/* Cycle counter register (ARMv7-M ARM, C1.8) */
+#define MCAL_DWT_CYCCNT_R       (*((volatile uint32_t *)0xE0001004U))
+
+/* Current cycle count; valid once MCAL_DWT_Init() has run */
+#define MCAL_DWT_GET_CYCLES()   (MCAL_DWT_CYCCNT_R)
+
+/**
+ * @brief Enable the trace block and start the cycle counter.
+ *
+ * Harmless to call again: a counter that is already running is left
+ * alone, so every user can call it from its own init.
+ */
+void MCAL_DWT_Init(void);
+
+#endif /* MCAL_DWT_H_ */
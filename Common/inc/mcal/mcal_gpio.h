@@ -95,6 +95,18 @@ uint8_t MCAL_GPIO_ReadPin(uint32_t portBase,
 void MCAL_GPIO_TogglePin(uint32_t portBase,
                          uint8_t  pins);
 
+/**
+ * @brief Unlock pins that come out of reset locked (PD7, PF0: NMI;
+ *        PC0-3: JTAG) so their function can be changed.
+ *
+ * Call before MCAL_GPIO_InitPin() or an alternate-function setup.
+ *
+ * @param portBase  GPIO_PORTx_BASE
+ * @param pins      Mask of pins to unlock
+ */
+void MCAL_GPIO_UnlockPin(uint32_t portBase,
+                         uint8_t  pins);
+
 
 
 
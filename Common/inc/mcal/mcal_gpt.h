@@ -12,6 +12,7 @@
 typedef enum {
     GPT_TIMER0A,
     GPT_WTIMER2A,
+    GPT_WTIMER0A,
     GPT_NUM_TIMERS
 } Gpt_IDType;
 
@@ -32,10 +33,11 @@ typedef enum {
 typedef struct {
     uint32_t             timer_InitialValue;   /* LOAD / period in ticks */
     uint32_t             timer_CompareValue;   /* MATCH value (PWM duty, compare) */
-    Gpt_IDType           timer_ID;             /* GPT_TIMER0A / GPT_WTIMER2A */
+    Gpt_IDType           timer_ID;             /* GPT_TIMER0A / GPT_WTIMER2A / GPT_WTIMER0A */
     Gpt_ModeType         timer_mode;           /* ONE_SHOT / PERIODIC / CAPTURE / PWM */
     Gpt_CaptureEdgeType  captureEdge;          /* Used only in CAPTURE mode */
     uint8_t              enableInterrupt;      /* 0 or 1 */
+    uint16_t             timer_Prescale;       /* Clock divider - 1 (WTIMER0A only) */
 } Gpt_ConfigType;
 
 /* Callback type */
@@ -66,6 +68,12 @@ void Gpt_SetPwmDuty(Gpt_IDType timer_ID, float dutyPercent);
 /* For capture mode: read captured value */
 uint32_t Gpt_GetCaptureValue(Gpt_IDType timer_ID);
 
+/* Current counter value (TAR) of a running timer */
+uint32_t Gpt_GetValue(Gpt_IDType timer_ID);
+
+/* Raw timeout flag: true from the reload until the ISR clears it */
+bool Gpt_IsTimeoutPending(Gpt_IDType timer_ID);
+
 
 
 #endif /* MCAL_GPT_H_ */
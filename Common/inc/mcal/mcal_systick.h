@@ -51,19 +51,54 @@ uint32_t MCAL_SysTick_GetTickMs(void);
 /**
  * @brief Blocking delay using SysTick millisecond counter.
  *
+ * Sleeps (WFI) between ticks instead of spinning.
+ *
  * @param ms  Number of milliseconds to wait.
  */
 void MCAL_SysTick_DelayMs(uint32_t ms);
 
 /**
- * @brief Blocking delay in microseconds using busy-wait.
+ * @brief Sleep until the next interrupt, for at most maxMs.
+ *
+ * With maxMs of 1 this is a plain WFI: the next tick, or any earlier
+ * interrupt, wakes the core. With more, the sleep is tickless: after the
+ * current ms the SysTick reload is stretched so the core wakes once more,
+ * maxMs ms after the last tick (capped by the 24-bit counter: ~1 s at
+ * 16 MHz). The ticks skipped are counted on wake, so
+ * MCAL_SysTick_GetTickMs() and the tick callback (called once per skipped
+ * ms) stay exact. A UART or GPIO interrupt ends the sleep early; the tick
+ * is then re-timed to the next ms boundary, which costs a few cycles of
+ * drift per early wake.
+ *
+ * Call from thread context only. An interrupt that arrives after the
+ * caller last checked for work but before the sleep starts is only seen
+ * on the next wake, so maxMs also bounds that latency.
+ *
+ * @param maxMs  Longest sleep in ms (the next deadline the caller knows).
+ */
+void MCAL_SysTick_Sleep(uint32_t maxMs);
+
+/**
+ * @brief Total time spent asleep in MCAL_SysTick_Sleep().
+ *
+ * Whole ms slept are counted before the tick callback for them runs, so
+ * a callback reading this sees the idle time up to its own tick, also in
+ * the burst of callbacks that follows a tickless sleep.
+ *
+ * @return Idle milliseconds since MCAL_SysTick_Init() (wraps around).
+ */
+uint32_t MCAL_SysTick_GetIdleMs(void);
+
+/**
+ * @brief Longest busy stretch (time between two sleeps) since the last call.
  *
- * Uses CPU clock cycles for precise short delays.
- * Accurate for delays >= 1us on systems with >= 16 MHz clock.
+ * A stretch still running counts with its length so far. Interrupts
+ * taken while asleep count as idle. Callable from the tick callback.
  *
- * @param us  Number of microseconds to wait.
+ * @return Cycles of the longest stretch (exact up to 2^32 cycles); the
+ *         maximum is cleared.
  */
-void MCAL_SysTick_DelayUs(uint32_t us);
+uint32_t MCAL_SysTick_TakeBusyMaxCycles(void);
 
 /**
  * @brief Get the system clock in Hz as used by SysTick.
@@ -0,0 +1,75 @@
+/*============================================================================
+ *  Module      : MCAL TRACE
+ *  File Name   : mcal_trace.h
+ *  Description : Event hook the MCAL drivers record trace events through
+ *
+ *  MCAL_TRACE(event, arg8, arg16) hands an event to a hook, which the
+ *  event trace (services/trace.h) installs from TRACE_Init(), so the
+ *  drivers record UART interrupts and EEPROM writes without depending on
+ *  a service. With no hook installed an event is dropped. TRACE_ENABLE 0
+ *  (default) compiles every MCAL_TRACE() out.
+ *
+ *  The event codes are the trace's own (TRACE_EventType takes its values
+ *  for these events from here), so records keep their meaning on the wire.
+ *===========================================================================*/
+
+#ifndef MCAL_TRACE_H_
+#define MCAL_TRACE_H_
+
+#include <stdint.h>
+
+/*======================================================================
+ *  Configuration
+ *====================================================================*/
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE            (0)
+#endif
+
+/* UART channels whose interrupts are traced, one bit each: the link
+ * (UART1), not the console UART that carries the trace itself */
+#define MCAL_TRACE_UART_ISR_MASK    (1U << 1)
+
+/*======================================================================
+ *  Event codes recorded by the MCAL
+ *====================================================================*/
+
+#define MCAL_TRACE_EVT_ISR_ENTER        (1U)    /* arg8: UART channel */
+#define MCAL_TRACE_EVT_ISR_EXIT         (2U)    /* arg8: UART channel */
+#define MCAL_TRACE_EVT_EEPROM_BEGIN     (7U)    /* arg16: EEPROM byte address */
+#define MCAL_TRACE_EVT_EEPROM_END       (8U)    /* arg8: 0 written, 1 failed; arg16: bytes */
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Receives every event; called from thread code and ISRs */
+typedef void (*MCAL_TraceHookType)(uint8_t event, uint8_t arg8, uint16_t arg16);
+
+#if (TRACE_ENABLE != 0)
+
+#define MCAL_TRACE(event, arg8, arg16) \
+    MCAL_Trace_Event((uint8_t)(event), (uint8_t)(arg8), (uint16_t)(arg16))
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Install the hook that receives MCAL events, or NULL for none.
+ */
+void MCAL_Trace_SetHook(MCAL_TraceHookType hook);
+
+/**
+ * @brief Pass one event to the hook, if any (used by MCAL_TRACE()).
+ */
+void MCAL_Trace_Event(uint8_t event, uint8_t arg8, uint16_t arg16);
+
+#else /* TRACE_ENABLE == 0 */
+
+#define MCAL_TRACE(event, arg8, arg16)  ((void)0)
+#define MCAL_Trace_SetHook(hook)        ((void)0)
+
+#endif /* TRACE_ENABLE */
+
+#endif /* MCAL_TRACE_H_ */
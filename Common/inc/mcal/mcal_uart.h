@@ -13,6 +13,27 @@
 #include "driverlib/uart.h"
 #include "driverlib/sysctl.h"
 
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Number of UART modules on the TM4C123 (UART0..UART7) */
+#define UART_NUM_CHANNELS     (8U)
+
+/* Return codes */
+#define UART_SUCCESS          (0U)
+#define UART_ERROR_INVALID    (1U)
+#define UART_ERROR_BUSY       (2U)
+
+/* Flow control modes (UART_ConfigType.flowControl).
+ * Both need an RX ring: the receiver holds the sender off while it is full. */
+#define UART_FLOW_NONE        (0U)
+#define UART_FLOW_RTS_CTS     (1U)  /* Hardware U1RTS/U1CTS (UART1 only); caller muxes the pins */
+#define UART_FLOW_XON_XOFF    (2U)  /* In-band XON/XOFF; text links only, binary data may contain them */
+
+#define UART_XON_CHAR         (0x11U)
+#define UART_XOFF_CHAR        (0x13U)
+
 /*======================================================================
  *  Types
  *====================================================================*/
@@ -24,8 +45,32 @@ typedef struct
 	uint8_t  dataBits;    /* 5..8 (UART supports up to 8) */
 	uint8_t  parity;      /* 0=None, 1=Even, 2=Odd, 3=Forced One, 4=Forced Zero */
 	uint8_t  stopBits;    /* 1 or 2 */
+	uint8_t  *rxBuffer;   /* Storage for the ISR-fed RX ring, or NULL for polled RX */
+	uint16_t rxBufferSize;/* Ring size in bytes, must be a power of two (2..32768) */
+	uint8_t  *txBuffer;   /* Storage for the ISR-drained TX ring, or NULL for blocking TX */
+	uint16_t txBufferSize;/* Ring size in bytes, must be a power of two (2..32768) */
+	uint8_t  flowControl; /* UART_FLOW_NONE, UART_FLOW_RTS_CTS or UART_FLOW_XON_XOFF */
 } UART_ConfigType;
 
+/* Link health counters of one UART, since UART_init() or UART_ResetStats().
+ * Error classes come from the status bits the hardware stores with every
+ * received character (the same bits UARTRxErrorGet() reports). */
+typedef struct
+{
+	uint32_t rxBytes;         /* Bytes received (ring, polled or uDMA) */
+	uint32_t txBytes;         /* Bytes handed to the TX FIFO (ring, blocking or uDMA) */
+	uint32_t rxRingOverruns;  /* Bytes dropped because the ring was full */
+	uint32_t rxFifoOverruns;  /* Hardware RX FIFO overruns (data lost before the ISR ran) */
+	uint32_t rxFramingErrors; /* No stop bit: baud mismatch or line noise */
+	uint32_t rxParityErrors;  /* Parity mismatch (parity enabled only) */
+	uint32_t rxBreaks;        /* Line held low for a whole character: cable or peer reset */
+	uint32_t rxThrottles;     /* Times flow control held the sender off */
+	uint16_t rxHighWater;     /* Most bytes ever waiting in the RX ring */
+	uint16_t txHighWater;     /* Most bytes ever waiting in the TX ring */
+	uint16_t rxBurstMax;      /* Most bytes drained in one interrupt; near 16 means it ran late */
+	uint32_t isrMaxCycles;    /* Longest UART interrupt, in SysTick (CPU clock) cycles */
+} UART_StatsType;
+
 
 /*======================================================================
  *  API
@@ -33,17 +78,39 @@ typedef struct
 /**
  * @brief Initialize a UART with baud, parity and stop-bits, and enable it.
  *
+ * When cfg->rxBuffer is not NULL, the RX and RX-timeout interrupts are
+ * enabled and the UART ISR drains the hardware FIFO into that ring, so
+ * receiveByte()/isDataAvailable() read from RAM instead of the 16-byte FIFO.
+ * Likewise, a non-NULL cfg->txBuffer makes sendByte() queue into a ring
+ * that the TX interrupt drains into the FIFO.
+ * The matching UARTn_Handler must be in the vector table (all eight are).
+ *
+ * With cfg->flowControl set (and an RX ring), the sender is held off
+ * before the ring overflows:
+ * - UART_FLOW_RTS_CTS: the ISR stops draining a full ring, the FIFO fills
+ *   and the hardware drops RTS; draining resumes once the ring is back
+ *   to 1/4 full. CTS pauses our own transmitter in hardware.
+ * - UART_FLOW_XON_XOFF: XOFF is sent at 3/4 full and XON once the ring is
+ *   back to 1/4; received XON/XOFF pause/resume the TX ring and are not
+ *   stored. uDMA bulk transmits are not paused.
+ *
  * @param cfg Pointer to configuration describing clock, base, baud and format.
  */
 void UART_init(const UART_ConfigType *cfg);
 
 /**
- * @brief Blocking send of one byte on a UART.
+ * @brief Send one byte on a UART.
+ *
+ * With a TX ring the byte is queued and the call only waits if the ring
+ * is full; without one it waits for hardware FIFO space.
  */
 void sendByte(uint32_t uartBase, uint8_t data);
 
 /**
  * @brief Blocking receive of one byte from a UART.
+ *
+ * Reads from the RX ring when the UART was initialized with one,
+ * otherwise straight from the hardware FIFO.
  */
 uint8_t receiveByte(uint32_t uartBase);
 
@@ -70,4 +137,114 @@ uint32_t receiveString(uint32_t uartBase, char *buffer, uint32_t maxLen);
  */
 uint8_t isDataAvailable(uint32_t uartBase);
 
+/**
+ * @brief Tick at which the ISR last took bytes from the RX FIFO.
+ *
+ * Tells how long ago the newest byte in the RX ring arrived, however
+ * late the application gets round to reading it. Only the ISR-fed ring
+ * records it; polled and uDMA receives leave it unchanged.
+ *
+ * @param uartBase Base address of UART module (UART0_BASE, etc.)
+ * @return MCAL_SysTick_GetTickMs() at that interrupt, 0 before the first
+ */
+uint32_t UART_GetLastRxTickMs(uint32_t uartBase);
+
+/**
+ * @brief Number of bytes queued in the TX ring and not yet in the FIFO.
+ *
+ * @param uartBase Base address of UART module (UART0_BASE, etc.)
+ * @return Bytes still waiting in software (0 for unbuffered UARTs)
+ */
+uint16_t UART_GetTxPending(uint32_t uartBase);
+
+/**
+ * @brief Check whether everything queued has left the transmitter.
+ *
+ * @param uartBase Base address of UART module (UART0_BASE, etc.)
+ * @return 1 if the TX ring is empty and the shift register is idle, 0 otherwise
+ */
+uint8_t UART_IsTxIdle(uint32_t uartBase);
+
+/**
+ * @brief Change the baud rate, keeping the frame format and any rings.
+ *
+ * Rates above clockFreq/16 use the high-speed (8x) divider, so the
+ * ceiling is clockFreq/8. Bytes still queued for TX are sent at the new
+ * rate; call only once UART_IsTxIdle() returns 1.
+ *
+ * @param uartBase  Base address of UART module (UART0_BASE, etc.)
+ * @param clockFreq UART source clock in Hz
+ * @param baudRate  New rate in bit/s
+ * @return UART_SUCCESS, or UART_ERROR_INVALID if the rate is out of range
+ */
+uint8_t UART_SetBaudRate(uint32_t uartBase, uint32_t clockFreq, uint32_t baudRate);
+
+/**
+ * @brief Start a uDMA transmit of a whole buffer.
+ *
+ * The CPU is only interrupted once per 1024-byte chunk. The buffer must
+ * stay valid until UART_IsDmaTxBusy() returns 0. Bytes queued with
+ * sendByte() meanwhile are sent after the buffer.
+ *
+ * @param uartBase Base address of UART module (UART0_BASE, etc.)
+ * @param data     Bytes to send
+ * @param len      Number of bytes (any length, chunked internally)
+ * @return UART_SUCCESS, UART_ERROR_BUSY (TX ring not drained or transfer
+ *         already running) or UART_ERROR_INVALID
+ */
+uint8_t UART_StartDmaTx(uint32_t uartBase, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Start a uDMA receive of exactly len bytes.
+ *
+ * Bytes already waiting in the RX ring or FIFO are copied first; the
+ * remainder is moved by the uDMA. The RX ring is bypassed until the
+ * transfer completes (UART_IsDmaRxBusy() returns 0).
+ *
+ * @param uartBase Base address of UART module (UART0_BASE, etc.)
+ * @param buffer   Destination
+ * @param len      Number of bytes to receive
+ * @return UART_SUCCESS, UART_ERROR_BUSY or UART_ERROR_INVALID
+ */
+uint8_t UART_StartDmaRx(uint32_t uartBase, uint8_t *buffer, uint32_t len);
+
+/**
+ * @brief Check whether a uDMA transmit is still in progress.
+ */
+uint8_t UART_IsDmaTxBusy(uint32_t uartBase);
+
+/**
+ * @brief Check whether a uDMA receive is still in progress.
+ */
+uint8_t UART_IsDmaRxBusy(uint32_t uartBase);
+
+/**
+ * @brief Read the health counters of a UART.
+ *
+ * Counting costs a few instructions per byte in the ISR. isrMaxCycles
+ * reads the SysTick down-counter, so it is only meaningful while
+ * MCAL_SysTick is running.
+ *
+ * @param uartBase Base address of UART module (UART0_BASE, etc.)
+ * @param stats    Destination for a snapshot of the counters
+ */
+void UART_GetStats(uint32_t uartBase, UART_StatsType *stats);
+
+/**
+ * @brief Zero the health counters and high-water marks of a UART.
+ */
+void UART_ResetStats(uint32_t uartBase);
+
+/**
+ * @brief UART0..UART7 interrupt handlers (placed in the vector table by startup_ewarm.c).
+ */
+void UART0_Handler(void);
+void UART1_Handler(void);
+void UART2_Handler(void);
+void UART3_Handler(void);
+void UART4_Handler(void);
+void UART5_Handler(void);
+void UART6_Handler(void);
+void UART7_Handler(void);
+
 #endif /* MCAL_UART_H_ */
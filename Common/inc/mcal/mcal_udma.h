@@ -0,0 +1,112 @@
+/*============================================================================
+ *  Module      : MCAL uDMA
+ *  File Name   : mcal_udma.h
+ *  Description : Micro-DMA abstraction layer built on top of TivaWare driverlib
+ *===========================================================================*/
+
+#ifndef MCAL_UDMA_H_
+#define MCAL_UDMA_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/udma.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Return codes */
+#define UDMA_SUCCESS                (0U)
+#define UDMA_ERROR_BUSY             (1U)
+#define UDMA_ERROR_INVALID_PARAM    (2U)
+
+/* Number of uDMA channels and the largest basic-mode transfer */
+#define UDMA_NUM_CHANNELS           (32U)
+#define UDMA_MAX_TRANSFER_ITEMS     (1024U)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Direction of a peripheral transfer */
+typedef enum
+{
+    UDMA_DIR_MEM_TO_PERIPH = 0,     /* e.g. buffer -> UARTn DR */
+    UDMA_DIR_PERIPH_TO_MEM          /* e.g. UARTn DR -> buffer */
+} Udma_DirectionType;
+
+/* Transfer accounting across all channels */
+typedef struct
+{
+    uint32_t transfersStarted;
+    uint32_t transfersCompleted;
+    uint32_t bytesCompleted;        /* Sum of completed transfer sizes */
+    uint32_t busErrors;             /* uDMA error interrupts */
+} Udma_StatsType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Enable the uDMA controller and install the channel control table.
+ *
+ * Safe to call more than once; only the first call touches the hardware.
+ */
+void MCAL_UDMA_Init(void);
+
+/**
+ * @brief Route a channel to a peripheral and reset its attributes.
+ *
+ * @param channelAssign  Channel/encoding value, e.g. UDMA_CH23_UART1TX
+ */
+void MCAL_UDMA_AssignChannel(uint32_t channelAssign);
+
+/**
+ * @brief Start a byte-wide basic-mode transfer between memory and a
+ *        peripheral data register.
+ *
+ * The peripheral's own interrupt fires when the transfer completes; its
+ * handler should call MCAL_UDMA_PollComplete() to collect the result.
+ *
+ * @param channel    Channel number (0..31)
+ * @param dir        Transfer direction
+ * @param periphReg  Address of the peripheral data register
+ * @param mem        Memory buffer (source or destination)
+ * @param count      Number of bytes, 1..UDMA_MAX_TRANSFER_ITEMS
+ * @return UDMA_SUCCESS, UDMA_ERROR_BUSY or UDMA_ERROR_INVALID_PARAM
+ */
+uint8_t MCAL_UDMA_StartTransfer(uint8_t channel, Udma_DirectionType dir,
+                                volatile void *periphReg, void *mem, uint16_t count);
+
+/**
+ * @brief Check whether a transfer is still in flight on a channel.
+ */
+uint8_t MCAL_UDMA_IsBusy(uint8_t channel);
+
+/**
+ * @brief Collect a finished transfer.
+ *
+ * Returns 1 exactly once per completed transfer (and updates the stats),
+ * 0 if the channel is idle or still running.
+ */
+uint8_t MCAL_UDMA_PollComplete(uint8_t channel);
+
+/**
+ * @brief Stop a channel early.
+ *
+ * @return Number of bytes that were transferred before the abort
+ */
+uint16_t MCAL_UDMA_Abort(uint8_t channel);
+
+/**
+ * @brief Snapshot of the transfer counters.
+ */
+void MCAL_UDMA_GetStats(Udma_StatsType *stats);
+
+/**
+ * @brief uDMA error interrupt handler (placed in the vector table by startup_ewarm.c).
+ */
+void uDMA_Error_Handler(void);
+
+#endif /* MCAL_UDMA_H_ */
@@ -0,0 +1,105 @@
+/*============================================================================
+ *  Module      : Services COBS
+ *  File Name   : cobs.h
+ *  Description : Consistent Overhead Byte Stuffing codec with a zero-byte
+ *                packet delimiter
+ *
+ *  Encoding removes every 0x00 from a packet: the data is split at each
+ *  zero into blocks, and each block is sent as [code][code-1 data bytes],
+ *  where code (1..255) is one more than the block length. A code of 0xFF
+ *  means a full 254-byte block with no zero after it. A single 0x00 then
+ *  ends the packet on the wire.
+ *
+ *  Because 0x00 only ever appears as a delimiter, a receiver that starts
+ *  mid-stream, or is hit by line noise, loses at most the packet in
+ *  progress and is back in step at the next zero.
+ *===========================================================================*/
+
+#ifndef COBS_H_
+#define COBS_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define COBS_DELIMITER          (0x00U)
+
+/* Worst-case wire size of an n-byte packet, delimiter included */
+#define COBS_MAX_ENCODED(n)     ((n) + ((n) / 254U) + 2U)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Result of feeding one byte to the decoder */
+typedef enum
+{
+    COBS_STATUS_PENDING = 0,    /* Need more bytes */
+    COBS_STATUS_COMPLETE,       /* decoder->buf holds decoder->length bytes */
+    COBS_STATUS_ERROR           /* Malformed or oversized packet dropped */
+} COBS_StatusType;
+
+/* Incremental decoder; one per receive stream */
+typedef struct
+{
+    uint8_t  *buf;          /* Caller-owned output buffer */
+    uint16_t  size;         /* Its size in bytes */
+    uint16_t  index;        /* Bytes decoded into buf so far */
+    uint16_t  length;       /* Length of the last complete packet */
+    uint8_t   code;         /* Code byte of the current block, 0 = none yet */
+    uint8_t   remaining;    /* Data bytes left in the current block */
+    boolean   discard;      /* Skipping to the next delimiter after an error */
+    uint32_t  errors;       /* Packets dropped (malformed or too long) */
+} COBS_DecoderType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Encode a packet and append the delimiter.
+ *
+ * @param src      Packet bytes (may be NULL when len is 0)
+ * @param len      Packet length
+ * @param dst      Destination buffer; must not overlap src
+ * @param dstSize  Size of the destination buffer
+ * @return Bytes written including the delimiter, or 0 if they do not fit
+ */
+uint16_t COBS_Encode(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dstSize);
+
+/**
+ * @brief Bind a decoder to its output buffer and wait for a packet start.
+ *
+ * @param decoder  Decoder state
+ * @param buf      Output buffer for decoded packets
+ * @param size     Size of the output buffer (largest accepted packet)
+ */
+void COBS_DecoderInit(COBS_DecoderType *decoder, uint8_t *buf, uint16_t size);
+
+/**
+ * @brief Drop a partially received packet; the error count is kept.
+ */
+void COBS_DecoderReset(COBS_DecoderType *decoder);
+
+/**
+ * @brief Check whether a decoder is in the middle of a packet.
+ */
+boolean COBS_DecoderIsBusy(const COBS_DecoderType *decoder);
+
+/**
+ * @brief Feed one received byte to a decoder.
+ *
+ * On COBS_STATUS_COMPLETE the packet is in decoder->buf (decoder->length
+ * bytes) and stays valid until the next byte is fed. A delimiter with no
+ * packet before it (idle line, back-to-back zeros) returns PENDING.
+ *
+ * @param decoder  Decoder state
+ * @param data     Received byte
+ * @return COBS_STATUS_PENDING, COBS_STATUS_COMPLETE or COBS_STATUS_ERROR
+ */
+COBS_StatusType COBS_DecoderFeed(COBS_DecoderType *decoder, uint8_t data);
+
+#endif /* COBS_H_ */
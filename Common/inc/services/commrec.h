@@ -0,0 +1,84 @@
+/*============================================================================
+ *  Module      : Services COMMREC
+ *  File Name   : commrec.h
+ *  Description : Byte-level traffic recorder for the inter-ECU link
+ *
+ *  Capture format (file or dump), one 6-byte record per byte on the wire:
+ *    +---------------------------+-----+------+
+ *    | TICK_MS (4 B, big-endian) | DIR | DATA |
+ *    +---------------------------+-----+------+
+ *    TICK_MS : MCAL_SysTick_GetTickMs() when the byte was queued/consumed
+ *    DIR     : COMMREC_DIR_RX ('R', received by this ECU) or
+ *              COMMREC_DIR_TX ('T', sent by this ECU)
+ *    DATA    : the byte
+ *  A capture is a plain concatenation of records; no header.
+ *===========================================================================*/
+
+#ifndef COMMREC_H_
+#define COMMREC_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define COMMREC_DIR_RX          ((uint8_t)'R')
+#define COMMREC_DIR_TX          ((uint8_t)'T')
+#define COMMREC_RECORD_SIZE     (6U)    /* Encoded bytes per record */
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+typedef struct
+{
+    uint32_t tickMs;
+    uint8_t  dir;
+    uint8_t  data;
+} COMMREC_RecordType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Attach the record ring and start recording.
+ *
+ * @param buffer  Storage for records
+ * @param depth   Number of records; must be a power of two
+ */
+void COMMREC_Init(COMMREC_RecordType *buffer, uint16_t depth);
+
+/**
+ * @brief Append one byte. When the ring is full the record is dropped
+ *        and counted, so a capture never has silent holes mid-stream.
+ */
+void COMMREC_Record(uint8_t dir, uint8_t data, uint32_t tickMs);
+
+/**
+ * @brief Remove up to max records, oldest first.
+ *
+ * @return Number of records copied
+ */
+uint16_t COMMREC_Read(COMMREC_RecordType *out, uint16_t max);
+
+/**
+ * @brief Records lost because the ring was full.
+ */
+uint32_t COMMREC_GetDropped(void);
+
+/**
+ * @brief Serialize a record into the 6-byte capture format.
+ */
+void COMMREC_Encode(const COMMREC_RecordType *rec, uint8_t *out);
+
+/**
+ * @brief Parse a 6-byte capture record.
+ *
+ * @return FALSE if the direction byte is not RX or TX
+ */
+boolean COMMREC_Decode(const uint8_t *in, COMMREC_RecordType *rec);
+
+#endif /* COMMREC_H_ */
@@ -0,0 +1,94 @@
+/*============================================================================
+ *  Module      : Services CONSOLE
+ *  File Name   : console.h
+ *  Description : Line-oriented command shell over a byte stream
+ *
+ *  Received characters are fed one at a time (CONSOLE_Feed()), echoed and
+ *  collected into a fixed line buffer; backspace edits, CR or LF ends the
+ *  line. The finished line is split into tokens in place (separators are
+ *  overwritten with '\0', argv points into the line) and the first token
+ *  is looked up in the caller's const command table. Nothing is allocated
+ *  and nothing blocks, so the shell can be pumped from a main loop.
+ *
+ *  "help" is built in and lists the table.
+ *===========================================================================*/
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define CONSOLE_LINE_SIZE       (64U)       /* Longest line, terminator included */
+#define CONSOLE_MAX_ARGS        (8U)        /* Tokens per line, command included */
+#define CONSOLE_PROMPT          "> "
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Output hook: queue a null-terminated string (e.g. HAL_COMM_PortSendString) */
+typedef void (*CONSOLE_PutsFnType)(const char *str);
+
+/* Command handler; argv[0] is the command name, argv[argc] is NULL */
+typedef void (*CONSOLE_HandlerType)(uint8_t argc, char *argv[]);
+
+/* One entry of the command table */
+typedef struct
+{
+    const char          *name;
+    const char          *help;      /* One line: arguments and purpose */
+    CONSOLE_HandlerType  handler;
+} CONSOLE_CommandType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Bind the shell to its command table and output, and print the prompt.
+ *
+ * @param commands  Command table; must stay valid (normally static const)
+ * @param count     Entries in the table
+ * @param putsFn    Output hook
+ */
+void CONSOLE_Init(const CONSOLE_CommandType *commands, uint8_t count,
+                  CONSOLE_PutsFnType putsFn);
+
+/**
+ * @brief Feed one received character.
+ *
+ * Runs the command, then prints a new prompt, when the character ends a
+ * line. Characters beyond CONSOLE_LINE_SIZE - 1 are dropped.
+ */
+void CONSOLE_Feed(char c);
+
+/**
+ * @brief Print a string.
+ */
+void CONSOLE_Print(const char *str);
+
+/**
+ * @brief Print an unsigned value in decimal.
+ */
+void CONSOLE_PrintDec(uint32_t value);
+
+/**
+ * @brief Print a value as "0x" and exactly digits hex digits (1..8).
+ */
+void CONSOLE_PrintHex(uint32_t value, uint8_t digits);
+
+/**
+ * @brief Parse a decimal or 0x-prefixed hex token.
+ *
+ * @param token  Null-terminated token
+ * @param value  Receives the value on success
+ * @return TRUE if the whole token is a number that fits in 32 bits
+ */
+boolean CONSOLE_ParseU32(const char *token, uint32_t *value);
+
+#endif /* CONSOLE_H_ */
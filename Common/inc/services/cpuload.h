@@ -0,0 +1,76 @@
+/*============================================================================
+ *  Module      : Services LOAD
+ *  File Name   : cpuload.h
+ *  Description : CPU load meter from the sleep (idle) accounting
+ *
+ *  Busy time is whatever the core does not spend asleep in
+ *  MCAL_SysTick_Sleep() (MCAL_SysTick_DelayMs() sleeps too). LOAD_OnTick(),
+ *  chained into the SysTick callback, closes a LOAD_WINDOW_MS window every
+ *  second and keeps:
+ *    - current: busy share of the last window
+ *    - average: busy share since LOAD_Init() / LOAD_Reset()
+ *    - peak:    busiest window since then
+ *    - the longest busy stretch (time between two sleeps), in the last
+ *      window and since the reset
+ *  Shares are in permille. An ECU whose loops never sleep reads 100 %: the
+ *  meter shows headroom only where waiting is done by sleeping.
+ *===========================================================================*/
+
+#ifndef CPULOAD_H_
+#define CPULOAD_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define LOAD_WINDOW_MS          (1000U)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+typedef struct
+{
+    uint16_t currentPermille;   /* Last complete window */
+    uint16_t averagePermille;   /* All windows since the reset */
+    uint16_t peakPermille;      /* Busiest window since the reset */
+    uint32_t busyMaxUs;         /* Longest busy stretch since the reset */
+    uint32_t windowBusyMaxUs;   /* Longest busy stretch in the last window */
+    uint32_t windows;           /* Windows since the reset */
+} LOAD_StatsType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Clear the statistics and start the first window.
+ *
+ * Call after MCAL_SysTick_Init().
+ */
+void LOAD_Init(void);
+
+/**
+ * @brief Count one ms tick; call from the SysTick callback.
+ */
+void LOAD_OnTick(void);
+
+/**
+ * @brief Copy the statistics (consistent snapshot).
+ */
+void LOAD_GetStats(LOAD_StatsType *stats);
+
+/**
+ * @brief Clear average, peak and longest stretch; the window runs on.
+ */
+void LOAD_Reset(void);
+
+/**
+ * @brief Console command: "load" prints the meter, "load reset" clears it.
+ */
+void LOAD_ConsoleCmd(uint8_t argc, char *argv[]);
+
+#endif /* CPULOAD_H_ */
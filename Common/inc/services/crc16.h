@@ -0,0 +1,43 @@
+/*============================================================================
+ *  Module      : Services CRC16
+ *  File Name   : crc16.h
+ *  Description : Table-driven CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ *===========================================================================*/
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include <stdint.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Initial value to pass to CRC16_Update() for a new message */
+#define CRC16_INIT_VALUE        (0xFFFFU)
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Fold one byte into a running CRC.
+ *
+ * One table lookup per byte; use for incremental (byte-by-byte) checks.
+ *
+ * @param crc   CRC so far (CRC16_INIT_VALUE for the first byte)
+ * @param data  Next message byte
+ * @return Updated CRC
+ */
+uint16_t CRC16_Update(uint16_t crc, uint8_t data);
+
+/**
+ * @brief Compute the CRC of a whole buffer.
+ *
+ * @param data  Message bytes
+ * @param len   Number of bytes
+ * @return CRC-16/CCITT-FALSE of the buffer
+ */
+uint16_t CRC16_Compute(const uint8_t *data, uint16_t len);
+
+#endif /* CRC16_H_ */
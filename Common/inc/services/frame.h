@@ -0,0 +1,124 @@
+/*============================================================================
+ *  Module      : Services FRAME
+ *  File Name   : frame.h
+ *  Description : Length-prefixed, CRC-protected frame codec shared by the
+ *                HMI and Control ECUs
+ *
+ *  Wire format:
+ *    +------+-----+-----+-----------------+--------+--------+
+ *    | SOF  | LEN | CMD | PAYLOAD[LEN]    | CRC_HI | CRC_LO |
+ *    +------+-----+-----+-----------------+--------+--------+
+ *    SOF  : FRAME_SOF (0x7E)
+ *    LEN  : payload length, 0..FRAME_MAX_PAYLOAD
+ *    CMD  : command / response code
+ *    CRC  : CRC-16/CCITT-FALSE over LEN, CMD and PAYLOAD (big-endian)
+ *===========================================================================*/
+
+#ifndef FRAME_H_
+#define FRAME_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define FRAME_SOF               (0x7EU)
+#define FRAME_MAX_PAYLOAD       (64U)
+#define FRAME_OVERHEAD          (5U)   /* SOF + LEN + CMD + 2 x CRC */
+#define FRAME_MAX_SIZE          (FRAME_MAX_PAYLOAD + FRAME_OVERHEAD)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* A decoded frame */
+typedef struct
+{
+    uint8_t cmd;
+    uint8_t len;
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+} FRAME_Type;
+
+/* Result of feeding one byte to the parser */
+typedef enum
+{
+    FRAME_STATUS_PENDING = 0,   /* Need more bytes */
+    FRAME_STATUS_COMPLETE,      /* parser->frame holds a valid frame */
+    FRAME_STATUS_ERROR          /* Bad length or CRC; parser re-armed */
+} FRAME_StatusType;
+
+/* Parser states */
+typedef enum
+{
+    FRAME_STATE_SOF = 0,
+    FRAME_STATE_LEN,
+    FRAME_STATE_CMD,
+    FRAME_STATE_PAYLOAD,
+    FRAME_STATE_CRC_HI,
+    FRAME_STATE_CRC_LO
+} FRAME_StateType;
+
+/* Incremental parser; one per receive stream */
+typedef struct
+{
+    FRAME_StateType state;
+    uint8_t         index;      /* Payload bytes received so far */
+    uint16_t        crc;        /* Running CRC over LEN/CMD/PAYLOAD */
+    uint16_t        rxCrc;      /* CRC carried by the frame */
+    FRAME_Type      frame;      /* Frame being assembled / last complete frame */
+    uint32_t        crcErrors;
+    uint32_t        lengthErrors;
+    uint32_t        truncatedFrames;    /* Frames abandoned by FRAME_ParserAbort() */
+} FRAME_ParserType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Build a complete frame in a caller-supplied buffer.
+ *
+ * @param cmd      Command / response code
+ * @param payload  Payload bytes (may be NULL when len is 0)
+ * @param len      Payload length, 0..FRAME_MAX_PAYLOAD
+ * @param out      Destination buffer
+ * @param outSize  Size of the destination buffer
+ * @return Number of bytes written, or 0 if the frame does not fit
+ */
+uint16_t FRAME_Encode(uint8_t cmd, const uint8_t *payload, uint8_t len,
+                      uint8_t *out, uint16_t outSize);
+
+/**
+ * @brief Reset a parser to wait for the next start byte.
+ */
+void FRAME_ParserInit(FRAME_ParserType *parser);
+
+/**
+ * @brief Abandon a partially received frame.
+ *
+ * Used when the sender goes quiet mid-frame, so the next start byte is
+ * not swallowed as payload. Counts a truncated frame if one was in
+ * progress; error counters are kept.
+ */
+void FRAME_ParserAbort(FRAME_ParserType *parser);
+
+/**
+ * @brief Check whether a parser is in the middle of a frame.
+ */
+boolean FRAME_ParserIsBusy(const FRAME_ParserType *parser);
+
+/**
+ * @brief Feed one received byte to a parser.
+ *
+ * On FRAME_STATUS_COMPLETE the decoded frame is in parser->frame and
+ * stays valid until the next byte is fed.
+ *
+ * @param parser  Parser state
+ * @param data    Received byte
+ * @return FRAME_STATUS_PENDING, FRAME_STATUS_COMPLETE or FRAME_STATUS_ERROR
+ */
+FRAME_StatusType FRAME_ParserFeed(FRAME_ParserType *parser, uint8_t data);
+
+#endif /* FRAME_H_ */
@@ -0,0 +1,141 @@
+/*============================================================================
+ *  Module      : Services LINK
+ *  File Name   : link.h
+ *  Description : Reliable, in-order frame delivery (go-back-N sliding
+ *                window) on top of the frame codec
+ *
+ *  Application frames travel inside link frames:
+ *    DATA     : LINK_CMD_DATA     | [SEQ][CMD][application payload...]
+ *    ACK      : LINK_CMD_ACK      | [next expected SEQ]   (cumulative)
+ *    SYNC     : LINK_CMD_SYNC     | (none)  sender restarts numbering at 0
+ *    SYNC_ACK : LINK_CMD_SYNC_ACK | (none)
+ *    RESYNC   : LINK_CMD_RESYNC   | (none)  DATA arrived before any SYNC
+ *
+ *  - Up to LINK_WINDOW_SIZE DATA frames may be unacknowledged at once.
+ *  - The receiver delivers only the next expected SEQ and acknowledges
+ *    every DATA frame, so duplicates and gaps are answered with the SEQ
+ *    it still needs.
+ *  - If the oldest frame is not acknowledged within LINK_RTO_MS, the
+ *    whole window is sent again (go-back-N). After LINK_MAX_RETRIES
+ *    rounds without progress the peer is assumed to have restarted: the
+ *    window is dropped and the sender goes back to SYNC.
+ *  - A sender queues but does not transmit DATA until its SYNC has been
+ *    acknowledged, and a receiver ignores DATA until it has seen a SYNC,
+ *    so a reboot on either side never delivers a frame twice.
+ *  - A receiver that has not seen a SYNC (it has just rebooted) answers
+ *    DATA with RESYNC, and the sender starts over with a SYNC at once
+ *    rather than after LINK_MAX_RETRIES timeouts.
+ *  - Starting over drops the window: frames in it may have reached the
+ *    peer before it rebooted, so they are not sent again. They are
+ *    counted (LINK_StatsType.dropped); the request layer above times
+ *    them out.
+ *
+ *  Frames whose command is not a LINK_CMD_* code are passed through
+ *  unchanged, so a peer without the link layer still gets through.
+ *===========================================================================*/
+
+#ifndef LINK_H_
+#define LINK_H_
+
+#include <stdint.h>
+#include "Types.h"
+#include "services/frame.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define LINK_WINDOW_SIZE        (4U)        /* DATA frames in flight */
+#define LINK_RTO_MS             (100U)      /* Retransmit timeout */
+#define LINK_MAX_RETRIES        (8U)        /* Timeouts in a row before resync */
+
+#define LINK_HEADER_SIZE        (2U)        /* SEQ + CMD */
+#define LINK_MAX_PAYLOAD        (FRAME_MAX_PAYLOAD - LINK_HEADER_SIZE)
+
+/* Link frame commands (control range below ' ', see hal_comm.h) */
+#define LINK_CMD_DATA           (0x04U)
+#define LINK_CMD_ACK            (0x05U)
+#define LINK_CMD_SYNC           (0x06U)
+#define LINK_CMD_SYNC_ACK       (0x07U)
+#define LINK_CMD_RESYNC         (0x0AU)
+
+/* Return codes */
+#define LINK_SUCCESS            (0U)
+#define LINK_ERROR_INVALID      (1U)
+#define LINK_ERROR_BUSY         (2U)        /* Window full */
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Raw frame transmit hook; returns 0 on success */
+typedef uint8_t (*LINK_SendFnType)(uint8_t cmd, const uint8_t *payload, uint8_t len);
+
+/* Link counters */
+typedef struct
+{
+    uint32_t sent;              /* DATA frames accepted from the application */
+    uint32_t retransmits;       /* DATA frames sent again after a timeout */
+    uint32_t acked;             /* DATA frames acknowledged by the peer */
+    uint32_t delivered;         /* DATA frames passed up in order */
+    uint32_t duplicates;        /* DATA frames dropped as already delivered or out of order */
+    uint32_t resyncs;           /* Restarts: LINK_MAX_RETRIES reached or RESYNC received */
+    uint32_t dropped;           /* Queued DATA frames discarded by those restarts */
+} LINK_StatsType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Reset both directions and start the SYNC handshake.
+ *
+ * @param sendFn  Transmit hook for raw frames
+ * @param nowMs   Current tick (MCAL_SysTick_GetTickMs())
+ */
+void LINK_Init(LINK_SendFnType sendFn, uint32_t nowMs);
+
+/**
+ * @brief Queue an application frame for reliable delivery.
+ *
+ * The frame is transmitted at once if the link is synchronised, otherwise
+ * as soon as the SYNC is acknowledged.
+ *
+ * @param cmd      Application command code
+ * @param payload  Payload bytes (may be NULL when len is 0)
+ * @param len      Payload length, 0..LINK_MAX_PAYLOAD
+ * @param nowMs    Current tick
+ * @return LINK_SUCCESS, LINK_ERROR_INVALID or LINK_ERROR_BUSY
+ */
+uint8_t LINK_Send(uint8_t cmd, const uint8_t *payload, uint8_t len, uint32_t nowMs);
+
+/**
+ * @brief Process a received frame.
+ *
+ * Link frames are consumed (and acknowledged where needed). An in-order
+ * DATA frame is unwrapped into out; any other frame is copied to out
+ * unchanged. in and out may point to the same frame.
+ *
+ * @param in     Frame from the frame parser
+ * @param out    Receives the application frame
+ * @param nowMs  Current tick
+ * @return TRUE if out holds a frame for the application
+ */
+boolean LINK_OnFrame(const FRAME_Type *in, FRAME_Type *out, uint32_t nowMs);
+
+/**
+ * @brief Run the SYNC and retransmit timers; call on every poll.
+ */
+void LINK_Tick(uint32_t nowMs);
+
+/**
+ * @brief Check whether every queued frame has been acknowledged.
+ */
+boolean LINK_IsIdle(void);
+
+/**
+ * @brief Snapshot of the link counters.
+ */
+void LINK_GetStats(LINK_StatsType *stats);
+
+#endif /* LINK_H_ */
@@ -0,0 +1,130 @@
+/*============================================================================
+ *  Module      : Services PROF
+ *  File Name   : prof.h
+ *  Description : Cycle-counter profiling with per-site statistics
+ *
+ *  PROF_BEGIN(id) / PROF_END(id) bracket a code path; every pass is timed
+ *  and folded into the site's count/min/max/total in a static table, which
+ *  PROF_ConsoleCmd() prints. Sites are the PROF_SiteType ids below, so a
+ *  site costs a table row and nothing is allocated or named at run time.
+ *
+ *  - Target: the Cortex-M4 DWT cycle counter (CYCCNT), in CPU cycles. The
+ *    core clock is gated in WFI, so time asleep (MCAL_SysTick_DelayMs())
+ *    is not counted: the figures are cycles actually executed.
+ *  - Host (Linux) builds: CLOCK_MONOTONIC, in nanoseconds.
+ *  - PROF_ENABLE 0 (default): the macros expand to nothing and the table
+ *    is not built, so instrumented code is unchanged.
+ *
+ *  The start stamp is kept per site, so sites may nest and a path may end
+ *  at several returns, but one site must not be entered again before it
+ *  ends (recursion, or the same site in an ISR and in thread code).
+ *===========================================================================*/
+
+#ifndef PROF_H_
+#define PROF_H_
+
+#include <stdint.h>
+#include "Types.h"
+#include "mcal/mcal_dwt.h"
+
+/*======================================================================
+ *  Configuration
+ *====================================================================*/
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE             (0)
+#endif
+
+#if defined(__unix__)
+#define PROF_HOST               (1)
+#else
+#define PROF_HOST               (0)
+#endif
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Instrumented sites; add a row to the name table in prof.c with each */
+typedef enum
+{
+    PROF_SITE_KEYPAD_GETKEY,    /* HAL_Keypad_GetKey() scan (HMI) */
+    PROF_SITE_LCD_STRING,       /* Lcd_DisplayString() (HMI) */
+    PROF_SITE_EEPROM_VERIFY,    /* HAL_EEPROM_VerifyPassword() (Control) */
+    PROF_SITE_ADC_READ,         /* ADC_Read() conversion, timed by its callers */
+    PROF_NUM_SITES
+} PROF_SiteType;
+
+#if (PROF_ENABLE != 0)
+
+/*======================================================================
+ *  Timestamp source
+ *====================================================================*/
+
+#if (PROF_HOST != 0)
+#define PROF_NOW()              PROF_HostNow()
+#define PROF_UNIT               "ns"
+#else
+#define PROF_NOW()              MCAL_DWT_GET_CYCLES()
+#define PROF_UNIT               "cycles"
+#endif
+
+/*======================================================================
+ *  Instrumentation
+ *====================================================================*/
+
+#define PROF_BEGIN(id)          (g_Prof_Start[(id)] = PROF_NOW())
+#define PROF_END(id)            PROF_Record((id), PROF_NOW() - g_Prof_Start[(id)])
+
+/* Start stamps, written by PROF_BEGIN(); private to the macros */
+extern uint32_t g_Prof_Start[PROF_NUM_SITES];
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Start the cycle counter (MCAL_DWT_Init()) and clear the table.
+ *
+ * Also measures an empty BEGIN/END pair once; that overhead is taken off
+ * every sample, so a site reports the cost of the code it brackets.
+ */
+void PROF_Init(void);
+
+/**
+ * @brief Fold one sample into a site's statistics (used by PROF_END()).
+ *
+ * @param id     Site
+ * @param delta  Elapsed counter ticks, overhead included
+ */
+void PROF_Record(PROF_SiteType id, uint32_t delta);
+
+/**
+ * @brief Clear every site's statistics.
+ */
+void PROF_Reset(void);
+
+/**
+ * @brief Console command: "prof" prints the table, "prof reset" clears it.
+ *
+ * For a CONSOLE_CommandType table; prints with CONSOLE_Print().
+ */
+void PROF_ConsoleCmd(uint8_t argc, char *argv[]);
+
+#if (PROF_HOST != 0)
+/**
+ * @brief Host timestamp: CLOCK_MONOTONIC in ns (low 32 bits).
+ */
+uint32_t PROF_HostNow(void);
+#endif
+
+#else /* PROF_ENABLE == 0 */
+
+#define PROF_BEGIN(id)          ((void)0)
+#define PROF_END(id)            ((void)0)
+#define PROF_Init()             ((void)0)
+#define PROF_Reset()            ((void)0)
+
+#endif /* PROF_ENABLE */
+
+#endif /* PROF_H_ */
@@ -0,0 +1,146 @@
+/*============================================================================
+ *  Module      : Services REQ
+ *  File Name   : request.h
+ *  Description : Sequence-numbered request/response tracking on top of the
+ *                frame codec
+ *
+ *  Every request and response frame carries a sequence number as its first
+ *  payload byte:
+ *    request  : CMD  | [SEQ][request payload...]
+ *    response : RESP | [SEQ][response payload...]
+ *  The responder echoes SEQ, so the requester can match replies to the
+ *  request that is still waiting. A late reply to a request that already
+ *  timed out matches nothing and is dropped. SEQ 0 marks unsolicited frames
+ *  (e.g. the boot-time Ready) and is never used for a request.
+ *===========================================================================*/
+
+#ifndef REQUEST_H_
+#define REQUEST_H_
+
+#include <stdint.h>
+#include "Types.h"
+#include "services/frame.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define REQ_MAX_OUTSTANDING     (4U)                    /* Requests in flight at once */
+#define REQ_MAX_PAYLOAD         (FRAME_MAX_PAYLOAD - 1U) /* After the SEQ byte, at most */
+#define REQ_SEQ_UNSOLICITED     (0U)
+#define REQ_INVALID_HANDLE      (0xFFU)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Lifecycle of a request slot */
+typedef enum
+{
+    REQ_STATUS_FREE = 0,        /* Slot unused (or handle invalid) */
+    REQ_STATUS_PENDING,         /* Sent, waiting for the reply */
+    REQ_STATUS_DONE,            /* Reply received */
+    REQ_STATUS_TIMEOUT          /* Deadline passed without a reply */
+} REQ_StatusType;
+
+/* Frame transmit hook, e.g. HAL_COMM_SendFrame */
+typedef uint8_t (*REQ_SendFnType)(uint8_t cmd, const uint8_t *payload, uint8_t len);
+
+/* Link counters */
+typedef struct
+{
+    uint32_t sent;
+    uint32_t completed;
+    uint32_t timeouts;
+    uint32_t unmatched;         /* Replies with no pending request (late or stray) */
+    uint32_t rttMinUs;          /* Send to reply (services/timebase.h), */
+    uint32_t rttMaxUs;          /* over the completed requests */
+    uint64_t rttTotalUs;        /* Mean = rttTotalUs / completed */
+} REQ_StatsType;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Reset all slots and install the frame transmit hook.
+ *
+ * @param sendFn      Frame transmit hook
+ * @param maxPayload  Largest payload the hook accepts (HAL_COMM_MAX_PAYLOAD);
+ *                    requests and replies get one byte less, for the SEQ
+ */
+void REQ_Init(REQ_SendFnType sendFn, uint8_t maxPayload);
+
+/**
+ * @brief Send a request and start tracking it.
+ *
+ * The sequence number is only used up once the transmit hook has taken
+ * the frame, so a refused send leaves no gap in the SEQ stream.
+ *
+ * @param cmd        Command code
+ * @param payload    Request payload (may be NULL when len is 0)
+ * @param len        Payload length, 0..REQ_GetMaxPayload()
+ * @param timeoutMs  How long to wait for the reply
+ * @param nowMs      Current tick (MCAL_SysTick_GetTickMs())
+ * @return Handle for REQ_GetStatus()/REQ_Release(), or REQ_INVALID_HANDLE
+ *         if all slots are busy, the payload is too long or the transmit
+ *         hook refused the frame
+ */
+uint8_t REQ_Send(uint8_t cmd, const uint8_t *payload, uint8_t len,
+                 uint32_t timeoutMs, uint32_t nowMs);
+
+/**
+ * @brief Largest request or reply payload on the installed transport.
+ */
+uint8_t REQ_GetMaxPayload(void);
+
+/**
+ * @brief Offer a received frame to the tracker.
+ *
+ * @return TRUE if the frame answered a pending request
+ */
+boolean REQ_OnFrame(const FRAME_Type *frame);
+
+/**
+ * @brief Expire requests whose deadline has passed.
+ */
+void REQ_Tick(uint32_t nowMs);
+
+/**
+ * @brief Query a request.
+ *
+ * @param handle    Handle from REQ_Send()
+ * @param response  Optional; on REQ_STATUS_DONE receives the reply with the
+ *                  SEQ byte removed
+ * @return Current status
+ */
+REQ_StatusType REQ_GetStatus(uint8_t handle, FRAME_Type *response);
+
+/**
+ * @brief Free a slot once its result has been consumed (or to cancel it).
+ */
+void REQ_Release(uint8_t handle);
+
+/**
+ * @brief Split a received frame into its SEQ byte and body.
+ *
+ * @param frame  Received frame
+ * @param seq    Receives the sequence number
+ * @param body   Receives the frame with the SEQ byte removed
+ * @return FALSE if the frame has no SEQ byte
+ */
+boolean REQ_Unwrap(const FRAME_Type *frame, uint8_t *seq, FRAME_Type *body);
+
+/**
+ * @brief Send a reply (or an unsolicited frame with REQ_SEQ_UNSOLICITED).
+ *
+ * @return Result of the transmit hook, or 0xFF if the payload is too long
+ */
+uint8_t REQ_Reply(uint8_t seq, uint8_t cmd, const uint8_t *payload, uint8_t len);
+
+/**
+ * @brief Snapshot of the link counters.
+ */
+void REQ_GetStats(REQ_StatsType *stats);
+
+#endif /* REQUEST_H_ */
@@ -0,0 +1,123 @@
+/*============================================================================
+ *  Module      : Services SWTIMER
+ *  File Name   : swtimer.h
+ *  Description : Software timers on a hierarchical timer wheel
+ *
+ *  Any number of timers can be armed; each one is a caller-owned
+ *  SWTIMER_Type node (normally static), so nothing is allocated and the
+ *  service never runs out of slots.
+ *
+ *  The wheel has SWTIMER_LEVELS levels of SWTIMER_WHEEL_SLOTS slots.
+ *  Level 0 slots are 1 ms wide, each higher level's slots are
+ *  SWTIMER_WHEEL_SLOTS times wider. A timer is linked into the slot that
+ *  holds its expiry tick; when level 0 wraps, the next slot of level 1 is
+ *  spread over level 0 (and so on up), so a timer is moved at most once
+ *  per level before it fires.
+ *    - Start, stop: constant time (doubly linked slot lists)
+ *    - Per tick: the timers expiring in that tick, plus a cascade of one
+ *      higher-level slot every SWTIMER_WHEEL_SLOTS ticks
+ *
+ *  The wheel is not turned by the 1 ms SysTick interrupt but by the main
+ *  loop, which calls SWTIMER_Process() with MCAL_SysTick_GetTickMs().
+ *  Callbacks therefore run in thread context, never in an ISR, and fire
+ *  on the first loop pass after their tick: late by up to one pass, and
+ *  caught up in order after a long one. A loop that blocks must keep
+ *  calling SWTIMER_Process() (the Control ECU does so through
+ *  HAL_COMM_SetWaitHook() during baud negotiation). Callbacks may start
+ *  and stop any timer, their own included. The service does no locking:
+ *  call every function from the main loop.
+ *===========================================================================*/
+
+#ifndef SWTIMER_H_
+#define SWTIMER_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define SWTIMER_WHEEL_BITS      (6U)
+#define SWTIMER_WHEEL_SLOTS     (1U << SWTIMER_WHEEL_BITS)
+#define SWTIMER_LEVELS          (4U)
+
+/* Longest delay or period (~4.6 h); longer ones are clamped */
+#define SWTIMER_MAX_DELAY_MS    ((1UL << (SWTIMER_WHEEL_BITS * SWTIMER_LEVELS)) - 1UL)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Expiry callback; context is the pointer given to SWTIMER_Setup() */
+typedef void (*SWTIMER_CallbackType)(void *context);
+
+/* Timer node, owned by the caller. Fields are private to the service. */
+typedef struct SWTIMER_Node
+{
+    struct SWTIMER_Node  *next;
+    struct SWTIMER_Node **pprev;        /* NULL while stopped */
+    uint32_t              expiryMs;
+    uint32_t              periodMs;     /* 0: one-shot */
+    SWTIMER_CallbackType  callback;
+    void                 *context;
+} SWTIMER_Type;
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Empty the wheel and set its clock.
+ *
+ * @param nowMs  Current tick (MCAL_SysTick_GetTickMs())
+ */
+void SWTIMER_Init(uint32_t nowMs);
+
+/**
+ * @brief Prepare a timer node (stopped). Call once before first use.
+ */
+void SWTIMER_Setup(SWTIMER_Type *timer, SWTIMER_CallbackType callback, void *context);
+
+/**
+ * @brief Arm a timer, restarting it if it is already armed.
+ *
+ * @param timer     Node set up with SWTIMER_Setup()
+ * @param delayMs   Time to the first expiry (0 counts as 1)
+ * @param periodMs  Time between later expiries, or 0 for a one-shot
+ */
+void SWTIMER_Start(SWTIMER_Type *timer, uint32_t delayMs, uint32_t periodMs);
+
+/**
+ * @brief Disarm a timer; harmless if it is not armed.
+ */
+void SWTIMER_Stop(SWTIMER_Type *timer);
+
+/**
+ * @brief Check whether a timer is armed.
+ */
+boolean SWTIMER_IsActive(const SWTIMER_Type *timer);
+
+/**
+ * @brief Advance the wheel to nowMs, running every callback due on the way.
+ *
+ * Call from the main loop; ticks missed while the loop was busy are
+ * caught up, in order.
+ *
+ * @param nowMs  Current tick
+ */
+void SWTIMER_Process(uint32_t nowMs);
+
+/**
+ * @brief Time until SWTIMER_Process() next has work, for an idle sleep.
+ *
+ * Looks at most SWTIMER_WHEEL_SLOTS ms ahead; a cascade counts as work.
+ *
+ * @param nowMs  Current tick
+ * @param maxMs  Longest answer wanted
+ * @return 0 if a tick is already due, else ms to the nearest expiry or
+ *         cascade (at most maxMs)
+ */
+uint32_t SWTIMER_GetIdleMs(uint32_t nowMs, uint32_t maxMs);
+
+#endif /* SWTIMER_H_ */
@@ -0,0 +1,58 @@
+/*============================================================================
+ *  Module      : Services TIME
+ *  File Name   : timebase.h
+ *  Description : 64-bit monotonic microsecond timebase
+ *
+ *  Wide Timer 0A (GPT_WTIMER0A) runs free at 1 MHz: its prescaler divides
+ *  the system clock down to 1 us steps and its 32-bit counter wraps every
+ *  ~71.6 minutes. The wrap interrupt counts epochs, which give the upper
+ *  32 bits, so the time never wraps in practice (584,000 years).
+ *
+ *  Reads take no lock and never mask interrupts. A wrap whose interrupt
+ *  has not run yet (interrupts masked, or read from an ISR) is detected
+ *  from the raw timeout flag and counted, so the time never steps back.
+ *  Callable from thread context and from any ISR whose priority is not
+ *  above the WTIMER0A interrupt (all share the reset priority here).
+ *
+ *  The system clock must be a whole number of MHz.
+ *===========================================================================*/
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdint.h>
+#include "Types.h"
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Start the timebase at 0 us. Call once, before any delay.
+ */
+void TIME_Init(void);
+
+/**
+ * @brief Microseconds since TIME_Init().
+ */
+uint64_t TIME_GetUs64(void);
+
+/**
+ * @brief Low 32 bits of TIME_GetUs64(); cheaper, for intervals under
+ *        ~71 minutes measured with unsigned subtraction.
+ */
+uint32_t TIME_GetUs(void);
+
+/**
+ * @brief Busy-wait for at least us microseconds (at most 1 us more,
+ *        plus time spent in interrupts).
+ *
+ * Independent of the compiler and optimisation level, unlike a counted
+ * loop. For waits of a millisecond or more, MCAL_SysTick_DelayMs() sleeps
+ * instead of spinning.
+ *
+ * @param us  Delay in microseconds (up to ~71 minutes)
+ */
+void TIME_DelayUs(uint32_t us);
+
+#endif /* TIMEBASE_H_ */
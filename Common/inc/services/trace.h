@@ -0,0 +1,175 @@
+/*============================================================================
+ *  Module      : Services TRACE
+ *  File Name   : trace.h
+ *  Description : Timestamped binary event trace, drained as packets for the
+ *                host exporter (Common/host/trace_export.c)
+ *
+ *  TRACE(event, arg8, arg16) appends an 8-byte record stamped with the
+ *  microsecond timebase (services/timebase.h) to a static ring. It is
+ *  callable from thread code and ISRs; a record costs a timer read, four
+ *  stores and a brief interrupt mask. When the ring is full new records
+ *  are dropped and counted, as in the traffic recorder
+ *  (services/commrec.h). TRACE_ENABLE 0 (default) compiles every TRACE()
+ *  out.
+ *
+ *  The stamps are whole microseconds from the wide timer, which keeps
+ *  counting while the core sleeps in WFI; the DWT cycle counter stops
+ *  there, so it would shorten every idle gap to nothing. Nor does the
+ *  trace touch the DWT, so host builds run it on the timer model.
+ *
+ *  Recording runs between TRACE_Start() and TRACE_Stop() (the "trace on"
+ *  and "trace off" console commands); the application meanwhile sends
+ *  TRACE_BuildPacket() output on the console UART whenever it has room.
+ *
+ *  Packet on the wire: 0x00, COBS(body), 0x00. The leading zero keeps a
+ *  packet apart from console text before it; text never contains zeros,
+ *  and fails the magic/CRC check, so a capture of the whole console
+ *  stream can be fed to the exporter as is.
+ *
+ *  Body (multi-byte fields big-endian):
+ *    +-------+-----+-----+-----+---------+---------+---------+---------+-----+
+ *    | 'T''R'| VER | ECU | SEQ | CLK_HZ  | NOW_CLK | NOW_US  | DROPPED | CNT |
+ *    |  2 B  | 1 B | 1 B | 2 B |  4 B    |  4 B    |  8 B    |  4 B    | 1 B |
+ *    +-------+-----+-----+-----+---------+---------+---------+---------+-----+
+ *    followed by CNT records and a CRC-16/CCITT-FALSE over everything before:
+ *    +---------------+-------+------+-------+
+ *    | STAMP (4 B)   | EVENT | ARG8 | ARG16 |
+ *    +---------------+-------+------+-------+
+ *    STAMP and NOW_CLK count at CLK_HZ (TRACE_STAMP_HZ); NOW_CLK and NOW_US
+ *    are read together when the packet is built, so the host places each
+ *    record at NOW_US - (NOW_CLK - STAMP) / CLK_HZ on the ECU's microsecond
+ *    timebase. Records are at most one stamp wrap (~71 min) old when
+ *    drained, which continuous draining ensures.
+ *===========================================================================*/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+#include "Types.h"
+#include "mcal/mcal_trace.h"
+#include "services/cobs.h"
+
+/*======================================================================
+ *  Configuration
+ *====================================================================*/
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE            (0)
+#endif
+#define TRACE_DEPTH             (256U)  /* Records in the ring (power of two) */
+#define TRACE_STAMP_HZ          (1000000U)  /* Record stamps: TIME_GetUs() */
+
+/*======================================================================
+ *  Wire format
+ *====================================================================*/
+
+#define TRACE_MAGIC_0           ((uint8_t)'T')
+#define TRACE_MAGIC_1           ((uint8_t)'R')
+#define TRACE_VERSION           (1U)
+#define TRACE_ECU_HMI           ((uint8_t)'H')
+#define TRACE_ECU_CONTROL       ((uint8_t)'C')
+
+#define TRACE_HEADER_SIZE       (27U)
+#define TRACE_RECORD_SIZE       (8U)
+#define TRACE_CRC_SIZE          (2U)
+#define TRACE_RECORDS_PER_PACKET (16U)
+#define TRACE_BODY_MAX_SIZE     (TRACE_HEADER_SIZE + \
+                                 (TRACE_RECORDS_PER_PACKET * TRACE_RECORD_SIZE) + \
+                                 TRACE_CRC_SIZE)
+
+/* Largest packet on the wire, both delimiters included */
+#define TRACE_PACKET_MAX_SIZE   (COBS_MAX_ENCODED(TRACE_BODY_MAX_SIZE) + 1U)
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Event codes (EVENT byte); the exporter knows each one. The MCAL
+ * records its events through mcal/mcal_trace.h, with the same codes. */
+typedef enum
+{
+    TRACE_EVT_ISR_ENTER = MCAL_TRACE_EVT_ISR_ENTER,
+    TRACE_EVT_ISR_EXIT  = MCAL_TRACE_EVT_ISR_EXIT,
+    TRACE_EVT_REQ_SEND,         /* arg8: command, arg16: SEQ (requester) */
+    TRACE_EVT_REQ_RECV,         /* arg8: command, arg16: SEQ (responder) */
+    TRACE_EVT_RESP_SEND,        /* arg8: response, arg16: SEQ (responder) */
+    TRACE_EVT_RESP_RECV,        /* arg8: response, arg16: SEQ (requester) */
+    TRACE_EVT_EEPROM_BEGIN = MCAL_TRACE_EVT_EEPROM_BEGIN,
+    TRACE_EVT_EEPROM_END   = MCAL_TRACE_EVT_EEPROM_END,
+    TRACE_EVT_MOTOR,            /* arg8: Motor_DirType (Control main.c) */
+    TRACE_EVT_LCD_BEGIN,        /* arg8: TRACE_LCD_STRING / TRACE_LCD_CLEAR */
+    TRACE_EVT_LCD_END,          /* arg8: as LCD_BEGIN; arg16: characters */
+    TRACE_EVT_MARK              /* Free use while debugging */
+} TRACE_EventType;
+
+#define TRACE_LCD_STRING        (0U)
+#define TRACE_LCD_CLEAR         (1U)
+
+/* One ring entry */
+typedef struct
+{
+    uint32_t stamp;             /* TIME_GetUs() */
+    uint8_t  event;
+    uint8_t  arg8;
+    uint16_t arg16;
+} TRACE_RecordType;
+
+#if (TRACE_ENABLE != 0)
+
+#define TRACE(event, arg8, arg16) \
+    TRACE_Record((uint8_t)(event), (uint8_t)(arg8), (uint16_t)(arg16))
+
+/*======================================================================
+ *  API
+ *====================================================================*/
+
+/**
+ * @brief Empty the ring and take the MCAL's events (MCAL_Trace_SetHook());
+ *        recording stays off.
+ *
+ * Needs TIME_Init() first (record stamps).
+ *
+ * @param ecu  TRACE_ECU_HMI or TRACE_ECU_CONTROL
+ */
+void TRACE_Init(uint8_t ecu);
+
+/**
+ * @brief Clear the ring and counters and start recording.
+ */
+void TRACE_Start(void);
+
+/**
+ * @brief Stop recording; records already taken can still be drained.
+ */
+void TRACE_Stop(void);
+
+/**
+ * @brief Append one record (used by TRACE()).
+ */
+void TRACE_Record(uint8_t event, uint8_t arg8, uint16_t arg16);
+
+/**
+ * @brief Move up to TRACE_RECORDS_PER_PACKET records into one wire packet.
+ *
+ * Thread context only (single consumer).
+ *
+ * @param out   Destination
+ * @param size  Its size; at least TRACE_PACKET_MAX_SIZE
+ * @return Packet length, or 0 if no record is waiting or out is too small
+ */
+uint16_t TRACE_BuildPacket(uint8_t *out, uint16_t size);
+
+/**
+ * @brief Console command: "trace on|off", or "trace" for the counters.
+ */
+void TRACE_ConsoleCmd(uint8_t argc, char *argv[]);
+
+#else /* TRACE_ENABLE == 0 */
+
+#define TRACE(event, arg8, arg16)   ((void)0)
+#define TRACE_Init(ecu)             ((void)0)
+
+#endif /* TRACE_ENABLE */
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,35 @@
+/*============================================================================
+ *  Module      : MCAL DWT
+ *  File Name   : mcal_dwt.c
+ *  Description : Cortex-M4 DWT cycle counter (CYCCNT)
+ *===========================================================================*/
+
+#include "mcal/mcal_dwt.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Debug Exception and Monitor Control (ARMv7-M ARM, C1.6) */
+#define DWT_DEMCR_R             (*((volatile uint32_t *)0xE000EDFCU))
+#define DWT_DEMCR_TRCENA        (0x01000000U)
+
+/* DWT control (ARMv7-M ARM, C1.8) */
+#define DWT_CTRL_R              (*((volatile uint32_t *)0xE0001000U))
+#define DWT_CTRL_CYCCNTENA      (0x00000001U)
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void MCAL_DWT_Init(void)
+{
+    if ((DWT_CTRL_R & DWT_CTRL_CYCCNTENA) != 0U)
+    {
+        return;
+    }
+
+    DWT_DEMCR_R       |= DWT_DEMCR_TRCENA;
+    MCAL_DWT_CYCCNT_R  = 0U;
+    DWT_CTRL_R        |= DWT_CTRL_CYCCNTENA;
+}
@@ -6,6 +6,7 @@
 
 #include "mcal/mcal_eeprom.h"
 #include "mcal/mcal_gpio.h"
+#include "mcal/mcal_trace.h"
 
 /*======================================================================
  *  API implementations
@@ -82,7 +83,9 @@ uint8_t MCAL_EEPROM_WriteWord(uint32_t address, uint32_t data)
     }
     
     /* Write the word using TivaWare function */
+    MCAL_TRACE(MCAL_TRACE_EVT_EEPROM_BEGIN, 0U, address);
     result = EEPROMProgram(&data, address, EEPROM_WORD_SIZE);
+    MCAL_TRACE(MCAL_TRACE_EVT_EEPROM_END, (result != 0U) ? 1U : 0U, EEPROM_WORD_SIZE);
     
     /* Check if write was successful */
     if (result == 0U)
@@ -163,7 +166,9 @@ uint8_t MCAL_EEPROM_WriteBlock(const uint32_t *pData, uint32_t address, uint32_t
     }
     
     /* Write the block using TivaWare function */
+    MCAL_TRACE(MCAL_TRACE_EVT_EEPROM_BEGIN, 0U, address);
     result = EEPROMProgram((uint32_t *)pData, address, bytesToWrite);
+    MCAL_TRACE(MCAL_TRACE_EVT_EEPROM_END, (result != 0U) ? 1U : 0U, bytesToWrite);
     
     /* Check if write was successful */
     if (result == 0U)
@@ -6,6 +6,9 @@
 
 #include "mcal/mcal_gpio.h"
 
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+
 /*======================================================================
  *  Local helpers
  *====================================================================*/
@@ -109,6 +112,15 @@ void MCAL_GPIO_TogglePin(uint32_t portBase,
     GPIOPinWrite(portBase, pins, toggled);
 }
 
+void MCAL_GPIO_UnlockPin(uint32_t portBase,
+                         uint8_t  pins)
+{
+    /* The commit register is only writable while the port is unlocked */
+    HWREG(portBase + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+    HWREG(portBase + GPIO_O_CR)  |= pins;
+    HWREG(portBase + GPIO_O_LOCK) = 0U;
+}
+
 
 void PORTF_Handler(void)
 {
@@ -10,7 +10,7 @@
  *   Static callback array
  * ===========================
  *
- * For each GPT timer (GPT_TIMER0A, GPT_WTIMER2A, ...)
+ * For each GPT timer (GPT_TIMER0A, GPT_WTIMER2A, GPT_WTIMER0A)
  * we store a function pointer to call from the ISR.
  *
  * You set these via Gpt_SetCallBack().
@@ -23,10 +23,10 @@ static Gpt_CallbackType g_Gpt_Callbacks[GPT_NUM_TIMERS] = {0};
  *
  * This struct maps our abstract timer ID (Gpt_IDType)
  * to the actual hardware details used by TivaWare:
- *  - base       : TIMER0_BASE / WTIMER2_BASE
+ *  - base       : TIMER0_BASE / WTIMER2_BASE / WTIMER0_BASE
  *  - subTimer   : TIMER_A (we always use sub-timer A here)
  *  - sysctlPeriph: clock gate ID for SysCtlPeripheralEnable()
- *  - intNumber  : NVIC interrupt number (INT_TIMER0A, INT_WTIMER2A)
+ *  - intNumber  : NVIC interrupt number (INT_TIMER0A, INT_WTIMER2A, INT_WTIMER0A)
  */
 typedef struct {
     uint32_t base;
@@ -48,6 +48,12 @@ static const Gpt_HwMapType g_Gpt_HwMap[GPT_NUM_TIMERS] = {
         .subTimer     = TIMER_A,
         .sysctlPeriph = SYSCTL_PERIPH_WTIMER2,
         .intNumber    = INT_WTIMER2A
+    },
+    [GPT_WTIMER0A] = {
+        .base         = WTIMER0_BASE,
+        .subTimer     = TIMER_A,
+        .sysctlPeriph = SYSCTL_PERIPH_WTIMER0,
+        .intNumber    = INT_WTIMER0A
     }
 };
 
@@ -78,7 +84,7 @@ void Gpt_Init(const Gpt_ConfigType *Config_Ptr)
     const Gpt_HwMapType *map = prvGetMap(id);
     if (!map) return;         // invalid ID ? do nothing
 
-    /* 1) Enable clock to the timer peripheral (Timer0 or WideTimer2) */
+    /* 1) Enable clock to the timer peripheral (Timer0 or a WideTimer) */
     SysCtlPeripheralEnable(map->sysctlPeriph);
     while (!SysCtlPeripheralReady(map->sysctlPeriph)) { }
 
@@ -186,6 +192,22 @@ void Gpt_Init(const Gpt_ConfigType *Config_Ptr)
         }
         break;
 
+    case GPT_WTIMER0A:
+        /* Wide Timer 0 sub-timer A is the free-running timebase: a
+         * PERIODIC 32-bit half (split pair) with the prescaler in front.
+         * Counting down, the prescaler divides the clock, so the counter
+         * steps once every (timer_Prescale + 1) clocks.
+         */
+        if (Config_Ptr->timer_mode != GPT_MODE_PERIODIC)
+        {
+            return;
+        }
+
+        TimerConfigure(base, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_PERIODIC);
+        TimerPrescaleSet(base, st, Config_Ptr->timer_Prescale);
+        TimerLoadSet(base, st, Config_Ptr->timer_InitialValue);
+        break;
+
     default:
         /* Unknown timer ID ? do nothing */
         return;
@@ -351,6 +373,32 @@ uint32_t Gpt_GetCaptureValue(Gpt_IDType timer_ID)
     return TimerValueGet(map->base, map->subTimer);
 }
 
+/* ===========================
+ *   Counter helpers
+ * ===========================
+ *
+ * Used to build a timebase on a free-running periodic timer:
+ *  - Gpt_GetValue() reads the counter (counts down to 0, then reloads)
+ *  - Gpt_IsTimeoutPending() tells whether a reload happened that the ISR
+ *    has not handled yet (interrupts masked, or the caller is an ISR)
+ */
+
+uint32_t Gpt_GetValue(Gpt_IDType timer_ID)
+{
+    const Gpt_HwMapType *map = prvGetMap(timer_ID);
+    if (!map) return 0u;
+
+    return TimerValueGet(map->base, map->subTimer);
+}
+
+bool Gpt_IsTimeoutPending(Gpt_IDType timer_ID)
+{
+    const Gpt_HwMapType *map = prvGetMap(timer_ID);
+    if (!map) return false;
+
+    return ((TimerIntStatus(map->base, false) & TIMER_TIMA_TIMEOUT) != 0u);
+}
+
 /* ===========================
  *   ISRs
  * ===========================
@@ -383,3 +431,13 @@ void WTimer2A_Handler(void)
     if (g_Gpt_Callbacks[GPT_WTIMER2A])
         g_Gpt_Callbacks[GPT_WTIMER2A]();
 }
+
+void WTimer0A_Handler(void)
+{
+    /* Clear both timeout and capture events to be safe */
+    TimerIntClear(WTIMER0_BASE, TIMER_TIMA_TIMEOUT | TIMER_CAPA_EVENT);
+
+    /* Call user callback if registered */
+    if (g_Gpt_Callbacks[GPT_WTIMER0A])
+        g_Gpt_Callbacks[GPT_WTIMER0A]();
+}
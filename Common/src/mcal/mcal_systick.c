@@ -7,9 +7,23 @@
 #include "mcal/mcal_systick.h"
 
 #include <stdbool.h>
+#include "Types.h"
 #include "tm4c123gh6pm.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/systick.h"
+#include "driverlib/cpu.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* The counter is only re-timed when it is at least this far from its next
+ * wrap; closer than that the wrap could slip in between reading and
+ * reprogramming it, so the code waits for the wrap instead. */
+#define SYSTICK_SLEEP_GUARD_CYCLES  (200U)
+
+/* SysTick reload register width */
+#define SYSTICK_MAX_PERIOD          (0x01000000U)
 
 /*======================================================================
  *  Private data
@@ -18,6 +32,106 @@
 static volatile uint32_t       g_systickMs   = 0U;
 static uint32_t                g_sysClkHz    = 0U;
 static SysTick_CallbackType    g_systickCb   = (SysTick_CallbackType)0;
+static uint32_t                g_cyclesPerMs = 0U;
+
+/* ms the next SysTick interrupt stands for (more than 1 after a tickless
+ * sleep has stretched the period) */
+static volatile uint32_t       g_tickStepMs  = 1U;
+
+/* The next SysTick interrupt ends a period slept through in full */
+static volatile boolean        g_tickSlept   = FALSE;
+
+/* Idle accounting (cycles spent in WFI); whole ms slept are added with
+ * their tick, so a tick callback sees the idle time up to that tick */
+static uint64_t                g_idleCycles  = 0U;
+
+/* Busy stretches: time between two sleeps, on the prv_stamp() clock */
+static uint32_t                g_wakeStamp   = 0U;
+static uint32_t                g_busyMaxCycles = 0U;
+static boolean                 g_asleep      = FALSE;
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+/* Count ms ticks; the callback sees every one of them, also after a
+ * tickless sleep. Ticks slept through count as idle before their
+ * callback runs. */
+static void prv_advance(uint32_t ms, boolean slept)
+{
+    while (ms != 0U)
+    {
+        if (slept)
+        {
+            g_idleCycles += g_cyclesPerMs;
+        }
+        g_systickMs++;
+
+        if (g_systickCb != (SysTick_CallbackType)0)
+        {
+            g_systickCb();
+        }
+        ms--;
+    }
+}
+
+/* Woken early from a long period: next wrap when the counter would have
+ * passed boundary cycles into it (at least SYSTICK_SLEEP_GUARD_CYCLES
+ * ahead when computed), 1 ms periods after it. The counter is read again
+ * just before the write, so only the write itself adds drift. */
+static void prv_setNextWrap(uint32_t longPeriod, uint32_t boundary)
+{
+    SysTickPeriodSet((SysTickValueGet() + boundary + 1U) - longPeriod);
+    NVIC_ST_CURRENT_R = 0U;         /* Any write reloads on the next clock */
+    while (NVIC_ST_CURRENT_R == 0U)
+    {
+    }
+    SysTickPeriodSet(g_cyclesPerMs);    /* Taken at the following wrap */
+}
+
+static boolean prv_tickPending(void)
+{
+    return ((NVIC_INT_CTRL_R & NVIC_INT_CTRL_PEND_SYST) != 0U) ? TRUE : FALSE;
+}
+
+/* Cycles since MCAL_SysTick_Init() modulo 2^32, ticks still pending
+ * included; differences are exact up to ~268 s at 16 MHz. Valid with the
+ * 1 ms reload in place: in thread code with interrupts masked, or in the
+ * tick callback outside a sleep. */
+static uint32_t prv_stamp(void)
+{
+    uint32_t ms    = g_systickMs;
+    uint32_t value = SysTickValueGet();
+
+    /* Counter first: if the tick pended after the read, value is still
+     * from the ms before it; if before, read again past the wrap */
+    if (prv_tickPending())
+    {
+        ms   += g_tickStepMs;
+        value = SysTickValueGet();
+    }
+
+    return (ms * g_cyclesPerMs) + (NVIC_ST_RELOAD_R - value);
+}
+
+/* Close the busy stretch that ends with this sleep (interrupts masked) */
+static void prv_busyEnd(void)
+{
+    uint32_t busy = prv_stamp() - g_wakeStamp;
+
+    if (busy > g_busyMaxCycles)
+    {
+        g_busyMaxCycles = busy;
+    }
+    g_asleep = TRUE;
+}
+
+/* Start the next busy stretch on the way out of a sleep (masked) */
+static void prv_busyStart(void)
+{
+    g_wakeStamp = prv_stamp();
+    g_asleep    = FALSE;
+}
 
 /*======================================================================
  *  SysTick ISR
@@ -31,12 +145,17 @@ static SysTick_CallbackType    g_systickCb   = (SysTick_CallbackType)0;
 
 void systick_ISR(void)
 {
-    g_systickMs++;
+    uint32_t ms    = g_tickStepMs;
+    boolean  slept = g_tickSlept;
 
-    if (g_systickCb != (SysTick_CallbackType)0)
-    {
-        g_systickCb();
-    }
+    g_tickStepMs = 1U;
+    g_tickSlept  = FALSE;
+
+    /* Ticks slept through are not part of the busy stretch that began
+     * when MCAL_SysTick_Sleep() returned */
+    g_asleep = slept;
+    prv_advance(ms, slept);
+    g_asleep = FALSE;
 }
 
 /*======================================================================
@@ -55,13 +174,20 @@ void MCAL_SysTick_Init(void)
 
     /* Reset counter */
     g_systickMs = 0U;
+    g_cyclesPerMs = g_sysClkHz / 1000U;
+    g_tickStepMs = 1U;
+    g_tickSlept = FALSE;
+    g_idleCycles = 0U;
+    g_wakeStamp = 0U;
+    g_busyMaxCycles = 0U;
+    g_asleep = FALSE;
 
     /* Configure SysTick for 1 ms period */
     SysTickDisable();
     SysTickIntDisable();
 
     /* Period = clock / 1000 for 1 ms tick */
-    SysTickPeriodSet(g_sysClkHz / 1000U);
+    SysTickPeriodSet(g_cyclesPerMs);
 
     /*
      * We DON'T call SysTickIntRegister() because the startup file
@@ -97,36 +223,186 @@ void MCAL_SysTick_DelayMs(uint32_t ms)
 {
     uint32_t start = g_systickMs;
 
-    /* Wrap-around safe: subtraction in unsigned arithmetic */
+    /* Wrap-around safe: subtraction in unsigned arithmetic. Sleeps
+     * between ticks; every interrupt (at least the next tick) wakes it. */
     while ((g_systickMs - start) < ms)
     {
-        /* busy wait */
+        MCAL_SysTick_Sleep(1U);
+    }
+}
+
+uint32_t MCAL_SysTick_GetClockHz(void)
+{
+    return g_sysClkHz;
+}
+
+void MCAL_SysTick_Sleep(uint32_t maxMs)
+{
+    uint32_t primask;
+    uint32_t before;
+    uint32_t now;
+    uint32_t longPeriod;
+    uint32_t elapsed;
+    uint32_t left;
+    uint32_t elapsedMs;
+
+    /* Masked: a waking interrupt stays pending (WFI still returns) until
+     * the time asleep has been accounted */
+    primask = CPUcpsid();
+
+    /* Counter before the pending flag: a wrap just ahead of the read
+     * shows as a pending tick, and before is never from the next ms */
+    before = SysTickValueGet();     /* Cycles to the end of this ms */
+
+    if (prv_tickPending() || (g_cyclesPerMs == 0U))
+    {
+        /* A tick is already due: nothing to sleep through */
+        if (primask == 0U)
+        {
+            (void)CPUcpsie();
+        }
+        return;
+    }
+
+    if (maxMs > ((SYSTICK_MAX_PERIOD / g_cyclesPerMs) + 1U))
+    {
+        maxMs = (SYSTICK_MAX_PERIOD / g_cyclesPerMs) + 1U;
+    }
+
+    prv_busyEnd();
+
+    if ((maxMs < 2U) || (before < SYSTICK_SLEEP_GUARD_CYCLES))
+    {
+        /* Plain: until the next tick or any earlier interrupt */
+        CPUwfi();
+        now = SysTickValueGet();
+        g_idleCycles += prv_tickPending() ? (before + (NVIC_ST_RELOAD_R - now))
+                                          : (before - now);
+    }
+    else
+    {
+        /* Tickless. The current ms runs out as usual, then the counter
+         * reloads one long period of maxMs - 1 ms. */
+        longPeriod = (maxMs - 1U) * g_cyclesPerMs;
+        SysTickPeriodSet(longPeriod);
+
+        CPUwfi();
+        now = SysTickValueGet();
+
+        if (!prv_tickPending() && (now >= SYSTICK_SLEEP_GUARD_CYCLES))
+        {
+            /* Woken early, still in the first ms: nothing skipped */
+            SysTickPeriodSet(g_cyclesPerMs);
+            g_idleCycles += before - now;
+        }
+        else
+        {
+            while (!prv_tickPending())
+            {
+            }
+
+            /* First ms over and the long period running (the counter
+             * reloads one clock after reaching 0): count the tick here,
+             * and put the 1 ms reload back for when the period ends */
+            while (SysTickValueGet() == 0U)
+            {
+            }
+            SysTickPeriodSet(g_cyclesPerMs);
+            NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTCLR;
+            g_idleCycles += before;
+            prv_advance(1U, FALSE);
+            g_tickStepMs = maxMs - 1U;
+            g_tickSlept  = TRUE;
+
+            CPUwfi();
+            now = SysTickValueGet();
+
+            if (!prv_tickPending() && (now >= SYSTICK_SLEEP_GUARD_CYCLES))
+            {
+                /* Woken early: count the whole ms slept and move the next
+                 * tick to the next ms boundary */
+                elapsed   = (longPeriod - 1U) - now;
+                elapsedMs = elapsed / g_cyclesPerMs;
+                left      = g_cyclesPerMs - (elapsed % g_cyclesPerMs);
+                if (left < SYSTICK_SLEEP_GUARD_CYCLES)
+                {
+                    /* Too close to re-time: count that boundary now */
+                    elapsedMs++;
+                    left += g_cyclesPerMs;
+                }
+
+                g_tickStepMs = 1U;
+                g_tickSlept  = FALSE;
+                prv_setNextWrap(longPeriod, elapsed + left);
+                prv_advance(elapsedMs, TRUE);
+                if (elapsed > (elapsedMs * g_cyclesPerMs))
+                {
+                    /* The part of the current ms already slept */
+                    g_idleCycles += elapsed - (elapsedMs * g_cyclesPerMs);
+                }
+            }
+            else
+            {
+                /* Whole period slept; systick_ISR() counts its ticks and
+                 * their idle time, this adds the part of the next ms */
+                while (!prv_tickPending())
+                {
+                }
+                now = SysTickValueGet();
+                g_idleCycles += NVIC_ST_RELOAD_R - now;
+            }
+        }
+    }
+
+    prv_busyStart();
+
+    if (primask == 0U)
+    {
+        (void)CPUcpsie();
     }
 }
 
-void MCAL_SysTick_DelayUs(uint32_t us)
+uint32_t MCAL_SysTick_GetIdleMs(void)
 {
-    /*
-     * For microsecond delays, we use a calibrated busy-wait loop.
-     * This is more accurate than trying to use the 1ms SysTick counter.
-     * 
-     * Assumes ~3 cycles per loop iteration (typical for simple while loop).
-     * Adjust CYCLES_PER_LOOP if needed for your specific compiler/optimization.
-     */
-    #define CYCLES_PER_LOOP 3U
-    
-    uint32_t cycles = (g_sysClkHz / 1000000U) * us;  /* Total cycles needed */
-    uint32_t loops = cycles / CYCLES_PER_LOOP;
-    
-    /* Simple busy-wait loop */
-    volatile uint32_t i;
-    for (i = 0; i < loops; i++)
+    uint32_t primask;
+    uint64_t idle;
+
+    /* Also written by systick_ISR() after a long sleep */
+    primask = CPUcpsid();
+    idle    = g_idleCycles;
+    if (primask == 0U)
     {
-        /* Empty loop body - just counting */
+        (void)CPUcpsie();
     }
+
+    return (g_cyclesPerMs != 0U) ? (uint32_t)(idle / g_cyclesPerMs) : 0U;
 }
 
-uint32_t MCAL_SysTick_GetClockHz(void)
+uint32_t MCAL_SysTick_TakeBusyMaxCycles(void)
 {
-    return g_sysClkHz;
+    uint32_t primask;
+    uint32_t busyMax;
+    uint32_t ongoing;
+
+    primask = CPUcpsid();
+
+    busyMax = g_busyMaxCycles;
+    g_busyMaxCycles = 0U;
+
+    /* A stretch still running counts with its length so far */
+    if (!g_asleep && (g_cyclesPerMs != 0U))
+    {
+        ongoing = prv_stamp() - g_wakeStamp;
+        if (ongoing > busyMax)
+        {
+            busyMax = ongoing;
+        }
+    }
+
+    if (primask == 0U)
+    {
+        (void)CPUcpsie();
+    }
+
+    return busyMax;
 }
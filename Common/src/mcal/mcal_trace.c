@@ -0,0 +1,38 @@
+/*============================================================================
+ *  Module      : MCAL TRACE
+ *  File Name   : mcal_trace.c
+ *  Description : Event hook the MCAL drivers record trace events through
+ *===========================================================================*/
+
+#include "mcal/mcal_trace.h"
+
+#if (TRACE_ENABLE != 0)
+
+#include <stddef.h>
+
+/*======================================================================
+ *  Private data
+ *====================================================================*/
+
+static volatile MCAL_TraceHookType g_McalTrace_Hook = NULL;
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void MCAL_Trace_SetHook(MCAL_TraceHookType hook)
+{
+    g_McalTrace_Hook = hook;
+}
+
+void MCAL_Trace_Event(uint8_t event, uint8_t arg8, uint16_t arg16)
+{
+    MCAL_TraceHookType hook = g_McalTrace_Hook;
+
+    if (hook != NULL)
+    {
+        hook(event, arg8, arg16);
+    }
+}
+
+#endif /* TRACE_ENABLE */
@@ -5,6 +5,510 @@
  *===========================================================================*/
 
 #include "mcal/mcal_uart.h"
+#include "mcal/mcal_udma.h"
+#include "mcal/mcal_systick.h"
+#include "mcal/mcal_trace.h"
+
+#include <stddef.h>
+#include "Types.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_uart.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/systick.h"
+
+/*======================================================================
+ *  Hardware mapping
+ *
+ *  Maps the UART index (UART0 = 0 ... UART7 = 7) to its base address,
+ *  NVIC interrupt number and uDMA RX/TX channel assignments.
+ *====================================================================*/
+typedef struct
+{
+	uint32_t base;
+	uint32_t intNumber;
+	uint32_t rxDmaAssign;
+	uint32_t txDmaAssign;
+} Uart_HwMapType;
+
+static const Uart_HwMapType g_Uart_HwMap[UART_NUM_CHANNELS] = {
+	{ UART0_BASE, INT_UART0, UDMA_CH8_UART0RX,  UDMA_CH9_UART0TX  },
+	{ UART1_BASE, INT_UART1, UDMA_CH22_UART1RX, UDMA_CH23_UART1TX },
+	{ UART2_BASE, INT_UART2, UDMA_CH12_UART2RX, UDMA_CH13_UART2TX },
+	{ UART3_BASE, INT_UART3, UDMA_CH16_UART3RX, UDMA_CH17_UART3TX },
+	{ UART4_BASE, INT_UART4, UDMA_CH18_UART4RX, UDMA_CH19_UART4TX },
+	{ UART5_BASE, INT_UART5, UDMA_CH6_UART5RX,  UDMA_CH7_UART5TX  },
+	{ UART6_BASE, INT_UART6, UDMA_CH10_UART6RX, UDMA_CH11_UART6TX },
+	{ UART7_BASE, INT_UART7, UDMA_CH20_UART7RX, UDMA_CH21_UART7TX }
+};
+
+/* uDMA channel number is the low 5 bits of the assignment value */
+#define UART_DMA_CHANNEL(assign)   ((uint8_t)((assign) & 0x1FU))
+
+/*======================================================================
+ *  Per-channel RX / TX rings
+ *
+ *  Single producer / single consumer rings. Head and tail are
+ *  free-running counters; the fill level is (head - tail) and the slot
+ *  is (counter & mask).
+ *
+ *  RX: the ISR writes rxHead, the application writes rxTail.
+ *  TX: the application writes txHead; txTail is advanced either by the
+ *      ISR or by prv_txKick() while the UART interrupt is masked in the
+ *      NVIC, so the two never run at the same time. While the TX
+ *      interrupt is armed the ISR will see a newly queued byte by itself,
+ *      so the application only kicks when it is not.
+ *
+ *  Bulk transfers bypass the rings through uDMA. Buffers longer than
+ *  one basic-mode transfer are split into chunks that the ISR chains.
+ *  While a TX bulk transfer is active the TX ring is held back (so byte
+ *  order is preserved); while an RX bulk transfer is active the RX
+ *  interrupts are masked so the ISR does not compete with the uDMA.
+ *====================================================================*/
+typedef struct
+{
+	volatile uint8_t  *rxBuf;   /* NULL when the channel is polled */
+	uint16_t           rxMask;  /* rxBufferSize - 1 */
+	volatile uint16_t  rxHead;  /* Next slot written by the ISR */
+	volatile uint16_t  rxTail;  /* Next slot read by the application */
+	volatile uint32_t  rxLastTickMs;  /* MCAL_SysTick tick of the last ISR that took bytes */
+	UART_StatsType     stats;
+
+	volatile uint8_t  *txBuf;   /* NULL when TX is blocking */
+	uint16_t           txMask;  /* txBufferSize - 1 */
+	volatile uint16_t  txHead;  /* Next slot written by the application */
+	volatile uint16_t  txTail;  /* Next slot moved into the FIFO */
+	volatile uint8_t   txArmed; /* TX interrupt enabled: the ISR drains the ring */
+
+	const uint8_t     *dmaTxNext;     /* Start of the next TX chunk */
+	volatile uint32_t  dmaTxLeft;     /* Bytes not yet handed to the uDMA */
+	volatile uint8_t   dmaTxActive;
+	uint8_t           *dmaRxNext;     /* Start of the next RX chunk */
+	volatile uint32_t  dmaRxLeft;
+	volatile uint8_t   dmaRxActive;
+	uint8_t            dmaAssigned;   /* Channels routed to this UART */
+
+	uint8_t            flowControl;   /* UART_FLOW_* */
+	volatile uint8_t   rxThrottled;   /* RTS/CTS: ISR left the FIFO undrained */
+	volatile uint8_t   xoffSent;      /* XON/XOFF: peer told to stop */
+	volatile uint8_t   txPaused;      /* XON/XOFF: peer told us to stop */
+	volatile uint8_t   txCtrl;        /* XON/XOFF char to send ahead of the ring, 0 = none */
+} Uart_ChannelCtxType;
+
+static Uart_ChannelCtxType g_Uart_Ctx[UART_NUM_CHANNELS];
+
+/*======================================================================
+ *  Local helpers
+ *====================================================================*/
+
+/**
+ * @brief Map a UART base address to its channel context, or NULL if unknown.
+ *
+ * The UART blocks sit 4 KB apart from UART0_BASE, so the channel is the
+ * offset's page number; an address below UART0_BASE wraps past the bound,
+ * one inside a block fails the base compare.
+ */
+static Uart_ChannelCtxType* prv_getCtx(uint32_t uartBase)
+{
+	uint32_t ch = (uartBase - UART0_BASE) >> 12;
+
+	if ((ch < UART_NUM_CHANNELS) && (g_Uart_HwMap[ch].base == uartBase))
+	{
+		return &g_Uart_Ctx[ch];
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief A ring is usable if it has storage and a power-of-two size >= 2.
+ */
+static uint8_t prv_isValidRing(const uint8_t *buf, uint16_t size)
+{
+	return ((buf != NULL) && (size >= 2U) && ((size & (size - 1U)) == 0U)) ? 1U : 0U;
+}
+
+/**
+ * @brief Number of bytes waiting in the RX ring.
+ */
+static uint16_t prv_rxCount(const Uart_ChannelCtxType *ctx)
+{
+	return (uint16_t)(ctx->rxHead - ctx->rxTail);
+}
+
+/**
+ * @brief Number of bytes waiting in the TX ring.
+ */
+static uint16_t prv_txCount(const Uart_ChannelCtxType *ctx)
+{
+	return (uint16_t)(ctx->txHead - ctx->txTail);
+}
+
+/**
+ * @brief Count one received character and its error class.
+ *
+ * raw is the full data register value, status bits included.
+ */
+static void prv_rxAccount(Uart_ChannelCtxType *ctx, uint32_t raw)
+{
+	ctx->stats.rxBytes++;
+
+	if ((raw & (UART_DR_OE | UART_DR_BE | UART_DR_PE | UART_DR_FE)) == 0U)
+	{
+		return;
+	}
+	if ((raw & UART_DR_OE) != 0U)
+	{
+		/* FIFO was full when a new character arrived */
+		ctx->stats.rxFifoOverruns++;
+	}
+	if ((raw & UART_DR_BE) != 0U)
+	{
+		/* A break also sets FE; count it once, as a break */
+		ctx->stats.rxBreaks++;
+	}
+	else if ((raw & UART_DR_FE) != 0U)
+	{
+		ctx->stats.rxFramingErrors++;
+	}
+	if ((raw & UART_DR_PE) != 0U)
+	{
+		ctx->stats.rxParityErrors++;
+	}
+}
+
+/**
+ * @brief Move a pending XON/XOFF and then queued TX bytes into the
+ *        hardware FIFO until it is full (or the peer sent XOFF).
+ *
+ * Caller guarantees the UART ISR cannot run concurrently.
+ */
+static void prv_txFill(Uart_ChannelCtxType *ctx, uint32_t base)
+{
+	if ((ctx->txCtrl != 0U) && UARTSpaceAvail(base))
+	{
+		UARTCharPutNonBlocking(base, ctx->txCtrl);
+		ctx->txCtrl = 0U;
+		ctx->stats.txBytes++;
+	}
+
+	while ((ctx->txBuf != NULL) && !ctx->txPaused &&
+	       (prv_txCount(ctx) != 0U) && UARTSpaceAvail(base))
+	{
+		UARTCharPutNonBlocking(base, ctx->txBuf[ctx->txTail & ctx->txMask]);
+		ctx->txTail++;
+		ctx->stats.txBytes++;
+	}
+}
+
+/**
+ * @brief Fill the FIFO and leave the TX interrupt enabled only while
+ *        something can still be sent.
+ *
+ * The FIFO is full whenever the interrupt stays enabled, so the next
+ * "FIFO below 1/2" transition raises the interrupt that resumes draining.
+ */
+static void prv_txService(Uart_ChannelCtxType *ctx, uint32_t base)
+{
+	prv_txFill(ctx, base);
+
+	if ((ctx->txCtrl != 0U) || (!ctx->txPaused && (prv_txCount(ctx) != 0U)))
+	{
+		UARTIntEnable(base, UART_INT_TX);
+		ctx->txArmed = 1U;
+	}
+	else
+	{
+		UARTIntDisable(base, UART_INT_TX);
+		ctx->txArmed = 0U;
+	}
+}
+
+/**
+ * @brief Start (or continue) draining the TX ring from thread context.
+ *
+ * The UART interrupt is masked in the NVIC for the few cycles the FIFO is
+ * topped up, because the RX path of the ISR may also touch the TX side
+ * (XON/XOFF).
+ */
+static void prv_txKick(Uart_ChannelCtxType *ctx, uint32_t base)
+{
+	uint32_t intNumber = g_Uart_HwMap[ctx - g_Uart_Ctx].intNumber;
+
+	if (ctx->dmaTxActive)
+	{
+		/* Queued bytes follow the bulk transfer; the ISR resumes them */
+		return;
+	}
+
+	IntDisable(intNumber);
+	prv_txService(ctx, base);
+	IntEnable(intNumber);
+}
+
+/**
+ * @brief Release RX flow control once the application has made room.
+ *
+ * Called from thread context after bytes were taken from the RX ring.
+ */
+static void prv_rxFlowResume(Uart_ChannelCtxType *ctx, uint32_t base)
+{
+	uint16_t lowMark = (uint16_t)((ctx->rxMask + 1U) / 4U);
+
+	if (ctx->rxThrottled && (prv_rxCount(ctx) <= lowMark))
+	{
+		/* Let the ISR drain the FIFO again; RTS rises once it empties.
+		 * Pend the interrupt since the RX trigger will not fire again. */
+		ctx->rxThrottled = 0U;
+		UARTIntEnable(base, UART_INT_RX | UART_INT_RT);
+		IntPendSet(g_Uart_HwMap[ctx - g_Uart_Ctx].intNumber);
+	}
+
+	if (ctx->xoffSent && (prv_rxCount(ctx) <= lowMark))
+	{
+		ctx->xoffSent = 0U;
+		ctx->txCtrl   = UART_XON_CHAR;
+		prv_txKick(ctx, base);
+	}
+}
+
+/**
+ * @brief Hand the next chunk of a bulk transfer to the uDMA.
+ */
+static void prv_dmaStartChunk(Uart_ChannelCtxType *ctx, uint8_t ch, uint8_t isTx)
+{
+	uint32_t base = g_Uart_HwMap[ch].base;
+	uint32_t left = isTx ? ctx->dmaTxLeft : ctx->dmaRxLeft;
+	uint16_t n    = (left > UDMA_MAX_TRANSFER_ITEMS) ? (uint16_t)UDMA_MAX_TRANSFER_ITEMS
+	                                                 : (uint16_t)left;
+
+	if (isTx)
+	{
+		(void)MCAL_UDMA_StartTransfer(UART_DMA_CHANNEL(g_Uart_HwMap[ch].txDmaAssign),
+		                              UDMA_DIR_MEM_TO_PERIPH,
+		                              (volatile void *)(base + UART_O_DR),
+		                              (void *)ctx->dmaTxNext, n);
+		ctx->dmaTxNext += n;
+		ctx->dmaTxLeft -= n;
+		ctx->stats.txBytes += n;
+	}
+	else
+	{
+		(void)MCAL_UDMA_StartTransfer(UART_DMA_CHANNEL(g_Uart_HwMap[ch].rxDmaAssign),
+		                              UDMA_DIR_PERIPH_TO_MEM,
+		                              (volatile void *)(base + UART_O_DR),
+		                              ctx->dmaRxNext, n);
+		ctx->dmaRxNext += n;
+		ctx->dmaRxLeft -= n;
+		ctx->stats.rxBytes += n;
+	}
+}
+
+/**
+ * @brief Route this UART's uDMA channels on first use.
+ */
+static void prv_dmaAssign(Uart_ChannelCtxType *ctx, uint8_t ch)
+{
+	if (!ctx->dmaAssigned)
+	{
+		MCAL_UDMA_Init();
+		MCAL_UDMA_AssignChannel(g_Uart_HwMap[ch].rxDmaAssign);
+		MCAL_UDMA_AssignChannel(g_Uart_HwMap[ch].txDmaAssign);
+		ctx->dmaAssigned = 1U;
+	}
+}
+
+/**
+ * @brief Chain or finish bulk transfers whose current chunk completed.
+ *
+ * uDMA completion on a peripheral channel is signalled on the
+ * peripheral's own interrupt, so this runs from the UART ISR.
+ */
+static void prv_dmaService(Uart_ChannelCtxType *ctx, uint8_t ch)
+{
+	uint32_t base = g_Uart_HwMap[ch].base;
+
+	if (ctx->dmaTxActive &&
+	    MCAL_UDMA_PollComplete(UART_DMA_CHANNEL(g_Uart_HwMap[ch].txDmaAssign)))
+	{
+		if (ctx->dmaTxLeft != 0U)
+		{
+			prv_dmaStartChunk(ctx, ch, 1U);
+		}
+		else
+		{
+			UARTDMADisable(base, UART_DMA_TX);
+			ctx->dmaTxActive = 0U;
+
+			/* Resume anything queued behind the bulk transfer */
+			prv_txService(ctx, base);
+		}
+	}
+
+	if (ctx->dmaRxActive &&
+	    MCAL_UDMA_PollComplete(UART_DMA_CHANNEL(g_Uart_HwMap[ch].rxDmaAssign)))
+	{
+		if (ctx->dmaRxLeft != 0U)
+		{
+			prv_dmaStartChunk(ctx, ch, 0U);
+		}
+		else
+		{
+			UARTDMADisable(base, UART_DMA_RX);
+			ctx->dmaRxActive = 0U;
+
+			if (ctx->rxBuf != NULL)
+			{
+				UARTIntEnable(base, UART_INT_RX | UART_INT_RT);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Common interrupt body: drain the RX FIFO into the ring,
+ *        refill the TX FIFO from the TX ring and chain bulk transfers.
+ */
+static void prv_uartService(Uart_ChannelCtxType *ctx, uint8_t ch)
+{
+	uint32_t             base = g_Uart_HwMap[ch].base;
+	uint32_t             status;
+	int32_t              raw;
+	uint16_t             burst = 0U;
+	uint16_t             level;
+
+	status = UARTIntStatus(base, true);
+	UARTIntClear(base, status);
+
+	if (ctx->dmaTxActive || ctx->dmaRxActive)
+	{
+		prv_dmaService(ctx, ch);
+	}
+
+	if (((status & UART_INT_TX) != 0U) && !ctx->dmaTxActive)
+	{
+		prv_txService(ctx, base);
+	}
+
+	if ((ctx->rxBuf == NULL) || ctx->dmaRxActive || ctx->rxThrottled)
+	{
+		return;
+	}
+
+	/* Empty the FIFO completely; RX fires at 1/2 full, RT on idle */
+	while (1)
+	{
+		if ((ctx->flowControl == UART_FLOW_RTS_CTS) && (prv_rxCount(ctx) > ctx->rxMask))
+		{
+			/* Ring full: leave the rest in the FIFO so RTS holds the peer
+			 * off; prv_rxFlowResume() restarts draining */
+			UARTIntDisable(base, UART_INT_RX | UART_INT_RT);
+			ctx->rxThrottled = 1U;
+			ctx->stats.rxThrottles++;
+			break;
+		}
+
+		if ((raw = UARTCharGetNonBlocking(base)) == -1)
+		{
+			break;
+		}
+
+		prv_rxAccount(ctx, (uint32_t)raw);
+		burst++;
+
+		if (ctx->flowControl == UART_FLOW_XON_XOFF)
+		{
+			if ((uint8_t)raw == UART_XOFF_CHAR)
+			{
+				ctx->txPaused = 1U;
+				continue;
+			}
+			if ((uint8_t)raw == UART_XON_CHAR)
+			{
+				ctx->txPaused = 0U;
+				if (!ctx->dmaTxActive)
+				{
+					prv_txService(ctx, base);
+				}
+				continue;
+			}
+		}
+
+		if (prv_rxCount(ctx) <= ctx->rxMask)
+		{
+			ctx->rxBuf[ctx->rxHead & ctx->rxMask] = (uint8_t)raw;
+			ctx->rxHead++;
+
+			level = prv_rxCount(ctx);
+			if (level > ctx->stats.rxHighWater)
+			{
+				ctx->stats.rxHighWater = level;
+			}
+		}
+		else
+		{
+			ctx->stats.rxRingOverruns++;
+		}
+
+		/* Ask the peer to stop at 3/4 full, leaving room for bytes in flight */
+		if ((ctx->flowControl == UART_FLOW_XON_XOFF) && !ctx->xoffSent &&
+		    (prv_rxCount(ctx) >= (uint16_t)(ctx->rxMask - (ctx->rxMask / 4U))))
+		{
+			ctx->xoffSent = 1U;
+			ctx->txCtrl   = UART_XOFF_CHAR;
+			ctx->stats.rxThrottles++;
+			if (!ctx->dmaTxActive)
+			{
+				prv_txService(ctx, base);
+			}
+		}
+	}
+
+	if (burst > ctx->stats.rxBurstMax)
+	{
+		ctx->stats.rxBurstMax = burst;
+	}
+
+	/* When the newest byte in the ring arrived, however late it is read */
+	if (burst != 0U)
+	{
+		ctx->rxLastTickMs = MCAL_SysTick_GetTickMs();
+	}
+}
+
+/**
+ * @brief Interrupt entry: service the UART and record how long it took.
+ *
+ * SysTick counts down and reloads every millisecond; one wrap at most
+ * can happen inside a handler this short.
+ */
+static void prv_uartIsr(uint8_t ch)
+{
+	Uart_ChannelCtxType *ctx   = &g_Uart_Ctx[ch];
+	uint32_t             start = SysTickValueGet();
+	uint32_t             end;
+	uint32_t             cycles;
+	boolean              traced = (((MCAL_TRACE_UART_ISR_MASK >> ch) & 1U) != 0U) ? TRUE : FALSE;
+
+	if (traced)
+	{
+		MCAL_TRACE(MCAL_TRACE_EVT_ISR_ENTER, ch, 0U);
+	}
+
+	prv_uartService(ctx, ch);
+
+	if (traced)
+	{
+		MCAL_TRACE(MCAL_TRACE_EVT_ISR_EXIT, ch, 0U);
+	}
+
+	end    = SysTickValueGet();
+	cycles = (start >= end) ? (start - end) : (start + SysTickPeriodGet() - end);
+	if (cycles > ctx->stats.isrMaxCycles)
+	{
+		ctx->stats.isrMaxCycles = cycles;
+	}
+}
 
 /*======================================================================
  *  API implementations
@@ -44,24 +548,163 @@ void UART_init(const UART_ConfigType *cfg)
 	/* Make sure FIFOs and UART are enabled */
 	UARTFIFOEnable(cfg->uartBase);
 	UARTEnable(cfg->uartBase);
+
+	/* Optional interrupt-driven receive / transmit through the caller's rings */
+	Uart_ChannelCtxType *ctx = prv_getCtx(cfg->uartBase);
+	if (ctx == NULL)
+	{
+		return;
+	}
+
+	uint8_t ch = (uint8_t)(ctx - g_Uart_Ctx);
+	IntDisable(g_Uart_HwMap[ch].intNumber);
+	UARTIntDisable(cfg->uartBase, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+
+	ctx->rxBuf = NULL;
+	ctx->txBuf = NULL;
+	ctx->txArmed = 0U;
+	UART_ResetStats(cfg->uartBase);
+	ctx->rxThrottled = 0U;
+	ctx->xoffSent    = 0U;
+	ctx->txPaused    = 0U;
+	ctx->txCtrl      = 0U;
+	ctx->flowControl = UART_FLOW_NONE;
+
+	if (prv_isValidRing(cfg->rxBuffer, cfg->rxBufferSize))
+	{
+		ctx->rxBuf  = cfg->rxBuffer;
+		ctx->rxMask = (uint16_t)(cfg->rxBufferSize - 1U);
+		ctx->rxHead = 0U;
+		ctx->rxTail = 0U;
+		ctx->rxLastTickMs = 0U;
+
+		/* Flow control only makes sense with a ring to protect */
+		ctx->flowControl = cfg->flowControl;
+	}
+
+	/* UART1 is the only TM4C123 UART with RTS/CTS */
+	if ((ctx->flowControl == UART_FLOW_RTS_CTS) && (cfg->uartBase == UART1_BASE))
+	{
+		UARTFlowControlSet(cfg->uartBase, UART_FLOWCONTROL_TX | UART_FLOWCONTROL_RX);
+	}
+	else
+	{
+		if (ctx->flowControl == UART_FLOW_RTS_CTS)
+		{
+			ctx->flowControl = UART_FLOW_NONE;
+		}
+		UARTFlowControlSet(cfg->uartBase, UART_FLOWCONTROL_NONE);
+	}
+
+	if (prv_isValidRing(cfg->txBuffer, cfg->txBufferSize))
+	{
+		ctx->txBuf  = cfg->txBuffer;
+		ctx->txMask = (uint16_t)(cfg->txBufferSize - 1U);
+		ctx->txHead = 0U;
+		ctx->txTail = 0U;
+	}
+
+	if ((ctx->rxBuf != NULL) || (ctx->txBuf != NULL))
+	{
+		/* RX interrupt at half-full FIFO (plus RX timeout for trailing bytes),
+		 * TX interrupt when the FIFO drains below half */
+		UARTFIFOLevelSet(cfg->uartBase, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+		UARTTxIntModeSet(cfg->uartBase, UART_TXINT_MODE_FIFO);
+		UARTIntClear(cfg->uartBase, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+
+		if (ctx->rxBuf != NULL)
+		{
+			UARTIntEnable(cfg->uartBase, UART_INT_RX | UART_INT_RT);
+		}
+
+		/* TX interrupt is enabled on demand by prv_txKick() */
+		IntEnable(g_Uart_HwMap[ch].intNumber);
+	}
 }
 
 void sendByte(uint32_t uartBase, uint8_t data)
 {
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+	uint16_t             level;
+
+	if ((ctx != NULL) && (ctx->txBuf != NULL))
+	{
+		/* Nothing queued and nothing that could drain the ring meanwhile
+		 * (TX interrupt, uDMA completion, XON/XOFF): straight into the
+		 * FIFO while it has room, at the cost of the blocking path */
+		if (!ctx->txArmed && (ctx->txHead == ctx->txTail) && !ctx->dmaTxActive &&
+		    (ctx->flowControl != UART_FLOW_XON_XOFF) && UARTSpaceAvail(uartBase))
+		{
+			UARTCharPutNonBlocking(uartBase, data);
+			ctx->stats.txBytes++;
+			return;
+		}
+
+		/* Only blocks when the ring is full; the ISR keeps draining it */
+		while (prv_txCount(ctx) > ctx->txMask) { }
+
+		ctx->txBuf[ctx->txHead & ctx->txMask] = data;
+		ctx->txHead++;
+
+		/* Reads txTail once; a racing ISR can only make this lower */
+		level = prv_txCount(ctx);
+		if (level > ctx->stats.txHighWater)
+		{
+			ctx->stats.txHighWater = level;
+		}
+
+		/* Read after the byte is published: an ISR that disarmed before
+		 * that did not see it, one that runs after it will */
+		if (!ctx->txArmed)
+		{
+			prv_txKick(ctx, uartBase);
+		}
+		return;
+	}
+
 	/* Wait until space is available */
 	while (!UARTSpaceAvail(uartBase)) { }
 
 	/* Send the byte */
 	UARTCharPut(uartBase, data);
+	if (ctx != NULL)
+	{
+		ctx->stats.txBytes++;
+	}
 }
 
 uint8_t receiveByte(uint32_t uartBase)
 {
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+	int32_t              raw;
+
+	if ((ctx != NULL) && (ctx->rxBuf != NULL))
+	{
+		uint8_t data;
+
+		/* Wait until the ISR has queued a byte */
+		while (prv_rxCount(ctx) == 0U) { }
+
+		data = ctx->rxBuf[ctx->rxTail & ctx->rxMask];
+		ctx->rxTail++;
+
+		if (ctx->rxThrottled || ctx->xoffSent)
+		{
+			prv_rxFlowResume(ctx, uartBase);
+		}
+		return data;
+	}
+
 	/* Wait until data is available */
 	while (!UARTCharsAvail(uartBase)) { }
 
-	/* Read the byte */
-	return (uint8_t)UARTCharGet(uartBase);
+	/* Read the byte, with its status bits for the counters */
+	raw = UARTCharGet(uartBase);
+	if (ctx != NULL)
+	{
+		prv_rxAccount(ctx, (uint32_t)raw);
+	}
+	return (uint8_t)raw;
 }
 
 void sendString(uint32_t uartBase, const char *str)
@@ -99,7 +742,262 @@ uint32_t receiveString(uint32_t uartBase, char *buffer, uint32_t maxLen)
 
 uint8_t isDataAvailable(uint32_t uartBase)
 {
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+
+	if ((ctx != NULL) && (ctx->rxBuf != NULL))
+	{
+		return (prv_rxCount(ctx) != 0U) ? 1U : 0U;
+	}
+
 	/* Use TivaWare function to check if data is available */
 	return UARTCharsAvail(uartBase) ? 1U : 0U;
 }
 
+uint16_t UART_GetTxPending(uint32_t uartBase)
+{
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+
+	if ((ctx == NULL) || (ctx->txBuf == NULL))
+	{
+		return 0U;
+	}
+
+	return prv_txCount(ctx);
+}
+
+uint8_t UART_IsTxIdle(uint32_t uartBase)
+{
+	if ((UART_GetTxPending(uartBase) != 0U) || UART_IsDmaTxBusy(uartBase))
+	{
+		return 0U;
+	}
+
+	/* BUSY stays set until the last stop bit has left the shift register */
+	return UARTBusy(uartBase) ? 0U : 1U;
+}
+
+uint8_t UART_SetBaudRate(uint32_t uartBase, uint32_t clockFreq, uint32_t baudRate)
+{
+	uint32_t oldBaud;
+	uint32_t config;
+
+	if ((baudRate == 0U) || (baudRate > (clockFreq / 8U)))
+	{
+		return UART_ERROR_INVALID;
+	}
+
+	/* Keep word length, parity and stop bits as UART_init() set them */
+	UARTConfigGetExpClk(uartBase, clockFreq, &oldBaud, &config);
+
+	/* Disables, reprograms (HSE above clock/16) and re-enables with FIFOs */
+	UARTConfigSetExpClk(uartBase, clockFreq, baudRate, config);
+
+	return UART_SUCCESS;
+}
+
+uint8_t UART_StartDmaTx(uint32_t uartBase, const uint8_t *data, uint32_t len)
+{
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+	uint8_t              ch;
+
+	if ((ctx == NULL) || (data == NULL) || (len == 0U))
+	{
+		return UART_ERROR_INVALID;
+	}
+
+	/* Ring bytes must leave first, and only one bulk transfer at a time */
+	if (ctx->dmaTxActive || (prv_txCount(ctx) != 0U))
+	{
+		return UART_ERROR_BUSY;
+	}
+
+	ch = (uint8_t)(ctx - g_Uart_Ctx);
+	prv_dmaAssign(ctx, ch);
+
+	/* Mark active before the TX interrupt could observe the ring again */
+	ctx->dmaTxNext   = data;
+	ctx->dmaTxLeft   = len;
+	ctx->dmaTxActive = 1U;
+
+	UARTIntDisable(uartBase, UART_INT_TX);
+	ctx->txArmed = 0U;
+	prv_dmaStartChunk(ctx, ch, 1U);
+	UARTDMAEnable(uartBase, UART_DMA_TX);
+	IntEnable(g_Uart_HwMap[ch].intNumber);
+
+	return UART_SUCCESS;
+}
+
+uint8_t UART_StartDmaRx(uint32_t uartBase, uint8_t *buffer, uint32_t len)
+{
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+	uint8_t              ch;
+	int32_t              raw;
+
+	if ((ctx == NULL) || (buffer == NULL) || (len == 0U))
+	{
+		return UART_ERROR_INVALID;
+	}
+
+	if (ctx->dmaRxActive)
+	{
+		return UART_ERROR_BUSY;
+	}
+
+	ch = (uint8_t)(ctx - g_Uart_Ctx);
+	prv_dmaAssign(ctx, ch);
+
+	/* Stop the ISR from pulling bytes out of the FIFO */
+	UARTIntDisable(uartBase, UART_INT_RX | UART_INT_RT);
+
+	/* Bytes that already arrived belong at the start of the buffer */
+	if (ctx->rxBuf != NULL)
+	{
+		while ((len != 0U) && (prv_rxCount(ctx) != 0U))
+		{
+			*buffer++ = ctx->rxBuf[ctx->rxTail & ctx->rxMask];
+			ctx->rxTail++;
+			len--;
+		}
+
+		/* RX interrupts are re-enabled below or when the DMA finishes;
+		 * only an XOFF still needs lifting */
+		ctx->rxThrottled = 0U;
+		if (ctx->xoffSent)
+		{
+			prv_rxFlowResume(ctx, uartBase);
+		}
+	}
+	while ((len != 0U) && ((raw = UARTCharGetNonBlocking(uartBase)) != -1))
+	{
+		prv_rxAccount(ctx, (uint32_t)raw);
+		*buffer++ = (uint8_t)raw;
+		len--;
+	}
+
+	if (len == 0U)
+	{
+		/* Satisfied without the uDMA */
+		if (ctx->rxBuf != NULL)
+		{
+			UARTIntEnable(uartBase, UART_INT_RX | UART_INT_RT);
+		}
+		return UART_SUCCESS;
+	}
+
+	ctx->dmaRxNext   = buffer;
+	ctx->dmaRxLeft   = len;
+	ctx->dmaRxActive = 1U;
+
+	prv_dmaStartChunk(ctx, ch, 0U);
+	UARTDMAEnable(uartBase, UART_DMA_RX);
+	IntEnable(g_Uart_HwMap[ch].intNumber);
+
+	return UART_SUCCESS;
+}
+
+uint8_t UART_IsDmaTxBusy(uint32_t uartBase)
+{
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+
+	return ((ctx != NULL) && ctx->dmaTxActive) ? 1U : 0U;
+}
+
+uint8_t UART_IsDmaRxBusy(uint32_t uartBase)
+{
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+
+	return ((ctx != NULL) && ctx->dmaRxActive) ? 1U : 0U;
+}
+
+uint32_t UART_GetLastRxTickMs(uint32_t uartBase)
+{
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+
+	return (ctx != NULL) ? ctx->rxLastTickMs : 0U;
+}
+
+void UART_GetStats(uint32_t uartBase, UART_StatsType *stats)
+{
+	static const UART_StatsType zero = { 0U };
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+
+	if (stats == NULL)
+	{
+		return;
+	}
+
+	/* Fields are updated by the ISR; each single-word read is atomic,
+	 * which is all a health snapshot needs */
+	*stats = (ctx != NULL) ? ctx->stats : zero;
+}
+
+void UART_ResetStats(uint32_t uartBase)
+{
+	static const UART_StatsType zero = { 0U };
+	Uart_ChannelCtxType *ctx = prv_getCtx(uartBase);
+	uint32_t             intNumber;
+	bool                 wasEnabled;
+
+	if (ctx == NULL)
+	{
+		return;
+	}
+
+	intNumber  = g_Uart_HwMap[ctx - g_Uart_Ctx].intNumber;
+	wasEnabled = IntIsEnabled(intNumber) ? true : false;
+
+	IntDisable(intNumber);
+	ctx->stats = zero;
+	if (wasEnabled)
+	{
+		IntEnable(intNumber);
+	}
+}
+
+/*======================================================================
+ *  ISRs
+ *
+ *  Must be wired in the startup file's vector table.
+ *====================================================================*/
+
+void UART0_Handler(void)
+{
+	prv_uartIsr(0U);
+}
+
+void UART1_Handler(void)
+{
+	prv_uartIsr(1U);
+}
+
+void UART2_Handler(void)
+{
+	prv_uartIsr(2U);
+}
+
+void UART3_Handler(void)
+{
+	prv_uartIsr(3U);
+}
+
+void UART4_Handler(void)
+{
+	prv_uartIsr(4U);
+}
+
+void UART5_Handler(void)
+{
+	prv_uartIsr(5U);
+}
+
+void UART6_Handler(void)
+{
+	prv_uartIsr(6U);
+}
+
+void UART7_Handler(void)
+{
+	prv_uartIsr(7U);
+}
+
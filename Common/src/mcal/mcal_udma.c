@@ -0,0 +1,194 @@
+/*============================================================================
+ *  Module      : MCAL uDMA
+ *  File Name   : mcal_udma.c
+ *  Description : Micro-DMA abstraction layer built on top of TivaWare driverlib
+ *===========================================================================*/
+
+#include "mcal/mcal_udma.h"
+
+#include <stddef.h>
+#include "inc/hw_ints.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+/*======================================================================
+ *  Channel control table
+ *
+ *  Only the primary structures are used (basic mode), so 32 entries
+ *  are enough, but the controller requires 1024-byte alignment.
+ *====================================================================*/
+#if defined(__ICCARM__)
+#pragma data_alignment=1024
+static tDMAControlTable g_Udma_ControlTable[UDMA_NUM_CHANNELS];
+#else
+static tDMAControlTable g_Udma_ControlTable[UDMA_NUM_CHANNELS] __attribute__((aligned(1024)));
+#endif
+
+/*======================================================================
+ *  Private data
+ *====================================================================*/
+
+static uint8_t                 g_Udma_Initialized = 0U;
+
+/* Size of the transfer currently owned by each channel (0 = idle) */
+static volatile uint16_t       g_Udma_Pending[UDMA_NUM_CHANNELS];
+
+static volatile Udma_StatsType g_Udma_Stats;
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void MCAL_UDMA_Init(void)
+{
+    if (g_Udma_Initialized)
+    {
+        return;
+    }
+
+    /* Enable the uDMA clock and wait until the controller is ready */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA)) { }
+
+    uDMAEnable();
+    uDMAControlBaseSet(g_Udma_ControlTable);
+
+    /* Bus errors are reported on their own vector */
+    IntEnable(INT_UDMAERR);
+
+    g_Udma_Initialized = 1U;
+}
+
+void MCAL_UDMA_AssignChannel(uint32_t channelAssign)
+{
+    uint8_t channel = (uint8_t)(channelAssign & 0x1FU);
+
+    uDMAChannelAssign(channelAssign);
+
+    /* Basic mode on the primary structure, normal priority, requests unmasked */
+    uDMAChannelAttributeDisable(channel,
+                                UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+}
+
+uint8_t MCAL_UDMA_StartTransfer(uint8_t channel, Udma_DirectionType dir,
+                                volatile void *periphReg, void *mem, uint16_t count)
+{
+    uint32_t control;
+
+    if ((channel >= UDMA_NUM_CHANNELS) || (mem == NULL) || (periphReg == NULL) ||
+        (count == 0U) || (count > UDMA_MAX_TRANSFER_ITEMS))
+    {
+        return UDMA_ERROR_INVALID_PARAM;
+    }
+
+    if (g_Udma_Pending[channel] != 0U)
+    {
+        return UDMA_ERROR_BUSY;
+    }
+
+    if (dir == UDMA_DIR_MEM_TO_PERIPH)
+    {
+        /* Walk the buffer, keep writing the same data register */
+        control = UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4;
+        uDMAChannelControlSet(channel | UDMA_PRI_SELECT, control);
+        uDMAChannelTransferSet(channel | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                               mem, (void *)periphReg, count);
+    }
+    else
+    {
+        control = UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_4;
+        uDMAChannelControlSet(channel | UDMA_PRI_SELECT, control);
+        uDMAChannelTransferSet(channel | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                               (void *)periphReg, mem, count);
+    }
+
+    g_Udma_Pending[channel] = count;
+    g_Udma_Stats.transfersStarted++;
+
+    uDMAChannelEnable(channel);
+
+    return UDMA_SUCCESS;
+}
+
+uint8_t MCAL_UDMA_IsBusy(uint8_t channel)
+{
+    if (channel >= UDMA_NUM_CHANNELS)
+    {
+        return 0U;
+    }
+
+    return (g_Udma_Pending[channel] != 0U) ? 1U : 0U;
+}
+
+uint8_t MCAL_UDMA_PollComplete(uint8_t channel)
+{
+    if ((channel >= UDMA_NUM_CHANNELS) || (g_Udma_Pending[channel] == 0U))
+    {
+        return 0U;
+    }
+
+    /* The controller returns the structure to STOP once the count hits zero */
+    if (uDMAChannelModeGet(channel | UDMA_PRI_SELECT) != UDMA_MODE_STOP)
+    {
+        return 0U;
+    }
+
+    g_Udma_Stats.transfersCompleted++;
+    g_Udma_Stats.bytesCompleted += g_Udma_Pending[channel];
+    g_Udma_Pending[channel] = 0U;
+
+    return 1U;
+}
+
+uint16_t MCAL_UDMA_Abort(uint8_t channel)
+{
+    uint16_t requested;
+    uint16_t remaining;
+
+    if ((channel >= UDMA_NUM_CHANNELS) || (g_Udma_Pending[channel] == 0U))
+    {
+        return 0U;
+    }
+
+    uDMAChannelDisable(channel);
+
+    requested = g_Udma_Pending[channel];
+    remaining = (uint16_t)uDMAChannelSizeGet(channel | UDMA_PRI_SELECT);
+    if (uDMAChannelModeGet(channel | UDMA_PRI_SELECT) == UDMA_MODE_STOP)
+    {
+        remaining = 0U;
+    }
+
+    g_Udma_Pending[channel] = 0U;
+
+    return (uint16_t)(requested - remaining);
+}
+
+void MCAL_UDMA_GetStats(Udma_StatsType *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    stats->transfersStarted   = g_Udma_Stats.transfersStarted;
+    stats->transfersCompleted = g_Udma_Stats.transfersCompleted;
+    stats->bytesCompleted     = g_Udma_Stats.bytesCompleted;
+    stats->busErrors          = g_Udma_Stats.busErrors;
+}
+
+/*======================================================================
+ *  ISR
+ *
+ *  Must be wired in the startup file's vector table (uDMA Error).
+ *====================================================================*/
+
+void uDMA_Error_Handler(void)
+{
+    if (uDMAErrorStatusGet() != 0U)
+    {
+        uDMAErrorStatusClear();
+        g_Udma_Stats.busErrors++;
+    }
+}
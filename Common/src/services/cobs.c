@@ -0,0 +1,182 @@
+/*============================================================================
+ *  Module      : Services COBS
+ *  File Name   : cobs.c
+ *  Description : Consistent Overhead Byte Stuffing codec with a zero-byte
+ *                packet delimiter
+ *===========================================================================*/
+
+#include "services/cobs.h"
+
+#include <stddef.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+/* Code of a full block: 254 data bytes, no zero implied after it */
+#define COBS_CODE_FULL          (0xFFU)
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+uint16_t COBS_Encode(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dstSize)
+{
+    uint16_t codePos = 0U;      /* Where the current block's code goes */
+    uint16_t pos     = 1U;
+    uint8_t  code    = 1U;
+    uint16_t i;
+
+    if ((dst == NULL) || ((src == NULL) && (len != 0U)) || (dstSize < 2U))
+    {
+        return 0U;
+    }
+
+    for (i = 0U; i < len; i++)
+    {
+        if (src[i] == 0U)
+        {
+            /* Close the block; the zero itself is implied by the code */
+            dst[codePos] = code;
+            codePos = pos++;
+            code    = 1U;
+        }
+        else
+        {
+            if (pos >= dstSize)
+            {
+                return 0U;
+            }
+            dst[pos++] = src[i];
+            code++;
+
+            if (code == COBS_CODE_FULL)
+            {
+                dst[codePos] = code;
+                codePos = pos++;
+                code    = 1U;
+            }
+        }
+
+        if (pos >= dstSize)
+        {
+            return 0U;
+        }
+    }
+
+    dst[codePos] = code;
+
+    if (pos >= dstSize)
+    {
+        return 0U;
+    }
+    dst[pos++] = COBS_DELIMITER;
+
+    return pos;
+}
+
+void COBS_DecoderInit(COBS_DecoderType *decoder, uint8_t *buf, uint16_t size)
+{
+    if (decoder == NULL)
+    {
+        return;
+    }
+
+    decoder->buf    = buf;
+    decoder->size   = (buf != NULL) ? size : 0U;
+    decoder->length = 0U;
+    decoder->errors = 0U;
+    COBS_DecoderReset(decoder);
+}
+
+void COBS_DecoderReset(COBS_DecoderType *decoder)
+{
+    if (decoder == NULL)
+    {
+        return;
+    }
+
+    decoder->index     = 0U;
+    decoder->code      = 0U;
+    decoder->remaining = 0U;
+    decoder->discard   = FALSE;
+}
+
+boolean COBS_DecoderIsBusy(const COBS_DecoderType *decoder)
+{
+    if (decoder == NULL)
+    {
+        return FALSE;
+    }
+
+    return ((decoder->code != 0U) || decoder->discard) ? TRUE : FALSE;
+}
+
+COBS_StatusType COBS_DecoderFeed(COBS_DecoderType *decoder, uint8_t data)
+{
+    boolean wasBusy;
+    boolean wellFormed;
+
+    if (decoder == NULL)
+    {
+        return COBS_STATUS_ERROR;
+    }
+
+    if (data == COBS_DELIMITER)
+    {
+        wasBusy    = COBS_DecoderIsBusy(decoder);
+        wellFormed = ((decoder->code != 0U) && (decoder->remaining == 0U) &&
+                      !decoder->discard) ? TRUE : FALSE;
+
+        decoder->length = decoder->index;
+        COBS_DecoderReset(decoder);
+
+        if (wellFormed)
+        {
+            return COBS_STATUS_COMPLETE;
+        }
+
+        /* Idle zeros are not errors; a packet cut short is */
+        if (wasBusy)
+        {
+            decoder->errors++;
+            return COBS_STATUS_ERROR;
+        }
+        return COBS_STATUS_PENDING;
+    }
+
+    if (decoder->discard)
+    {
+        return COBS_STATUS_PENDING;
+    }
+
+    if (decoder->remaining == 0U)
+    {
+        /* Code byte: the previous block, unless full, ended with a zero */
+        if ((decoder->code != 0U) && (decoder->code != COBS_CODE_FULL))
+        {
+            if (decoder->index >= decoder->size)
+            {
+                decoder->discard = TRUE;
+                return COBS_STATUS_PENDING;
+            }
+            decoder->buf[decoder->index++] = 0U;
+        }
+
+        decoder->code      = data;
+        decoder->remaining = (uint8_t)(data - 1U);
+        return COBS_STATUS_PENDING;
+    }
+
+    if (decoder->index >= decoder->size)
+    {
+        /* Too long for the buffer: skip to the next delimiter */
+        decoder->discard = TRUE;
+        return COBS_STATUS_PENDING;
+    }
+
+    decoder->buf[decoder->index++] = data;
+    decoder->remaining--;
+
+    return COBS_STATUS_PENDING;
+}
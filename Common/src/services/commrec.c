@@ -0,0 +1,114 @@
+/*============================================================================
+ *  Module      : Services COMMREC
+ *  File Name   : commrec.c
+ *  Description : Byte-level traffic recorder for the inter-ECU link
+ *===========================================================================*/
+
+#include "services/commrec.h"
+
+#include <stddef.h>
+
+/*======================================================================
+ *  Private data
+ *
+ *  Single producer (the HAL_COMM byte paths) and single consumer (the
+ *  dump path), both in thread context, with free-running indices.
+ *====================================================================*/
+
+static COMMREC_RecordType *g_Commrec_Buf = NULL;
+static uint16_t            g_Commrec_Mask = 0U;
+static uint16_t            g_Commrec_Head = 0U;
+static uint16_t            g_Commrec_Tail = 0U;
+static uint32_t            g_Commrec_Dropped = 0U;
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void COMMREC_Init(COMMREC_RecordType *buffer, uint16_t depth)
+{
+    g_Commrec_Head    = 0U;
+    g_Commrec_Tail    = 0U;
+    g_Commrec_Dropped = 0U;
+
+    /* Reject sizes the mask arithmetic cannot handle */
+    if ((buffer == NULL) || (depth == 0U) || ((depth & (depth - 1U)) != 0U))
+    {
+        g_Commrec_Buf  = NULL;
+        g_Commrec_Mask = 0U;
+        return;
+    }
+
+    g_Commrec_Buf  = buffer;
+    g_Commrec_Mask = (uint16_t)(depth - 1U);
+}
+
+void COMMREC_Record(uint8_t dir, uint8_t data, uint32_t tickMs)
+{
+    COMMREC_RecordType *rec;
+
+    if (g_Commrec_Buf == NULL)
+    {
+        return;
+    }
+
+    if ((uint16_t)(g_Commrec_Head - g_Commrec_Tail) > g_Commrec_Mask)
+    {
+        g_Commrec_Dropped++;
+        return;
+    }
+
+    rec = &g_Commrec_Buf[g_Commrec_Head & g_Commrec_Mask];
+    rec->tickMs = tickMs;
+    rec->dir    = dir;
+    rec->data   = data;
+    g_Commrec_Head++;
+}
+
+uint16_t COMMREC_Read(COMMREC_RecordType *out, uint16_t max)
+{
+    uint16_t count = 0U;
+
+    if ((g_Commrec_Buf == NULL) || (out == NULL))
+    {
+        return 0U;
+    }
+
+    while ((count < max) && (g_Commrec_Tail != g_Commrec_Head))
+    {
+        out[count++] = g_Commrec_Buf[g_Commrec_Tail & g_Commrec_Mask];
+        g_Commrec_Tail++;
+    }
+
+    return count;
+}
+
+uint32_t COMMREC_GetDropped(void)
+{
+    return g_Commrec_Dropped;
+}
+
+void COMMREC_Encode(const COMMREC_RecordType *rec, uint8_t *out)
+{
+    out[0] = (uint8_t)(rec->tickMs >> 24);
+    out[1] = (uint8_t)(rec->tickMs >> 16);
+    out[2] = (uint8_t)(rec->tickMs >> 8);
+    out[3] = (uint8_t)(rec->tickMs);
+    out[4] = rec->dir;
+    out[5] = rec->data;
+}
+
+boolean COMMREC_Decode(const uint8_t *in, COMMREC_RecordType *rec)
+{
+    if ((in[4] != COMMREC_DIR_RX) && (in[4] != COMMREC_DIR_TX))
+    {
+        return FALSE;
+    }
+
+    rec->tickMs = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) |
+                  ((uint32_t)in[2] << 8)  |  (uint32_t)in[3];
+    rec->dir    = in[4];
+    rec->data   = in[5];
+
+    return TRUE;
+}
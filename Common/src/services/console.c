@@ -0,0 +1,275 @@
+/*============================================================================
+ *  Module      : Services CONSOLE
+ *  File Name   : console.c
+ *  Description : Line-oriented command shell over a byte stream
+ *===========================================================================*/
+
+#include "services/console.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define CONSOLE_CHAR_BS         ('\b')
+#define CONSOLE_CHAR_DEL        ((char)0x7F)
+
+/*======================================================================
+ *  Private data
+ *====================================================================*/
+
+static const CONSOLE_CommandType *g_Console_Commands = NULL;
+static uint8_t                    g_Console_Count    = 0U;
+static CONSOLE_PutsFnType         g_Console_PutsFn   = NULL;
+
+static char    g_Console_Line[CONSOLE_LINE_SIZE];
+static uint8_t g_Console_Len       = 0U;
+static char    g_Console_LastEnd   = '\0';  /* CR or LF that ended the previous line */
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+static boolean prv_isSpace(char c)
+{
+    return ((c == ' ') || (c == '\t')) ? TRUE : FALSE;
+}
+
+/* Split the line in place; returns the token count */
+static uint8_t prv_tokenize(char *line, char *argv[])
+{
+    uint8_t argc = 0U;
+
+    while (*line != '\0')
+    {
+        while (prv_isSpace(*line))
+        {
+            *line++ = '\0';
+        }
+        if (*line == '\0')
+        {
+            break;
+        }
+        if (argc >= CONSOLE_MAX_ARGS)
+        {
+            break;      /* Rest of the line is ignored */
+        }
+
+        argv[argc++] = line;
+        while ((*line != '\0') && !prv_isSpace(*line))
+        {
+            line++;
+        }
+    }
+
+    argv[argc] = NULL;
+    return argc;
+}
+
+static void prv_help(void)
+{
+    uint8_t i;
+
+    CONSOLE_Print("help - list commands\r\n");
+    for (i = 0U; i < g_Console_Count; i++)
+    {
+        CONSOLE_Print(g_Console_Commands[i].name);
+        CONSOLE_Print(" - ");
+        CONSOLE_Print(g_Console_Commands[i].help);
+        CONSOLE_Print("\r\n");
+    }
+}
+
+static void prv_execute(void)
+{
+    char   *argv[CONSOLE_MAX_ARGS + 1U];
+    uint8_t argc;
+    uint8_t i;
+
+    g_Console_Line[g_Console_Len] = '\0';
+    argc = prv_tokenize(g_Console_Line, argv);
+    if (argc == 0U)
+    {
+        return;
+    }
+
+    if (strcmp(argv[0], "help") == 0)
+    {
+        prv_help();
+        return;
+    }
+
+    for (i = 0U; i < g_Console_Count; i++)
+    {
+        if (strcmp(argv[0], g_Console_Commands[i].name) == 0)
+        {
+            g_Console_Commands[i].handler(argc, argv);
+            return;
+        }
+    }
+
+    CONSOLE_Print("unknown command: ");
+    CONSOLE_Print(argv[0]);
+    CONSOLE_Print(" (try help)\r\n");
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void CONSOLE_Init(const CONSOLE_CommandType *commands, uint8_t count,
+                  CONSOLE_PutsFnType putsFn)
+{
+    g_Console_Commands = commands;
+    g_Console_Count    = (commands != NULL) ? count : 0U;
+    g_Console_PutsFn   = putsFn;
+    g_Console_Len      = 0U;
+    g_Console_LastEnd  = '\0';
+
+    CONSOLE_Print("\r\n" CONSOLE_PROMPT);
+}
+
+void CONSOLE_Feed(char c)
+{
+    char echo[2];
+
+    if ((c == '\r') || (c == '\n'))
+    {
+        /* A CR LF pair ends one line, not two */
+        if ((g_Console_Len == 0U) && (g_Console_LastEnd != '\0') &&
+            (g_Console_LastEnd != c))
+        {
+            g_Console_LastEnd = '\0';
+            return;
+        }
+        g_Console_LastEnd = c;
+
+        CONSOLE_Print("\r\n");
+        prv_execute();
+        g_Console_Len = 0U;
+        CONSOLE_Print(CONSOLE_PROMPT);
+        return;
+    }
+    g_Console_LastEnd = '\0';
+
+    if ((c == CONSOLE_CHAR_BS) || (c == CONSOLE_CHAR_DEL))
+    {
+        if (g_Console_Len > 0U)
+        {
+            g_Console_Len--;
+            CONSOLE_Print("\b \b");
+        }
+        return;
+    }
+
+    /* Printable only, and one byte kept for the terminator */
+    if ((c < ' ') || (c > '~') || (g_Console_Len >= (CONSOLE_LINE_SIZE - 1U)))
+    {
+        return;
+    }
+
+    g_Console_Line[g_Console_Len++] = c;
+    echo[0] = c;
+    echo[1] = '\0';
+    CONSOLE_Print(echo);
+}
+
+void CONSOLE_Print(const char *str)
+{
+    if ((g_Console_PutsFn != NULL) && (str != NULL))
+    {
+        g_Console_PutsFn(str);
+    }
+}
+
+void CONSOLE_PrintDec(uint32_t value)
+{
+    char    buf[11];            /* 4294967295 + terminator */
+    uint8_t pos = (uint8_t)(sizeof(buf) - 1U);
+
+    buf[pos] = '\0';
+    do
+    {
+        buf[--pos] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+
+    CONSOLE_Print(&buf[pos]);
+}
+
+void CONSOLE_PrintHex(uint32_t value, uint8_t digits)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char    buf[11];            /* "0x" + 8 digits + terminator */
+    uint8_t i;
+
+    if ((digits == 0U) || (digits > 8U))
+    {
+        digits = 8U;
+    }
+
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (i = 0U; i < digits; i++)
+    {
+        buf[1U + digits - i] = hex[value & 0xFU];
+        value >>= 4;
+    }
+    buf[2U + digits] = '\0';
+
+    CONSOLE_Print(buf);
+}
+
+boolean CONSOLE_ParseU32(const char *token, uint32_t *value)
+{
+    uint32_t result = 0U;
+    uint32_t base   = 10U;
+    uint32_t digit;
+
+    if ((token == NULL) || (value == NULL) || (*token == '\0'))
+    {
+        return FALSE;
+    }
+
+    if ((token[0] == '0') && ((token[1] == 'x') || (token[1] == 'X')))
+    {
+        base   = 16U;
+        token += 2;
+        if (*token == '\0')
+        {
+            return FALSE;
+        }
+    }
+
+    while (*token != '\0')
+    {
+        if ((*token >= '0') && (*token <= '9'))
+        {
+            digit = (uint32_t)(*token - '0');
+        }
+        else if ((base == 16U) && (*token >= 'a') && (*token <= 'f'))
+        {
+            digit = (uint32_t)(*token - 'a') + 10U;
+        }
+        else if ((base == 16U) && (*token >= 'A') && (*token <= 'F'))
+        {
+            digit = (uint32_t)(*token - 'A') + 10U;
+        }
+        else
+        {
+            return FALSE;
+        }
+
+        if (result > ((0xFFFFFFFFU - digit) / base))
+        {
+            return FALSE;   /* Overflow */
+        }
+        result = (result * base) + digit;
+        token++;
+    }
+
+    *value = result;
+    return TRUE;
+}
@@ -0,0 +1,159 @@
+/*============================================================================
+ *  Module      : Services LOAD
+ *  File Name   : cpuload.c
+ *  Description : CPU load meter from the sleep (idle) accounting
+ *===========================================================================*/
+
+#include "services/cpuload.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "driverlib/cpu.h"
+#include "mcal/mcal_systick.h"
+#include "services/console.h"
+
+/*======================================================================
+ *  Private data
+ *
+ *  Written by LOAD_OnTick() in the SysTick interrupt; thread code reads
+ *  and clears it with interrupts masked.
+ *====================================================================*/
+
+static uint32_t g_Load_WindowTicks = 0U;
+static uint32_t g_Load_LastIdleMs  = 0U;
+static uint32_t g_Load_BusyTotalMs = 0U;    /* Busy ms over all windows */
+static LOAD_StatsType g_Load_Stats;
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+static void prv_printPermille(const char *label, uint16_t permille)
+{
+    CONSOLE_Print(label);
+    CONSOLE_PrintDec(permille / 10U);
+    CONSOLE_Print(".");
+    CONSOLE_PrintDec(permille % 10U);
+    CONSOLE_Print(" %\r\n");
+}
+
+/* Clear the statistics; interrupts masked or not yet running */
+static void prv_clear(void)
+{
+    g_Load_BusyTotalMs = 0U;
+    (void)memset(&g_Load_Stats, 0, sizeof(g_Load_Stats));
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void LOAD_Init(void)
+{
+    g_Load_WindowTicks = 0U;
+    g_Load_LastIdleMs  = MCAL_SysTick_GetIdleMs();
+    (void)MCAL_SysTick_TakeBusyMaxCycles();
+    prv_clear();
+}
+
+void LOAD_OnTick(void)
+{
+    uint32_t idleMs;
+    uint32_t sleptMs;
+    uint32_t busyMs;
+    uint32_t cyclesPerUs;
+    uint32_t busyMaxUs;
+    uint16_t permille;
+
+    g_Load_WindowTicks++;
+    if (g_Load_WindowTicks < LOAD_WINDOW_MS)
+    {
+        return;
+    }
+    g_Load_WindowTicks = 0U;
+
+    /* Idle of each ms is counted before its tick, so the window is exact
+     * to a fraction of a ms even across a tickless sleep */
+    idleMs  = MCAL_SysTick_GetIdleMs();
+    sleptMs = idleMs - g_Load_LastIdleMs;
+    g_Load_LastIdleMs = idleMs;
+    busyMs  = (sleptMs < LOAD_WINDOW_MS) ? (LOAD_WINDOW_MS - sleptMs) : 0U;
+
+    permille = (uint16_t)((busyMs * 1000U) / LOAD_WINDOW_MS);
+    g_Load_Stats.currentPermille = permille;
+    if (permille > g_Load_Stats.peakPermille)
+    {
+        g_Load_Stats.peakPermille = permille;
+    }
+
+    g_Load_BusyTotalMs += busyMs;
+    g_Load_Stats.windows++;
+    g_Load_Stats.averagePermille =
+        (uint16_t)(((uint64_t)g_Load_BusyTotalMs * 1000U) /
+                   ((uint64_t)g_Load_Stats.windows * LOAD_WINDOW_MS));
+
+    cyclesPerUs = MCAL_SysTick_GetClockHz() / 1000000U;
+    busyMaxUs   = MCAL_SysTick_TakeBusyMaxCycles() / ((cyclesPerUs != 0U) ? cyclesPerUs : 1U);
+    g_Load_Stats.windowBusyMaxUs = busyMaxUs;
+    if (busyMaxUs > g_Load_Stats.busyMaxUs)
+    {
+        g_Load_Stats.busyMaxUs = busyMaxUs;
+    }
+}
+
+void LOAD_GetStats(LOAD_StatsType *stats)
+{
+    uint32_t primask;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    primask = CPUcpsid();
+    *stats = g_Load_Stats;
+    if (primask == 0U)
+    {
+        CPUcpsie();
+    }
+}
+
+void LOAD_Reset(void)
+{
+    uint32_t primask = CPUcpsid();
+
+    prv_clear();
+
+    if (primask == 0U)
+    {
+        CPUcpsie();
+    }
+}
+
+void LOAD_ConsoleCmd(uint8_t argc, char *argv[])
+{
+    LOAD_StatsType stats;
+
+    if ((argc > 1U) && (strcmp(argv[1], "reset") == 0))
+    {
+        LOAD_Reset();
+        CONSOLE_Print("load cleared\r\n");
+        return;
+    }
+
+    LOAD_GetStats(&stats);
+
+    CONSOLE_Print("windows   ");
+    CONSOLE_PrintDec(stats.windows);
+    CONSOLE_Print(" of ");
+    CONSOLE_PrintDec(LOAD_WINDOW_MS);
+    CONSOLE_Print(" ms\r\n");
+    prv_printPermille("current   ", stats.currentPermille);
+    prv_printPermille("average   ", stats.averagePermille);
+    prv_printPermille("peak      ", stats.peakPermille);
+    CONSOLE_Print("busy max  ");
+    CONSOLE_PrintDec(stats.busyMaxUs);
+    CONSOLE_Print(" us (last window ");
+    CONSOLE_PrintDec(stats.windowBusyMaxUs);
+    CONSOLE_Print(" us)\r\n");
+}
@@ -0,0 +1,142 @@
+/*============================================================================
+ *  Module      : Services FRAME
+ *  File Name   : frame.c
+ *  Description : Length-prefixed, CRC-protected frame codec shared by the
+ *                HMI and Control ECUs
+ *===========================================================================*/
+
+#include "services/frame.h"
+#include "services/crc16.h"
+
+#include <stddef.h>
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+uint16_t FRAME_Encode(uint8_t cmd, const uint8_t *payload, uint8_t len,
+                      uint8_t *out, uint16_t outSize)
+{
+    uint16_t crc;
+    uint16_t pos = 0U;
+    uint8_t  i;
+
+    if ((out == NULL) || (len > FRAME_MAX_PAYLOAD) ||
+        ((payload == NULL) && (len != 0U)) ||
+        (outSize < (uint16_t)(len + FRAME_OVERHEAD)))
+    {
+        return 0U;
+    }
+
+    out[pos++] = FRAME_SOF;
+    out[pos++] = len;
+    out[pos++] = cmd;
+    for (i = 0U; i < len; i++)
+    {
+        out[pos++] = payload[i];
+    }
+
+    /* CRC covers LEN, CMD and PAYLOAD (everything after SOF) */
+    crc = CRC16_Compute(&out[1], (uint16_t)(len + 2U));
+    out[pos++] = (uint8_t)(crc >> 8);
+    out[pos++] = (uint8_t)(crc & 0xFFU);
+
+    return pos;
+}
+
+void FRAME_ParserInit(FRAME_ParserType *parser)
+{
+    if (parser == NULL)
+    {
+        return;
+    }
+
+    parser->state        = FRAME_STATE_SOF;
+    parser->index        = 0U;
+    parser->crc          = CRC16_INIT_VALUE;
+    parser->rxCrc        = 0U;
+    parser->frame.cmd    = 0U;
+    parser->frame.len    = 0U;
+    parser->crcErrors    = 0U;
+    parser->lengthErrors = 0U;
+    parser->truncatedFrames = 0U;
+}
+
+void FRAME_ParserAbort(FRAME_ParserType *parser)
+{
+    if ((parser == NULL) || (parser->state == FRAME_STATE_SOF))
+    {
+        return;
+    }
+
+    parser->truncatedFrames++;
+    parser->state = FRAME_STATE_SOF;
+}
+
+boolean FRAME_ParserIsBusy(const FRAME_ParserType *parser)
+{
+    return ((parser != NULL) && (parser->state != FRAME_STATE_SOF)) ? TRUE : FALSE;
+}
+
+FRAME_StatusType FRAME_ParserFeed(FRAME_ParserType *parser, uint8_t data)
+{
+    switch (parser->state)
+    {
+        case FRAME_STATE_SOF:
+            /* Anything before a start byte is line noise; skip it */
+            if (data == FRAME_SOF)
+            {
+                parser->crc   = CRC16_INIT_VALUE;
+                parser->index = 0U;
+                parser->state = FRAME_STATE_LEN;
+            }
+            break;
+
+        case FRAME_STATE_LEN:
+            if (data > FRAME_MAX_PAYLOAD)
+            {
+                parser->lengthErrors++;
+                parser->state = FRAME_STATE_SOF;
+                return FRAME_STATUS_ERROR;
+            }
+            parser->frame.len = data;
+            parser->crc       = CRC16_Update(parser->crc, data);
+            parser->state     = FRAME_STATE_CMD;
+            break;
+
+        case FRAME_STATE_CMD:
+            parser->frame.cmd = data;
+            parser->crc       = CRC16_Update(parser->crc, data);
+            parser->state     = (parser->frame.len != 0U) ? FRAME_STATE_PAYLOAD
+                                                          : FRAME_STATE_CRC_HI;
+            break;
+
+        case FRAME_STATE_PAYLOAD:
+            parser->frame.payload[parser->index++] = data;
+            parser->crc = CRC16_Update(parser->crc, data);
+            if (parser->index >= parser->frame.len)
+            {
+                parser->state = FRAME_STATE_CRC_HI;
+            }
+            break;
+
+        case FRAME_STATE_CRC_HI:
+            parser->rxCrc = (uint16_t)((uint16_t)data << 8);
+            parser->state = FRAME_STATE_CRC_LO;
+            break;
+
+        case FRAME_STATE_CRC_LO:
+        default:
+            parser->rxCrc |= data;
+            parser->state  = FRAME_STATE_SOF;
+
+            if (parser->rxCrc != parser->crc)
+            {
+                parser->crcErrors++;
+                return FRAME_STATUS_ERROR;
+            }
+            return FRAME_STATUS_COMPLETE;
+    }
+
+    return FRAME_STATUS_PENDING;
+}
@@ -0,0 +1,348 @@
+/*============================================================================
+ *  Module      : Services LINK
+ *  File Name   : link.c
+ *  Description : Reliable, in-order frame delivery (go-back-N sliding
+ *                window) on top of the frame codec
+ *===========================================================================*/
+
+#include "services/link.h"
+
+#include <stddef.h>
+
+/*======================================================================
+ *  Private types and data
+ *====================================================================*/
+
+/* One queued DATA frame, kept until acknowledged */
+typedef struct
+{
+    uint8_t cmd;
+    uint8_t len;
+    uint8_t payload[LINK_MAX_PAYLOAD];
+} Link_SlotType;
+
+static LINK_SendFnType g_Link_SendFn = NULL;
+
+/* Transmit side: slots [base, base + count) hold SEQs base.. in order */
+static Link_SlotType   g_Link_Window[LINK_WINDOW_SIZE];
+static uint8_t         g_Link_TxBase;       /* SEQ of the oldest unacknowledged frame */
+static uint8_t         g_Link_TxCount;      /* Frames queued */
+static uint8_t         g_Link_TxSent;       /* Of those, already transmitted since the last (re)start */
+static boolean         g_Link_TxSynced;     /* Peer acknowledged our SYNC */
+static uint32_t        g_Link_TimerMs;      /* Start of the SYNC / retransmit timer */
+static uint8_t         g_Link_Retries;
+
+/* Receive side */
+static boolean         g_Link_RxSynced;     /* Peer's SYNC seen */
+static uint8_t         g_Link_RxExpected;   /* Next SEQ to deliver */
+
+static LINK_StatsType  g_Link_Stats;
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+static Link_SlotType *prv_slot(uint8_t seq)
+{
+    return &g_Link_Window[seq % LINK_WINDOW_SIZE];
+}
+
+/* Put one queued frame on the wire as DATA */
+static void prv_sendData(uint8_t seq)
+{
+    const Link_SlotType *slot = prv_slot(seq);
+    uint8_t buf[FRAME_MAX_PAYLOAD];
+    uint8_t i;
+
+    buf[0] = seq;
+    buf[1] = slot->cmd;
+    for (i = 0U; i < slot->len; i++)
+    {
+        buf[LINK_HEADER_SIZE + i] = slot->payload[i];
+    }
+
+    (void)g_Link_SendFn(LINK_CMD_DATA, buf, (uint8_t)(slot->len + LINK_HEADER_SIZE));
+}
+
+/* Transmit everything queued but not yet sent */
+static void prv_sendPending(uint32_t nowMs)
+{
+    if (!g_Link_TxSynced)
+    {
+        return;
+    }
+
+    if ((g_Link_TxSent == 0U) && (g_Link_TxCount != 0U))
+    {
+        g_Link_TimerMs = nowMs;
+    }
+
+    while (g_Link_TxSent < g_Link_TxCount)
+    {
+        prv_sendData((uint8_t)(g_Link_TxBase + g_Link_TxSent));
+        g_Link_TxSent++;
+    }
+}
+
+static void prv_sendAck(void)
+{
+    uint8_t next = g_Link_RxExpected;
+
+    (void)g_Link_SendFn(LINK_CMD_ACK, &next, 1U);
+}
+
+/* Drop the window and start numbering again from a fresh SYNC */
+static void prv_restartSync(uint32_t nowMs)
+{
+    g_Link_Stats.dropped += g_Link_TxCount;
+
+    g_Link_TxBase   = 0U;
+    g_Link_TxCount  = 0U;
+    g_Link_TxSent   = 0U;
+    g_Link_TxSynced = FALSE;
+    g_Link_Retries  = 0U;
+    g_Link_TimerMs  = nowMs;
+
+    (void)g_Link_SendFn(LINK_CMD_SYNC, NULL, 0U);
+}
+
+static void prv_onAck(uint8_t next, uint32_t nowMs)
+{
+    uint8_t acked = (uint8_t)(next - g_Link_TxBase);
+
+    /* Only SEQs we have actually sent can be acknowledged */
+    if ((acked == 0U) || (acked > g_Link_TxSent))
+    {
+        return;
+    }
+
+    g_Link_TxBase   = next;
+    g_Link_TxCount  = (uint8_t)(g_Link_TxCount - acked);
+    g_Link_TxSent   = (uint8_t)(g_Link_TxSent - acked);
+    g_Link_Retries  = 0U;
+    g_Link_TimerMs  = nowMs;
+    g_Link_Stats.acked += acked;
+}
+
+static boolean prv_onData(const FRAME_Type *in, FRAME_Type *out)
+{
+    uint8_t seq;
+    uint8_t i;
+
+    if (!g_Link_RxSynced)
+    {
+        /* We rebooted under the sender: ask for its SYNC */
+        (void)g_Link_SendFn(LINK_CMD_RESYNC, NULL, 0U);
+        return FALSE;
+    }
+
+    if (in->len < LINK_HEADER_SIZE)
+    {
+        return FALSE;
+    }
+
+    seq = in->payload[0];
+    if (seq != g_Link_RxExpected)
+    {
+        g_Link_Stats.duplicates++;
+        prv_sendAck();
+        return FALSE;
+    }
+
+    g_Link_RxExpected++;
+    g_Link_Stats.delivered++;
+    prv_sendAck();
+
+    /* Payload moves down by the header; safe when in == out */
+    out->cmd = in->payload[1];
+    out->len = (uint8_t)(in->len - LINK_HEADER_SIZE);
+    for (i = 0U; i < out->len; i++)
+    {
+        out->payload[i] = in->payload[LINK_HEADER_SIZE + i];
+    }
+
+    return TRUE;
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void LINK_Init(LINK_SendFnType sendFn, uint32_t nowMs)
+{
+    g_Link_SendFn = sendFn;
+
+    g_Link_RxSynced   = FALSE;
+    g_Link_RxExpected = 0U;
+
+    g_Link_Stats.sent        = 0U;
+    g_Link_Stats.retransmits = 0U;
+    g_Link_Stats.acked       = 0U;
+    g_Link_Stats.delivered   = 0U;
+    g_Link_Stats.duplicates  = 0U;
+    g_Link_Stats.resyncs     = 0U;
+    g_Link_Stats.dropped     = 0U;
+    g_Link_TxCount           = 0U;
+
+    if (g_Link_SendFn != NULL)
+    {
+        prv_restartSync(nowMs);
+    }
+}
+
+uint8_t LINK_Send(uint8_t cmd, const uint8_t *payload, uint8_t len, uint32_t nowMs)
+{
+    Link_SlotType *slot;
+    uint8_t i;
+
+    if ((g_Link_SendFn == NULL) || (len > LINK_MAX_PAYLOAD) ||
+        ((payload == NULL) && (len != 0U)))
+    {
+        return LINK_ERROR_INVALID;
+    }
+
+    if (g_Link_TxCount >= LINK_WINDOW_SIZE)
+    {
+        return LINK_ERROR_BUSY;
+    }
+
+    slot = prv_slot((uint8_t)(g_Link_TxBase + g_Link_TxCount));
+    slot->cmd = cmd;
+    slot->len = len;
+    for (i = 0U; i < len; i++)
+    {
+        slot->payload[i] = payload[i];
+    }
+    g_Link_TxCount++;
+    g_Link_Stats.sent++;
+
+    prv_sendPending(nowMs);
+
+    return LINK_SUCCESS;
+}
+
+boolean LINK_OnFrame(const FRAME_Type *in, FRAME_Type *out, uint32_t nowMs)
+{
+    uint8_t i;
+
+    if ((in == NULL) || (out == NULL) || (g_Link_SendFn == NULL))
+    {
+        return FALSE;
+    }
+
+    switch (in->cmd)
+    {
+        case LINK_CMD_DATA:
+            return prv_onData(in, out);
+
+        case LINK_CMD_ACK:
+            if (in->len >= 1U)
+            {
+                prv_onAck(in->payload[0], nowMs);
+                prv_sendPending(nowMs);
+            }
+            return FALSE;
+
+        case LINK_CMD_SYNC:
+            /* Peer restarted its numbering (repeats are harmless: nothing
+             * is delivered between its SYNC and our SYNC_ACK) */
+            g_Link_RxSynced   = TRUE;
+            g_Link_RxExpected = 0U;
+            (void)g_Link_SendFn(LINK_CMD_SYNC_ACK, NULL, 0U);
+            return FALSE;
+
+        case LINK_CMD_SYNC_ACK:
+            if (!g_Link_TxSynced)
+            {
+                g_Link_TxSynced = TRUE;
+                g_Link_Retries  = 0U;
+                prv_sendPending(nowMs);
+            }
+            return FALSE;
+
+        case LINK_CMD_RESYNC:
+            /* Once per restart: the rest of the window's RESYNCs arrive
+             * before the peer's SYNC_ACK and find us unsynchronised */
+            if (g_Link_TxSynced)
+            {
+                g_Link_Stats.resyncs++;
+                prv_restartSync(nowMs);
+            }
+            return FALSE;
+
+        default:
+            break;
+    }
+
+    if (out != in)
+    {
+        out->cmd = in->cmd;
+        out->len = in->len;
+        for (i = 0U; i < in->len; i++)
+        {
+            out->payload[i] = in->payload[i];
+        }
+    }
+
+    return TRUE;
+}
+
+void LINK_Tick(uint32_t nowMs)
+{
+    uint8_t i;
+
+    if ((g_Link_SendFn == NULL) || ((nowMs - g_Link_TimerMs) < LINK_RTO_MS))
+    {
+        return;
+    }
+
+    if (!g_Link_TxSynced)
+    {
+        /* Keep offering the SYNC until the peer is there */
+        g_Link_TimerMs = nowMs;
+        (void)g_Link_SendFn(LINK_CMD_SYNC, NULL, 0U);
+        return;
+    }
+
+    if (g_Link_TxSent == 0U)
+    {
+        return;
+    }
+
+    if (g_Link_Retries >= LINK_MAX_RETRIES)
+    {
+        g_Link_Stats.resyncs++;
+        prv_restartSync(nowMs);
+        return;
+    }
+
+    /* Go back N: resend the whole window from the oldest frame */
+    g_Link_Retries++;
+    g_Link_TimerMs = nowMs;
+    for (i = 0U; i < g_Link_TxSent; i++)
+    {
+        prv_sendData((uint8_t)(g_Link_TxBase + i));
+        g_Link_Stats.retransmits++;
+    }
+}
+
+boolean LINK_IsIdle(void)
+{
+    return (g_Link_TxCount == 0U) ? TRUE : FALSE;
+}
+
+void LINK_GetStats(LINK_StatsType *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    stats->sent        = g_Link_Stats.sent;
+    stats->retransmits = g_Link_Stats.retransmits;
+    stats->acked       = g_Link_Stats.acked;
+    stats->delivered   = g_Link_Stats.delivered;
+    stats->duplicates  = g_Link_Stats.duplicates;
+    stats->resyncs     = g_Link_Stats.resyncs;
+    stats->dropped     = g_Link_Stats.dropped;
+}
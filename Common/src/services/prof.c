@@ -0,0 +1,194 @@
+/*============================================================================
+ *  Module      : Services PROF
+ *  File Name   : prof.c
+ *  Description : Cycle-counter profiling with per-site statistics
+ *===========================================================================*/
+
+#if defined(__unix__)
+#define _POSIX_C_SOURCE 199309L     /* clock_gettime() */
+#endif
+
+#include "services/prof.h"
+
+#if (PROF_ENABLE != 0)
+
+#include <string.h>
+#include "services/console.h"
+
+#if (PROF_HOST != 0)
+#include <time.h>
+#endif
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define PROF_CALIBRATION_RUNS   (8U)
+#define PROF_NAME_WIDTH         (16U)
+#define PROF_VALUE_WIDTH        (11U)
+
+/*======================================================================
+ *  Private types and data
+ *====================================================================*/
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} Prof_SiteStatsType;
+
+/* Console names, in PROF_SiteType order */
+static const char * const g_Prof_Names[PROF_NUM_SITES] =
+{
+    "keypad_getkey",
+    "lcd_string",
+    "eeprom_verify",
+    "adc_read"
+};
+
+uint32_t                  g_Prof_Start[PROF_NUM_SITES];
+static Prof_SiteStatsType g_Prof_Sites[PROF_NUM_SITES];
+static uint32_t           g_Prof_Overhead = 0U;    /* Empty BEGIN/END pair */
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+/* Print str left-aligned in width columns */
+static void prv_printLeft(const char *str, uint8_t width)
+{
+    size_t len = strlen(str);
+
+    CONSOLE_Print(str);
+    while (len < width)
+    {
+        CONSOLE_Print(" ");
+        len++;
+    }
+}
+
+/* Print value right-aligned in width columns */
+static void prv_printRight(uint32_t value, uint8_t width)
+{
+    uint32_t rest   = value;
+    uint8_t  digits = 1U;
+
+    while (rest >= 10U)
+    {
+        rest /= 10U;
+        digits++;
+    }
+    while (digits < width)
+    {
+        CONSOLE_Print(" ");
+        digits++;
+    }
+    CONSOLE_PrintDec(value);
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void PROF_Init(void)
+{
+    uint8_t i;
+
+#if (PROF_HOST == 0)
+    MCAL_DWT_Init();
+#endif
+
+    /* The cheapest empty pair is the fixed cost of the macros */
+    g_Prof_Overhead = 0U;
+    PROF_Reset();
+    for (i = 0U; i < PROF_CALIBRATION_RUNS; i++)
+    {
+        PROF_BEGIN(PROF_SITE_KEYPAD_GETKEY);
+        PROF_END(PROF_SITE_KEYPAD_GETKEY);
+    }
+    g_Prof_Overhead = g_Prof_Sites[PROF_SITE_KEYPAD_GETKEY].min;
+    PROF_Reset();
+}
+
+void PROF_Record(PROF_SiteType id, uint32_t delta)
+{
+    Prof_SiteStatsType *site;
+
+    if ((uint32_t)id >= (uint32_t)PROF_NUM_SITES)
+    {
+        return;
+    }
+    site  = &g_Prof_Sites[id];
+    delta = (delta > g_Prof_Overhead) ? (delta - g_Prof_Overhead) : 0U;
+
+    if ((site->count == 0U) || (delta < site->min))
+    {
+        site->min = delta;
+    }
+    if (delta > site->max)
+    {
+        site->max = delta;
+    }
+    site->total += delta;
+    site->count++;
+}
+
+void PROF_Reset(void)
+{
+    uint8_t i;
+
+    for (i = 0U; i < (uint8_t)PROF_NUM_SITES; i++)
+    {
+        g_Prof_Sites[i].count = 0U;
+        g_Prof_Sites[i].min   = 0U;
+        g_Prof_Sites[i].max   = 0U;
+        g_Prof_Sites[i].total = 0U;
+    }
+}
+
+void PROF_ConsoleCmd(uint8_t argc, char *argv[])
+{
+    const Prof_SiteStatsType *site;
+    uint8_t i;
+
+    if ((argc > 1U) && (strcmp(argv[1], "reset") == 0))
+    {
+        PROF_Reset();
+        CONSOLE_Print("profile cleared\r\n");
+        return;
+    }
+
+    prv_printLeft("site", PROF_NAME_WIDTH);
+    CONSOLE_Print("      count        min       mean        max  (" PROF_UNIT ")\r\n");
+
+    for (i = 0U; i < (uint8_t)PROF_NUM_SITES; i++)
+    {
+        site = &g_Prof_Sites[i];
+
+        prv_printLeft(g_Prof_Names[i], PROF_NAME_WIDTH);
+        prv_printRight(site->count, PROF_VALUE_WIDTH);
+        prv_printRight(site->min, PROF_VALUE_WIDTH);
+        prv_printRight((site->count != 0U) ? (uint32_t)(site->total / site->count) : 0U,
+                       PROF_VALUE_WIDTH);
+        prv_printRight(site->max, PROF_VALUE_WIDTH);
+        CONSOLE_Print("\r\n");
+    }
+
+    CONSOLE_Print("overhead removed per sample: ");
+    CONSOLE_PrintDec(g_Prof_Overhead);
+    CONSOLE_Print(" " PROF_UNIT "\r\n");
+}
+
+#if (PROF_HOST != 0)
+uint32_t PROF_HostNow(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+}
+#endif
+
+#endif /* PROF_ENABLE */
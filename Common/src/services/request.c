@@ -0,0 +1,271 @@
+/*============================================================================
+ *  Module      : Services REQ
+ *  File Name   : request.c
+ *  Description : Sequence-numbered request/response tracking on top of the
+ *                frame codec
+ *===========================================================================*/
+
+#include "services/request.h"
+
+#include <stddef.h>
+#include "services/timebase.h"
+#include "services/trace.h"
+
+/*======================================================================
+ *  Private types and data
+ *====================================================================*/
+
+typedef struct
+{
+    REQ_StatusType status;
+    uint8_t        seq;
+    uint32_t       startMs;
+    uint32_t       timeoutMs;
+    uint32_t       sentUs;      /* For the round-trip statistics */
+    FRAME_Type     response;
+} Req_SlotType;
+
+static Req_SlotType   g_Req_Slots[REQ_MAX_OUTSTANDING];
+static REQ_SendFnType g_Req_SendFn = NULL;
+static uint8_t        g_Req_NextSeq = 1U;
+static uint8_t        g_Req_MaxPayload = REQ_MAX_PAYLOAD;
+static REQ_StatsType  g_Req_Stats;
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+/* Build [seq][payload] and hand it to the transmit hook */
+static uint8_t prv_sendWithSeq(uint8_t seq, uint8_t cmd,
+                               const uint8_t *payload, uint8_t len)
+{
+    uint8_t buf[FRAME_MAX_PAYLOAD];
+    uint8_t i;
+
+    if ((g_Req_SendFn == NULL) || (len > g_Req_MaxPayload) ||
+        ((payload == NULL) && (len != 0U)))
+    {
+        return 0xFFU;
+    }
+
+    buf[0] = seq;
+    for (i = 0U; i < len; i++)
+    {
+        buf[1U + i] = payload[i];
+    }
+
+    return g_Req_SendFn(cmd, buf, (uint8_t)(len + 1U));
+}
+
+/* Use up the current sequence number, skipping REQ_SEQ_UNSOLICITED on wrap */
+static void prv_advanceSeq(void)
+{
+    g_Req_NextSeq++;
+    if (g_Req_NextSeq == REQ_SEQ_UNSOLICITED)
+    {
+        g_Req_NextSeq = 1U;
+    }
+}
+
+/* Completed request and its round trip */
+static void prv_countRtt(uint32_t rttUs)
+{
+    if ((g_Req_Stats.completed == 0U) || (rttUs < g_Req_Stats.rttMinUs))
+    {
+        g_Req_Stats.rttMinUs = rttUs;
+    }
+    if (rttUs > g_Req_Stats.rttMaxUs)
+    {
+        g_Req_Stats.rttMaxUs = rttUs;
+    }
+    g_Req_Stats.rttTotalUs += rttUs;
+    g_Req_Stats.completed++;
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void REQ_Init(REQ_SendFnType sendFn, uint8_t maxPayload)
+{
+    uint8_t i;
+
+    for (i = 0U; i < REQ_MAX_OUTSTANDING; i++)
+    {
+        g_Req_Slots[i].status = REQ_STATUS_FREE;
+    }
+
+    g_Req_SendFn  = sendFn;
+    g_Req_NextSeq = 1U;
+
+    /* The SEQ byte comes out of what the transport carries */
+    if (maxPayload > FRAME_MAX_PAYLOAD)
+    {
+        maxPayload = FRAME_MAX_PAYLOAD;
+    }
+    g_Req_MaxPayload = (maxPayload > 0U) ? (uint8_t)(maxPayload - 1U) : 0U;
+
+    g_Req_Stats.sent      = 0U;
+    g_Req_Stats.completed = 0U;
+    g_Req_Stats.timeouts  = 0U;
+    g_Req_Stats.unmatched = 0U;
+    g_Req_Stats.rttMinUs   = 0U;
+    g_Req_Stats.rttMaxUs   = 0U;
+    g_Req_Stats.rttTotalUs = 0U;
+}
+
+uint8_t REQ_Send(uint8_t cmd, const uint8_t *payload, uint8_t len,
+                 uint32_t timeoutMs, uint32_t nowMs)
+{
+    Req_SlotType *slot;
+    uint8_t i;
+
+    for (i = 0U; i < REQ_MAX_OUTSTANDING; i++)
+    {
+        if (g_Req_Slots[i].status == REQ_STATUS_FREE)
+        {
+            break;
+        }
+    }
+
+    if (i == REQ_MAX_OUTSTANDING)
+    {
+        return REQ_INVALID_HANDLE;
+    }
+
+    slot = &g_Req_Slots[i];
+    if (prv_sendWithSeq(g_Req_NextSeq, cmd, payload, len) != 0U)
+    {
+        return REQ_INVALID_HANDLE;
+    }
+
+    slot->seq = g_Req_NextSeq;
+    prv_advanceSeq();
+    TRACE(TRACE_EVT_REQ_SEND, cmd, slot->seq);
+
+    slot->startMs   = nowMs;
+    slot->timeoutMs = timeoutMs;
+    slot->sentUs    = TIME_GetUs();
+    slot->status    = REQ_STATUS_PENDING;
+    g_Req_Stats.sent++;
+
+    return i;
+}
+
+uint8_t REQ_GetMaxPayload(void)
+{
+    return g_Req_MaxPayload;
+}
+
+boolean REQ_OnFrame(const FRAME_Type *frame)
+{
+    uint8_t seq;
+    uint8_t i;
+
+    if ((frame == NULL) || (frame->len == 0U))
+    {
+        return FALSE;
+    }
+
+    seq = frame->payload[0];
+    if (seq == REQ_SEQ_UNSOLICITED)
+    {
+        return FALSE;
+    }
+
+    for (i = 0U; i < REQ_MAX_OUTSTANDING; i++)
+    {
+        if ((g_Req_Slots[i].status == REQ_STATUS_PENDING) &&
+            (g_Req_Slots[i].seq == seq))
+        {
+            (void)REQ_Unwrap(frame, &seq, &g_Req_Slots[i].response);
+            TRACE(TRACE_EVT_RESP_RECV, frame->cmd, seq);
+            g_Req_Slots[i].status = REQ_STATUS_DONE;
+            prv_countRtt(TIME_GetUs() - g_Req_Slots[i].sentUs);
+            return TRUE;
+        }
+    }
+
+    g_Req_Stats.unmatched++;
+    return FALSE;
+}
+
+void REQ_Tick(uint32_t nowMs)
+{
+    uint8_t i;
+
+    for (i = 0U; i < REQ_MAX_OUTSTANDING; i++)
+    {
+        /* Wrap-around safe elapsed time */
+        if ((g_Req_Slots[i].status == REQ_STATUS_PENDING) &&
+            ((nowMs - g_Req_Slots[i].startMs) >= g_Req_Slots[i].timeoutMs))
+        {
+            g_Req_Slots[i].status = REQ_STATUS_TIMEOUT;
+            g_Req_Stats.timeouts++;
+        }
+    }
+}
+
+REQ_StatusType REQ_GetStatus(uint8_t handle, FRAME_Type *response)
+{
+    uint8_t i;
+
+    if (handle >= REQ_MAX_OUTSTANDING)
+    {
+        return REQ_STATUS_FREE;
+    }
+
+    if ((g_Req_Slots[handle].status == REQ_STATUS_DONE) && (response != NULL))
+    {
+        response->cmd = g_Req_Slots[handle].response.cmd;
+        response->len = g_Req_Slots[handle].response.len;
+        for (i = 0U; i < response->len; i++)
+        {
+            response->payload[i] = g_Req_Slots[handle].response.payload[i];
+        }
+    }
+
+    return g_Req_Slots[handle].status;
+}
+
+void REQ_Release(uint8_t handle)
+{
+    if (handle < REQ_MAX_OUTSTANDING)
+    {
+        g_Req_Slots[handle].status = REQ_STATUS_FREE;
+    }
+}
+
+boolean REQ_Unwrap(const FRAME_Type *frame, uint8_t *seq, FRAME_Type *body)
+{
+    uint8_t i;
+
+    if ((frame == NULL) || (seq == NULL) || (body == NULL) || (frame->len == 0U))
+    {
+        return FALSE;
+    }
+
+    *seq      = frame->payload[0];
+    body->cmd = frame->cmd;
+    body->len = (uint8_t)(frame->len - 1U);
+    for (i = 0U; i < body->len; i++)
+    {
+        body->payload[i] = frame->payload[1U + i];
+    }
+
+    return TRUE;
+}
+
+uint8_t REQ_Reply(uint8_t seq, uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    TRACE(TRACE_EVT_RESP_SEND, cmd, seq);
+    return prv_sendWithSeq(seq, cmd, payload, len);
+}
+
+void REQ_GetStats(REQ_StatsType *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = g_Req_Stats;
+    }
+}
@@ -0,0 +1,232 @@
+/*============================================================================
+ *  Module      : Services SWTIMER
+ *  File Name   : swtimer.c
+ *  Description : Software timers on a hierarchical timer wheel
+ *===========================================================================*/
+
+#include "services/swtimer.h"
+
+#include <stddef.h>
+
+/*======================================================================
+ *  Private data
+ *====================================================================*/
+
+#define SWTIMER_SLOT_MASK       (SWTIMER_WHEEL_SLOTS - 1U)
+
+static SWTIMER_Type *g_SwTimer_Wheel[SWTIMER_LEVELS][SWTIMER_WHEEL_SLOTS];
+static uint32_t      g_SwTimer_NextMs;      /* Next tick to process */
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+static void prv_unlink(SWTIMER_Type *timer)
+{
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    *timer->pprev = timer->next;
+    timer->next   = NULL;
+    timer->pprev  = NULL;
+}
+
+static void prv_pushFront(SWTIMER_Type **head, SWTIMER_Type *timer)
+{
+    timer->next  = *head;
+    timer->pprev = head;
+    if (*head != NULL)
+    {
+        (*head)->pprev = &timer->next;
+    }
+    *head = timer;
+}
+
+/* Link a timer into the slot that holds its expiry (expiry >= next tick) */
+static void prv_insert(SWTIMER_Type *timer)
+{
+    uint32_t delta = timer->expiryMs - g_SwTimer_NextMs;
+    uint8_t  level = 0U;
+
+    while ((level < (SWTIMER_LEVELS - 1U)) &&
+           (delta >= (1UL << (SWTIMER_WHEEL_BITS * (level + 1U)))))
+    {
+        level++;
+    }
+
+    prv_pushFront(&g_SwTimer_Wheel[level]
+                      [(timer->expiryMs >> (SWTIMER_WHEEL_BITS * level)) & SWTIMER_SLOT_MASK],
+                  timer);
+}
+
+/* Spread one slot of a higher level over the levels below it */
+static void prv_cascade(uint8_t level, uint32_t index)
+{
+    SWTIMER_Type *list = g_SwTimer_Wheel[level][index];
+    SWTIMER_Type *timer;
+
+    g_SwTimer_Wheel[level][index] = NULL;
+
+    while (list != NULL)
+    {
+        timer = list;
+        list  = timer->next;
+        prv_insert(timer);
+    }
+}
+
+/* Process tick g_SwTimer_NextMs */
+static void prv_tick(void)
+{
+    uint32_t      tick = g_SwTimer_NextMs;
+    uint32_t      index = tick & SWTIMER_SLOT_MASK;
+    uint8_t       level = 1U;
+    SWTIMER_Type *expired;
+    SWTIMER_Type *timer;
+
+    /* Level 0 wrapped: bring the next slot of each wrapped level down */
+    while ((index == 0U) && (level < SWTIMER_LEVELS))
+    {
+        index = (tick >> (SWTIMER_WHEEL_BITS * level)) & SWTIMER_SLOT_MASK;
+        prv_cascade(level, index);
+        level++;
+    }
+
+    /* Take the due slot as a private list: callbacks may stop timers in
+     * it or start timers for later ticks while it is being emptied */
+    expired = g_SwTimer_Wheel[0][tick & SWTIMER_SLOT_MASK];
+    g_SwTimer_Wheel[0][tick & SWTIMER_SLOT_MASK] = NULL;
+    if (expired != NULL)
+    {
+        expired->pprev = &expired;
+    }
+    g_SwTimer_NextMs = tick + 1U;
+
+    while (expired != NULL)
+    {
+        timer = expired;
+        prv_unlink(timer);
+
+        if (timer->periodMs != 0U)
+        {
+            timer->expiryMs = tick + timer->periodMs;
+            prv_insert(timer);
+        }
+
+        timer->callback(timer->context);
+    }
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void SWTIMER_Init(uint32_t nowMs)
+{
+    uint8_t  level;
+    uint32_t index;
+
+    for (level = 0U; level < SWTIMER_LEVELS; level++)
+    {
+        for (index = 0U; index < SWTIMER_WHEEL_SLOTS; index++)
+        {
+            g_SwTimer_Wheel[level][index] = NULL;
+        }
+    }
+
+    g_SwTimer_NextMs = nowMs + 1U;
+}
+
+void SWTIMER_Setup(SWTIMER_Type *timer, SWTIMER_CallbackType callback, void *context)
+{
+    if (timer == NULL)
+    {
+        return;
+    }
+
+    timer->next     = NULL;
+    timer->pprev    = NULL;
+    timer->expiryMs = 0U;
+    timer->periodMs = 0U;
+    timer->callback = callback;
+    timer->context  = context;
+}
+
+void SWTIMER_Start(SWTIMER_Type *timer, uint32_t delayMs, uint32_t periodMs)
+{
+    if ((timer == NULL) || (timer->callback == NULL))
+    {
+        return;
+    }
+
+    SWTIMER_Stop(timer);
+
+    if (delayMs == 0U)
+    {
+        delayMs = 1U;
+    }
+    if (delayMs > SWTIMER_MAX_DELAY_MS)
+    {
+        delayMs = SWTIMER_MAX_DELAY_MS;
+    }
+    if (periodMs > SWTIMER_MAX_DELAY_MS)
+    {
+        periodMs = SWTIMER_MAX_DELAY_MS;
+    }
+
+    /* Delays count from the last processed tick */
+    timer->expiryMs = (g_SwTimer_NextMs - 1U) + delayMs;
+    timer->periodMs = periodMs;
+    prv_insert(timer);
+}
+
+void SWTIMER_Stop(SWTIMER_Type *timer)
+{
+    if ((timer != NULL) && (timer->pprev != NULL))
+    {
+        prv_unlink(timer);
+    }
+}
+
+boolean SWTIMER_IsActive(const SWTIMER_Type *timer)
+{
+    return ((timer != NULL) && (timer->pprev != NULL)) ? TRUE : FALSE;
+}
+
+void SWTIMER_Process(uint32_t nowMs)
+{
+    while ((int32_t)(nowMs - g_SwTimer_NextMs) >= 0)
+    {
+        prv_tick();
+    }
+}
+
+uint32_t SWTIMER_GetIdleMs(uint32_t nowMs, uint32_t maxMs)
+{
+    uint32_t ahead;
+    uint32_t tick;
+
+    if ((int32_t)(nowMs - g_SwTimer_NextMs) >= 0)
+    {
+        return 0U;
+    }
+
+    /* Level 0 holds exactly the next SWTIMER_WHEEL_SLOTS ticks */
+    if (maxMs > SWTIMER_WHEEL_SLOTS)
+    {
+        maxMs = SWTIMER_WHEEL_SLOTS;
+    }
+
+    for (ahead = 1U; ahead < maxMs; ahead++)
+    {
+        tick = nowMs + ahead;
+        if (((tick & SWTIMER_SLOT_MASK) == 0U) ||
+            (g_SwTimer_Wheel[0][tick & SWTIMER_SLOT_MASK] != NULL))
+        {
+            return ahead;
+        }
+    }
+
+    return maxMs;
+}
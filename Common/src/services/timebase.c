@@ -0,0 +1,114 @@
+/*============================================================================
+ *  Module      : Services TIME
+ *  File Name   : timebase.c
+ *  Description : 64-bit monotonic microsecond timebase
+ *===========================================================================*/
+
+#include "services/timebase.h"
+
+#include <stdbool.h>
+#include "driverlib/sysctl.h"
+#include "mcal/mcal_gpt.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define TIME_GPT            (GPT_WTIMER0A)
+#define TIME_TICK_HZ        (1000000U)
+
+/*======================================================================
+ *  Private data
+ *====================================================================*/
+
+/* Counter wraps handled by the ISR (upper 32 bits of the time) */
+static volatile uint32_t g_Time_Epoch = 0U;
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+/* WTIMER0A timeout (interrupt context) */
+static void prv_onWrap(void)
+{
+    g_Time_Epoch++;
+}
+
+/* Microseconds into the current epoch; the counter runs down from
+ * 0xFFFFFFFF, so the elapsed count is its complement */
+static uint32_t prv_readTicks(void)
+{
+    return ~Gpt_GetValue(TIME_GPT);
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void TIME_Init(void)
+{
+    Gpt_ConfigType config;
+
+    config.timer_InitialValue = 0xFFFFFFFFU;
+    config.timer_CompareValue = 0U;
+    config.timer_ID           = TIME_GPT;
+    config.timer_mode         = GPT_MODE_PERIODIC;
+    config.captureEdge        = GPT_CAPTURE_EDGE_RISING;
+    config.enableInterrupt    = 1U;
+    config.timer_Prescale     = (uint16_t)((SysCtlClockGet() / TIME_TICK_HZ) - 1U);
+
+    g_Time_Epoch = 0U;
+
+    Gpt_Init(&config);
+    Gpt_SetCallBack(prv_onWrap, TIME_GPT);
+    Gpt_Start(TIME_GPT);
+}
+
+uint64_t TIME_GetUs64(void)
+{
+    uint32_t epoch;
+    uint32_t ticks;
+    boolean  wrapped;
+
+    /* Retry if the wrap ISR ran in between: epoch and ticks must come
+     * from the same side of a wrap */
+    do
+    {
+        epoch   = g_Time_Epoch;
+        ticks   = prv_readTicks();
+        wrapped = Gpt_IsTimeoutPending(TIME_GPT) ? TRUE : FALSE;
+        if (wrapped)
+        {
+            /* Wrapped but not counted yet; the first read may predate
+             * the wrap, this one does not */
+            ticks = prv_readTicks();
+        }
+    } while (epoch != g_Time_Epoch);
+
+    if (wrapped)
+    {
+        epoch++;
+    }
+
+    return ((uint64_t)epoch << 32) | ticks;
+}
+
+uint32_t TIME_GetUs(void)
+{
+    return prv_readTicks();
+}
+
+void TIME_DelayUs(uint32_t us)
+{
+    uint32_t start = prv_readTicks();
+
+    /* The first tick may come right after start, so wait one more;
+     * unsigned subtraction handles the counter wrap */
+    if (us == 0xFFFFFFFFU)
+    {
+        us--;
+    }
+    while ((prv_readTicks() - start) <= us)
+    {
+    }
+}
@@ -0,0 +1,220 @@
+/*============================================================================
+ *  Module      : Services TRACE
+ *  File Name   : trace.c
+ *  Description : Timestamped binary event trace, drained as packets for the
+ *                host exporter (Common/host/trace_export.c)
+ *===========================================================================*/
+
+#include "services/trace.h"
+
+#if (TRACE_ENABLE != 0)
+
+#include <string.h>
+#include "driverlib/cpu.h"
+#include "services/console.h"
+#include "services/crc16.h"
+#include "services/timebase.h"
+
+/*======================================================================
+ *  Defines
+ *====================================================================*/
+
+#define TRACE_MASK              (TRACE_DEPTH - 1U)
+
+/*======================================================================
+ *  Private data
+ *
+ *  Any context produces (under a brief interrupt mask); the application
+ *  loop consumes. Indices run free; a record is only written into a slot
+ *  the consumer has finished with, so the consumer needs no lock.
+ *====================================================================*/
+
+static TRACE_RecordType  g_Trace_Ring[TRACE_DEPTH];
+static volatile uint16_t g_Trace_Head    = 0U;
+static volatile uint16_t g_Trace_Tail    = 0U;
+static volatile uint32_t g_Trace_Dropped = 0U;
+static volatile uint32_t g_Trace_Count   = 0U;      /* Records taken */
+static volatile boolean  g_Trace_Running = FALSE;
+static uint8_t           g_Trace_Ecu     = 0U;
+static uint16_t          g_Trace_Seq     = 0U;
+
+/*======================================================================
+ *  Private helpers
+ *====================================================================*/
+
+static void prv_putU16(uint8_t *buf, uint16_t *pos, uint16_t value)
+{
+    buf[(*pos)++] = (uint8_t)(value >> 8);
+    buf[(*pos)++] = (uint8_t)value;
+}
+
+static void prv_putU32(uint8_t *buf, uint16_t *pos, uint32_t value)
+{
+    buf[(*pos)++] = (uint8_t)(value >> 24);
+    buf[(*pos)++] = (uint8_t)(value >> 16);
+    buf[(*pos)++] = (uint8_t)(value >> 8);
+    buf[(*pos)++] = (uint8_t)value;
+}
+
+/*======================================================================
+ *  API implementations
+ *====================================================================*/
+
+void TRACE_Init(uint8_t ecu)
+{
+    g_Trace_Running = FALSE;
+    g_Trace_Ecu     = ecu;
+    g_Trace_Seq     = 0U;
+    g_Trace_Head    = 0U;
+    g_Trace_Tail    = 0U;
+    g_Trace_Dropped = 0U;
+    g_Trace_Count   = 0U;
+
+    MCAL_Trace_SetHook(TRACE_Record);
+}
+
+void TRACE_Start(void)
+{
+    uint32_t primask = CPUcpsid();
+
+    g_Trace_Tail    = g_Trace_Head;
+    g_Trace_Dropped = 0U;
+    g_Trace_Count   = 0U;
+    g_Trace_Running = TRUE;
+
+    if (primask == 0U)
+    {
+        CPUcpsie();
+    }
+}
+
+void TRACE_Stop(void)
+{
+    g_Trace_Running = FALSE;
+}
+
+void TRACE_Record(uint8_t event, uint8_t arg8, uint16_t arg16)
+{
+    TRACE_RecordType *rec;
+    uint32_t          primask;
+
+    if (!g_Trace_Running)
+    {
+        return;
+    }
+
+    /* Stamp and slot are taken together, so the ring stays in time order
+     * when an ISR records in the middle of thread code */
+    primask = CPUcpsid();
+
+    if ((uint16_t)(g_Trace_Head - g_Trace_Tail) >= TRACE_DEPTH)
+    {
+        g_Trace_Dropped++;
+    }
+    else
+    {
+        rec = &g_Trace_Ring[g_Trace_Head & TRACE_MASK];
+        rec->stamp  = TIME_GetUs();
+        rec->event  = event;
+        rec->arg8   = arg8;
+        rec->arg16  = arg16;
+        g_Trace_Head++;
+        g_Trace_Count++;
+    }
+
+    if (primask == 0U)
+    {
+        CPUcpsie();
+    }
+}
+
+uint16_t TRACE_BuildPacket(uint8_t *out, uint16_t size)
+{
+    uint8_t  body[TRACE_BODY_MAX_SIZE];
+    uint16_t pos = 0U;
+    uint16_t count;
+    uint16_t tail;
+    uint16_t len;
+    uint64_t nowUs;
+    const TRACE_RecordType *rec;
+
+    if ((out == NULL) || (size < TRACE_PACKET_MAX_SIZE))
+    {
+        return 0U;
+    }
+
+    count = (uint16_t)(g_Trace_Head - g_Trace_Tail);
+    if (count == 0U)
+    {
+        return 0U;
+    }
+    if (count > TRACE_RECORDS_PER_PACKET)
+    {
+        count = TRACE_RECORDS_PER_PACKET;
+    }
+
+    /* The stamp clock is the low word of the timebase: one read gives
+     * both, newer than every record taken */
+    nowUs = TIME_GetUs64();
+
+    body[pos++] = TRACE_MAGIC_0;
+    body[pos++] = TRACE_MAGIC_1;
+    body[pos++] = TRACE_VERSION;
+    body[pos++] = g_Trace_Ecu;
+    prv_putU16(body, &pos, g_Trace_Seq++);
+    prv_putU32(body, &pos, TRACE_STAMP_HZ);
+    prv_putU32(body, &pos, (uint32_t)nowUs);
+    prv_putU32(body, &pos, (uint32_t)(nowUs >> 32));
+    prv_putU32(body, &pos, (uint32_t)nowUs);
+    prv_putU32(body, &pos, g_Trace_Dropped);
+    body[pos++] = (uint8_t)count;
+
+    for (tail = g_Trace_Tail; count > 0U; count--, tail++)
+    {
+        rec = &g_Trace_Ring[tail & TRACE_MASK];
+        prv_putU32(body, &pos, rec->stamp);
+        body[pos++] = rec->event;
+        body[pos++] = rec->arg8;
+        prv_putU16(body, &pos, rec->arg16);
+    }
+    g_Trace_Tail = tail;
+
+    prv_putU16(body, &pos, CRC16_Compute(body, pos));
+
+    out[0] = COBS_DELIMITER;
+    len = COBS_Encode(body, pos, &out[1], (uint16_t)(size - 1U));
+
+    return (len != 0U) ? (uint16_t)(len + 1U) : 0U;
+}
+
+void TRACE_ConsoleCmd(uint8_t argc, char *argv[])
+{
+    if (argc > 1U)
+    {
+        if (strcmp(argv[1], "on") == 0)
+        {
+            /* Binary packets follow on this port from now on */
+            TRACE_Start();
+            return;
+        }
+        if (strcmp(argv[1], "off") == 0)
+        {
+            TRACE_Stop();
+            CONSOLE_Print("trace off\r\n");
+            return;
+        }
+        CONSOLE_Print("usage: trace [on|off]\r\n");
+        return;
+    }
+
+    CONSOLE_Print(g_Trace_Running ? "recording\r\n" : "stopped\r\n");
+    CONSOLE_Print("records  ");
+    CONSOLE_PrintDec(g_Trace_Count);
+    CONSOLE_Print("\r\ndropped  ");
+    CONSOLE_PrintDec(g_Trace_Dropped);
+    CONSOLE_Print("\r\npending  ");
+    CONSOLE_PrintDec((uint16_t)(g_Trace_Head - g_Trace_Tail));
+    CONSOLE_Print("\r\n");
+}
+
+#endif /* TRACE_ENABLE */
@@ -11,42 +11,247 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "Types.h"
+#include "services/frame.h"
+#include "services/commrec.h"
+#include "services/cobs.h"
+#include "services/link.h"
 
 /*======================================================================
  *  Defines
  *====================================================================*/
 
-/* UART Configuration */
-#define HAL_COMM_UART_MODULE        UART1_BASE
-#define HAL_COMM_UART_PERIPH        SYSCTL_PERIPH_UART1
-#define HAL_COMM_GPIO_PERIPH        SYSCTL_PERIPH_GPIOB
-#define HAL_COMM_GPIO_PORT          GPIO_PORTB_BASE
-#define HAL_COMM_RX_PIN             GPIO_PIN_0     /* PB0 - U1RX */
-#define HAL_COMM_TX_PIN             GPIO_PIN_1     /* PB1 - U1TX */
+/* UART ports: index into the pin table in hal_comm.c. Pins as routed
+ * on this board; the notes name what else uses them. */
+#define HAL_COMM_PORT_UART0         (0U)           /* PA0/PA1 - ICDI virtual COM port */
+#define HAL_COMM_PORT_UART1         (1U)           /* PB0/PB1 */
+#define HAL_COMM_PORT_UART2         (2U)           /* PD6/PD7 (PD7 unlocked on open) */
+#define HAL_COMM_PORT_UART3         (3U)           /* PC6/PC7 - HMI keypad columns */
+#define HAL_COMM_PORT_UART4         (4U)           /* PC4/PC5 - HMI keypad columns, U1RTS/CTS */
+#define HAL_COMM_PORT_UART5         (5U)           /* PE4/PE5 */
+#define HAL_COMM_PORT_UART6         (6U)           /* PD4/PD5 */
+#define HAL_COMM_PORT_UART7         (7U)           /* PE0/PE1 */
+#define HAL_COMM_NUM_PORTS          (8U)
+
+/* UARTn_BASE are 4 KB apart, so a constant port folds to a constant base */
+#define HAL_COMM_PORT_BASE(port)    (UART0_BASE + ((uint32_t)(port) << 12))
+
+/* Link UART: the port carrying the frame protocol to the other ECU */
+#ifndef HAL_COMM_PORT
+#define HAL_COMM_PORT               HAL_COMM_PORT_UART1
+#endif
+#define HAL_COMM_UART_MODULE        HAL_COMM_PORT_BASE(HAL_COMM_PORT)
 #define HAL_COMM_BAUD_RATE          115200U
 #define HAL_COMM_SYSTEM_CLOCK       16000000U      /* 16 MHz */
 
+/* Flow control (mcal_uart.h UART_FLOW_*).
+ * - UART_FLOW_RTS_CTS uses PC4 (U1RTS) / PC5 (U1CTS), so the link must be
+ *   on UART1; those pins are keypad columns on the HMI board, so only
+ *   enable it on boards that route them.
+ * - UART_FLOW_XON_XOFF is in-band and 0x11/0x13 may appear inside binary
+ *   frames (LEN, SEQ, CRC), so it is only usable for text traffic. */
+#ifndef HAL_COMM_FLOW_CONTROL
+#define HAL_COMM_FLOW_CONTROL       UART_FLOW_NONE
+#endif
+#define HAL_COMM_RTS_PIN            GPIO_PIN_4     /* PC4 - U1RTS */
+#define HAL_COMM_CTS_PIN            GPIO_PIN_5     /* PC5 - U1CTS */
+
+/* Baud-rate negotiation (HAL_COMM_NegotiateBaud). The link always comes
+ * up at HAL_COMM_BAUD_RATE; faster rates are tried fastest first and only
+ * kept once a test pattern has been echoed intact at that rate. */
+#define HAL_COMM_BAUD_CANDIDATES    { 2000000U, 1000000U, 921600U, 460800U, 230400U }
+#define HAL_COMM_BAUD_TEST_ROUNDS   (4U)           /* Echoed test frames per candidate */
+#define HAL_COMM_BAUD_TEST_LEN      (32U)          /* Test pattern bytes per frame */
+#define HAL_COMM_BAUD_RETRIES       (3U)           /* Proposal/commit attempts */
+#define HAL_COMM_BAUD_REPLY_MS      (50U)          /* Wait for each echo */
+#define HAL_COMM_BAUD_SETTLE_MS     (2U)           /* Proposer pause after switching, so the peer switches first */
+#define HAL_COMM_BAUD_TRIAL_MS      (200U)         /* Responder drops a silent trial rate after this */
+#define HAL_COMM_BAUD_CACHE_ADDR    (32U)          /* EEPROM word caching the agreed rate (Control layout: after timeout at 28) */
+#define HAL_COMM_BAUD_REPROBE_MS    (3600000U)     /* After a full probe found no faster rate, none again for this long */
+
+/* Link-control commands, below ' ' so they never collide with application
+ * commands; HAL_COMM_PollFrame() answers them and does not return them.
+ * 0x01..0x03 are the baud negotiation below, 0x04..0x07 and 0x0A
+ * services/link.h, 0x08 the heartbeat, 0x09 the bus poll. */
+#define HAL_COMM_CMD_BAUD_PROPOSE   (0x01U)        /* [rate BE32] at the base rate; echoed, [0] refuses */
+#define HAL_COMM_CMD_BAUD_TEST      (0x02U)        /* Test pattern at the trial rate; echoed */
+#define HAL_COMM_CMD_BAUD_COMMIT    (0x03U)        /* Keep the trial rate; echoed */
+#define HAL_COMM_CMD_HEARTBEAT      (0x08U)        /* (none); never acknowledged */
+#define HAL_COMM_CMD_POLL           (0x09U)        /* (none); bus master gives a slave its turn */
+
+/* Liveness supervision. HAL_COMM_OnTick() sends a heartbeat frame whenever
+ * the link has been quiet for HAL_COMM_HEARTBEAT_MS, so it costs nothing
+ * while traffic flows; any valid frame from the peer counts as a sign of
+ * life. After HAL_COMM_LIVENESS_MS without one the peer is reported lost
+ * and the link drops back to HAL_COMM_BAUD_RATE, the rate a rebooted peer
+ * starts at. */
+#define HAL_COMM_HEARTBEAT_MS       (1000U)
+#define HAL_COMM_LIVENESS_MS        (3500U)        /* Three heartbeats missed */
+
 /* Communication buffer sizes */
-#define HAL_COMM_RX_BUFFER_SIZE     (64U)          /* Receive buffer size */
-#define HAL_COMM_TX_BUFFER_SIZE     (64U)          /* Transmit buffer size */
+#define HAL_COMM_RX_BUFFER_SIZE     (128U)         /* ISR-fed receive ring (power of two) */
+#define HAL_COMM_TX_BUFFER_SIZE     (128U)         /* ISR-drained transmit ring (power of two) */
+
+/* Further ports (HAL_COMM_Open): plain byte streams next to the link, such
+ * as a debug console or a gateway. Their rings come from static pools
+ * sized here, one slot per open port. */
+#define HAL_COMM_MAX_OPEN_PORTS     (2U)
+#define HAL_COMM_PORT_RX_BUFFER_SIZE (64U)         /* Per open port (power of two) */
+#define HAL_COMM_PORT_TX_BUFFER_SIZE (512U)        /* Per open port (power of two) */
 
 /* Return codes */
 #define HAL_COMM_SUCCESS            (0U)
 #define HAL_COMM_ERROR_INIT         (1U)
 #define HAL_COMM_ERROR_INVALID      (2U)
 #define HAL_COMM_ERROR_BUFFER_FULL  (3U)
+#define HAL_COMM_ERROR_TIMEOUT      (4U)
+#define HAL_COMM_ERROR_BUSY         (5U)
+
+/* Timeout value meaning "wait until done" (Flush and *Timeout receives) */
+#define HAL_COMM_WAIT_FOREVER       (0U)
+
+/* Wire framing: 1 sends each frame COBS-encoded (services/cobs.h) and
+ * terminated by 0x00, so a receiver that joins mid-stream or sees noise
+ * resyncs at the next zero instead of hunting for a SOF that can also
+ * appear in payload bytes. Both ECUs must be built with the same value. */
+#ifndef HAL_COMM_FRAMING_COBS
+#define HAL_COMM_FRAMING_COBS       (0)
+#endif
+
+/* Bus mode. HAL_COMM_BUS_NONE is the point-to-point link between one
+ * Control and one HMI. On a multi-drop bus (RS-485 half duplex, the
+ * transceiver's DE and /RE driven together by HAL_COMM_DE_PIN) one master
+ * serves HAL_COMM_BUS_NODES slaves at addresses 1..N:
+ * - Every frame carries an address as its first payload byte: the
+ *   destination when the master sends (HAL_COMM_ADDR_BROADCAST reaches
+ *   all slaves), the sender's own address when a slave answers.
+ * - The master gives the slaves the bus in turn, round-robin: a frame
+ *   queued for that slave, or HAL_COMM_CMD_POLL if there is none.
+ * - A slave transmits only in answer to a frame addressed to it: its
+ *   oldest queued frame, or a heartbeat if it has nothing to say. It
+ *   keeps quiet if the frame was read more than HAL_COMM_BUS_REPLY_MS / 2
+ *   after it arrived, or with bus traffic behind it. A slave that has
+ *   not answered within HAL_COMM_BUS_REPLY_MS loses its turn;
+ *   one that has gone silent is polled once per HAL_COMM_HEARTBEAT_MS.
+ * So no two nodes ever drive the bus at once, and the polls double as
+ * heartbeats. Baud negotiation and HAL_COMM_RELIABLE are point-to-point
+ * only; a frame lost on the bus is left to the requester's timeout. */
+#define HAL_COMM_BUS_NONE           (0)
+#define HAL_COMM_BUS_MASTER         (1)            /* Control ECU */
+#define HAL_COMM_BUS_SLAVE          (2)            /* HMI panels */
+#ifndef HAL_COMM_BUS_MODE
+#define HAL_COMM_BUS_MODE           HAL_COMM_BUS_NONE
+#endif
+
+/* Node addresses. On a point-to-point link the peer is node 1. */
+#define HAL_COMM_NODE_PEER          (1U)
+#define HAL_COMM_ADDR_BROADCAST     (0xFFU)
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_NONE)
+#undef  HAL_COMM_BUS_NODES
+#define HAL_COMM_BUS_NODES          (1U)
+#elif !defined(HAL_COMM_BUS_NODES)
+#define HAL_COMM_BUS_NODES          (3U)           /* Panels polled by the master (1..254) */
+#endif
+#ifndef HAL_COMM_NODE_ADDRESS
+#define HAL_COMM_NODE_ADDRESS       (1U)           /* This slave's address, unique on the bus */
+#endif
+
+#define HAL_COMM_BUS_REPLY_MS       (10U)          /* Slave answer window */
+#define HAL_COMM_BUS_QUEUE_DEPTH    (8U)           /* Frames waiting for our turn */
+#define HAL_COMM_DE_PERIPH          SYSCTL_PERIPH_GPIOD
+#define HAL_COMM_DE_PORT            GPIO_PORTD_BASE
+#define HAL_COMM_DE_PIN             GPIO_PIN_2     /* PD2 - RS-485 driver enable */
+
+/* Reliable delivery: 1 carries every HAL_COMM_SendFrame() frame through
+ * services/link.h (sequence numbers, ACKs, retransmission, a window of
+ * LINK_WINDOW_SIZE frames), so a lost response is resent rather than left
+ * for the requester's timeout. Both ECUs must use the same value.
+ * services/link.h tracks a single peer, so it is off in bus mode. */
+#ifndef HAL_COMM_RELIABLE
+#if (HAL_COMM_BUS_MODE == HAL_COMM_BUS_NONE)
+#define HAL_COMM_RELIABLE           (1)
+#else
+#define HAL_COMM_RELIABLE           (0)
+#endif
+#endif
+
+#if (HAL_COMM_RELIABLE != 0) && (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+#error "HAL_COMM_RELIABLE needs a point-to-point link"
+#endif
+
+/* Largest HAL_COMM_SendFrame() payload: the link header or the bus
+ * address byte comes out of the frame's FRAME_MAX_PAYLOAD */
+#if (HAL_COMM_RELIABLE != 0)
+#define HAL_COMM_MAX_PAYLOAD        (LINK_MAX_PAYLOAD)
+#elif (HAL_COMM_BUS_MODE != HAL_COMM_BUS_NONE)
+#define HAL_COMM_MAX_PAYLOAD        (FRAME_MAX_PAYLOAD - 1U)
+#else
+#define HAL_COMM_MAX_PAYLOAD        (FRAME_MAX_PAYLOAD)
+#endif
+
+/* Silence inside a frame longer than this abandons the partial frame */
+#define HAL_COMM_FRAME_GAP_MS       (20U)
+
+/* Traffic recorder (services/commrec.h): 1 records every byte sent or
+ * consumed through this API with its tick; 0 compiles the hooks out */
+#ifndef HAL_COMM_RECORD_ENABLE
+#define HAL_COMM_RECORD_ENABLE      (0)
+#endif
+#define HAL_COMM_RECORD_DEPTH       (256U)         /* Records (power of two) */
+
+/*======================================================================
+ *  Types
+ *====================================================================*/
+
+/* Link health snapshot (HAL_COMM_GetStats); counters run since init */
+typedef struct
+{
+    uint32_t rxBytes;           /* Bytes received by the UART */
+    uint32_t txBytes;           /* Bytes handed to the UART */
+    uint32_t rxRingOverruns;    /* Bytes dropped because the RX ring was full */
+    uint32_t rxFifoOverruns;    /* Hardware FIFO overruns (bytes lost in the UART) */
+    uint32_t framingErrors;
+    uint32_t parityErrors;
+    uint32_t breaks;            /* Break conditions on the line */
+    uint32_t rxThrottles;       /* Times flow control paused the peer */
+    uint32_t crcErrors;         /* Frames dropped by the frame parser ... */
+    uint32_t lengthErrors;
+    uint32_t truncatedFrames;
+    uint32_t retransmits;       /* Link DATA frames sent again (HAL_COMM_RELIABLE) */
+    uint32_t linkDropped;       /* Link DATA frames given up on a resync (HAL_COMM_RELIABLE) */
+    uint16_t rxHighWater;       /* Peak RX ring fill in bytes */
+    uint16_t txHighWater;       /* Peak TX ring fill in bytes */
+    uint16_t rxBurstMax;        /* Most bytes drained by one UART interrupt */
+    uint32_t isrMaxCycles;      /* Longest UART interrupt in CPU cycles */
+} HAL_COMM_StatsType;
+
+/* An open port (HAL_COMM_Open). Filled in by hal_comm.c; the base is kept
+ * so each call costs the same as the link's fixed-base path plus a load. */
+typedef struct
+{
+    uint32_t uartBase;
+    uint8_t  port;              /* HAL_COMM_PORT_UARTn */
+} HAL_COMM_InstanceType;
+
+typedef const HAL_COMM_InstanceType *HAL_COMM_HandleType;
+
+/* Called while baud negotiation waits (HAL_COMM_SetWaitHook) */
+typedef void (*HAL_COMM_WaitHookType)(void);
 
 /*======================================================================
  *  API
  *====================================================================*/
 
 /**
- * @brief Initialize the HAL communication module (UART1).
+ * @brief Initialize the HAL communication module (the HAL_COMM_PORT link,
+ *        UART1 by default).
  *
  * This function:
- * - Enables UART1 and GPIOB peripheral clocks
- * - Configures PB0 (RX) and PB1 (TX) for UART1
- * - Initializes UART1 with 115200 baud, 8N1 configuration
+ * - Enables the link UART and its GPIO port clocks
+ * - Muxes its RX/TX pins from the pin table (PB0/PB1 for UART1)
+ * - Initializes the UART with 115200 baud, 8N1 configuration
+ * - Enables the UART RX interrupt feeding a HAL_COMM_RX_BUFFER_SIZE ring
+ * - Routes transmission through a HAL_COMM_TX_BUFFER_SIZE ring drained
+ *   by the UART TX interrupt
  *
  * Must be called before any other HAL_COMM functions.
  *
@@ -56,27 +261,267 @@
 uint8_t HAL_COMM_Init(void);
 
 /**
- * @brief Send a single byte over UART.
+ * @brief Queue a single byte for transmission over UART.
  *
- * Blocking function that waits until the byte is transmitted.
+ * Returns as soon as the byte is in the TX ring; only waits when the ring
+ * is full. Use HAL_COMM_Flush() to wait until it is actually on the wire.
  *
  * @param data  Byte to transmit
  */
 void HAL_COMM_SendByte(uint8_t data);
 
+/**
+ * @brief Wait until all queued bytes have been transmitted.
+ *
+ * @param timeoutMs  Maximum time to wait in milliseconds, or
+ *                   HAL_COMM_WAIT_FOREVER to wait until drained
+ * @return HAL_COMM_SUCCESS if the TX ring and shift register are empty
+ *         HAL_COMM_ERROR_TIMEOUT if the deadline expired first
+ */
+uint8_t HAL_COMM_Flush(uint32_t timeoutMs);
+
 /**
  * @brief Receive a single byte from UART.
  *
- * Blocking function that waits until a byte is received.
+ * Blocking function that waits until a byte is in the RX ring.
  *
  * @return Received byte
  */
 uint8_t HAL_COMM_ReceiveByte(void);
 
+/**
+ * @brief Receive a single byte, giving up after a deadline.
+ *
+ * @param data       Receives the byte on success
+ * @param timeoutMs  Maximum wait in milliseconds, or HAL_COMM_WAIT_FOREVER
+ * @return HAL_COMM_SUCCESS if a byte was received
+ *         HAL_COMM_ERROR_TIMEOUT if nothing arrived in time
+ *         HAL_COMM_ERROR_INVALID / HAL_COMM_ERROR_INIT on bad use
+ */
+uint8_t HAL_COMM_ReceiveByteTimeout(uint8_t *data, uint32_t timeoutMs);
+
+/**
+ * @brief Receive exactly len bytes, giving up after a deadline.
+ *
+ * The timeout covers the whole read, not each byte.
+ *
+ * @param buffer     Destination
+ * @param len        Number of bytes wanted
+ * @param timeoutMs  Maximum wait in milliseconds, or HAL_COMM_WAIT_FOREVER
+ * @param received   Optional; receives the number of bytes actually read
+ * @return HAL_COMM_SUCCESS if all len bytes were received
+ *         HAL_COMM_ERROR_TIMEOUT on a short read
+ *         HAL_COMM_ERROR_INVALID / HAL_COMM_ERROR_INIT on bad use
+ */
+uint8_t HAL_COMM_ReceiveBytesTimeout(uint8_t *buffer, uint32_t len,
+                                     uint32_t timeoutMs, uint32_t *received);
+
+/**
+ * @brief Start a bulk transmit of a buffer using uDMA.
+ *
+ * Non-blocking: the uDMA feeds the UART and the CPU only takes a completion
+ * interrupt per 1024-byte chunk. Waits (briefly) for the TX ring to drain
+ * first so byte order is preserved. The buffer must stay untouched until
+ * HAL_COMM_IsSendComplete() returns TRUE.
+ *
+ * @param data  Bytes to send
+ * @param len   Number of bytes
+ * @return HAL_COMM_SUCCESS if the transfer was started
+ *         HAL_COMM_ERROR_BUSY if a bulk transmit is already running
+ *         HAL_COMM_ERROR_INVALID if the arguments are invalid
+ */
+uint8_t HAL_COMM_SendBuffer(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Start a bulk receive of exactly len bytes using uDMA.
+ *
+ * Bytes already buffered are copied first; the rest is written by the
+ * uDMA. Byte-wise HAL_COMM_ReceiveByte()/IsDataAvailable() see nothing
+ * until HAL_COMM_IsReceiveComplete() returns TRUE.
+ *
+ * @param buffer  Destination
+ * @param len     Number of bytes to receive
+ * @return HAL_COMM_SUCCESS if the transfer was started (or already satisfied)
+ *         HAL_COMM_ERROR_BUSY if a bulk receive is already running
+ *         HAL_COMM_ERROR_INVALID if the arguments are invalid
+ */
+uint8_t HAL_COMM_ReceiveBuffer(uint8_t *buffer, uint32_t len);
+
+/**
+ * @brief Check whether the last HAL_COMM_SendBuffer() has finished.
+ */
+boolean HAL_COMM_IsSendComplete(void);
+
+/**
+ * @brief Check whether the last HAL_COMM_ReceiveBuffer() has finished.
+ */
+boolean HAL_COMM_IsReceiveComplete(void);
+
+/**
+ * @brief Encode and queue one protocol frame.
+ *
+ * Wraps the payload as SOF/LEN/CMD/PAYLOAD/CRC16 (see services/frame.h)
+ * and queues it on the TX ring. With HAL_COMM_RELIABLE the frame goes out
+ * as link DATA and is kept for retransmission until the peer ACKs it.
+ * In bus mode it waits in a queue for this node's turn; a master sends it
+ * to the node chosen with HAL_COMM_SelectNode().
+ *
+ * @param cmd      Command / response code
+ * @param payload  Payload bytes (may be NULL when len is 0)
+ * @param len      Payload length, 0..HAL_COMM_MAX_PAYLOAD
+ * @return HAL_COMM_SUCCESS if the frame was queued
+ *         HAL_COMM_ERROR_INVALID if the payload is too long
+ *         HAL_COMM_ERROR_BUSY if LINK_WINDOW_SIZE frames are still unacknowledged,
+ *         or HAL_COMM_BUS_QUEUE_DEPTH frames still wait for the bus
+ */
+uint8_t HAL_COMM_SendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len);
+
+/**
+ * @brief Drain buffered bytes into the frame parser.
+ *
+ * Non-blocking. Stops as soon as one complete, CRC-valid frame has been
+ * assembled; corrupt frames are counted and skipped. A frame whose sender
+ * goes quiet for HAL_COMM_FRAME_GAP_MS is treated as truncated and dropped.
+ * Link-control frames (HAL_COMM_CMD_BAUD_*) are answered here, which may
+ * block for up to HAL_COMM_BAUD_TRIAL_MS while a peer probes a new rate.
+ * With HAL_COMM_RELIABLE, ACKs and retransmissions are also handled here,
+ * so it must be called regularly even when no frame is expected.
+ * Heartbeats are consumed here and feed HAL_COMM_IsPeerAlive().
+ * In bus mode the address byte is stripped, frames for other slaves are
+ * skipped, and the bus turns (master polls, slave answers) run from here.
+ *
+ * @param frame  Receives the decoded frame
+ * @return TRUE if a frame was decoded, FALSE if none is complete yet
+ */
+boolean HAL_COMM_PollFrame(FRAME_Type *frame);
+
+/**
+ * @brief Wait for the next valid frame, giving up after a deadline.
+ *
+ * @param frame      Receives the decoded frame
+ * @param timeoutMs  Maximum wait in milliseconds, or HAL_COMM_WAIT_FOREVER
+ * @return HAL_COMM_SUCCESS if a frame was decoded
+ *         HAL_COMM_ERROR_TIMEOUT if none completed in time
+ */
+uint8_t HAL_COMM_ReceiveFrameTimeout(FRAME_Type *frame, uint32_t timeoutMs);
+
+/**
+ * @brief Raise the link to the fastest rate both ends can sustain.
+ *
+ * Run by one end (the Control ECU) once the peer is polling frames; the
+ * peer answers from HAL_COMM_PollFrame(). Each candidate in
+ * HAL_COMM_BAUD_CANDIDATES above clock/8 is skipped. A candidate is
+ * proposed at the base rate, then both ends switch and the proposer
+ * echoes HAL_COMM_BAUD_TEST_ROUNDS test frames; any CRC error, mismatch
+ * or timeout falls back to the base rate and the next candidate.
+ *
+ * An agreed faster rate is cached at HAL_COMM_BAUD_CACHE_ADDR
+ * (MCAL_EEPROM_Init() must have run); on the next boot it is tried alone,
+ * and the full probe only runs again if it fails. A full probe that finds
+ * nothing clears the cache rather than storing the base rate, and is not
+ * repeated for HAL_COMM_BAUD_REPROBE_MS (or until the next boot), so a
+ * peer that reconnects often is not probed each time.
+ * If the peer never answers, the link stays at the base rate and the
+ * cache is left untouched.
+ *
+ * Blocks while it runs: up to HAL_COMM_BAUD_TRIAL_MS + HAL_COMM_BAUD_REPLY_MS
+ * per failed candidate; the hook set with HAL_COMM_SetWaitHook() runs
+ * throughout.
+ * In bus mode every node stays at HAL_COMM_BAUD_RATE and this returns at once.
+ *
+ * @return The baud rate in use afterwards
+ */
+uint32_t HAL_COMM_NegotiateBaud(void);
+
+/**
+ * @brief Work to keep running while baud negotiation blocks, on either
+ *        side (e.g. the software timers).
+ *
+ * The hook is called repeatedly from the negotiation's wait loops. It
+ * must not send or receive on the link, which may be at a trial rate.
+ *
+ * @param hook  Called while waiting, or NULL for none
+ */
+void HAL_COMM_SetWaitHook(HAL_COMM_WaitHookType hook);
+
+/**
+ * @brief Current baud rate of the link.
+ */
+uint32_t HAL_COMM_GetBaudRate(void);
+
+/**
+ * @brief Heartbeat timer; call once per millisecond from the SysTick
+ *        callback (MCAL_SysTick_SetCallback()).
+ *
+ * Runs in interrupt context, so heartbeats keep flowing while the main
+ * loop is blocked. A heartbeat that would land inside a frame being
+ * queued by the main loop, a uDMA transmit or a baud-rate change is held
+ * back to the next tick. Heartbeats are not seen by the traffic recorder.
+ * The SysTick and link UART interrupts must share a priority (the reset
+ * default) so neither can preempt the other while touching the TX ring.
+ * In bus mode nothing is sent unprompted, so this does nothing.
+ */
+void HAL_COMM_OnTick(void);
+
+/**
+ * @brief Check whether the peer has been heard from recently.
+ *
+ * Updated by HAL_COMM_PollFrame(): a valid frame marks the peer alive,
+ * HAL_COMM_LIVENESS_MS of silence (with nothing left to parse) marks it
+ * lost. FALSE until the first frame after HAL_COMM_Init().
+ *
+ * @return TRUE while the peer is alive
+ */
+boolean HAL_COMM_IsPeerAlive(void);
+
+/**
+ * @brief Choose the destination of the following HAL_COMM_SendFrame() calls.
+ *
+ * Only used by a bus master; ignored on a point-to-point link and on a slave.
+ *
+ * @param node  1..HAL_COMM_BUS_NODES, or HAL_COMM_ADDR_BROADCAST
+ */
+void HAL_COMM_SelectNode(uint8_t node);
+
+/**
+ * @brief Node that sent the frame last returned by HAL_COMM_PollFrame().
+ *
+ * @return The slave's address on a bus master, HAL_COMM_NODE_PEER otherwise
+ */
+uint8_t HAL_COMM_GetSourceNode(void);
+
+/**
+ * @brief Check whether one node has been heard from recently.
+ *
+ * On a bus master each slave is supervised on its own; elsewhere this is
+ * HAL_COMM_IsPeerAlive() for HAL_COMM_NODE_PEER.
+ *
+ * @param node  1..HAL_COMM_BUS_NODES
+ * @return TRUE while the node is alive
+ */
+boolean HAL_COMM_IsNodeAlive(uint8_t node);
+
+/**
+ * @brief Snapshot of the link health counters.
+ *
+ * Counters not kept by a backend (e.g. ISR cycles on the host) read 0.
+ *
+ * @param stats  Receives the counters
+ */
+void HAL_COMM_GetStats(HAL_COMM_StatsType *stats);
+
+/**
+ * @brief Clear the UART counters and high-water marks.
+ *
+ * Frame parser and link counters keep running; compare two snapshots to
+ * see their rate.
+ */
+void HAL_COMM_ResetStats(void);
+
 /**
  * @brief Send a null-terminated string over UART.
  *
- * Blocking function that transmits the entire string.
+ * Queues the entire string; blocks only while the TX ring is full.
  *
  * @param str  Pointer to null-terminated string
  */
@@ -101,13 +546,76 @@ uint32_t HAL_COMM_ReceiveString(char *buffer, uint32_t maxLen);
 /**
  * @brief Check if data is available in UART receive buffer.
  *
- * Non-blocking function to check if data can be read without waiting.
+ * Non-blocking function to check if the RX ring holds unread data.
  *
  * @return TRUE if data is available
  *         FALSE if no data is available
  */
 boolean HAL_COMM_IsDataAvailable(void);
 
+/**
+ * @brief Take recorded traffic, oldest first.
+ *
+ * Bytes moved by HAL_COMM_ReceiveBuffer() (uDMA) are not recorded.
+ *
+ * @param out  Destination records
+ * @param max  Capacity of out
+ * @return Number of records copied (always 0 if HAL_COMM_RECORD_ENABLE is 0)
+ */
+uint16_t HAL_COMM_ReadRecording(COMMREC_RecordType *out, uint16_t max);
+
+/**
+ * @brief Open a further UART port as a byte stream (8N1, RX and TX rings).
+ *
+ * Muxes the port's pins from the pin table and gives it a ring pair from
+ * the pools. Independent of HAL_COMM_Init(); the link's own port cannot
+ * be opened again.
+ *
+ * @param port      HAL_COMM_PORT_UART0..HAL_COMM_PORT_UART7
+ * @param baudRate  Rate in bit/s
+ * @return Handle for the HAL_COMM_Port*() calls, or NULL if the port is
+ *         invalid, already open, or all HAL_COMM_MAX_OPEN_PORTS are in use
+ */
+HAL_COMM_HandleType HAL_COMM_Open(uint8_t port, uint32_t baudRate);
+
+/**
+ * @brief Queue one byte on an open port; waits only while its ring is full.
+ */
+void HAL_COMM_PortSendByte(HAL_COMM_HandleType handle, uint8_t data);
+
+/**
+ * @brief Queue a null-terminated string on an open port.
+ */
+void HAL_COMM_PortSendString(HAL_COMM_HandleType handle, const char *str);
+
+/**
+ * @brief Free space in an open port's transmit ring.
+ *
+ * That many bytes can be queued with HAL_COMM_PortSendByte() without
+ * waiting; lets a background producer send only what fits.
+ *
+ * @return Bytes free, or 0 for an invalid handle
+ */
+uint16_t HAL_COMM_PortGetTxRoom(HAL_COMM_HandleType handle);
+
+/**
+ * @brief Take one received byte from an open port without waiting.
+ *
+ * @param handle  From HAL_COMM_Open()
+ * @param data    Receives the byte
+ * @return TRUE if a byte was read, FALSE if none is waiting
+ */
+boolean HAL_COMM_PortReceiveByte(HAL_COMM_HandleType handle, uint8_t *data);
+
+/**
+ * @brief Wait until everything queued on an open port is on the wire.
+ *
+ * @param handle     From HAL_COMM_Open()
+ * @param timeoutMs  Maximum wait in milliseconds, or HAL_COMM_WAIT_FOREVER
+ * @return HAL_COMM_SUCCESS, HAL_COMM_ERROR_TIMEOUT or HAL_COMM_ERROR_INVALID
+ */
+uint8_t HAL_COMM_PortFlush(HAL_COMM_HandleType handle, uint32_t timeoutMs);
+
 /**
  * @brief Send formatted message over UART (for debugging).
  *
@@ -3,6 +3,20 @@
  *  - Displays menu on LCD
  *  - Reads keypad and potentiometer
  *  - Sends commands to Control ECU over UART using hal_comm
+ *    (one CRC-protected frame per command/response, see services/frame.h)
+ *  - Tracks requests by sequence number (services/request.h) so the menu,
+ *    keypad and door status keep running while Control works
+ *  - Watches link liveness (HAL_COMM heartbeats): when Control goes quiet
+ *    it shows "Link lost" and redoes the ready handshake once it is back
+ *  - Runs timed screens (the lockout countdown) on software timers
+ *    (services/swtimer.h), so link and door status stay live meanwhile
+ *  - Diagnostic console on UART0 (ICDI virtual COM port, 115200 8N1) in
+ *    DIAG_CONSOLE_ENABLE builds:
+ *    uptime from the microsecond timebase and, in PROF_ENABLE builds,
+ *    the "prof" table of keypad/LCD/ADC cycle counts, the CPU load meter
+ *    ("load"; the service loops sleep between passes); in TRACE_ENABLE
+ *    builds "trace on" streams the event trace (services/trace.h) for
+ *    Common/host/trace_export.c
  *===========================================================================*/
 
 #include <stdint.h>
@@ -18,6 +32,13 @@
 #include "hal/hal_rgb_led.h"
 #include "hal/hal_potentiometer.h"
 #include "hal/hal_comm.h"
+#include "services/request.h"
+#include "services/console.h"
+#include "services/prof.h"
+#include "services/swtimer.h"
+#include "services/timebase.h"
+#include "services/trace.h"
+#include "services/cpuload.h"
 
 #define PASSWORD_MAX_LENGTH     16U  /* Maximum password length (matches EEPROM HAL) */
 #define PASSWORD_MIN_LENGTH     5U   /* Minimum password length (matches EEPROM HAL) */
@@ -35,51 +56,152 @@ static uint8_t g_currentTimeout = TIMEOUT_DEFAULT_SECONDS;
 #define CMD_OPEN_DOOR           'O'
 #define CMD_CHANGE_PASSWORD     'C'
 #define CMD_SET_TIMEOUT         'T'
+#define CMD_READY_QUERY         'R'  /* Unsolicited: ask Control to resend Ready */
 
 /* Responses from Control ECU */
 #define RESP_SUCCESS            'Y'
 #define RESP_FAILURE            'N'
 #define RESP_LOCKOUT            'L'
 #define RESP_READY              'R'
+#define RESP_BUSY               'B'
+
+/* Unsolicited events from Control ECU */
+#define EVT_DOOR_STATE          'D'  /* [state][timestamp BE32][duration s] */
+
+/* Longest wait for a Control ECU reply before reporting "No Response" */
+#define RESPONSE_TIMEOUT_MS     2000U
+
+/* How often the ready query is repeated while waiting for Control */
+#define READY_QUERY_MS          1000U
+
+/* How long "Secure" stays in the menu corner after the door locks */
+#define DOOR_SECURED_SHOW_MS    2000U
+
+/* Door status shown at the end of the menu's second row */
+#define DOOR_STATUS_COLUMN      10U
 
 /* Lockout behavior */
 #define LOCKOUT_WAIT_SECONDS    10U
+#define LOCKOUT_TICK_MS         1000U  /* Countdown step */
+
+/* Diagnostic console; it has no password, so only bench builds set
+ * DIAG_CONSOLE_ENABLE to 1 */
+#ifndef DIAG_CONSOLE_ENABLE
+#define DIAG_CONSOLE_ENABLE     0U
+#endif
+#define CONSOLE_BAUD_RATE       115200U
+#define CONSOLE_CHARS_PER_LOOP  16U    /* Input handled per service pass */
+
+/* Door state as reported by Control ECU (values match the event payload) */
+typedef enum
+{
+    DOOR_VIEW_SECURED = 0,
+    DOOR_VIEW_UNLOCKING,
+    DOOR_VIEW_OPEN,
+    DOOR_VIEW_LOCKING,
+    DOOR_VIEW_IDLE                          /* Nothing to show */
+} HMI_DoorViewType;
+
+static HMI_DoorViewType g_doorView = DOOR_VIEW_IDLE;
+static uint32_t g_doorEndMs = 0U;            /* Local tick when the state is due to end */
+static uint32_t g_doorEventStampMs = 0U;     /* Control timestamp of the last event */
+static boolean g_doorShownValid = FALSE;     /* FALSE forces a redraw */
+static HMI_DoorViewType g_doorShownView = DOOR_VIEW_IDLE;
+static uint8_t g_doorShownSeconds = 0U;
+static boolean g_menuVisible = FALSE;
+
+static uint8_t g_lockoutRemaining = 0U;     /* Seconds left, 0 when not locked out */
+static SWTIMER_Type g_lockoutTimer;          /* One countdown second */
+
+static HAL_COMM_HandleType g_consolePort = NULL;   /* NULL: console disabled */
 
 /* Helper prototypes */
 static void HMI_Init(void);
-static void HMI_WaitForReady(void);
+static void HMI_Connect(const char *line1, const char *line2);
+static void HMI_WaitForReady(const char *line1, const char *line2);
+static void HMI_SetTimeoutFromReady(const FRAME_Type *body);
+static void HMI_Service(void);
+static void HMI_OnTick(void);
+static void HMI_DrawMenu(void);
+static void HMI_OnEvent(const FRAME_Type *frame);
+static void HMI_DoorService(void);
 static char HMI_WaitKey(void);
 static uint8_t HMI_ReadPasswordUntilHash(char *buf, uint8_t maxLen);
 static uint8_t HMI_ReadTimeoutFromPot(void);
-static uint8_t HMI_WaitResponse(void);
+static uint8_t HMI_AppendPassword(uint8_t *payload, uint8_t pos,
+                                  const char *pwd, uint8_t len);
+static uint8_t HMI_Request(uint8_t cmd, const uint8_t *payload, uint8_t len);
 static void HMI_ShowMessage(const char *line1, const char *line2, uint32_t delayMs);
 static void HMI_HandleLockout(void);
+static void HMI_CancelLockout(void);
+static void HMI_LockoutTick(void *context);
+static void HMI_DrawLockout(void);
 
 static void Handle_SetupPassword(void);
 static void Handle_OpenDoor(void);
 static void Handle_ChangePassword(void);
 static void Handle_SetTimeout(void);
 
+static void Console_Init(void);
+static void Console_Service(void);
+#if (DIAG_CONSOLE_ENABLE != 0)
+static void Console_Puts(const char *str);
+static void Console_CmdUptime(uint8_t argc, char *argv[]);
+static void Console_CmdRequests(uint8_t argc, char *argv[]);
+#endif
+#if (TRACE_ENABLE != 0)
+static void Console_SendTrace(void);
+#endif
+
+#if (DIAG_CONSOLE_ENABLE != 0)
+/* Console command table ("help" is built in) */
+static const CONSOLE_CommandType consoleCommands[] =
+{
+    { "uptime", "time since reset (us timebase)",   Console_CmdUptime },
+    { "req",    "request counters and round trip",  Console_CmdRequests },
+    { "load",   "[reset] CPU load, peak, busy max", LOAD_ConsoleCmd   },
+#if (PROF_ENABLE != 0)
+    { "prof",   "[reset] cycles per profiled site", PROF_ConsoleCmd   },
+#endif
+#if (TRACE_ENABLE != 0)
+    { "trace",  "[on|off] stream the event trace",  TRACE_ConsoleCmd  },
+#endif
+};
+#endif
+
 int main(void)
 {
     //SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN);
 
     HMI_Init();
-    HMI_WaitForReady();
-
-    /* Check if password needs to be set for the first time */
-    Handle_SetupPassword();
+    HMI_Connect("Waiting Control", NULL);
 
     while(1)
     {
-        /* Show main menu */
-        Lcd_Clear();
-        Lcd_GoToRowColumn(0, 0);
-        Lcd_DisplayString("+)Open  -)Change");
-        Lcd_GoToRowColumn(1, 0);
-        Lcd_DisplayString("=)Timeout");
+        /* Link and door status keep running between key presses */
+        HMI_Service();
+
+        if (!HAL_COMM_IsPeerAlive())
+        {
+            /* Control reset or the cable was pulled: start over once it is back */
+            HMI_Connect("Link lost", "Waiting Control");
+            continue;
+        }
+
+        char key = HAL_Keypad_GetKey();
+
+        /* Ignore input during lockout window */
+        if (g_lockoutRemaining != 0U)
+        {
+            continue;
+        }
 
-        char key = HMI_WaitKey();
+        if ((key != 'A') && (key != 'B') && (key != '*'))
+        {
+            continue;
+        }
+
+        g_menuVisible = FALSE;
 
         if (key == 'A')
         {
@@ -89,10 +211,12 @@ int main(void)
         {
             Handle_ChangePassword();
         }
-        else if (key == '*')
+        else
         {
             Handle_SetTimeout();
         }
+
+        HMI_DrawMenu();
     }
 
     return 0;
@@ -104,40 +228,256 @@ int main(void)
 static void HMI_Init(void)
 {
     MCAL_SysTick_Init();
+    PROF_Init();                  /* Cycle counter (PROF_ENABLE builds) */
+    TIME_Init();                  /* Microsecond delays for the LCD */
+    TRACE_Init(TRACE_ECU_HMI);    /* Event trace (TRACE_ENABLE builds) */
     Lcd_Init();
     HAL_Keypad_Init();
     POT_Init();
     RGB_LED_Init();
     HAL_COMM_Init();
+    LOAD_Init();
+    MCAL_SysTick_SetCallback(HMI_OnTick);  /* Heartbeats, load meter */
+    SWTIMER_Init(MCAL_SysTick_GetTickMs());
+    SWTIMER_Setup(&g_lockoutTimer, HMI_LockoutTick, NULL);
+    REQ_Init(HAL_COMM_SendFrame, HAL_COMM_MAX_PAYLOAD);
+    Console_Init();
     Lcd_Clear();
 }
 
-static void HMI_WaitForReady(void)
+/**
+ * @brief Ready handshake, first-time password check and menu
+ * Run at boot and again after every link loss: a restarted Control has
+ * cleared its password, and the door state shown is stale.
+ */
+static void HMI_Connect(const char *line1, const char *line2)
 {
-    Lcd_Clear();
-    Lcd_DisplayString("Waiting Control");
+    g_menuVisible = FALSE;
+    g_doorView = DOOR_VIEW_IDLE;
+
+    /* Control reports a lockout again if it is still running */
+    HMI_CancelLockout();
+
+    HMI_WaitForReady(line1, line2);
+
+    /* Check if password needs to be set for the first time */
+    Handle_SetupPassword();
+
+    HMI_DrawMenu();
+}
+
+static void HMI_WaitForReady(const char *line1, const char *line2)
+{
+    FRAME_Type frame;
+    FRAME_Type body;
+    uint32_t queryMs;
+    uint8_t seq;
+
+    HMI_ShowMessage(line1, line2, 0U);
+
+    /* Control sends Ready by itself when it hears us after a loss; the
+     * query covers the case where it never noticed we were gone */
+    queryMs = MCAL_SysTick_GetTickMs() - READY_QUERY_MS;
     while (1)
     {
-        if (HAL_COMM_IsDataAvailable())
+        SWTIMER_Process(MCAL_SysTick_GetTickMs());
+
+        if ((MCAL_SysTick_GetTickMs() - queryMs) >= READY_QUERY_MS)
         {
-            uint8_t b = HAL_COMM_ReceiveByte();
-            if (b == RESP_READY)
-            {
-                Lcd_Clear();
-                Lcd_DisplayString("Control Ready");
-                MCAL_SysTick_DelayMs(800U);
+            queryMs = MCAL_SysTick_GetTickMs();
+            (void)REQ_Reply(REQ_SEQ_UNSOLICITED, CMD_READY_QUERY, NULL, 0U);
+        }
 
-                g_currentTimeout = HAL_COMM_ReceiveByte();
-                return;
-            }
+        /* Ready is unsolicited: SEQ 0, payload [timeout] */
+        if (HAL_COMM_PollFrame(&frame) && REQ_Unwrap(&frame, &seq, &body) &&
+            (seq == REQ_SEQ_UNSOLICITED) && (body.cmd == RESP_READY))
+        {
+            Lcd_Clear();
+            Lcd_DisplayString("Control Ready");
+            MCAL_SysTick_DelayMs(800U);
+
+            HMI_SetTimeoutFromReady(&body);
+            return;
+        }
+
+        MCAL_SysTick_Sleep(1U);
+    }
+}
+
+/**
+ * @brief Take the stored auto-lock timeout carried by a Ready frame
+ */
+static void HMI_SetTimeoutFromReady(const FRAME_Type *body)
+{
+    if (body->len >= 1U)
+    {
+        g_currentTimeout = body->payload[0];
+    }
+}
+
+/**
+ * @brief One pass of background work: match replies, expire requests,
+ *        run due timers, refresh the door status
+ * A pass that found no frame ends asleep until the next tick or
+ * interrupt, so the polling loops built on it (keypad, replies) leave
+ * the core idle instead of spinning, and the load meter sees it.
+ */
+static void HMI_Service(void)
+{
+    FRAME_Type frame;
+    boolean gotFrame = FALSE;
+
+    while (HAL_COMM_PollFrame(&frame))
+    {
+        gotFrame = TRUE;
+
+        /* Replies go to their request; late or stray replies are dropped */
+        if (!REQ_OnFrame(&frame))
+        {
+            HMI_OnEvent(&frame);
         }
     }
+
+    REQ_Tick(MCAL_SysTick_GetTickMs());
+    SWTIMER_Process(MCAL_SysTick_GetTickMs());
+    HMI_DoorService();
+    Console_Service();
+
+    if (!gotFrame)
+    {
+        MCAL_SysTick_Sleep(1U);
+    }
+}
+
+/**
+ * @brief SysTick callback work (interrupt context)
+ */
+static void HMI_OnTick(void)
+{
+    HAL_COMM_OnTick();
+    LOAD_OnTick();
+}
+
+static void HMI_DrawMenu(void)
+{
+    /* The lockout screen owns the LCD until the countdown ends */
+    if (g_lockoutRemaining != 0U)
+    {
+        return;
+    }
+
+    Lcd_Clear();
+    Lcd_GoToRowColumn(0, 0);
+    Lcd_DisplayString("+)Open  -)Change");
+    Lcd_GoToRowColumn(1, 0);
+    Lcd_DisplayString("=)Timeout");
+
+    g_menuVisible = TRUE;
+    g_doorShownValid = FALSE;  /* Redraw door status on the fresh screen */
+    HMI_DoorService();
+}
+
+/**
+ * @brief Handle an unsolicited frame from Control
+ * Door events drive the status shown on the menu; the timeline itself
+ * lives only on Control. A repeated Ready (Control answering a query we
+ * no longer wait for) only refreshes the timeout.
+ */
+static void HMI_OnEvent(const FRAME_Type *frame)
+{
+    FRAME_Type body;
+    uint32_t stamp;
+    uint8_t seq;
+
+    if (!REQ_Unwrap(frame, &seq, &body) || (seq != REQ_SEQ_UNSOLICITED))
+    {
+        return;
+    }
+
+    if (body.cmd == RESP_READY)
+    {
+        HMI_SetTimeoutFromReady(&body);
+        return;
+    }
+
+    if ((body.cmd != EVT_DOOR_STATE) || (body.len < 6U) ||
+        (body.payload[0] > (uint8_t)DOOR_VIEW_LOCKING))
+    {
+        return;
+    }
+
+    stamp = ((uint32_t)body.payload[1] << 24) | ((uint32_t)body.payload[2] << 16) |
+            ((uint32_t)body.payload[3] << 8)  |  (uint32_t)body.payload[4];
+
+    /* Drop events older than the last one; "unlocking" starts a new sequence */
+    if ((body.payload[0] != (uint8_t)DOOR_VIEW_UNLOCKING) &&
+        ((int32_t)(stamp - g_doorEventStampMs) < 0))
+    {
+        return;
+    }
+    g_doorEventStampMs = stamp;
+
+    g_doorView = (HMI_DoorViewType)body.payload[0];
+    g_doorEndMs = MCAL_SysTick_GetTickMs() +
+                  ((g_doorView == DOOR_VIEW_SECURED) ? DOOR_SECURED_SHOW_MS
+                                                     : (uint32_t)body.payload[5] * 1000U);
+    g_doorShownValid = FALSE;
+}
+
+/**
+ * @brief Show the reported door state on the menu screen
+ * Status uses the last 6 columns of row 1: "Unlock", "Open12", "Lock..",
+ * "Secure".
+ */
+static void HMI_DoorService(void)
+{
+    int32_t remainingMs = (int32_t)(g_doorEndMs - MCAL_SysTick_GetTickMs());
+    uint8_t seconds = 0U;
+    const char *text;
+
+    /* "Secure" is only a short notice */
+    if ((g_doorView == DOOR_VIEW_SECURED) && (remainingMs <= 0))
+    {
+        g_doorView = DOOR_VIEW_IDLE;
+    }
+
+    switch (g_doorView)
+    {
+        case DOOR_VIEW_UNLOCKING: text = "Unlock"; break;
+        case DOOR_VIEW_LOCKING:   text = "Lock.."; break;
+        case DOOR_VIEW_SECURED:   text = "Secure"; break;
+        case DOOR_VIEW_OPEN:
+            text = "Open";
+            seconds = (remainingMs > 0) ? (uint8_t)((remainingMs + 999) / 1000) : 0U;
+            break;
+        default:                  text = "      "; break;
+    }
+
+    /* Only touch the LCD when something changed and the menu is up */
+    if ((!g_menuVisible) ||
+        (g_doorShownValid && (g_doorShownView == g_doorView) &&
+         (g_doorShownSeconds == seconds)))
+    {
+        return;
+    }
+    g_doorShownValid = TRUE;
+    g_doorShownView = g_doorView;
+    g_doorShownSeconds = seconds;
+
+    Lcd_GoToRowColumn(1, DOOR_STATUS_COLUMN);
+    Lcd_DisplayString(text);
+    if (g_doorView == DOOR_VIEW_OPEN)
+    {
+        Lcd_DisplayCharacter((char)('0' + (seconds / 10U)));
+        Lcd_DisplayCharacter((char)('0' + (seconds % 10U)));
+    }
 }
 
 static char HMI_WaitKey(void)
 {
     char k;
     do {
+        HMI_Service();
         k = HAL_Keypad_GetKey();
     } while (k == '\0');
     return k;
@@ -191,10 +531,52 @@ static uint8_t HMI_ReadTimeoutFromPot(void)
     return t;
 }
 
-static uint8_t HMI_WaitResponse(void)
+/**
+ * @brief Append a length-prefixed password to a command payload
+ * @return Payload length after the append
+ */
+static uint8_t HMI_AppendPassword(uint8_t *payload, uint8_t pos,
+                                  const char *pwd, uint8_t len)
+{
+    payload[pos++] = len;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        payload[pos++] = (uint8_t)pwd[i];
+    }
+    return pos;
+}
+
+/**
+ * @brief Send a request and wait for its reply while background work runs
+ * @return Response code, or RESP_FAILURE if Control did not answer in time
+ */
+static uint8_t HMI_Request(uint8_t cmd, const uint8_t *payload, uint8_t len)
 {
-    /* Blocking wait for 1 byte */
-    return HAL_COMM_ReceiveByte();
+    FRAME_Type response;
+    REQ_StatusType status;
+    uint8_t handle;
+
+    handle = REQ_Send(cmd, payload, len, RESPONSE_TIMEOUT_MS, MCAL_SysTick_GetTickMs());
+    if (handle == REQ_INVALID_HANDLE)
+    {
+        return RESP_FAILURE;
+    }
+
+    do
+    {
+        HMI_Service();
+        status = REQ_GetStatus(handle, &response);
+    } while (status == REQ_STATUS_PENDING);
+
+    REQ_Release(handle);
+
+    if (status != REQ_STATUS_DONE)
+    {
+        HMI_ShowMessage("No Response", "From Control", 1000U);
+        return RESP_FAILURE;
+    }
+
+    return response.cmd;
 }
 
 static void HMI_ShowMessage(const char *line1, const char *line2, uint32_t delayMs)
@@ -205,33 +587,187 @@ static void HMI_ShowMessage(const char *line1, const char *line2, uint32_t delay
     if (delayMs > 0U) { MCAL_SysTick_DelayMs(delayMs); }
 }
 
+/**
+ * @brief Start the 10 second lockout screen
+ * The countdown is a periodic software timer; the main loop ignores keys
+ * until it ends and the menu comes back.
+ */
 static void HMI_HandleLockout(void)
 {
-    /* Block user interaction for 10 seconds, then return to main menu */
-    for (uint8_t remaining = LOCKOUT_WAIT_SECONDS; remaining > 0U; remaining--)
+    HMI_CancelLockout();
+
+    g_menuVisible = FALSE;
+    g_lockoutRemaining = LOCKOUT_WAIT_SECONDS;
+    HMI_DrawLockout();
+
+    SWTIMER_Start(&g_lockoutTimer, LOCKOUT_TICK_MS, LOCKOUT_TICK_MS);
+}
+
+static void HMI_CancelLockout(void)
+{
+    SWTIMER_Stop(&g_lockoutTimer);
+    g_lockoutRemaining = 0U;
+}
+
+/**
+ * @brief One countdown second (g_lockoutTimer)
+ */
+static void HMI_LockoutTick(void *context)
+{
+    (void)context;
+
+    if (g_lockoutRemaining > 1U)
     {
-        Lcd_Clear();
-        Lcd_GoToRowColumn(0, 0);
-        Lcd_DisplayString("LOCKOUT");
-        Lcd_GoToRowColumn(1, 0);
-        Lcd_DisplayString("Wait ");
+        g_lockoutRemaining--;
+        HMI_DrawLockout();
+        return;
+    }
+
+    HMI_CancelLockout();
+    HMI_DrawMenu();
+}
+
+static void HMI_DrawLockout(void)
+{
+    Lcd_Clear();
+    Lcd_GoToRowColumn(0, 0);
+    Lcd_DisplayString("LOCKOUT");
+    Lcd_GoToRowColumn(1, 0);
+    Lcd_DisplayString("Wait ");
+    Lcd_DisplayCharacter((char)('0' + (g_lockoutRemaining / 10U)));
+    Lcd_DisplayCharacter((char)('0' + (g_lockoutRemaining % 10U)));
+    Lcd_DisplayString("s");
+}
+
+/*======================================================================
+ *  Diagnostic Console
+ *====================================================================*/
+
+/**
+ * @brief Open UART0 and start the shell (no-op with DIAG_CONSOLE_ENABLE 0)
+ */
+static void Console_Init(void)
+{
+#if (DIAG_CONSOLE_ENABLE != 0)
+    g_consolePort = HAL_COMM_Open(HAL_COMM_PORT_UART0, CONSOLE_BAUD_RATE);
+    if (g_consolePort != NULL)
+    {
+        CONSOLE_Init(consoleCommands,
+                     (uint8_t)(sizeof(consoleCommands) / sizeof(consoleCommands[0])),
+                     Console_Puts);
+    }
+#endif
+}
+
+/**
+ * @brief Feed the shell what UART0 has received, a bounded amount per pass
+ */
+static void Console_Service(void)
+{
+    uint8_t data;
+    uint8_t count = 0U;
 
-        if (remaining < 10U)
+    while ((count < CONSOLE_CHARS_PER_LOOP) &&
+           HAL_COMM_PortReceiveByte(g_consolePort, &data))
+    {
+        CONSOLE_Feed((char)data);
+        count++;
+    }
+
+#if (TRACE_ENABLE != 0)
+    Console_SendTrace();
+#endif
+}
+
+#if (TRACE_ENABLE != 0)
+/**
+ * @brief Drain the event trace into the UART0 TX ring, whole packets only
+ */
+static void Console_SendTrace(void)
+{
+    uint8_t  packet[TRACE_PACKET_MAX_SIZE];
+    uint16_t len;
+    uint16_t i;
+
+    while (HAL_COMM_PortGetTxRoom(g_consolePort) >= TRACE_PACKET_MAX_SIZE)
+    {
+        len = TRACE_BuildPacket(packet, (uint16_t)sizeof(packet));
+        if (len == 0U)
         {
-            Lcd_DisplayCharacter('0');
-            Lcd_DisplayCharacter((char)('0' + remaining));
+            break;
         }
-        else
+        for (i = 0U; i < len; i++)
         {
-            Lcd_DisplayCharacter((char)('0' + (remaining / 10U)));
-            Lcd_DisplayCharacter((char)('0' + (remaining % 10U)));
+            HAL_COMM_PortSendByte(g_consolePort, packet[i]);
         }
-        Lcd_DisplayString("s");
+    }
+}
+#endif
 
-        /* Ignore input during lockout window */
-        MCAL_SysTick_DelayMs(1000U);
+#if (DIAG_CONSOLE_ENABLE != 0)
+/**
+ * @brief Console output hook
+ */
+static void Console_Puts(const char *str)
+{
+    HAL_COMM_PortSendString(g_consolePort, str);
+}
+
+/**
+ * @brief "uptime": seconds and microseconds since reset
+ */
+static void Console_CmdUptime(uint8_t argc, char *argv[])
+{
+    uint64_t us = TIME_GetUs64();
+    uint32_t frac = (uint32_t)(us % 1000000U);
+    uint32_t digit;
+
+    (void)argc;
+    (void)argv;
+
+    CONSOLE_PrintDec((uint32_t)(us / 1000000U));
+    CONSOLE_Print(".");
+    for (digit = 100000U; digit > 0U; digit /= 10U)
+    {
+        CONSOLE_PrintDec((frac / digit) % 10U);
+    }
+    CONSOLE_Print(" s\r\n");
+}
+
+/**
+ * @brief "req": requests to Control and their round-trip times
+ */
+static void Console_CmdRequests(uint8_t argc, char *argv[])
+{
+    REQ_StatsType stats;
+
+    (void)argc;
+    (void)argv;
+
+    REQ_GetStats(&stats);
+
+    CONSOLE_Print("sent ");
+    CONSOLE_PrintDec(stats.sent);
+    CONSOLE_Print(" done ");
+    CONSOLE_PrintDec(stats.completed);
+    CONSOLE_Print(" timeout ");
+    CONSOLE_PrintDec(stats.timeouts);
+    CONSOLE_Print(" unmatched ");
+    CONSOLE_PrintDec(stats.unmatched);
+    CONSOLE_Print("\r\n");
+
+    if (stats.completed != 0U)
+    {
+        CONSOLE_Print("rtt us min ");
+        CONSOLE_PrintDec(stats.rttMinUs);
+        CONSOLE_Print(" mean ");
+        CONSOLE_PrintDec((uint32_t)(stats.rttTotalUs / stats.completed));
+        CONSOLE_Print(" max ");
+        CONSOLE_PrintDec(stats.rttMaxUs);
+        CONSOLE_Print("\r\n");
     }
 }
+#endif /* DIAG_CONSOLE_ENABLE */
 
 /*======================================================================
  *  Handlers
@@ -245,15 +781,14 @@ static void Handle_SetupPassword(void)
 {
     char pwd1[PASSWORD_MAX_LENGTH + 1];
     char pwd2[PASSWORD_MAX_LENGTH + 1];
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t payloadLen;
     uint8_t len1, len2;
     uint8_t resp;
 
     /* Send setup command to check if password is already set */
-    HAL_COMM_SendByte(CMD_SETUP_PASSWORD);
-    HAL_COMM_SendByte(0);  /* Query mode: send 0 length */
-    
-    /* Wait for response */
-    resp = HMI_WaitResponse();
+    payload[0] = 0U;  /* Query mode: send 0 length */
+    resp = HMI_Request(CMD_SETUP_PASSWORD, payload, 1U);
 
     if (resp == RESP_LOCKOUT)
     {
@@ -316,20 +851,9 @@ static void Handle_SetupPassword(void)
         }
 
         /* Send to Control ECU */
-        HAL_COMM_SendByte(CMD_SETUP_PASSWORD);
-        HAL_COMM_SendByte(len1);  /* Send length first */
-        for (uint8_t i = 0; i < len1; i++)
-        {
-            HAL_COMM_SendByte((uint8_t)pwd1[i]);
-        }
-        HAL_COMM_SendByte(len2);  /* Send confirmation length */
-        for (uint8_t i = 0; i < len2; i++)
-        {
-            HAL_COMM_SendByte((uint8_t)pwd2[i]);
-        }
-
-        /* Wait for response */
-        resp = HMI_WaitResponse();
+        payloadLen = HMI_AppendPassword(payload, 0U, pwd1, len1);
+        payloadLen = HMI_AppendPassword(payload, payloadLen, pwd2, len2);
+        resp = HMI_Request(CMD_SETUP_PASSWORD, payload, payloadLen);
         if (resp == RESP_SUCCESS)
         {
             HMI_ShowMessage("Password", "Saved!", 1500U);
@@ -345,6 +869,7 @@ static void Handle_SetupPassword(void)
 static void Handle_OpenDoor(void)
 {
     char pwd[PASSWORD_MAX_LENGTH + 1];
+    uint8_t payload[FRAME_MAX_PAYLOAD];
     uint8_t pwdLen;
 
     /* Prompt for password */
@@ -355,61 +880,16 @@ static void Handle_OpenDoor(void)
     pwdLen = HMI_ReadPasswordUntilHash(pwd, PASSWORD_MAX_LENGTH);
 
     /* Send command */
-    HAL_COMM_SendByte(CMD_OPEN_DOOR);
-    HAL_COMM_SendByte(pwdLen);  /* Send length first */
-    for (uint8_t i = 0; i < pwdLen; i++)
+    uint8_t resp = HMI_Request(CMD_OPEN_DOOR, payload,
+                               HMI_AppendPassword(payload, 0U, pwd, pwdLen));
+    if (resp == RESP_SUCCESS)
     {
-        HAL_COMM_SendByte((uint8_t)pwd[i]);
+        /* Nothing to wait for: Control runs the motor and reports each
+         * step as an event, shown in the menu corner */
     }
-
-    uint8_t resp = HMI_WaitResponse();
-    if (resp == RESP_SUCCESS)
+    else if (resp == RESP_BUSY)
     {
-        /* Show unlocking message */
-        Lcd_Clear();
-        Lcd_GoToRowColumn(0, 0);
-        Lcd_DisplayString("Unlocking...");
-        MCAL_SysTick_DelayMs(2000U);  /* Match Control ECU unlock time */
-        
-        /* Countdown during door open period */
-        Lcd_Clear();
-        Lcd_GoToRowColumn(0, 0);
-        Lcd_DisplayString("Door Open");
-        
-        /* Use the configured timeout for countdown */
-        uint8_t timeout = g_currentTimeout;
-        
-        for (uint8_t remaining = timeout; remaining > 0; remaining--)
-        {
-            Lcd_GoToRowColumn(1, 0);
-            Lcd_DisplayString("Closing: ");
-            
-            if (remaining < 10)
-            {
-                Lcd_DisplayCharacter('0' + remaining);
-                Lcd_DisplayCharacter(' ');
-            }
-            else
-            {
-                Lcd_DisplayCharacter('0' + (remaining / 10));
-                Lcd_DisplayCharacter('0' + (remaining % 10));
-            }
-            Lcd_DisplayString(" sec  ");
-            
-            MCAL_SysTick_DelayMs(1000U);  /* Wait 1 second */
-        }
-        
-        /* Show locking message */
-        Lcd_Clear();
-        Lcd_GoToRowColumn(0, 0);
-        Lcd_DisplayString("Locking...");
-        MCAL_SysTick_DelayMs(2000U);  /* Match Control ECU lock time */
-        
-        /* Show completion */
-        Lcd_Clear();
-        Lcd_GoToRowColumn(0, 0);
-        Lcd_DisplayString("Door Secured");
-        MCAL_SysTick_DelayMs(1500U);
+        HMI_ShowMessage("Door Busy", "Try Later", 1000U);
     }
     else if (resp == RESP_LOCKOUT)
     {
@@ -426,6 +906,8 @@ static void Handle_ChangePassword(void)
     char oldPwd[PASSWORD_MAX_LENGTH + 1];
     char newPwd[PASSWORD_MAX_LENGTH + 1];
     char confPwd[PASSWORD_MAX_LENGTH + 1];
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t payloadLen;
     uint8_t oldLen, newLen, confLen;
 
     /* Get old password */
@@ -457,15 +939,10 @@ static void Handle_ChangePassword(void)
     confLen = HMI_ReadPasswordUntilHash(confPwd, PASSWORD_MAX_LENGTH);
 
     /* Send command */
-    HAL_COMM_SendByte(CMD_CHANGE_PASSWORD);
-    HAL_COMM_SendByte(oldLen);
-    for (uint8_t i = 0; i < oldLen; i++) HAL_COMM_SendByte((uint8_t)oldPwd[i]);
-    HAL_COMM_SendByte(newLen);
-    for (uint8_t i = 0; i < newLen; i++) HAL_COMM_SendByte((uint8_t)newPwd[i]);
-    HAL_COMM_SendByte(confLen);
-    for (uint8_t i = 0; i < confLen; i++) HAL_COMM_SendByte((uint8_t)confPwd[i]);
-
-    uint8_t resp = HMI_WaitResponse();
+    payloadLen = HMI_AppendPassword(payload, 0U, oldPwd, oldLen);
+    payloadLen = HMI_AppendPassword(payload, payloadLen, newPwd, newLen);
+    payloadLen = HMI_AppendPassword(payload, payloadLen, confPwd, confLen);
+    uint8_t resp = HMI_Request(CMD_CHANGE_PASSWORD, payload, payloadLen);
     if (resp == RESP_SUCCESS)
     {
         HMI_ShowMessage("Password", "Changed", 1000U);
@@ -514,6 +991,7 @@ static void Handle_SetTimeout(void)
 
     /* Read password to authorize */
     char pwd[PASSWORD_MAX_LENGTH + 1];
+    uint8_t payload[FRAME_MAX_PAYLOAD];
     uint8_t pwdLen;
     
     Lcd_Clear();
@@ -522,12 +1000,9 @@ static void Handle_SetTimeout(void)
     Lcd_GoToRowColumn(1, 0);
     pwdLen = HMI_ReadPasswordUntilHash(pwd, PASSWORD_MAX_LENGTH);
 
-    HAL_COMM_SendByte(CMD_SET_TIMEOUT);
-    HAL_COMM_SendByte(timeoutVal); /* 1-byte integer */
-    HAL_COMM_SendByte(pwdLen);
-    for (uint8_t i = 0; i < pwdLen; i++) HAL_COMM_SendByte((uint8_t)pwd[i]);
-
-    uint8_t resp = HMI_WaitResponse();
+    payload[0] = timeoutVal; /* 1-byte integer */
+    uint8_t resp = HMI_Request(CMD_SET_TIMEOUT, payload,
+                               HMI_AppendPassword(payload, 1U, pwd, pwdLen));
     if (resp == RESP_SUCCESS)
     {
         g_currentTimeout = timeoutVal;  /* Update local copy */
@@ -8,6 +8,7 @@
 #include "hal/hal_keypad.h"
 #include "driverlib/sysctl.h"  // For SYSCTL_PERIPH_GPIOx
 #include "mcal/mcal_systick.h" // For debounce delays
+#include "services/prof.h"
 
 /* 
  * Keypad mapping array.
@@ -83,6 +84,8 @@ void HAL_Keypad_Init(void) {
 uint8_t HAL_Keypad_GetKey(void) {
     uint8_t row_state;
     
+    PROF_BEGIN(PROF_SITE_KEYPAD_GETKEY);
+    
     /* Scan each column */
     for (uint8_t col = 0; col < KEYPAD_COLS; col++) {
         /* Set all columns HIGH (inactive) */
@@ -119,11 +122,15 @@ uint8_t HAL_Keypad_GetKey(void) {
                 /* Debounce delay after release */
                 MCAL_SysTick_DelayMs(20);
                 
+                PROF_END(PROF_SITE_KEYPAD_GETKEY);
+                
                 /* Return the mapped character */
                 return keypad_codes[row][col];
             }
         }
     }
     
+    PROF_END(PROF_SITE_KEYPAD_GETKEY);
+    
     return 0; /* No key pressed */
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "hal/hal_lcd.h"
 #include "mcal/mcal_i2c.h"
 #include "mcal/mcal_systick.h"
+#include "services/timebase.h"
+#include "services/prof.h"
+#include "services/trace.h"
 #include <stdint.h> 
 #include "Types.h"
 
@@ -18,12 +21,12 @@ void Lcd_Write_Nibble(uint8_t nibble, uint8_t rs_mode)
     // Construct packet: Nibble + Backlight + RS + Enable(1)
     data_packet = (nibble & 0xF0) | backlight | rs_mode | 0x04; 
     I2C0_WriteByte(LCD_ADDRESS, data_packet);
-    MCAL_SysTick_DelayUs(100); // Enable Pulse Width
+    TIME_DelayUs(100); // Enable Pulse Width
 
     // Pulse Enable OFF
     data_packet = (nibble & 0xF0) | backlight | rs_mode | 0x00;
     I2C0_WriteByte(LCD_ADDRESS, data_packet);
-    MCAL_SysTick_DelayUs(100); // Wait for LCD to process
+    TIME_DelayUs(100); // Wait for LCD to process
 }
 
 /* ======================================================= */
@@ -56,10 +59,14 @@ void Lcd_DisplayCharacter(uint8_t data)
 void Lcd_DisplayString(const char *Str)
 {
     uint8_t i = 0;
+    PROF_BEGIN(PROF_SITE_LCD_STRING);
+    TRACE(TRACE_EVT_LCD_BEGIN, TRACE_LCD_STRING, 0U);
     while(Str[i] != '\0') {
         Lcd_DisplayCharacter(Str[i]);
         i++;
     }
+    TRACE(TRACE_EVT_LCD_END, TRACE_LCD_STRING, i);
+    PROF_END(PROF_SITE_LCD_STRING);
 }
 
 void Lcd_GoToRowColumn(uint8_t row, uint8_t col)
@@ -74,8 +81,10 @@ void Lcd_GoToRowColumn(uint8_t row, uint8_t col)
 
 void Lcd_Clear(void)
 {
+    TRACE(TRACE_EVT_LCD_BEGIN, TRACE_LCD_CLEAR, 0U);
     Lcd_SendCommand(0x01);
-    MCAL_SysTick_DelayUs(2000); // Clear command is SLOW!
+    TIME_DelayUs(2000); // Clear command is SLOW!
+    TRACE(TRACE_EVT_LCD_END, TRACE_LCD_CLEAR, 0U);
 }
 
 /* ======================================================= */
@@ -91,23 +100,23 @@ void Lcd_Init(void)
     // Sending a full byte here causes "Gibberish" sync errors.
     
     Lcd_Write_Nibble(0x30, 0); 
-    MCAL_SysTick_DelayUs(5000); // Wait >4.1ms
+    TIME_DelayUs(5000); // Wait >4.1ms
     
     Lcd_Write_Nibble(0x30, 0); 
-    MCAL_SysTick_DelayUs(200);  // Wait >100us
+    TIME_DelayUs(200);  // Wait >100us
     
     Lcd_Write_Nibble(0x30, 0); 
-    MCAL_SysTick_DelayUs(200);
+    TIME_DelayUs(200);
     
     // --- STEP 2: SWITCH TO 4-BIT MODE ---
     Lcd_Write_Nibble(0x20, 0); // Send 0x20 (Set 4-bit)
-    MCAL_SysTick_DelayUs(2000);
+    TIME_DelayUs(2000);
 
     // --- STEP 3: CONFIGURE LCD (Now safe to use SendCommand) ---
     Lcd_SendCommand(0x28); // Function Set: 4-bit, 2 Line, 5x8 Dots
     Lcd_SendCommand(0x08); // Display OFF
     Lcd_SendCommand(0x01); // Clear Display
-    MCAL_SysTick_DelayUs(2000);        // Clear is slow
+    TIME_DelayUs(2000);        // Clear is slow
     Lcd_SendCommand(0x06); // Entry Mode: Auto Increment
     
     // --- STEP 4: TURN ON DISPLAY ---
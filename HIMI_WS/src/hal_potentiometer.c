@@ -1,5 +1,18 @@
 #include "hal/hal_potentiometer.h"
 #include "mcal/mcal_adc.h"
+#include "services/prof.h"
+
+/* One conversion, profiled as PROF_SITE_ADC_READ */
+static uint16_t prv_read(void)
+{
+    uint16_t raw;
+
+    PROF_BEGIN(PROF_SITE_ADC_READ);
+    raw = ADC_Read();
+    PROF_END(PROF_SITE_ADC_READ);
+
+    return raw;
+}
 
 // Initializes the potentiometer (ADC on PE3)
 void POT_Init(void)
@@ -10,18 +23,18 @@ void POT_Init(void)
 
 uint16_t POT_ReadRaw(void)
 {
-    return ADC_Read();
+    return prv_read();
 }
 
 uint32_t POT_ReadMillivolts(void)
 {
-    uint16_t rawValue = ADC_Read();
+    uint16_t rawValue = prv_read();
     return ADC_ToMillivolts(rawValue);
 }
 
 uint8_t POT_ReadPercentage(void)
 {
-    uint16_t rawValue = ADC_Read();
+    uint16_t rawValue = prv_read();
     /* Convert to percentage: (rawValue * 100) / 4095 */
     return (uint8_t)((rawValue * 100UL) / 4095UL);
 }
@@ -36,7 +49,7 @@ uint16_t POT_ReadRawAveraged(uint8_t numSamples)
     
     for (i = 0; i < numSamples; i++)
     {
-        sum += ADC_Read();
+        sum += prv_read();
     }
     
     return (uint16_t)(sum / numSamples);
@@ -53,7 +66,7 @@ uint8_t POT_ReadPercentageAveraged(uint8_t numSamples)
 // Maps the potentiometer reading to a custom range
 uint32_t POT_ReadMapped(uint32_t min, uint32_t max)
 {
-    uint16_t rawValue = ADC_Read();
+    uint16_t rawValue = prv_read();
     
     /* Map from 0-4095 to min-max range */
     return min + ((rawValue * (max - min)) / 4095UL);